@@ -0,0 +1,121 @@
+/**
+ * @file alert_engine.h
+ * @brief Compiled alert rules evaluated against batches of market events
+ */
+
+#ifndef ALERT_ENGINE_H
+#define ALERT_ENGINE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "emers.h"
+#include "symbol_table.h"
+
+/**
+ * @struct CompiledAlertRule
+ * @brief An AlertConfig reduced to a type mask and per-type thresholds
+ */
+typedef struct {
+    unsigned int typeMask;        /* Bit (1 << EventType) set for every type that can fire */
+    int severityThreshold;        /* Minimum |impactScore| */
+    double minPriceChange;        /* Minimum |changePercent| of price events */
+    double minVolumeChange;       /* Minimum changePercent of volume spikes */
+    int anySymbol;                /* Non-zero if the config has no target symbols */
+} CompiledAlertRule;
+
+/**
+ * @struct Alert
+ * @brief One firing alert, deduplicated on (rule, symbol, event type)
+ */
+typedef struct {
+    int ruleIndex;                /* Rule that fired */
+    int eventIndex;               /* First event that fired it */
+    EventType type;
+    char symbol[MAX_SYMBOL_LENGTH]; /* Affected symbol, "" for market-wide events */
+    int severity;                 /* Largest |impactScore| among the matching events */
+    time_t timestamp;             /* Timestamp of the first matching event */
+    int occurrences;              /* Matching events collapsed into this alert */
+} Alert;
+
+/**
+ * @struct AlertEngine
+ * @brief Set of compiled rules indexed by target symbol
+ *
+ * Each symbol id maps to the rules targeting it (CSR layout), so an event
+ * only visits rules that can match one of its symbols instead of comparing
+ * every target string of every config.
+ */
+typedef struct {
+    SymbolTable symbols;
+    CompiledAlertRule* rules;
+    int ruleCount;
+    int ruleCapacity;
+
+    /* Targets as added: (rule, symbol id) pairs, turned into the CSR index on compile */
+    int* targetRule;
+    int* targetSymbol;
+    int targetCount;
+    int targetCapacity;
+
+    int* symbolRuleStart;         /* symbols.count + 1 offsets into symbolRules */
+    int* symbolRules;
+    int* anySymbolRules;          /* Rules without target symbols */
+    int anySymbolRuleCount;
+    int compiled;
+} AlertEngine;
+
+/**
+ * @brief Initialize an empty alert engine
+ *
+ * @param engine Engine to initialize
+ * @return 0 on success, negative on failure
+ */
+int initAlertEngine(AlertEngine* engine);
+
+/**
+ * @brief Free memory used by an alert engine
+ *
+ * @param engine Engine to free
+ */
+void freeAlertEngine(AlertEngine* engine);
+
+/**
+ * @brief Compile an AlertConfig into a rule
+ *
+ * Price events (jump, drop, volatility) fire when priceChangeThreshold is
+ * positive and the event's |changePercent| reaches it; volume spikes fire
+ * when volumeChangeThreshold is positive and changePercent reaches it.
+ * Events whose changePercent is 0 (not measured) pass both thresholds.
+ * Earnings and merger events fire when their flags are set, and other event
+ * types always qualify. Every event must also reach severityThreshold.
+ *
+ * @param engine Engine to add to
+ * @param config Alert configuration
+ * @return Rule index, negative on failure
+ */
+int addAlertRule(AlertEngine* engine, const AlertConfig* config);
+
+/**
+ * @brief Build the symbol-to-rule index after all rules are added
+ *
+ * @param engine Engine to compile
+ * @return 0 on success, negative on failure
+ */
+int compileAlertEngine(AlertEngine* engine);
+
+/**
+ * @brief Evaluate every rule against a batch of events in one pass
+ *
+ * @param engine Compiled engine
+ * @param events Events to evaluate
+ * @param eventCount Number of events
+ * @param alerts Output alerts in order of first occurrence
+ * @param maxAlerts Capacity of the alerts array
+ * @return Number of alerts stored, negative on failure
+ */
+int evaluateAlerts(const AlertEngine* engine, const MarketEvent* events, int eventCount,
+                   Alert* alerts, int maxAlerts);
+
+#endif /* ALERT_ENGINE_H */
@@ -0,0 +1,84 @@
+/**
+ * @file anomaly_detection.h
+ * @brief Rolling z-score anomaly detection over price change and volume
+ */
+
+#ifndef ANOMALY_DETECTION_H
+#define ANOMALY_DETECTION_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "data_mining.h"
+#include "series_columns.h"
+
+/**
+ * @struct AnomalyConfig
+ * @brief Window and scoring parameters
+ */
+typedef struct {
+    int window;                   /* Trailing bars the z-scores are measured against */
+    double threshold;             /* Minimum score that flags a bar */
+    double priceWeight;           /* Weight of the price-change z-score */
+    double volumeWeight;          /* Weight of the volume z-score */
+} AnomalyConfig;
+
+/**
+ * @brief Fill a config with defaults (20 bars, 2.5 threshold, 0.7/0.3 weights)
+ *
+ * @param config Config to initialize
+ */
+void initAnomalyConfig(AnomalyConfig* config);
+
+/**
+ * @brief Number of doubles of scratch space anomaly scoring needs for a series
+ *
+ * @param barCount Number of bars in the series
+ * @return Scratch size in doubles
+ */
+size_t anomalyWorkspaceSize(int barCount);
+
+/**
+ * @brief Detect anomalies using caller-provided scratch space
+ *
+ * Each bar is scored against the window bars before it, so an anomaly
+ * does not widen its own baseline. Window sums come from prefix sums and
+ * the scoring loop is branch-free, letting the compiler vectorize it.
+ *
+ * @param series Price columns (close, volume)
+ * @param config Parameters (NULL for defaults)
+ * @param workspace Scratch of at least anomalyWorkspaceSize(series->count) doubles
+ * @param anomalies Output anomalies in bar order
+ * @param maxAnomalies Capacity; the most recent anomalies are kept
+ * @return Number of anomalies stored, negative on failure
+ */
+int scoreSeriesAnomalies(const SeriesColumns* series, const AnomalyConfig* config, double* workspace,
+                         AnomalyResult* anomalies, int maxAnomalies);
+
+/**
+ * @brief Detect anomalies of one series
+ *
+ * @param series Price columns (close, volume)
+ * @param config Parameters (NULL for defaults)
+ * @param anomalies Output anomalies in bar order
+ * @param maxAnomalies Capacity; the most recent anomalies are kept
+ * @return Number of anomalies stored, negative on failure
+ */
+int detectSeriesAnomalies(const SeriesColumns* series, const AnomalyConfig* config,
+                          AnomalyResult* anomalies, int maxAnomalies);
+
+/**
+ * @brief Detect anomalies of many series in parallel
+ *
+ * @param series Array of price columns
+ * @param seriesCount Number of series
+ * @param config Parameters (NULL for defaults)
+ * @param anomalies Output, seriesCount * maxAnomalies entries, row-major by series
+ * @param maxAnomalies Capacity per series
+ * @param anomalyCounts Output number of anomalies per series
+ * @return 0 on success, negative on failure
+ */
+int detectUniverseAnomalies(const SeriesColumns* series, int seriesCount, const AnomalyConfig* config,
+                            AnomalyResult* anomalies, int maxAnomalies, int* anomalyCounts);
+
+#endif /* ANOMALY_DETECTION_H */
@@ -0,0 +1,203 @@
+/**
+ * @file backtest.h
+ * @brief Crossover signal generation and multi-symbol backtesting
+ */
+
+#ifndef BACKTEST_H
+#define BACKTEST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "emers.h"
+#include "data_mining.h"
+#include "series_columns.h"
+
+/* Bars per year used to annualize the Sharpe ratio */
+#define BACKTEST_BARS_PER_YEAR 252
+
+/* Bars of volume averaged for signal confidence */
+#define SIGNAL_VOLUME_WINDOW 20
+
+/* Moving averages a crossover rule can compare */
+typedef enum {
+    CROSSOVER_SMA = 0,
+    CROSSOVER_EMA
+} CrossoverType;
+
+/**
+ * @struct CrossoverRule
+ * @brief Fast/slow moving average pair
+ */
+typedef struct {
+    CrossoverType type;
+    int shortPeriod;
+    int longPeriod;
+} CrossoverRule;
+
+/**
+ * @struct BacktestConfig
+ * @brief Exit and cost assumptions of a backtest
+ */
+typedef struct {
+    double targetPercent;         /* Profit target of generated signals (0.05 = 5%) */
+    double stopPercent;           /* Stop distance of generated signals */
+    double costPerSide;           /* Transaction cost per entry or exit, fraction of notional */
+    int allowShort;               /* Non-zero to trade SELL signals short, else they only exit */
+    int maxHoldingBars;           /* Exit at the close after this many bars, 0 for no limit */
+} BacktestConfig;
+
+/**
+ * @struct BacktestResult
+ * @brief Summary statistics of one backtest
+ */
+typedef struct {
+    double totalReturn;           /* Compounded return after costs */
+    double sharpeRatio;           /* Annualized, from bar-to-bar equity returns */
+    double maxDrawdown;           /* Largest equity decline, fraction of the peak */
+    double winRate;               /* Fraction of trades with positive net return */
+    double profitFactor;          /* Gross gains / gross losses (HUGE_VAL with gains but no losses) */
+    double averageTradeReturn;    /* Mean net return per trade */
+    double exposure;              /* Fraction of bars with an open position */
+    int tradeCount;
+    int targetExits;
+    int stopExits;
+    int signalExits;              /* Exits on an opposite signal, holding limit or end of data */
+} BacktestResult;
+
+/**
+ * @brief Fill a config with defaults (5% target, 3% stop, 5 bp per side, long/short)
+ *
+ * @param config Config to initialize
+ */
+void initBacktestConfig(BacktestConfig* config);
+
+/**
+ * @brief Fill a BUY or SELL signal entered at a close
+ *
+ * The target and stop are placed config->targetPercent and
+ * config->stopPercent away from the close in the signal's direction.
+ *
+ * @param signal Signal to fill
+ * @param type DM_SIGNAL_BUY or DM_SIGNAL_SELL
+ * @param index Bar of the signal
+ * @param close Close of that bar (the entry price)
+ * @param confidence Signal confidence
+ * @param config Target and stop distances
+ */
+void initCrossoverSignal(DMTradingSignal* signal, int type, int index, double close,
+                         double confidence, const BacktestConfig* config);
+
+/**
+ * @brief Generate crossover signals from close prices in one pass
+ *
+ * Averages are updated incrementally, so no indicator arrays are built.
+ * Signals start once the slow average has a full window. When more than
+ * maxSignals fire, the most recent ones are kept.
+ *
+ * @param series Price columns
+ * @param rule Moving average pair
+ * @param config Target and stop distances (NULL for defaults)
+ * @param signals Output signals in bar order
+ * @param maxSignals Capacity of the signals array
+ * @return Number of signals stored, negative on failure
+ */
+int generateCrossoverSignals(const SeriesColumns* series, const CrossoverRule* rule,
+                             const BacktestConfig* config, DMTradingSignal* signals, int maxSignals);
+
+/**
+ * @brief Simulate trading a list of signals
+ *
+ * Positions open at a signal's entry price and close at its stop or target
+ * (checked against each later bar's low and high, stop first, with gap
+ * opens filled at the open), at an opposite or STOP_LOSS signal, at the
+ * holding limit, or at the last close.
+ *
+ * @param series Price columns
+ * @param signals Signals sorted by signalIndex
+ * @param signalCount Number of signals
+ * @param config Cost and holding assumptions (NULL for defaults)
+ * @param result Output statistics
+ * @return 0 on success, negative on failure
+ */
+int runSignalBacktest(const SeriesColumns* series, const DMTradingSignal* signals, int signalCount,
+                      const BacktestConfig* config, BacktestResult* result);
+
+/**
+ * @brief Upper bound on how much equity can grow after each bar
+ *
+ * bound[j] is the product over later bars of the best one-bar gain a long
+ * (to the high) or short (to the low) position could make. It holds for
+ * signals that enter at a close, as generated signals do.
+ *
+ * @param series Price columns
+ * @param bound Output array of series->count values
+ * @return 0 on success, negative on failure
+ */
+int computeEquityGainBound(const SeriesColumns* series, double* bound);
+
+/**
+ * @brief runSignalBacktest that gives up once a final equity is unreachable
+ *
+ * Every 32 bars the current equity times gainBound is compared with
+ * minFinalEquity; if it falls short the simulation stops early.
+ *
+ * @param series Price columns
+ * @param signals Signals sorted by signalIndex
+ * @param signalCount Number of signals
+ * @param config Cost and holding assumptions (NULL for defaults)
+ * @param gainBound Output of computeEquityGainBound (NULL to never prune)
+ * @param minFinalEquity Final equity (1.0 = break even) the caller still cares about
+ * @param result Output statistics (only totalReturn so far when pruned)
+ * @return 0 when complete, 1 when pruned, negative on failure
+ */
+int runSignalBacktestBounded(const SeriesColumns* series, const DMTradingSignal* signals, int signalCount,
+                             const BacktestConfig* config, const double* gainBound, double minFinalEquity,
+                             BacktestResult* result);
+
+/**
+ * @brief Generate a rule's signals and backtest them
+ *
+ * @param series Price columns
+ * @param rule Moving average pair
+ * @param config Backtest assumptions (NULL for defaults)
+ * @param result Output statistics
+ * @return 0 on success, negative on failure
+ */
+int runCrossoverBacktest(const SeriesColumns* series, const CrossoverRule* rule,
+                         const BacktestConfig* config, BacktestResult* result);
+
+/**
+ * @brief Backtest every rule on every series in parallel
+ *
+ * Series are distributed over worker threads; each worker reuses one signal
+ * buffer for all rules of its series.
+ *
+ * @param series Array of price columns
+ * @param seriesCount Number of series
+ * @param rules Array of rules
+ * @param ruleCount Number of rules
+ * @param config Backtest assumptions (NULL for defaults)
+ * @param results Output, seriesCount * ruleCount entries, row-major by series
+ * @return 0 on success, negative on failure
+ */
+int runBacktestUniverse(const SeriesColumns* series, int seriesCount,
+                        const CrossoverRule* rules, int ruleCount,
+                        const BacktestConfig* config, BacktestResult* results);
+
+/**
+ * @brief Transpose stocks to columns and backtest every rule on each
+ *
+ * @param stocks Array of stocks
+ * @param stockCount Number of stocks
+ * @param rules Array of rules
+ * @param ruleCount Number of rules
+ * @param config Backtest assumptions (NULL for defaults)
+ * @param results Output, stockCount * ruleCount entries, row-major by stock
+ * @return 0 on success, negative on failure
+ */
+int backtestStocks(const Stock* stocks, int stockCount,
+                   const CrossoverRule* rules, int ruleCount,
+                   const BacktestConfig* config, BacktestResult* results);
+
+#endif /* BACKTEST_H */
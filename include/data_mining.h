@@ -57,4 +57,131 @@ int fillMissingData(StockData* data, int dataSize);
 int prepareDataForMining(const StockData* inputData, int inputSize, 
                          StockData* outputData, int shouldNormalize);
 
+/* Price Patterns */
+
+/* Pattern types (match the PATTERN_* codes of the Java GUI; 9 and 10 are
+   the Java-only head-and-shoulders and reversal codes) */
+typedef enum {
+    DM_PATTERN_UNKNOWN = 0,
+    DM_PATTERN_SUPPORT = 1,
+    DM_PATTERN_RESISTANCE = 2,
+    DM_PATTERN_TREND_CHANGE = 3,
+    DM_PATTERN_DOUBLE_TOP = 4,
+    DM_PATTERN_DOUBLE_BOTTOM = 5,
+    DM_PATTERN_HEAD_SHOULDERS = 6,            /* Head and shoulders top */
+    DM_PATTERN_UPTREND = 7,
+    DM_PATTERN_DOWNTREND = 8,
+    DM_PATTERN_INVERSE_HEAD_SHOULDERS = 11    /* Head and shoulders bottom */
+} DMPatternType;
+
+/**
+ * Chart pattern located between two bars
+ */
+typedef struct {
+    int type;                 /* DMPatternType */
+    int startIndex;           /* First pivot of the pattern */
+    int endIndex;             /* Last pivot (or confirming bar) of the pattern */
+    double confidence;        /* 0.5 to 0.95 */
+    double expectedMove;      /* Projected move from priceLevel in percent (signed) */
+    double priceLevel;        /* Support/resistance, neckline or trend pivot price */
+} MarketPattern;
+
+/**
+ * Detect support/resistance, double tops/bottoms, head and shoulders and
+ * trend changes from zigzag pivots (5% reversals).
+ * When more than maxPatterns are found, the most recent ones are kept.
+ * 
+ * @param data Input stock data array
+ * @param dataSize Number of data points
+ * @param patterns Output patterns ordered by start index
+ * @param maxPatterns Capacity of the patterns array
+ * @return Number of patterns stored, negative on failure
+ */
+int detectPricePatterns(const StockData* data, int dataSize, MarketPattern* patterns, int maxPatterns);
+
+/* Anomalies */
+
+/**
+ * Bar whose price change and volume stand out from the trailing window
+ */
+typedef struct {
+    int index;                /* Bar index */
+    double score;             /* Weighted absolute z-score */
+    double priceDeviation;    /* Signed z-score of the close-to-close change */
+    double volumeDeviation;   /* Signed z-score of the volume */
+    double priceChange;       /* Close-to-close change as a fraction */
+} AnomalyResult;
+
+/**
+ * Detect anomalies with rolling 20-bar z-scores of price change (weight 0.7)
+ * and volume (weight 0.3), flagging scores above 2.5.
+ * When more than maxAnomalies are found, the most recent ones are kept.
+ * 
+ * @param data Input stock data array
+ * @param dataSize Number of data points
+ * @param anomalies Output anomalies in bar order
+ * @param maxAnomalies Capacity of the anomalies array
+ * @return Number of anomalies stored, negative on failure
+ */
+int detectAnomalies(const StockData* data, int dataSize, AnomalyResult* anomalies, int maxAnomalies);
+
+/* Trading Signals */
+
+/* Signal types (match the SIGNAL_* codes of the Java GUI) */
+typedef enum {
+    DM_SIGNAL_UNKNOWN = 0,
+    DM_SIGNAL_BUY,
+    DM_SIGNAL_SELL,
+    DM_SIGNAL_HOLD,
+    DM_SIGNAL_STOP_LOSS
+} DMSignalType;
+
+/* Default exits of crossover signals: 5% target, 3% stop */
+#define DM_DEFAULT_TARGET_PERCENT 0.05
+#define DM_DEFAULT_STOP_PERCENT 0.03
+
+/**
+ * Trading signal with entry, target and stop-loss prices
+ */
+typedef struct {
+    int type;                 /* DMSignalType */
+    int signalIndex;          /* Bar the signal fired on */
+    double confidence;        /* 0.5 to 1.0, from volume confirmation */
+    double entryPrice;
+    double targetPrice;
+    double stopLossPrice;
+    double riskRewardRatio;
+} DMTradingSignal;
+
+/**
+ * Detect simple moving average crossover signals
+ * BUY when the short SMA crosses above the long SMA, SELL when it crosses below.
+ * When more than maxSignals signals fire, the most recent ones are kept.
+ * 
+ * @param data Input stock data array
+ * @param dataSize Number of data points
+ * @param shortPeriod Period of the fast average
+ * @param longPeriod Period of the slow average
+ * @param signals Output signals in bar order
+ * @param maxSignals Capacity of the signals array
+ * @return Number of signals stored, negative on failure
+ */
+int detectSMACrossoverSignals(const StockData* data, int dataSize, int shortPeriod, int longPeriod,
+                              DMTradingSignal* signals, int maxSignals);
+
+/**
+ * Detect exponential moving average crossover signals
+ * Same rules as detectSMACrossoverSignals with EMAs seeded by the first close.
+ * 
+ * @param data Input stock data array
+ * @param dataSize Number of data points
+ * @param shortPeriod Period of the fast average
+ * @param longPeriod Period of the slow average
+ * @param signals Output signals in bar order
+ * @param maxSignals Capacity of the signals array
+ * @return Number of signals stored, negative on failure
+ */
+int detectEMACrossoverSignals(const StockData* data, int dataSize, int shortPeriod, int longPeriod,
+                              DMTradingSignal* signals, int maxSignals);
+
 #endif /* DATA_MINING_H */
\ No newline at end of file
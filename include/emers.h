@@ -67,10 +67,13 @@ typedef struct {
     int impactScore;             /* Impact score (0-10) */
 } EventData;
 
+struct NewsDeduper;
+
 typedef struct {
     EventData* events;
     int eventCount;
     int eventCapacity;
+    struct NewsDeduper* newsDedup;  /* Recent story signatures shared across news fetches */
 } EventDatabase;
 
 typedef struct {
@@ -97,6 +100,7 @@ typedef struct {
     char affectedStocks[10][16]; // Up to 10 stock symbols
     int affectedStockCount;
     int impactScore;          // -10 to 10 scale
+    double changePercent;     // Price or volume change behind the event, in percent (0 if unknown)
     char source[64];          // Information source
 } MarketEvent;
 
@@ -132,14 +136,16 @@ void calculateBollingerBands(const StockData* data, int dataSize, int period, do
 void calculateATR(const StockData* data, int dataSize, int period, double* output);
 void calculateAllIndicators(const StockData* data, int dataSize, TechnicalIndicators* indicators);
 
-// Event Detection and Analysis
-int detectMarketEvents(const Stock* stocks, int stockCount, const EventDatabase* newsEvents, EventData* detectedEvents);
+// Event Detection and Analysis (fills at most maxEvents entries of detectedEvents)
+int detectMarketEvents(const Stock* stocks, int stockCount, const EventDatabase* newsEvents,
+                       EventData* detectedEvents, int maxEvents);
 double calculateEventImpact(const EventData* event, const Stock* stocks, int stockCount);
 EventType classifyEvent(const EventData* event);
 
 // Risk Management
 double calculateValueAtRisk(const Stock* stock, double confidenceLevel, int timeHorizon);
 double calculateMaxDrawdown(const StockData* data, int dataSize);
+// strategyOutput must hold MAX_BUFFER_SIZE bytes
 void generateDefensiveStrategy(const Stock* stocks, int stockCount, const EventData* event, char* strategyOutput);
 
 // Utility Functions
@@ -0,0 +1,195 @@
+/**
+ * @file event_bus.h
+ * @brief Bounded lock-free event queues consumed in batches by a worker pool
+ */
+
+#ifndef EVENT_BUS_H
+#define EVENT_BUS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "emers.h"
+
+/* Upper bound on worker threads (one queue per worker) */
+#define MAX_EVENT_BUS_WORKERS 32
+
+/**
+ * @enum BackpressurePolicy
+ * @brief What publishing does when the target queue is full
+ */
+typedef enum {
+    BACKPRESSURE_BLOCK = 0,       /* Wait until the worker frees a cell */
+    BACKPRESSURE_DROP_NEWEST,     /* Reject the new event */
+    BACKPRESSURE_DROP_OLDEST      /* Discard the oldest queued event to make room */
+} BackpressurePolicy;
+
+/**
+ * @brief Consumer callback, called by a worker with a batch of events
+ *
+ * @param events Events in publish order per symbol
+ * @param count Number of events (1 to batchSize)
+ * @param context Handler context given to startEventBus
+ */
+typedef void (*EventBatchHandler)(const MarketEvent* events, int count, void* context);
+
+/**
+ * @struct EventBusConfig
+ * @brief Worker pool and queue settings
+ */
+typedef struct {
+    int workerCount;              /* Worker threads, each draining its own queue */
+    int queueCapacity;            /* Cells per queue, rounded up to a power of two */
+    int batchSize;                /* Maximum events handed to the handler at once */
+    BackpressurePolicy policy;
+} EventBusConfig;
+
+/**
+ * @struct EventQueueStats
+ * @brief Counters of one queue
+ */
+typedef struct {
+    unsigned long published;      /* Events accepted */
+    unsigned long consumed;       /* Events handed to the handler */
+    unsigned long dropped;        /* Events rejected or discarded by backpressure */
+    unsigned long batches;        /* Handler calls */
+    int depth;                    /* Events queued right now */
+    int highWatermark;            /* Largest depth observed at publish time */
+    int capacity;
+} EventQueueStats;
+
+typedef struct EventBus EventBus;
+
+/**
+ * @struct EventCell
+ * @brief One ring cell; its sequence says whether it is free or full for a lap
+ */
+typedef struct {
+    unsigned long sequence;
+    MarketEvent event;
+} EventCell;
+
+/**
+ * @struct EventQueue
+ * @brief Bounded multi-producer queue (Vyukov sequence-per-cell ring)
+ *
+ * Producers claim cells with a CAS on the enqueue position; the owning
+ * worker (and, under DROP_OLDEST, producers evicting) claim with a CAS on
+ * the dequeue position. No locks are taken on the publish path; the mutex
+ * and condition only park an idle worker.
+ */
+typedef struct {
+    EventCell* cells;
+    unsigned long mask;
+    unsigned long enqueuePos;
+    char padding[64];             /* Keep producer and consumer positions on separate lines */
+    unsigned long dequeuePos;
+
+    unsigned long published;
+    unsigned long consumed;
+    unsigned long dropped;
+    unsigned long batches;
+    int highWatermark;
+
+    EventBus* bus;                /* Owning bus, for the worker */
+    int sleeping;
+    pthread_mutex_t wakeLock;
+    pthread_cond_t wakeSignal;
+} EventQueue;
+
+/**
+ * @struct EventBus
+ * @brief Queues, workers and handler of a running bus
+ */
+struct EventBus {
+    EventBusConfig config;
+    EventQueue queues[MAX_EVENT_BUS_WORKERS];
+    pthread_t workers[MAX_EVENT_BUS_WORKERS];
+    int workerCount;
+    unsigned long nextQueue;      /* Round-robin cursor for market-wide events */
+    EventBatchHandler handler;
+    void* context;
+    int running;
+};
+
+/**
+ * @brief Fill an event bus configuration with defaults
+ *
+ * Two workers, 4096 cells per queue, batches of 64, BLOCK policy.
+ *
+ * @param config Configuration to initialize
+ */
+void initEventBusConfig(EventBusConfig* config);
+
+/**
+ * @brief Allocate queues and start the workers
+ *
+ * @param bus Bus to start
+ * @param config Configuration (NULL for defaults)
+ * @param handler Batch consumer
+ * @param context Handler context
+ * @return 0 on success, negative on failure
+ */
+int startEventBus(EventBus* bus, const EventBusConfig* config, EventBatchHandler handler, void* context);
+
+/**
+ * @brief Drain every queue, stop the workers and free the queues
+ *
+ * Producers must have stopped publishing before this is called.
+ *
+ * @param bus Bus to stop
+ */
+void stopEventBus(EventBus* bus);
+
+/**
+ * @brief Publish one event
+ *
+ * Events with affected stocks go to the queue owned by their first symbol,
+ * so each symbol's events are handled in order by one worker. Market-wide
+ * events are spread round-robin.
+ *
+ * @param bus Running bus
+ * @param event Event to copy into the queue
+ * @return 0 if queued, 1 if dropped by backpressure, negative on failure
+ */
+int publishEvent(EventBus* bus, const MarketEvent* event);
+
+/**
+ * @brief Publish several events
+ *
+ * @param bus Running bus
+ * @param events Events to publish
+ * @param count Number of events
+ * @return Number of events queued, negative on failure
+ */
+int publishEvents(EventBus* bus, const MarketEvent* events, int count);
+
+/**
+ * @brief Read the counters of one queue
+ *
+ * @param bus Bus
+ * @param queue Queue (worker) index
+ * @param stats Output counters
+ * @return 0 on success, negative on failure
+ */
+int getEventQueueStats(const EventBus* bus, int queue, EventQueueStats* stats);
+
+/**
+ * @brief Set the handler used by the bus that initEMERS starts
+ *
+ * Must be called before initEMERS. The default handler logs each event.
+ *
+ * @param handler Batch consumer (NULL for the default)
+ * @param context Handler context
+ */
+void setEMERSEventHandler(EventBatchHandler handler, void* context);
+
+/**
+ * @brief Bus started by initEMERS, or NULL when not running
+ *
+ * @return Process-wide event bus
+ */
+EventBus* getEMERSEventBus(void);
+
+#endif /* EVENT_BUS_H */
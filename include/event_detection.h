@@ -0,0 +1,109 @@
+/**
+ * @file event_detection.h
+ * @brief Streaming detection of price, volume and volatility events
+ */
+
+#ifndef EVENT_DETECTION_H
+#define EVENT_DETECTION_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "emers.h"
+#include "event_store.h"
+#include "symbol_table.h"
+
+/* Most events a single bar can produce (jump or drop, volume, volatility) */
+#define MAX_EVENTS_PER_BAR 3
+
+/**
+ * @struct EventDetectorConfig
+ * @brief Thresholds and smoothing of the market event detector
+ */
+typedef struct {
+    int span;                     /* EWMA span in bars for return and volume statistics */
+    int fastSpan;                 /* EWMA span in bars for short-term volatility */
+    int warmupBars;               /* Bars seen before any event is emitted */
+    double returnZThreshold;      /* |z| of the bar return for PRICE_JUMP/PRICE_DROP */
+    double minReturn;             /* Smallest absolute return reported as a jump or drop */
+    double volumeZThreshold;      /* z of log volume for VOLUME_SPIKE */
+    double volatilityRatio;       /* Short/long volatility ratio for VOLATILITY_SPIKE */
+} EventDetectorConfig;
+
+/**
+ * @struct DetectorState
+ * @brief Exponentially weighted statistics of one symbol, updated in O(1) per bar
+ */
+typedef struct {
+    double lastClose;
+    double returnMean;
+    double returnVar;
+    double fastVar;               /* Short-span mean of squared returns */
+    double logVolumeMean;
+    double logVolumeVar;
+    int barCount;
+    int inVolatilitySpike;        /* Suppresses repeats until volatility calms down */
+} DetectorState;
+
+/**
+ * @struct MarketEventDetector
+ * @brief Per-symbol detector states for live bar streams
+ */
+typedef struct {
+    EventDetectorConfig config;
+    SymbolTable symbols;
+    DetectorState* states;        /* Indexed by symbol id */
+    int stateCapacity;
+} MarketEventDetector;
+
+/**
+ * @brief Fill a config with defaults (20-bar span, 3-sigma thresholds)
+ *
+ * @param config Config to initialize
+ */
+void initEventDetectorConfig(EventDetectorConfig* config);
+
+/**
+ * @brief Initialize a detector
+ *
+ * @param detector Detector to initialize
+ * @param config Configuration (NULL for defaults)
+ * @return 0 on success, negative on failure
+ */
+int initMarketEventDetector(MarketEventDetector* detector, const EventDetectorConfig* config);
+
+/**
+ * @brief Free memory used by a detector
+ *
+ * @param detector Detector to free
+ */
+void freeMarketEventDetector(MarketEventDetector* detector);
+
+/**
+ * @brief Feed one new bar of a symbol and collect the events it triggers
+ *
+ * @param detector Detector
+ * @param symbol Symbol the bar belongs to
+ * @param bar The new bar
+ * @param events Output array of at least MAX_EVENTS_PER_BAR entries
+ * @return Number of events written, negative on failure
+ */
+int detectorOnBar(MarketEventDetector* detector, const char* symbol, const StockData* bar,
+                  EventData* events);
+
+/**
+ * @brief Replay full histories and store every detected event
+ *
+ * Each stock is replayed independently in parallel. Events are appended
+ * grouped by stock in input order and by bar within each stock.
+ *
+ * @param stocks Price histories
+ * @param stockCount Number of stocks
+ * @param config Configuration (NULL for defaults)
+ * @param store Store receiving the events
+ * @return Number of events added, negative on failure
+ */
+int replayMarketHistory(const Stock* stocks, int stockCount, const EventDetectorConfig* config,
+                        EventStore* store);
+
+#endif /* EVENT_DETECTION_H */
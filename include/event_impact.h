@@ -0,0 +1,103 @@
+/**
+ * @file event_impact.h
+ * @brief Event study engine: abnormal returns around events via sort-merge join
+ */
+
+#ifndef EVENT_IMPACT_H
+#define EVENT_IMPACT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "emers.h"
+#include "event_store.h"
+
+/* Symbol used as the benchmark by calculateEventImpact when present */
+#define DEFAULT_BENCHMARK_SYMBOL "SPY"
+
+/* Fewest estimation bars needed to fit the market model */
+#define MIN_ESTIMATION_BARS 20
+
+/* How normal returns are modelled */
+typedef enum {
+    EVENT_MODEL_RAW = 0,          /* AR = r (no benchmark) */
+    EVENT_MODEL_MARKET_ADJUSTED,  /* AR = r - rm */
+    EVENT_MODEL_MARKET            /* AR = r - (alpha + beta * rm), fitted before the event */
+} EventReturnModel;
+
+/**
+ * @struct EventStudyConfig
+ * @brief Windows (in bars) and model of an event study
+ *
+ * For an event mapped to bar t, the pre-event window is [t - preWindow, t - 1],
+ * the post-event window is [t, t + postWindow] and the estimation window is
+ * [t - estimationGap - estimationWindow, t - estimationGap).
+ */
+typedef struct {
+    int preWindow;
+    int postWindow;
+    int estimationWindow;
+    int estimationGap;
+    EventReturnModel model;
+} EventStudyConfig;
+
+/**
+ * @struct EventImpact
+ * @brief Abnormal-return statistics of one event
+ */
+typedef struct {
+    int valid;                    /* Non-zero if the windows fit the price history */
+    int stockIndex;               /* Index of the matched stock */
+    int barIndex;                 /* First bar on or after the event date */
+    double eventReturn;           /* Abnormal return on the event bar */
+    double preCAR;                /* Cumulative abnormal return before the event */
+    double postCAR;               /* Cumulative abnormal return from the event bar on */
+    double alpha;                 /* Market model intercept (0 for other models) */
+    double beta;                  /* Market model slope (1 market-adjusted, 0 raw) */
+    double sigma;                 /* Per-bar abnormal return std dev in the estimation window */
+    double tStat;                 /* postCAR / (sigma * sqrt(postWindow + 1)) */
+} EventImpact;
+
+/**
+ * @brief Fill a config with defaults (5 bars pre/post, 120-bar estimation, market model)
+ *
+ * @param config Config to initialize
+ */
+void initEventStudyConfig(EventStudyConfig* config);
+
+/**
+ * @brief Run an event study over every event of an EventStore
+ *
+ * Events are sorted by (stock, timestamp) and merge-joined against each
+ * stock's bars, so each series is walked once regardless of how many events
+ * it has. Stocks are processed in parallel. Bars must be in ascending date
+ * order.
+ *
+ * @param store Events to study
+ * @param stocks Price histories, matched to events by symbol
+ * @param stockCount Number of stocks
+ * @param benchmark Benchmark series (may be NULL, which forces the raw model)
+ * @param config Study configuration (NULL for defaults)
+ * @param impacts Output array indexed like the store (store->count entries)
+ * @return Number of events with valid results, negative on failure
+ */
+int runEventStudy(const EventStore* store, const Stock* stocks, int stockCount,
+                  const Stock* benchmark, const EventStudyConfig* config, EventImpact* impacts);
+
+/**
+ * @brief Run an event study over an array of EventData records
+ *
+ * @param events Events to study (timestamp, or date when timestamp is 0)
+ * @param eventCount Number of events
+ * @param stocks Price histories, matched to events by symbol
+ * @param stockCount Number of stocks
+ * @param benchmark Benchmark series (may be NULL)
+ * @param config Study configuration (NULL for defaults)
+ * @param impacts Output array of eventCount entries
+ * @return Number of events with valid results, negative on failure
+ */
+int runEventStudyOnEvents(const EventData* events, int eventCount, const Stock* stocks, int stockCount,
+                          const Stock* benchmark, const EventStudyConfig* config, EventImpact* impacts);
+
+#endif /* EVENT_IMPACT_H */
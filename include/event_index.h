@@ -0,0 +1,151 @@
+/**
+ * @file event_index.h
+ * @brief Inverted index over an EventStore by symbol, stemmed term and day
+ */
+
+#ifndef EVENT_INDEX_H
+#define EVENT_INDEX_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "event_store.h"
+#include "stemmer.h"
+#include "string_arena.h"
+
+/* Number of event ids per compressed posting block */
+#define POSTING_BLOCK_SIZE 128
+
+/* Most terms in one query */
+#define MAX_QUERY_TERMS 8
+
+/* Seconds per day bucket */
+#define INDEX_DAY_SECONDS 86400
+
+/* Kinds of index keys */
+typedef enum {
+    INDEX_KEY_SYMBOL = 1,
+    INDEX_KEY_TERM,
+    INDEX_KEY_DAY
+} IndexKeyKind;
+
+/**
+ * @struct PostingSkip
+ * @brief Skip entry locating one compressed posting block
+ */
+typedef struct {
+    int baseId;                   /* Event id preceding the block (-1 for the first) */
+    int maxId;                    /* Largest event id in the block */
+    int byteOffset;               /* Offset of the block in the posting bytes */
+} PostingSkip;
+
+/**
+ * @struct PostingList
+ * @brief Ascending event ids stored as varint-encoded deltas in blocks
+ */
+typedef struct {
+    unsigned char* bytes;
+    int byteCount;
+    int byteCapacity;
+    PostingSkip* skips;           /* One entry per block */
+    int skipCount;
+    int skipCapacity;
+    int idCount;
+    int lastId;
+} PostingList;
+
+/**
+ * @struct IndexEntry
+ * @brief One index key and its posting list
+ */
+typedef struct {
+    unsigned int hash;
+    unsigned char kind;           /* IndexKeyKind */
+    long long value;              /* Symbol id or day number */
+    unsigned int termOffset;      /* Stemmed term in the index arena */
+    PostingList postings;
+} IndexEntry;
+
+/**
+ * @struct EventIndex
+ * @brief Inverted index built incrementally over an EventStore
+ *
+ * Event ids are store indices. Events are indexed in store order, so every
+ * posting list is appended in ascending order and never re-sorted.
+ */
+typedef struct {
+    const EventStore* store;
+    int indexedCount;             /* Store events indexed so far */
+    IndexEntry* entries;
+    int entryCount;
+    int entryCapacity;
+    int* slots;                   /* Entry + 1 per slot, 0 for empty */
+    int slotCapacity;             /* Always a power of two */
+    StringArena terms;
+    StemCache* stemCache;
+} EventIndex;
+
+/**
+ * @struct EventQuery
+ * @brief Conjunctive query: all given conditions must hold
+ */
+typedef struct {
+    const char* symbol;                    /* NULL for any symbol */
+    const char* terms[MAX_QUERY_TERMS];    /* Words that must appear (stemmed before lookup) */
+    int termCount;
+    time_t startTime;                      /* Inclusive, 0 for no lower bound */
+    time_t endTime;                        /* Exclusive, 0 for no upper bound */
+} EventQuery;
+
+/**
+ * @brief Initialize an empty index over an event store
+ *
+ * @param index Index to initialize
+ * @param store Store whose events will be indexed
+ * @return 0 on success, negative on failure
+ */
+int initEventIndex(EventIndex* index, const EventStore* store);
+
+/**
+ * @brief Free memory used by an index
+ *
+ * @param index Index to free
+ */
+void freeEventIndex(EventIndex* index);
+
+/**
+ * @brief Index every store event added since the last update
+ *
+ * @param index Index to update
+ * @return Number of events indexed, negative on failure
+ */
+int updateEventIndex(EventIndex* index);
+
+/**
+ * @brief Find events matching a query
+ *
+ * A query needs at least one condition. Events whose timestamps fall in the
+ * first or last day of the range are checked against the exact bounds.
+ *
+ * @param index Event index
+ * @param query Query to run
+ * @param results Output event ids in ascending order
+ * @param maxResults Capacity of the results array
+ * @return Number of ids stored, negative on failure
+ */
+int queryEventIndex(const EventIndex* index, const EventQuery* query, int* results, int maxResults);
+
+/**
+ * @brief Number of events whose posting list holds a key
+ *
+ * @param index Event index
+ * @param kind Key kind
+ * @param symbolOrTerm Symbol or term for symbol and term keys
+ * @param day Day number for day keys
+ * @return Posting list length, 0 if the key is absent
+ */
+int eventIndexKeyCount(const EventIndex* index, IndexKeyKind kind, const char* symbolOrTerm, long long day);
+
+#endif /* EVENT_INDEX_H */
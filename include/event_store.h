@@ -0,0 +1,223 @@
+/**
+ * @file event_store.h
+ * @brief Compact event storage with hot fields in an array and text in an arena
+ */
+
+#ifndef EVENT_STORE_H
+#define EVENT_STORE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "emers.h"
+#include "string_arena.h"
+#include "symbol_table.h"
+
+/**
+ * @struct EventRecord
+ * @brief Fixed-size fields of one stored event
+ *
+ * Records hold only what scans filter and aggregate on, so a full pass over
+ * a million events touches about 24 MB instead of the 8 KB per event that an
+ * EventData array costs.
+ */
+typedef struct {
+    time_t timestamp;             /* Event timestamp */
+    int symbolId;                 /* Id in the store's symbol table */
+    float sentiment;              /* Sentiment score (-1.0 to 1.0) */
+    float magnitude;              /* Event magnitude (severity) */
+    unsigned char type;           /* EventType */
+    signed char impactScore;      /* Impact score (0-10) */
+} EventRecord;
+
+/**
+ * @struct EventTextRef
+ * @brief Arena offsets of the variable-length text of one event
+ */
+typedef struct {
+    unsigned int title;
+    unsigned int description;
+    unsigned int url;
+    unsigned int date;
+} EventTextRef;
+
+/**
+ * @struct EventStore
+ * @brief Append-only event store
+ *
+ * records[i] and text[i] describe event i. Text lives in one arena, so
+ * storing an event costs its actual text length rather than fixed buffers.
+ */
+typedef struct {
+    EventRecord* records;
+    EventTextRef* text;
+    int count;
+    int capacity;
+    StringArena arena;
+    SymbolTable symbols;
+} EventStore;
+
+/**
+ * @struct EventStoreCursor
+ * @brief Filtered forward iterator over an event store
+ */
+typedef struct {
+    const EventStore* store;
+    int next;                     /* Index of the next event to examine */
+    int symbolId;                 /* INVALID_SYMBOL_ID for all symbols */
+    time_t startTime;             /* Inclusive, 0 for no lower bound */
+    time_t endTime;               /* Exclusive, 0 for no upper bound */
+} EventStoreCursor;
+
+/**
+ * @brief Initialize an empty event store
+ *
+ * @param store Store to initialize
+ * @param expectedEvents Number of events expected (0 for a default)
+ * @return 0 on success, negative on failure
+ */
+int initEventStore(EventStore* store, int expectedEvents);
+
+/**
+ * @brief Free memory used by an event store
+ *
+ * @param store Store to free
+ */
+void freeEventStore(EventStore* store);
+
+/**
+ * @brief Remove all events but keep allocated memory and symbol ids
+ *
+ * @param store Store to clear
+ */
+void clearEventStore(EventStore* store);
+
+/**
+ * @brief Append an event given its individual fields
+ *
+ * @param store Store to append to
+ * @param symbol Stock symbol (may be NULL or empty for market-wide events)
+ * @param timestamp Event timestamp
+ * @param type Event type
+ * @param sentiment Sentiment score
+ * @param impactScore Impact score
+ * @param magnitude Event magnitude
+ * @param title Title text (may be NULL)
+ * @param description Description text (may be NULL)
+ * @param url Source URL (may be NULL)
+ * @param date Date string (may be NULL)
+ * @return Index of the new event, negative on failure
+ */
+int eventStoreAppend(EventStore* store, const char* symbol, time_t timestamp, EventType type,
+                     float sentiment, int impactScore, double magnitude,
+                     const char* title, const char* description, const char* url, const char* date);
+
+/**
+ * @brief Append a copy of an EventData record
+ *
+ * @param store Store to append to
+ * @param event Event to copy
+ * @return Index of the new event, negative on failure
+ */
+int eventStoreAdd(EventStore* store, const EventData* event);
+
+/**
+ * @brief Append every event of an EventDatabase
+ *
+ * @param store Store to append to
+ * @param db Database to copy
+ * @return Number of events added, negative on failure
+ */
+int eventStoreImportDatabase(EventStore* store, const EventDatabase* db);
+
+/**
+ * @brief Get the fixed-size fields of an event
+ *
+ * @param store Event store
+ * @param index Event index
+ * @return Pointer to the record, or NULL for an invalid index
+ */
+const EventRecord* eventStoreRecord(const EventStore* store, int index);
+
+/**
+ * @brief Get the symbol of an event
+ *
+ * @param store Event store
+ * @param index Event index
+ * @return Symbol text, or "" if the event has none
+ */
+const char* eventStoreSymbol(const EventStore* store, int index);
+
+/**
+ * @brief Get the title of an event
+ *
+ * The pointer is invalidated by the next append.
+ *
+ * @param store Event store
+ * @param index Event index
+ * @return Title text, or "" for an invalid index
+ */
+const char* eventStoreTitle(const EventStore* store, int index);
+
+/**
+ * @brief Get the description of an event
+ *
+ * @param store Event store
+ * @param index Event index
+ * @return Description text, or "" for an invalid index
+ */
+const char* eventStoreDescription(const EventStore* store, int index);
+
+/**
+ * @brief Get the source URL of an event
+ *
+ * @param store Event store
+ * @param index Event index
+ * @return URL text, or "" for an invalid index
+ */
+const char* eventStoreUrl(const EventStore* store, int index);
+
+/**
+ * @brief Get the date string of an event
+ *
+ * @param store Event store
+ * @param index Event index
+ * @return Date text, or "" for an invalid index
+ */
+const char* eventStoreDate(const EventStore* store, int index);
+
+/**
+ * @brief Materialize an event as an EventData record
+ *
+ * Text longer than the EventData buffers is truncated.
+ *
+ * @param store Event store
+ * @param index Event index
+ * @param event Output event
+ * @return 0 on success, negative on failure
+ */
+int eventStoreGet(const EventStore* store, int index, EventData* event);
+
+/**
+ * @brief Start iterating over events matching a symbol and time range
+ *
+ * @param cursor Cursor to initialize
+ * @param store Event store
+ * @param symbol Symbol to match, or NULL for all symbols
+ * @param startTime Inclusive lower time bound, 0 for none
+ * @param endTime Exclusive upper time bound, 0 for none
+ */
+void eventStoreCursorInit(EventStoreCursor* cursor, const EventStore* store, const char* symbol,
+                          time_t startTime, time_t endTime);
+
+/**
+ * @brief Advance a cursor to the next matching event
+ *
+ * @param cursor Cursor
+ * @return Index of the next matching event, or -1 when exhausted
+ */
+int eventStoreNext(EventStoreCursor* cursor);
+
+#endif /* EVENT_STORE_H */
@@ -0,0 +1,180 @@
+/**
+ * @file keyword_matcher.h
+ * @brief Compiled multi-keyword matcher (Aho-Corasick) for news scanning
+ */
+
+#ifndef KEYWORD_MATCHER_H
+#define KEYWORD_MATCHER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Maximum length of a single keyword or phrase */
+#define MAX_KEYWORD_LENGTH 64
+
+/**
+ * @struct KeywordMatch
+ * @brief A single word-bounded keyword occurrence reported by a scan
+ */
+typedef struct {
+    int keywordId;   /* Keyword index in insertion order */
+    int lexiconId;   /* Lexicon the keyword was added under */
+    int start;       /* Byte offset of the match in the scanned text */
+    int length;      /* Length of the match in bytes */
+    double weight;   /* Weight given to the keyword when it was added */
+} KeywordMatch;
+
+/**
+ * @struct KeywordMatcher
+ * @brief Aho-Corasick automaton compiled from one or more keyword lexicons
+ *
+ * Keywords are added with addKeyword()/addKeywordLexicon() and the automaton
+ * is built once by compileKeywordMatcher(). The compiled form is a dense
+ * DFA over a reduced alphabet, so a scan costs one table lookup per input
+ * byte regardless of how many keywords are loaded. Matching is ASCII
+ * case-insensitive and only matches that start and end on word boundaries
+ * are reported.
+ */
+typedef struct {
+    /* Keyword storage (filled before compilation) */
+    char* keywordText;         /* Folded keyword bytes, back to back */
+    int keywordTextSize;
+    int keywordTextCapacity;
+    int* keywordOffset;        /* Offset of each keyword in keywordText */
+    int* keywordLength;
+    int* keywordLexicon;
+    double* keywordWeight;
+    int keywordCount;
+    int keywordCapacity;
+
+    /* Compiled automaton */
+    unsigned char classMap[256]; /* Input byte -> alphabet class (0 = unused) */
+    int classCount;
+    int* transitions;          /* stateCount x classCount goto/fail table */
+    int* stateKeyword;         /* First keyword ending at a state, -1 if none */
+    int* keywordNext;          /* Next keyword ending at the same state */
+    int* outputLink;           /* Nearest suffix state with output, -1 if none */
+    int stateCount;
+    int compiled;
+} KeywordMatcher;
+
+/**
+ * @brief Callback invoked for every match found by scanKeywordsWithCallback()
+ */
+typedef void (*KeywordMatchCallback)(const KeywordMatch* match, void* context);
+
+/**
+ * @brief Initialize an empty keyword matcher
+ *
+ * @param matcher Matcher to initialize
+ */
+void initKeywordMatcher(KeywordMatcher* matcher);
+
+/**
+ * @brief Free all memory owned by a keyword matcher
+ *
+ * @param matcher Matcher to free
+ */
+void freeKeywordMatcher(KeywordMatcher* matcher);
+
+/**
+ * @brief Add a single keyword or phrase to the matcher
+ *
+ * Adding a keyword invalidates a previous compilation.
+ *
+ * @param matcher Matcher to add to
+ * @param keyword Keyword text (matched case-insensitively)
+ * @param lexiconId Caller-defined lexicon identifier reported with matches
+ * @param weight Caller-defined weight reported with matches
+ * @return Keyword id on success, negative error code on failure
+ */
+int addKeyword(KeywordMatcher* matcher, const char* keyword, int lexiconId, double weight);
+
+/**
+ * @brief Add a whole list of keywords under one lexicon id with weight 1.0
+ *
+ * @param matcher Matcher to add to
+ * @param keywords Array of keywords
+ * @param keywordCount Number of keywords
+ * @param lexiconId Lexicon identifier reported with matches
+ * @return Number of keywords added, negative error code on failure
+ */
+int addKeywordLexicon(KeywordMatcher* matcher, const char** keywords, int keywordCount, int lexiconId);
+
+/**
+ * @brief Build the automaton from all added keywords
+ *
+ * @param matcher Matcher to compile
+ * @return 0 on success, negative error code on failure
+ */
+int compileKeywordMatcher(KeywordMatcher* matcher);
+
+/**
+ * @brief Scan a NUL-terminated text in a single pass and collect matches
+ *
+ * @param matcher Compiled matcher
+ * @param text Text to scan
+ * @param matches Output array for matches (may be NULL to only count)
+ * @param maxMatches Capacity of the matches array
+ * @return Total number of word-bounded matches in the text
+ */
+int scanKeywords(const KeywordMatcher* matcher, const char* text,
+                 KeywordMatch* matches, int maxMatches);
+
+/**
+ * @brief Scan a NUL-terminated text and invoke a callback for every match
+ *
+ * @param matcher Compiled matcher
+ * @param text Text to scan
+ * @param callback Function called once per match
+ * @param context User pointer passed through to the callback
+ * @return Total number of word-bounded matches in the text
+ */
+int scanKeywordsWithCallback(const KeywordMatcher* matcher, const char* text,
+                             KeywordMatchCallback callback, void* context);
+
+/**
+ * @brief Scan a text and accumulate match weights per lexicon
+ *
+ * @param matcher Compiled matcher
+ * @param text Text to scan
+ * @param scale Multiplier applied to every weight (e.g. title vs. body)
+ * @param lexiconScores Per-lexicon accumulators, indexed by lexicon id
+ * @param lexiconCount Number of accumulators; matches for other ids are ignored
+ * @return Total number of word-bounded matches in the text
+ */
+int scoreKeywordLexicons(const KeywordMatcher* matcher, const char* text, double scale,
+                         double* lexiconScores, int lexiconCount);
+
+/**
+ * @brief Scan a text and accumulate the weight of each distinct keyword once
+ *
+ * Works like scoreKeywordLexicons(), but a keyword is only scored on its
+ * first match: its seen flag is set and later occurrences are skipped.
+ * Passing the same seen array for several texts counts a keyword once
+ * across all of them.
+ *
+ * @param matcher Compiled matcher
+ * @param text Text to scan
+ * @param scale Multiplier applied to every weight
+ * @param seen Per-keyword flags, keywordCount bytes, zeroed by the caller
+ * @param lexiconScores Per-lexicon accumulators, indexed by lexicon id
+ * @param lexiconCount Number of accumulators; matches for other ids are ignored
+ * @return Number of keywords scored for the first time in this text
+ */
+int scoreDistinctKeywordLexicons(const KeywordMatcher* matcher, const char* text, double scale,
+                                 unsigned char* seen, double* lexiconScores, int lexiconCount);
+
+/**
+ * @brief Get the folded text of a keyword
+ *
+ * @param matcher Matcher the keyword was added to
+ * @param keywordId Keyword id returned by addKeyword()
+ * @param buffer Output buffer
+ * @param bufferSize Size of the output buffer
+ * @return buffer, or NULL if the id is invalid
+ */
+char* getKeywordText(const KeywordMatcher* matcher, int keywordId, char* buffer, int bufferSize);
+
+#endif /* KEYWORD_MATCHER_H */
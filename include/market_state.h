@@ -0,0 +1,175 @@
+/**
+ * @file market_state.h
+ * @brief Per-symbol latest bar and indicator snapshots with lock-free reads
+ */
+
+#ifndef MARKET_STATE_H
+#define MARKET_STATE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "emers.h"
+#include "symbol_table.h"
+
+/* Default symbol capacity of the process-wide market state */
+#define DEFAULT_MARKET_STATE_CAPACITY 4096
+
+/**
+ * @struct MarketSnapshot
+ * @brief Latest bar of one symbol and indicators derived incrementally from it
+ */
+typedef struct {
+    StockData bar;                /* Most recent bar */
+    double previousClose;         /* Close of the bar before it (0 for the first bar) */
+    double changePercent;         /* Close-to-close change in percent */
+    double emaFast;               /* 12-bar EMA of the close */
+    double emaSlow;               /* 26-bar EMA of the close */
+    double volatility;            /* EWMA (lambda 0.94) standard deviation of returns */
+    double averageVolume;         /* 20-bar EMA of the volume */
+    double volumeRatio;           /* Bar volume / average volume before it */
+    int barCount;                 /* Bars applied to this symbol */
+    unsigned long version;        /* Increases with every update, 0 if never written */
+} MarketSnapshot;
+
+/**
+ * @struct MarketSlot
+ * @brief Seqlock-protected snapshot of one symbol
+ *
+ * The sequence is odd while a writer is publishing. Readers copy the
+ * snapshot and retry if the sequence was odd or changed under them, so
+ * they never block writers or each other.
+ */
+typedef struct {
+    unsigned long sequence;
+    MarketSnapshot snapshot;
+} MarketSlot;
+
+/**
+ * @struct MarketState
+ * @brief Fixed-capacity table of per-symbol market slots
+ *
+ * Slots are allocated up front so ids and slot addresses stay valid while
+ * other threads read. Only symbol registration takes the mutex; updates and
+ * reads by id are lock-free.
+ */
+typedef struct {
+    SymbolTable symbols;
+    MarketSlot* slots;
+    int capacity;
+    unsigned long version;        /* Incremented once per published update or batch */
+    pthread_mutex_t registryLock;
+} MarketState;
+
+/**
+ * @brief Initialize a market state
+ *
+ * @param state State to initialize
+ * @param capacity Maximum number of symbols
+ * @return 0 on success, negative on failure
+ */
+int initMarketState(MarketState* state, int capacity);
+
+/**
+ * @brief Free memory used by a market state
+ *
+ * No other thread may use the state during or after this call.
+ *
+ * @param state State to free
+ */
+void freeMarketState(MarketState* state);
+
+/**
+ * @brief Get or create the slot id of a symbol
+ *
+ * @param state Market state
+ * @param symbol Ticker symbol (case-insensitive)
+ * @return Slot id, negative on failure or when the state is full
+ */
+int registerMarketSymbol(MarketState* state, const char* symbol);
+
+/**
+ * @brief Look up the slot id of a symbol without creating it
+ *
+ * @param state Market state
+ * @param symbol Ticker symbol (case-insensitive)
+ * @return Slot id, or INVALID_SYMBOL_ID if the symbol is unknown
+ */
+int findMarketSymbol(MarketState* state, const char* symbol);
+
+/**
+ * @brief Apply a new bar to one symbol and publish the updated snapshot
+ *
+ * Writers of the same symbol serialize on the slot's sequence; writers of
+ * different symbols never contend.
+ *
+ * @param state Market state
+ * @param id Slot id from registerMarketSymbol
+ * @param bar New bar
+ * @return 0 on success, negative on failure
+ */
+int updateMarketSymbol(MarketState* state, int id, const StockData* bar);
+
+/**
+ * @brief Apply a batch of bars, then bump the state version once
+ *
+ * @param state Market state
+ * @param ids Slot id of each bar
+ * @param bars Bars to apply, in time order per symbol
+ * @param count Number of bars
+ * @return Number of bars applied, negative on failure
+ */
+int updateMarketBatch(MarketState* state, const int* ids, const StockData* bars, int count);
+
+/**
+ * @brief Copy a consistent snapshot of one symbol
+ *
+ * @param state Market state
+ * @param id Slot id
+ * @param snapshot Output snapshot
+ * @return 0 on success, negative on failure
+ */
+int readMarketSnapshot(const MarketState* state, int id, MarketSnapshot* snapshot);
+
+/**
+ * @brief Copy a snapshot only if it is newer than a version the caller holds
+ *
+ * @param state Market state
+ * @param id Slot id
+ * @param knownVersion Version of the caller's copy (0 for none)
+ * @param snapshot Output snapshot, written only when newer
+ * @return 1 if a newer snapshot was copied, 0 if unchanged, negative on failure
+ */
+int readMarketSnapshotIfNewer(const MarketState* state, int id, unsigned long knownVersion,
+                              MarketSnapshot* snapshot);
+
+/**
+ * @brief Version of the whole state, for cheap change polling
+ *
+ * @param state Market state
+ * @return Current version
+ */
+unsigned long marketStateVersion(const MarketState* state);
+
+/**
+ * @brief Process-wide market state used by updateMarketData
+ *
+ * Created on first use with DEFAULT_MARKET_STATE_CAPACITY symbols.
+ *
+ * @return Shared market state, or NULL if it could not be created
+ */
+MarketState* getMarketState(void);
+
+/**
+ * @brief Select the symbol that updateMarketData applies bars to
+ *
+ * StockData carries no symbol, so each feed thread selects its symbol
+ * first. The selection is per thread.
+ *
+ * @param symbol Ticker symbol
+ * @return 0 on success, negative on failure
+ */
+int setMarketDataSymbol(const char* symbol);
+
+#endif /* MARKET_STATE_H */
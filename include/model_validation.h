@@ -0,0 +1,170 @@
+/**
+ * @file model_validation.h
+ * @brief Walk-forward and purged k-fold validation over column series
+ */
+
+#ifndef MODEL_VALIDATION_H
+#define MODEL_VALIDATION_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "series_columns.h"
+
+/* Upper bound on metrics reported per fold */
+#define MAX_VALIDATION_METRICS 16
+
+/* Ways of cutting the date axis into folds */
+typedef enum {
+    VALIDATION_WALK_FORWARD = 0,  /* Expanding train window, consecutive test windows */
+    VALIDATION_ROLLING,           /* Fixed-length train window that moves with the test window */
+    VALIDATION_PURGED_KFOLD       /* K equal date blocks; train on the rest minus purge/embargo gaps */
+} ValidationScheme;
+
+/**
+ * @struct ValidationConfig
+ * @brief Fold layout, in calendar days
+ */
+typedef struct {
+    ValidationScheme scheme;
+    int foldCount;                /* K for k-fold; maximum folds for walk-forward (0 = all that fit) */
+    int trainDays;                /* Walk-forward: first train window; rolling: train length */
+    int testDays;                 /* Walk-forward and rolling test length */
+    int purgeDays;                /* Gap dropped from train before each test window */
+    int embargoDays;              /* K-fold: gap dropped from train after each test window */
+    int minTrainBars;             /* Folds with fewer train bars for a series are skipped */
+    int minTestBars;              /* Folds with fewer test bars for a series are skipped */
+} ValidationConfig;
+
+/**
+ * @struct SeriesView
+ * @brief Bars of one series selected by a fold, without copying them
+ *
+ * A view is up to two half-open index ranges [begin, end) into the series
+ * (purged k-fold trains on the data before and after the test block).
+ */
+typedef struct {
+    const SeriesColumns* series;
+    int seriesIndex;
+    int foldIndex;
+    int segmentCount;
+    int begin[2];
+    int end[2];
+    void* prepared;               /* Result of the prepare callback for this series */
+} SeriesView;
+
+/**
+ * @brief Build per-series data shared by all folds (indicators, features, ...)
+ *
+ * @param series Full series
+ * @param seriesIndex Index of the series
+ * @param context ValidationModel context
+ * @return Prepared data (may be NULL)
+ */
+typedef void* (*ValidationPrepareFn)(const SeriesColumns* series, int seriesIndex, void* context);
+
+/**
+ * @brief Release what the prepare callback returned
+ */
+typedef void (*ValidationReleaseFn)(void* prepared, void* context);
+
+/**
+ * @brief Fit a model on the train view
+ *
+ * @param train Train bars
+ * @param model Zeroed buffer of modelSize bytes owned by the calling worker
+ * @param context ValidationModel context
+ * @return 0 on success, negative to skip the fold
+ */
+typedef int (*ValidationFitFn)(const SeriesView* train, void* model, void* context);
+
+/**
+ * @brief Evaluate a fitted model on the test view
+ *
+ * @param test Test bars
+ * @param model Model written by the fit callback
+ * @param metrics Output, metricCount values
+ * @param context ValidationModel context
+ * @return 0 on success, negative to skip the fold
+ */
+typedef int (*ValidationEvaluateFn)(const SeriesView* test, const void* model, double* metrics, void* context);
+
+/**
+ * @struct ValidationModel
+ * @brief Callbacks and sizes of the model under validation
+ *
+ * Callbacks run concurrently on worker threads and must only share
+ * read-only state through context.
+ */
+typedef struct {
+    size_t modelSize;
+    int metricCount;
+    ValidationPrepareFn prepare;  /* Optional */
+    ValidationReleaseFn release;  /* Optional */
+    ValidationFitFn fit;
+    ValidationEvaluateFn evaluate;
+    void* context;
+} ValidationModel;
+
+/**
+ * @struct ValidationReport
+ * @brief Metrics of every (series, fold) task and their aggregate
+ */
+typedef struct {
+    int seriesCount;
+    int foldCount;
+    int metricCount;
+    int* testStartDay;            /* foldCount test window starts (days since 1970-01-01) */
+    int* testEndDay;              /* foldCount test window ends (exclusive) */
+    double* foldMetrics;          /* [series][fold][metric] */
+    unsigned char* valid;         /* [series][fold], 1 if fit and evaluate succeeded */
+    int validCount;
+    double mean[MAX_VALIDATION_METRICS];
+    double stdDev[MAX_VALIDATION_METRICS];
+} ValidationReport;
+
+/**
+ * @brief Fill a config with defaults
+ *
+ * Walk-forward, 3-year first train window, 1-year tests, 5-day purge,
+ * 5-day embargo, 5 folds for k-fold, at least 60 train and 20 test bars.
+ *
+ * @param config Config to initialize
+ */
+void initValidationConfig(ValidationConfig* config);
+
+/**
+ * @brief Validate a model over every fold of every series
+ *
+ * Fold boundaries are dates shared by all series; each series maps them to
+ * index ranges by binary search on its day column. Prepare runs once per
+ * series, then every (series, fold) task runs fit and evaluate on a worker
+ * thread. Aggregates are summed in (series, fold) order, so the report does
+ * not depend on thread scheduling.
+ *
+ * @param series Array of column series with day columns
+ * @param seriesCount Number of series
+ * @param config Fold layout (NULL for defaults)
+ * @param model Model callbacks
+ * @param report Output report (free with freeValidationReport)
+ * @return 0 on success, negative on failure
+ */
+int runValidation(const SeriesColumns* series, int seriesCount, const ValidationConfig* config,
+                  const ValidationModel* model, ValidationReport* report);
+
+/**
+ * @brief Free memory used by a validation report
+ *
+ * @param report Report to free
+ */
+void freeValidationReport(ValidationReport* report);
+
+/**
+ * @brief Number of bars in a view
+ *
+ * @param view View
+ * @return Bars across all segments
+ */
+int seriesViewLength(const SeriesView* view);
+
+#endif /* MODEL_VALIDATION_H */
@@ -0,0 +1,140 @@
+/**
+ * @file news_dedup.h
+ * @brief Near-duplicate news detection with SimHash signatures and banded LSH
+ */
+
+#ifndef NEWS_DEDUP_H
+#define NEWS_DEDUP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Default similarity above which two articles are treated as the same story */
+#define DEFAULT_DEDUP_THRESHOLD 0.90
+
+/* Most LSH bands used; bounds the Hamming distance that can be searched */
+#define MAX_DEDUP_BANDS 16
+
+/**
+ * @struct NewsDeduper
+ * @brief Set of article signatures searchable by Hamming distance
+ *
+ * Two 64-bit SimHash signatures within distance k agree exactly on at least
+ * one of k + 1 disjoint bit bands, so bucketing every signature under each of
+ * its band values finds all near-duplicates without comparing every pair.
+ *
+ * Each signature remembers when its story was last seen, so a long-lived
+ * deduplicator can forget stories that fall out of its time window.
+ */
+typedef struct NewsDeduper {
+    unsigned long long* signatures;
+    int* duplicateCounts;         /* Duplicates collapsed into each signature */
+    time_t* lastSeen;             /* Latest time each story was seen */
+    int count;
+    int capacity;
+    int maxArticles;              /* Oldest stories are evicted beyond this (0 for no limit) */
+
+    int maxDistance;              /* Largest Hamming distance treated as a duplicate */
+    int bandCount;
+    unsigned char bandShift[MAX_DEDUP_BANDS];
+    unsigned long long bandMask[MAX_DEDUP_BANDS];
+
+    int* bucketHeads;             /* Entry + 1 per bucket, 0 for empty */
+    int* entryNext;               /* Chain links, one entry per (signature, band) */
+    int bucketCount;              /* Always a power of two */
+} NewsDeduper;
+
+/**
+ * @brief Compute the SimHash signature of an article
+ *
+ * Features are the lowercase words and adjacent word pairs of the title and
+ * body, so reordered or lightly edited copies of a story get nearby signatures.
+ *
+ * @param title Article title (may be NULL)
+ * @param body Article body or description (may be NULL)
+ * @return 64-bit signature
+ */
+unsigned long long computeSimHash(const char* title, const char* body);
+
+/**
+ * @brief Number of differing bits between two signatures
+ *
+ * @param a First signature
+ * @param b Second signature
+ * @return Hamming distance (0-64)
+ */
+int simHashDistance(unsigned long long a, unsigned long long b);
+
+/**
+ * @brief Initialize a deduplicator
+ *
+ * @param dedup Deduplicator to initialize
+ * @param threshold Similarity (0.0-1.0) at or above which articles are duplicates
+ * @param expectedArticles Number of articles expected (0 for a default)
+ * @return 0 on success, negative on failure
+ */
+int initNewsDeduper(NewsDeduper* dedup, double threshold, int expectedArticles);
+
+/**
+ * @brief Free memory used by a deduplicator
+ *
+ * @param dedup Deduplicator to free
+ */
+void freeNewsDeduper(NewsDeduper* dedup);
+
+/**
+ * @brief Forget all signatures but keep the threshold and allocated memory
+ *
+ * @param dedup Deduplicator to reset
+ */
+void resetNewsDeduper(NewsDeduper* dedup);
+
+/**
+ * @brief Forget stories not seen since a cutoff time
+ *
+ * @param dedup Deduplicator
+ * @param cutoff Stories last seen before this time are removed
+ * @return Number of signatures removed
+ */
+int expireNewsSignatures(NewsDeduper* dedup, time_t cutoff);
+
+/**
+ * @brief Find a stored signature near the given one
+ *
+ * @param dedup Deduplicator
+ * @param signature Signature to look up
+ * @return Index of the closest stored near-duplicate, or -1 if none
+ */
+int findNearDuplicate(const NewsDeduper* dedup, unsigned long long signature);
+
+/**
+ * @brief Check a signature and remember it if it is new
+ *
+ * Duplicates are not stored; the matching signature's duplicate count is
+ * incremented and its story is marked as seen at `seenAt` instead. When the
+ * deduplicator is full, the least recently seen stories are evicted first.
+ *
+ * @param dedup Deduplicator
+ * @param signature Signature of the article
+ * @param seenAt Time the article was published or fetched
+ * @param duplicateOf Output index of the matching signature, or of the new one (may be NULL)
+ * @return 1 if the article is new, 0 if it is a near-duplicate, negative on failure
+ */
+int addNewsSignature(NewsDeduper* dedup, unsigned long long signature, time_t seenAt, int* duplicateOf);
+
+/**
+ * @brief Check an article and remember it if it is new
+ *
+ * @param dedup Deduplicator
+ * @param title Article title
+ * @param body Article body or description
+ * @param seenAt Time the article was published or fetched
+ * @param duplicateOf Output index of the matching signature (may be NULL)
+ * @return 1 if the article is new, 0 if it is a near-duplicate, negative on failure
+ */
+int addNewsArticle(NewsDeduper* dedup, const char* title, const char* body, time_t seenAt,
+                   int* duplicateOf);
+
+#endif /* NEWS_DEDUP_H */
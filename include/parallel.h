@@ -0,0 +1,52 @@
+/**
+ * @file parallel.h
+ * @brief Minimal fork-join helper for data-parallel loops
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief Body of a parallel loop, called for the index range [begin, end)
+ *
+ * @param begin First index of the range
+ * @param end One past the last index
+ * @param context Caller data shared by all ranges
+ */
+typedef void (*ParallelRangeFn)(int begin, int end, void* context);
+
+/**
+ * @brief Number of worker threads used by parallelFor
+ *
+ * Defaults to the number of online processors.
+ *
+ * @return Worker thread count (at least 1)
+ */
+int getParallelThreadCount(void);
+
+/**
+ * @brief Override the number of worker threads
+ *
+ * @param threads Thread count, or 0 to use the number of processors
+ */
+void setParallelThreadCount(int threads);
+
+/**
+ * @brief Run fn over [0, count) split into ranges of about grainSize indices
+ *
+ * Ranges are handed out dynamically, so uneven work balances across threads.
+ * Returns after every range has completed. Runs inline when one thread or
+ * one range suffices.
+ *
+ * @param count Number of indices
+ * @param grainSize Indices per range (0 to choose automatically)
+ * @param fn Loop body
+ * @param context Caller data passed to every call
+ * @return 0 on success, negative on failure
+ */
+int parallelFor(int count, int grainSize, ParallelRangeFn fn, void* context);
+
+#endif /* PARALLEL_H */
@@ -0,0 +1,96 @@
+/**
+ * @file param_optimizer.h
+ * @brief Grid search over SMA crossover periods
+ */
+
+#ifndef PARAM_OPTIMIZER_H
+#define PARAM_OPTIMIZER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "backtest.h"
+#include "series_columns.h"
+
+/* Metric a parameter search ranks by */
+typedef enum {
+    OPTIMIZE_SHARPE = 0,
+    OPTIMIZE_TOTAL_RETURN
+} OptimizeObjective;
+
+/**
+ * @struct OptimizerConfig
+ * @brief Parameter grid and ranking settings
+ */
+typedef struct {
+    int minShort;
+    int maxShort;
+    int shortStep;
+    int minLong;
+    int maxLong;
+    int longStep;
+    OptimizeObjective objective;
+    int minTrades;                /* Pairs with fewer completed trades are not ranked */
+    BacktestConfig backtest;      /* Exit and cost assumptions of every pair */
+} OptimizerConfig;
+
+/**
+ * @struct ParameterScore
+ * @brief One ranked (short, long) pair and its backtest
+ */
+typedef struct {
+    int shortPeriod;
+    int longPeriod;
+    double score;                 /* Value of the objective */
+    BacktestResult metrics;
+} ParameterScore;
+
+/**
+ * @brief Fill a config with defaults
+ *
+ * Short 2..50, long 10..200, step 1, ranked by Sharpe, at least 5 trades,
+ * default backtest assumptions.
+ *
+ * @param config Config to initialize
+ */
+void initOptimizerConfig(OptimizerConfig* config);
+
+/**
+ * @brief Rank the SMA (short, long) grid of one series
+ *
+ * One prefix-sum array makes every window mean O(1), so each pair costs
+ * one pass over the bars. Every trade opens on a crossover, so pairs with
+ * fewer crossovers than minTrades are skipped before simulation; pairs that
+ * complete fewer than minTrades trades are dropped after it.
+ *
+ * Pruning applies only to OPTIMIZE_TOTAL_RETURN: final equity has an upper
+ * bound that simulations are abandoned against once they cannot reach the
+ * current top list. The Sharpe ratio has no such bound from a partial
+ * equity curve, so with OPTIMIZE_SHARPE every remaining pair is simulated
+ * in full.
+ *
+ * @param series Price columns
+ * @param config Grid and ranking (NULL for defaults)
+ * @param ranked Output, best first
+ * @param maxRanked Number of pairs to keep
+ * @return Number of pairs stored, negative on failure
+ */
+int optimizeCrossoverParameters(const SeriesColumns* series, const OptimizerConfig* config,
+                                ParameterScore* ranked, int maxRanked);
+
+/**
+ * @brief Rank the grid of every series in parallel
+ *
+ * @param series Array of price columns
+ * @param seriesCount Number of series
+ * @param config Grid and ranking (NULL for defaults)
+ * @param ranked Output, seriesCount * maxRanked entries, row-major by series
+ * @param maxRanked Number of pairs kept per series
+ * @param rankedCounts Output number of pairs stored per series
+ * @return 0 on success, negative on failure
+ */
+int optimizeUniverseParameters(const SeriesColumns* series, int seriesCount,
+                               const OptimizerConfig* config, ParameterScore* ranked,
+                               int maxRanked, int* rankedCounts);
+
+#endif /* PARAM_OPTIMIZER_H */
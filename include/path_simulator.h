@@ -0,0 +1,144 @@
+/**
+ * @file path_simulator.h
+ * @brief Streaming Monte Carlo price paths for strategy stress tests
+ */
+
+#ifndef PATH_SIMULATOR_H
+#define PATH_SIMULATOR_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "emers.h"
+
+/* Paths generated together, per random stream and per callback */
+#define DEFAULT_PATH_CHUNK 1024
+
+/* Return processes the simulator can draw from */
+typedef enum {
+    PATH_GBM = 0,                 /* Normal daily log returns */
+    PATH_BOOTSTRAP,               /* Circular block bootstrap of historical log returns */
+    PATH_JUMP_DIFFUSION           /* GBM plus Poisson jumps with normal log sizes (Merton) */
+} PathModel;
+
+/**
+ * @struct PathSimConfig
+ * @brief Process parameters, all per bar and in log returns
+ */
+typedef struct {
+    PathModel model;
+    int pathCount;
+    int horizon;                  /* Bars per path */
+    double drift;                 /* Mean log return (diffusion part) */
+    double volatility;            /* Standard deviation of the diffusion part */
+    int blockLength;              /* Bootstrap block length in bars */
+    double jumpIntensity;         /* Expected jumps per bar */
+    double jumpMean;              /* Mean log jump size */
+    double jumpStdDev;            /* Standard deviation of the log jump size */
+    int chunkPaths;               /* Paths per chunk (0 for DEFAULT_PATH_CHUNK) */
+    unsigned long long seed;      /* Equal seeds give equal paths for any thread count */
+} PathSimConfig;
+
+/**
+ * @struct PathChunk
+ * @brief A block of simulated paths stored time-major
+ *
+ * growth[step * pathCount + p] is path p's price after step + 1 bars
+ * divided by the starting price, so every step is one contiguous array
+ * across paths.
+ */
+typedef struct {
+    int firstPath;                /* Global index of the chunk's first path */
+    int pathCount;
+    int horizon;
+    const double* growth;
+} PathChunk;
+
+/**
+ * @brief Strategy evaluated on each chunk as soon as it is generated
+ *
+ * Chunks are handed out on worker threads; the callback must only read
+ * shared state through context.
+ *
+ * @param chunk Paths of the chunk
+ * @param outcomes Output, one value per path (for example the strategy's return)
+ * @param context Caller data
+ * @return 0 on success, negative on failure
+ */
+typedef int (*PathStrategyFn)(const PathChunk* chunk, double* outcomes, void* context);
+
+/**
+ * @struct PathSimSummary
+ * @brief Distribution of the strategy outcomes over all paths
+ */
+typedef struct {
+    int pathCount;
+    double meanOutcome;
+    double stdDevOutcome;
+    double worstOutcome;
+    double bestOutcome;
+    double valueAtRisk;           /* Loss at the 5% outcome quantile (positive = loss) */
+    double conditionalVaR;        /* Mean loss of the worst 5% of paths */
+    double lossProbability;       /* Fraction of paths with a negative outcome */
+} PathSimSummary;
+
+/**
+ * @struct StopLossStrategy
+ * @brief Context of evaluateStopLossPaths
+ */
+typedef struct {
+    double exposure;              /* Fraction of the position kept (1.0 unhedged, 0.5 half hedged) */
+    double stopLoss;              /* Exit when the price falls this far below entry (0 = none) */
+    double trailingStop;          /* Exit when the price falls this far below its peak (0 = none) */
+} StopLossStrategy;
+
+/**
+ * @brief Fill a config with defaults (GBM, 10000 paths, 20 bars, 2% daily volatility)
+ *
+ * @param config Config to initialize
+ */
+void initPathSimConfig(PathSimConfig* config);
+
+/**
+ * @brief Estimate drift, volatility and jump parameters from a price history
+ *
+ * Returns beyond three standard deviations are treated as jumps; the rest
+ * set the diffusion parameters.
+ *
+ * @param config Config to update (model and sizes are left alone)
+ * @param logReturns Historical log returns
+ * @param count Number of returns
+ * @return 0 on success, negative on failure
+ */
+int calibratePathSimConfig(PathSimConfig* config, const double* logReturns, int count);
+
+/**
+ * @brief Simulate paths chunk by chunk and run a strategy on each chunk
+ *
+ * Chunk c draws from Philox stream c of the seed, so results depend only
+ * on the config. Only one chunk per worker exists at a time; the full path
+ * matrix is never stored.
+ *
+ * @param config Process and sizes
+ * @param history Historical log returns (required for PATH_BOOTSTRAP)
+ * @param historyCount Number of historical returns
+ * @param strategy Chunk callback
+ * @param context Callback context
+ * @param outcomes Output per path, pathCount values (NULL to only summarize)
+ * @param summary Output distribution summary (may be NULL)
+ * @return 0 on success, negative on failure
+ */
+int simulatePaths(const PathSimConfig* config, const double* history, int historyCount,
+                  PathStrategyFn strategy, void* context, double* outcomes, PathSimSummary* summary);
+
+/**
+ * @brief Strategy callback: return of a position with optional stops and hedge
+ *
+ * @param chunk Paths of the chunk
+ * @param outcomes Output return of each path
+ * @param context StopLossStrategy
+ * @return 0 on success
+ */
+int evaluateStopLossPaths(const PathChunk* chunk, double* outcomes, void* context);
+
+#endif /* PATH_SIMULATOR_H */
@@ -0,0 +1,101 @@
+/**
+ * @file pattern_detection.h
+ * @brief Zigzag pivot extraction and pivot-based chart pattern detection
+ */
+
+#ifndef PATTERN_DETECTION_H
+#define PATTERN_DETECTION_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "data_mining.h"
+#include "series_columns.h"
+
+/**
+ * @struct PatternConfig
+ * @brief Pivot and matching thresholds
+ */
+typedef struct {
+    double reversalPercent;       /* Move from an extreme that confirms a pivot (0.05 = 5%) */
+    double tolerancePercent;      /* Price distance at which two pivots count as equal */
+    int minTrendPivots;           /* Consecutive higher (lower) pivots that make a trend */
+} PatternConfig;
+
+/**
+ * @struct ZigZagPivot
+ * @brief A swing high or low
+ */
+typedef struct {
+    int index;
+    double price;                 /* High of a swing high, low of a swing low */
+    int isHigh;
+    int confirmed;                /* 0 for the last, still-moving extreme */
+} ZigZagPivot;
+
+/**
+ * @brief Fill a config with defaults (5% reversals, 1.5% tolerance, 4 trend pivots)
+ *
+ * @param config Config to initialize
+ */
+void initPatternConfig(PatternConfig* config);
+
+/**
+ * @brief Extract alternating swing highs and lows in one pass
+ *
+ * A swing high is confirmed once the low falls reversalPercent below it,
+ * a swing low once the high rises reversalPercent above it. The running
+ * extreme after the last confirmed pivot is appended unconfirmed.
+ *
+ * @param series Price columns (high, low)
+ * @param reversalPercent Reversal that confirms a pivot
+ * @param pivots Output pivots (series->count entries always suffice)
+ * @param maxPivots Capacity of the pivots array
+ * @return Number of pivots stored, negative on failure
+ */
+int extractZigZagPivots(const SeriesColumns* series, double reversalPercent, ZigZagPivot* pivots, int maxPivots);
+
+/**
+ * @brief Match patterns against a pivot sequence
+ *
+ * Each pattern looks at a fixed number of neighbouring pivots, so the
+ * whole pass is linear in the pivot count.
+ *
+ * @param series Price columns (close is used for confirmation)
+ * @param pivots Pivots from extractZigZagPivots
+ * @param pivotCount Number of pivots
+ * @param config Matching thresholds (NULL for defaults)
+ * @param patterns Output patterns ordered by start index
+ * @param maxPatterns Capacity; the most recent patterns are kept
+ * @return Number of patterns stored, negative on failure
+ */
+int detectPivotPatterns(const SeriesColumns* series, const ZigZagPivot* pivots, int pivotCount,
+                        const PatternConfig* config, MarketPattern* patterns, int maxPatterns);
+
+/**
+ * @brief Extract pivots and detect patterns of one series
+ *
+ * @param series Price columns
+ * @param config Thresholds (NULL for defaults)
+ * @param patterns Output patterns ordered by start index
+ * @param maxPatterns Capacity; the most recent patterns are kept
+ * @return Number of patterns stored, negative on failure
+ */
+int detectSeriesPatterns(const SeriesColumns* series, const PatternConfig* config,
+                         MarketPattern* patterns, int maxPatterns);
+
+/**
+ * @brief Detect patterns of many series in parallel
+ *
+ * @param series Array of price columns
+ * @param seriesCount Number of series
+ * @param config Thresholds (NULL for defaults)
+ * @param patterns Output, seriesCount * maxPatterns entries, row-major by series
+ * @param maxPatterns Capacity per series
+ * @param patternCounts Output number of patterns per series
+ * @return 0 on success, negative on failure
+ */
+int detectUniversePatterns(const SeriesColumns* series, int seriesCount, const PatternConfig* config,
+                           MarketPattern* patterns, int maxPatterns, int* patternCounts);
+
+#endif /* PATTERN_DETECTION_H */
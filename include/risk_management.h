@@ -0,0 +1,167 @@
+/**
+ * @file risk_management.h
+ * @brief Value-at-Risk, Conditional Value-at-Risk and drawdown analysis
+ */
+
+#ifndef RISK_MANAGEMENT_H
+#define RISK_MANAGEMENT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "emers.h"
+
+/* Fewest overlapping horizon returns used directly by historical VaR */
+#define MIN_VAR_OBSERVATIONS 30
+
+/* Monte Carlo paths generated per random stream (and per work item) */
+#define VAR_PATHS_PER_CHUNK 65536
+
+/* Methods of estimating the loss distribution */
+typedef enum {
+    VAR_HISTORICAL = 0,           /* Empirical quantile of past horizon returns */
+    VAR_PARAMETRIC,               /* Normal log returns fitted to history */
+    VAR_MONTE_CARLO               /* Simulated paths with normal or Student-t daily shocks */
+} VaRMethod;
+
+/**
+ * @struct VaRConfig
+ * @brief Parameters of a VaR estimate
+ */
+typedef struct {
+    VaRMethod method;
+    double confidenceLevel;       /* e.g. 0.99 */
+    int horizon;                  /* Holding period in bars */
+    int lookback;                 /* Most recent bars used, 0 for the full history */
+    int pathCount;                /* Monte Carlo paths */
+    int studentDegrees;           /* Monte Carlo shock tails: 0 normal, else Student-t degrees */
+    unsigned long long seed;      /* Monte Carlo seed; equal seeds give equal results */
+} VaRConfig;
+
+/**
+ * @struct VaRResult
+ * @brief Loss statistics as fractions of position value (0.05 = 5% loss)
+ */
+typedef struct {
+    double valueAtRisk;           /* Loss not exceeded with the configured confidence */
+    double conditionalVaR;        /* Mean loss beyond the VaR (expected shortfall) */
+    double meanReturn;            /* Mean daily log return of the history used */
+    double volatility;            /* Daily log return standard deviation */
+    int observations;             /* Returns or paths the estimate is based on */
+} VaRResult;
+
+/**
+ * @brief Fill a config with defaults (historical, 95%, 1 bar, 250-bar lookback)
+ *
+ * @param config Config to initialize
+ */
+void initVaRConfig(VaRConfig* config);
+
+/**
+ * @brief Estimate VaR and CVaR of one stock
+ *
+ * Quantiles come from quickselect rather than full sorts. Monte Carlo paths
+ * are generated in parallel, one Philox stream per chunk of paths, so the
+ * result depends only on the seed.
+ *
+ * @param stock Price history
+ * @param config Estimate parameters
+ * @param result Output statistics
+ * @return 0 on success, negative on failure
+ */
+int computeValueAtRisk(const Stock* stock, const VaRConfig* config, VaRResult* result);
+
+/**
+ * @brief Estimate VaR and CVaR for every stock at several horizons
+ *
+ * Work items are processed in parallel; Monte Carlo items run their paths
+ * serially inside each item.
+ *
+ * @param stocks Price histories
+ * @param stockCount Number of stocks
+ * @param horizons Holding periods in bars
+ * @param horizonCount Number of horizons
+ * @param config Parameters shared by all estimates (its horizon is ignored)
+ * @param results Output array of stockCount * horizonCount entries, stock-major
+ * @return Number of successful estimates, negative on failure
+ */
+int computeValueAtRiskBatch(const Stock* stocks, int stockCount, const int* horizons, int horizonCount,
+                            const VaRConfig* config, VaRResult* results);
+
+/**
+ * @struct DrawdownEpisode
+ * @brief One peak-to-recovery drawdown
+ */
+typedef struct {
+    int peakIndex;                /* Last bar at the running peak before the decline */
+    int troughIndex;              /* Lowest bar of the episode */
+    int recoveryIndex;            /* First bar back at or above the peak, -1 if not recovered */
+    double depth;                 /* (peak - trough) / peak */
+} DrawdownEpisode;
+
+/**
+ * @struct DrawdownSummary
+ * @brief Drawdown statistics of one price series
+ */
+typedef struct {
+    double maxDrawdown;           /* Deepest drawdown as a fraction (0.25 = 25%) */
+    int peakIndex;                /* Peak, trough and recovery of the deepest drawdown */
+    int troughIndex;
+    int recoveryIndex;
+    double currentDrawdown;       /* Drawdown at the last bar */
+    int longestDuration;          /* Most bars spent below a prior peak */
+    int episodeCount;             /* Number of distinct drawdown episodes */
+    double rollingMaxDrawdown;    /* Max drawdown of the trailing window (if requested) */
+} DrawdownSummary;
+
+/**
+ * @brief Analyze drawdowns of a price series in one O(n) pass
+ *
+ * @param prices Price series
+ * @param count Number of prices
+ * @param underwater Output p[i] / peak[i] - 1 for every bar (may be NULL)
+ * @param episodes Output deepest episodes, deepest first (may be NULL)
+ * @param maxEpisodes Capacity of the episodes array
+ * @param summary Output summary (may be NULL)
+ * @return Number of episodes stored, negative on failure
+ */
+int analyzeDrawdowns(const double* prices, int count, double* underwater,
+                     DrawdownEpisode* episodes, int maxEpisodes, DrawdownSummary* summary);
+
+/**
+ * @brief Drawdown from the highest price of a trailing window (monotonic deque, O(n))
+ *
+ * @param prices Price series
+ * @param count Number of prices
+ * @param window Window length in bars (shorter at the start of the series)
+ * @param output Output drawdown fraction per bar
+ * @return 0 on success, negative on failure
+ */
+int rollingDrawdown(const double* prices, int count, int window, double* output);
+
+/**
+ * @brief Maximum drawdown inside each trailing window (amortized O(1) per bar)
+ *
+ * Uses a two-stack sliding queue whose elements carry (max, min, max drawdown)
+ * aggregates, combined in time order.
+ *
+ * @param prices Price series
+ * @param count Number of prices
+ * @param window Window length in bars (shorter at the start of the series)
+ * @param output Output max drawdown fraction per bar
+ * @return 0 on success, negative on failure
+ */
+int rollingMaxDrawdown(const double* prices, int count, int window, double* output);
+
+/**
+ * @brief Drawdown summaries of many stocks in parallel
+ *
+ * @param stocks Price histories (adjusted close when available)
+ * @param stockCount Number of stocks
+ * @param window Trailing window for rollingMaxDrawdown, 0 to skip it
+ * @param summaries Output array of stockCount summaries
+ * @return Number of stocks analyzed, negative on failure
+ */
+int computePortfolioDrawdowns(const Stock* stocks, int stockCount, int window, DrawdownSummary* summaries);
+
+#endif /* RISK_MANAGEMENT_H */
@@ -0,0 +1,83 @@
+/**
+ * @file rng.h
+ * @brief Counter-based Philox4x32-10 random number streams
+ */
+
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @struct PhiloxStream
+ * @brief One independent random stream
+ *
+ * Output block n of stream s under seed k is Philox(counter = (n, s), key = k),
+ * so streams never overlap and any block can be computed directly. Giving each
+ * thread or work chunk its own stream id makes results independent of
+ * scheduling.
+ */
+typedef struct {
+    unsigned int key[2];
+    unsigned int counter[4];
+    unsigned int block[4];        /* Current output block */
+    int used;                     /* Words of the block already consumed */
+    double spareNormal;           /* Second Box-Muller output */
+    int hasSpare;
+} PhiloxStream;
+
+/**
+ * @brief Compute one Philox4x32-10 block
+ *
+ * @param counter 128-bit counter
+ * @param key 64-bit key
+ * @param out Output 128-bit block
+ */
+void philox4x32(const unsigned int counter[4], const unsigned int key[2], unsigned int out[4]);
+
+/**
+ * @brief Start a stream
+ *
+ * @param stream Stream to initialize
+ * @param seed Seed shared by related streams
+ * @param streamId Identifier of this stream
+ */
+void initPhiloxStream(PhiloxStream* stream, unsigned long long seed, unsigned long long streamId);
+
+/**
+ * @brief Next 32 random bits
+ *
+ * @param stream Stream
+ * @return Uniform 32-bit value
+ */
+unsigned int philoxNextUint32(PhiloxStream* stream);
+
+/**
+ * @brief Next uniform double in (0, 1)
+ *
+ * @param stream Stream
+ * @return Uniform value, never exactly 0 or 1
+ */
+double philoxUniform(PhiloxStream* stream);
+
+/**
+ * @brief Next standard normal value (Box-Muller)
+ *
+ * @param stream Stream
+ * @return Normal value with mean 0 and variance 1
+ */
+double philoxNormal(PhiloxStream* stream);
+
+/**
+ * @brief Fill an array with standard normal values
+ *
+ * Works a whole Philox block (two normal pairs) at a time.
+ *
+ * @param stream Stream
+ * @param out Output array
+ * @param count Number of values
+ */
+void philoxFillNormal(PhiloxStream* stream, double* out, int count);
+
+#endif /* RNG_H */
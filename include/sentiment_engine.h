@@ -0,0 +1,183 @@
+/**
+ * @file sentiment_engine.h
+ * @brief Single-pass tokenizer and hashed-lexicon sentiment scorer
+ */
+
+#ifndef SENTIMENT_ENGINE_H
+#define SENTIMENT_ENGINE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Longest token the tokenizer keeps; longer tokens are never looked up */
+#define MAX_TOKEN_LENGTH 32
+
+/* Default number of tokens a negation word affects ("not very strong") */
+#define DEFAULT_NEGATION_WINDOW 3
+
+/* Lexicon entry flags */
+#define SENTIMENT_TERM_NEGATION 0x01
+
+/**
+ * @struct SentimentTerm
+ * @brief One open-addressing slot of a sentiment lexicon
+ */
+typedef struct {
+    unsigned int hash;           /* FNV-1a hash of the term, 0 for an empty slot */
+    unsigned char length;        /* Term length in bytes */
+    unsigned char flags;         /* SENTIMENT_TERM_* flags */
+    float weight;                /* > 0 positive, < 0 negative */
+    char term[MAX_TOKEN_LENGTH]; /* Folded term text */
+} SentimentTerm;
+
+/**
+ * @struct SentimentLexicon
+ * @brief Weighted term lexicon with open-addressing lookup
+ *
+ * The lexicon is built once and then shared read-only by any number of
+ * scoring calls. Scoring tokenizes a document in one pass, hashing each
+ * token while it is read, and does not allocate.
+ */
+typedef struct {
+    SentimentTerm* slots;
+    int capacity;                /* Always a power of two */
+    int count;
+    int negationWindow;          /* Tokens flipped after a negation word */
+    double titleWeight;          /* Multiplier for matches in titles */
+    double bodyWeight;           /* Multiplier for matches in bodies */
+    int useStemming;             /* Stem terms and tokens before lookup */
+} SentimentLexicon;
+
+/**
+ * @struct SentimentAccumulator
+ * @brief Running positive/negative totals across one or more texts
+ */
+typedef struct {
+    double positive;
+    double negative;
+    int tokenCount;
+    int matchCount;
+} SentimentAccumulator;
+
+/**
+ * @brief Initialize a sentiment lexicon
+ *
+ * @param lexicon Lexicon to initialize
+ * @param expectedTerms Number of terms expected, used to size the table
+ * @return 0 on success, negative on failure
+ */
+int initSentimentLexicon(SentimentLexicon* lexicon, int expectedTerms);
+
+/**
+ * @brief Free memory used by a sentiment lexicon
+ *
+ * @param lexicon Lexicon to free
+ */
+void freeSentimentLexicon(SentimentLexicon* lexicon);
+
+/**
+ * @brief Enable or disable Porter stemming of terms and tokens
+ *
+ * Must be set before any terms are added, since stored terms are stemmed
+ * on insert.
+ *
+ * @param lexicon Lexicon to configure
+ * @param enabled Non-zero to stem
+ */
+void setSentimentStemming(SentimentLexicon* lexicon, int enabled);
+
+/**
+ * @brief Add or update a weighted sentiment term
+ *
+ * @param lexicon Lexicon to add to
+ * @param term Single-word term (matched case-insensitively)
+ * @param weight Positive for bullish words, negative for bearish words
+ * @return 0 on success, negative on failure
+ */
+int addSentimentTerm(SentimentLexicon* lexicon, const char* term, double weight);
+
+/**
+ * @brief Add a negation word such as "not" or "never"
+ *
+ * @param lexicon Lexicon to add to
+ * @param term Negation word
+ * @return 0 on success, negative on failure
+ */
+int addNegationTerm(SentimentLexicon* lexicon, const char* term);
+
+/**
+ * @brief Add positive and negative word lists with unit weights
+ *
+ * @param lexicon Lexicon to add to
+ * @param positiveWords Array of positive sentiment words
+ * @param positiveCount Number of positive words
+ * @param negativeWords Array of negative sentiment words
+ * @param negativeCount Number of negative words
+ * @return 0 on success, negative on failure
+ */
+int addSentimentWordLists(SentimentLexicon* lexicon,
+                          const char** positiveWords, int positiveCount,
+                          const char** negativeWords, int negativeCount);
+
+/**
+ * @brief Add the default English negation words
+ *
+ * @param lexicon Lexicon to add to
+ * @return 0 on success, negative on failure
+ */
+int addDefaultNegations(SentimentLexicon* lexicon);
+
+/**
+ * @brief Look up the weight of a single term
+ *
+ * @param lexicon Lexicon to search
+ * @param term Term to look up
+ * @return Term weight, or 0.0 if the term is not a sentiment term
+ */
+double lookupSentimentTerm(const SentimentLexicon* lexicon, const char* term);
+
+/**
+ * @brief Tokenize a text once and add its sentiment to an accumulator
+ *
+ * @param lexicon Lexicon to score against
+ * @param text NUL-terminated text
+ * @param weight Multiplier applied to every match in this text
+ * @param acc Accumulator to add to (must be zeroed before the first call)
+ */
+void accumulateSentiment(const SentimentLexicon* lexicon, const char* text,
+                         double weight, SentimentAccumulator* acc);
+
+/**
+ * @brief Convert an accumulator to the (score, confidence) pair
+ *
+ * @param acc Accumulator
+ * @param score Output sentiment score (-1.0 to 1.0)
+ * @param confidence Output confidence (0.0 to 1.0)
+ */
+void finishSentiment(const SentimentAccumulator* acc, double* score, double* confidence);
+
+/**
+ * @brief Score a single text
+ *
+ * @param lexicon Lexicon to score against
+ * @param text NUL-terminated text
+ * @param score Output sentiment score (-1.0 to 1.0)
+ * @param confidence Output confidence (0.0 to 1.0)
+ */
+void scoreSentimentText(const SentimentLexicon* lexicon, const char* text,
+                        double* score, double* confidence);
+
+/**
+ * @brief Score a news document using the lexicon's title and body weights
+ *
+ * @param lexicon Lexicon to score against
+ * @param title Document title (may be NULL)
+ * @param body Document body or description (may be NULL)
+ * @param score Output sentiment score (-1.0 to 1.0)
+ * @param confidence Output confidence (0.0 to 1.0)
+ */
+void scoreSentimentDocument(const SentimentLexicon* lexicon, const char* title, const char* body,
+                            double* score, double* confidence);
+
+#endif /* SENTIMENT_ENGINE_H */
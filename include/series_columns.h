@@ -0,0 +1,102 @@
+/**
+ * @file series_columns.h
+ * @brief Column-oriented (structure of arrays) price series
+ */
+
+#ifndef SERIES_COLUMNS_H
+#define SERIES_COLUMNS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "emers.h"
+
+/**
+ * @struct SeriesColumns
+ * @brief OHLCV bars stored as one contiguous array per field
+ *
+ * Loops that only touch closes (and volumes) stream through 8-byte strides
+ * instead of dragging the 72-byte StockData records through the cache.
+ */
+typedef struct {
+    double* open;
+    double* high;
+    double* low;
+    double* close;
+    double* volume;
+    int* day;                     /* Days since 1970-01-01 of each bar's date */
+    int count;
+    int capacity;
+    int borrowed;                 /* Columns point into memory the caller owns */
+} SeriesColumns;
+
+/* Bytes of one bar in the bound layout: five double columns and the day column */
+#define SERIES_COLUMNS_BAR_BYTES (5 * sizeof(double) + sizeof(int))
+
+/**
+ * @brief Initialize empty columns
+ *
+ * @param columns Columns to initialize
+ * @param capacity Initial capacity in bars (may be 0)
+ * @return 0 on success, negative on failure
+ */
+int initSeriesColumns(SeriesColumns* columns, int capacity);
+
+/**
+ * @brief Point columns at caller-owned memory without copying
+ *
+ * The memory holds capacity opens, highs, lows, closes and volumes back
+ * to back, followed by capacity int days, SERIES_COLUMNS_BAR_BYTES *
+ * capacity bytes in all. Owned columns keep the five price columns in one
+ * block but allocate days separately, so only bound columns have days in
+ * the same block. Bound columns cannot grow; freeing them only detaches
+ * them.
+ *
+ * @param columns Columns to bind
+ * @param memory Start of the layout, aligned for double
+ * @param capacity Bars the memory has room for
+ * @param count Bars currently filled in
+ * @return 0 on success, negative on failure
+ */
+int bindSeriesColumns(SeriesColumns* columns, void* memory, int capacity, int count);
+
+/**
+ * @brief Free memory used by columns
+ *
+ * @param columns Columns to free
+ */
+void freeSeriesColumns(SeriesColumns* columns);
+
+/**
+ * @brief Make room for at least capacity bars, keeping existing bars
+ *
+ * @param columns Columns to grow
+ * @param capacity Required capacity
+ * @return 0 on success, negative on failure
+ */
+int reserveSeriesColumns(SeriesColumns* columns, int capacity);
+
+/**
+ * @brief Replace the columns' contents with bars
+ *
+ * Dates are parsed into the day column; a date that does not parse
+ * repeats the previous bar's day so the column stays sorted.
+ *
+ * @param columns Initialized columns
+ * @param data Bars to transpose
+ * @param count Number of bars
+ * @return 0 on success, negative on failure
+ */
+int loadSeriesColumns(SeriesColumns* columns, const StockData* data, int count);
+
+/**
+ * @brief Append bars to the columns
+ *
+ * @param columns Initialized columns
+ * @param data Bars to append
+ * @param count Number of bars
+ * @return 0 on success, negative on failure
+ */
+int appendSeriesColumns(SeriesColumns* columns, const StockData* data, int count);
+
+#endif /* SERIES_COLUMNS_H */
@@ -0,0 +1,248 @@
+/**
+ * @file series_session.h
+ * @brief Handle-based native price series with cached derived indicators
+ */
+
+#ifndef SERIES_SESSION_H
+#define SERIES_SESSION_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "data_mining.h"
+#include "series_columns.h"
+#include "backtest.h"
+
+/* Opaque session identifier; 0 is never a valid handle */
+typedef int64_t SeriesHandle;
+
+#define INVALID_SERIES_HANDLE 0
+
+/* Most sessions open at once */
+#define MAX_SERIES_SESSIONS 1024
+
+/**
+ * @brief Indicator columns a session can cache (codes match the JNI calculateIndicators call)
+ */
+typedef enum {
+    SESSION_INDICATOR_SMA = 0,
+    SESSION_INDICATOR_EMA,
+    SESSION_INDICATOR_RSI,
+    SESSION_INDICATOR_MACD,               /* 12/26 EMA difference; period is ignored */
+    SESSION_INDICATOR_MACD_SIGNAL,        /* 9-bar EMA of MACD; period is ignored */
+    SESSION_INDICATOR_MACD_HISTOGRAM,     /* MACD minus signal; period is ignored */
+    SESSION_INDICATOR_COUNT
+} SessionIndicator;
+
+/**
+ * @struct CachedIndicator
+ * @brief One indicator column, extended in place as bars are appended
+ */
+typedef struct {
+    int kind;                     /* SessionIndicator */
+    int period;
+    int count;                    /* Bars computed so far */
+    int capacity;
+    double* values;
+    double state[3];              /* Running sums or averages carried between extensions */
+} CachedIndicator;
+
+/**
+ * @struct SeriesSession
+ * @brief Owned price columns plus everything derived from them
+ *
+ * Sessions are reached through acquireSeriesSession, which returns them
+ * locked; results stay cached until the next append.
+ */
+typedef struct {
+    SeriesColumns columns;
+    CachedIndicator* indicators;
+    int indicatorCount;
+    int indicatorCapacity;
+
+    MarketPattern* patterns;      /* Cached detectSeriesPatterns output */
+    int patternCount;
+    int patternLimit;             /* maxPatterns of the cached call, 0 when stale */
+    AnomalyResult* anomalies;     /* Cached detectSeriesAnomalies output */
+    int anomalyCount;
+    int anomalyLimit;
+
+    pthread_mutex_t lock;
+    int references;               /* Acquisitions not yet released (registry lock) */
+    int closed;                   /* Handle closed; freed at the last release */
+} SeriesSession;
+
+/**
+ * @brief Create a session holding a copy of bars
+ *
+ * @param data Bars to load
+ * @param count Number of bars
+ * @return Session handle, INVALID_SERIES_HANDLE on failure
+ */
+SeriesHandle openSeriesSession(const StockData* data, int count);
+
+/**
+ * @brief Create a session holding a copy of columns (owned or bound)
+ *
+ * @param columns Columns to copy
+ * @return Session handle, INVALID_SERIES_HANDLE on failure
+ */
+SeriesHandle openSeriesSessionColumns(const SeriesColumns* columns);
+
+/**
+ * @brief Close a session handle
+ *
+ * The handle stops resolving immediately; the memory is released once
+ * no caller holds the session.
+ *
+ * @param handle Handle to close
+ * @return 0 on success, negative if the handle is not open
+ */
+int closeSeriesSession(SeriesHandle handle);
+
+/**
+ * @brief Close every open session
+ */
+void closeAllSeriesSessions(void);
+
+/**
+ * @brief Resolve and lock a session
+ *
+ * @param handle Session handle
+ * @return Locked session, NULL if the handle is not open
+ */
+SeriesSession* acquireSeriesSession(SeriesHandle handle);
+
+/**
+ * @brief Unlock a session returned by acquireSeriesSession
+ *
+ * @param session Session to release
+ */
+void releaseSeriesSession(SeriesSession* session);
+
+/**
+ * @brief Append bars to an acquired session
+ *
+ * Cached indicator columns are extended lazily from their running state;
+ * cached pattern and anomaly results are invalidated.
+ *
+ * @param session Acquired session
+ * @param data Bars to append
+ * @param count Number of bars
+ * @return 0 on success, negative on failure
+ */
+int appendSessionBars(SeriesSession* session, const StockData* data, int count);
+
+/**
+ * @brief Get an indicator column of an acquired session, computing only bars not yet cached
+ *
+ * @param session Acquired session
+ * @param kind SessionIndicator
+ * @param period Indicator period (ignored by the MACD family)
+ * @return Column of session->columns.count values valid until the session is released, NULL on failure
+ */
+const double* getSessionIndicator(SeriesSession* session, int kind, int period);
+
+/**
+ * @brief Detect price patterns of an acquired session, reusing the cached result
+ *
+ * @param session Acquired session
+ * @param patterns Output patterns ordered by start index
+ * @param maxPatterns Capacity; the most recent patterns are kept
+ * @return Number of patterns stored, negative on failure
+ */
+int getSessionPatterns(SeriesSession* session, MarketPattern* patterns, int maxPatterns);
+
+/**
+ * @brief Detect anomalies of an acquired session, reusing the cached result
+ *
+ * @param session Acquired session
+ * @param anomalies Output anomalies in bar order
+ * @param maxAnomalies Capacity; the most recent anomalies are kept
+ * @return Number of anomalies stored, negative on failure
+ */
+int getSessionAnomalies(SeriesSession* session, AnomalyResult* anomalies, int maxAnomalies);
+
+/**
+ * @brief Generate crossover signals of an acquired session
+ *
+ * @param session Acquired session
+ * @param rule Moving average pair
+ * @param signals Output signals in bar order
+ * @param maxSignals Capacity; the most recent signals are kept
+ * @return Number of signals stored, negative on failure
+ */
+int getSessionCrossoverSignals(SeriesSession* session, const CrossoverRule* rule,
+                               DMTradingSignal* signals, int maxSignals);
+
+/* Most indicators one fused analysis reports */
+#define MAX_ANALYSIS_INDICATORS 16
+
+/* Leading ints of an analysis buffer: pattern, signal and anomaly counts and the bar count */
+#define ANALYSIS_HEADER_INTS 4
+
+/**
+ * @struct AnalysisRequest
+ * @brief Everything analyzeSeriesSession computes in one call
+ */
+typedef struct {
+    int maxResults;               /* Patterns and anomalies kept; signals keep this many per rule */
+    CrossoverRule smaRule;
+    CrossoverRule emaRule;
+    int indicatorCount;
+    int indicators[MAX_ANALYSIS_INDICATORS];  /* SessionIndicator codes */
+    int periods[MAX_ANALYSIS_INDICATORS];
+} AnalysisRequest;
+
+/**
+ * @struct AnalysisLayout
+ * @brief Offsets of each structure-of-arrays column in the flat result buffers
+ *
+ * With M = maxResults and K = indicatorCount, the int buffer holds the
+ * header followed by pattern type/start/end (M each), signal
+ * type/index/rule (2M each, rule 0 for SMA and 1 for EMA) and anomaly
+ * index (M). The double buffer holds pattern confidence/expected
+ * move/level (M each), signal confidence/entry/target/stop/risk-reward
+ * (2M each), anomaly score/price deviation/volume deviation/price change
+ * (M each) and the last value of each indicator (K).
+ */
+typedef struct {
+    int intCount;
+    int doubleCount;
+
+    int patternType, patternStart, patternEnd;
+    int signalType, signalIndex, signalRule;
+    int anomalyIndex;
+
+    int patternConfidence, patternExpectedMove, patternLevel;
+    int signalConfidence, signalEntry, signalTarget, signalStop, signalRiskReward;
+    int anomalyScore, anomalyPriceDeviation, anomalyVolumeDeviation, anomalyPriceChange;
+    int indicatorValues;
+} AnalysisLayout;
+
+/**
+ * @brief Compute the flat buffer layout of a request
+ *
+ * @param layout Output layout
+ * @param maxResults Result capacity M
+ * @param indicatorCount Indicator count K
+ */
+void initAnalysisLayout(AnalysisLayout* layout, int maxResults, int indicatorCount);
+
+/**
+ * @brief Run patterns, SMA and EMA signals, anomalies and indicators of an acquired session
+ *
+ * Signals of both rules are merged in bar order. Unused slots are left
+ * untouched; an invalid indicator reports NaN.
+ *
+ * @param session Acquired session
+ * @param request What to compute
+ * @param ints Output of at least layout.intCount ints
+ * @param doubles Output of at least layout.doubleCount doubles
+ * @return 0 on success, negative on failure
+ */
+int analyzeSeriesSession(SeriesSession* session, const AnalysisRequest* request, int* ints, double* doubles);
+
+#endif /* SERIES_SESSION_H */
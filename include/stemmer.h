@@ -0,0 +1,114 @@
+/**
+ * @file stemmer.h
+ * @brief Table-driven Porter stemmer with batch and memoized entry points
+ */
+
+#ifndef STEMMER_H
+#define STEMMER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "string_arena.h"
+
+/* Words longer than this are returned unchanged */
+#define MAX_STEM_WORD_LENGTH 48
+
+/* Number of entries in a stem memo cache (power of two) */
+#define STEM_CACHE_SIZE 1024
+
+/**
+ * @struct StemCacheEntry
+ * @brief One direct-mapped memo slot: a word and its stem
+ */
+typedef struct {
+    unsigned int hash;                 /* Hash of the word, 0 for an empty slot */
+    unsigned char wordLength;
+    unsigned char stemLength;
+    char word[MAX_STEM_WORD_LENGTH];
+    char stem[MAX_STEM_WORD_LENGTH];
+} StemCacheEntry;
+
+/**
+ * @struct StemCache
+ * @brief Small direct-mapped cache of recently stemmed words
+ *
+ * News text repeats the same words heavily, so most lookups hit. A cache is
+ * not thread-safe; give each thread its own.
+ */
+typedef struct {
+    StemCacheEntry entries[STEM_CACHE_SIZE];
+    unsigned long hits;
+    unsigned long misses;
+} StemCache;
+
+/**
+ * @struct StemmedToken
+ * @brief Location of one stemmed token in an arena and in the source text
+ */
+typedef struct {
+    unsigned int offset;   /* Offset of the stem in the arena */
+    int length;            /* Length of the stem */
+    int sourceStart;       /* Byte offset of the token in the source text */
+} StemmedToken;
+
+/**
+ * @brief Stem a lowercase ASCII word in place using the full Porter algorithm
+ *
+ * Words containing anything other than 'a'-'z', and words shorter than three
+ * letters, are left unchanged.
+ *
+ * @param word Word to stem (modified in place, stays NUL-terminated)
+ * @param length Length of the word
+ * @return Length of the stem
+ */
+int porterStem(char* word, int length);
+
+/**
+ * @brief Reset a memo cache to empty
+ *
+ * @param cache Cache to clear
+ */
+void initStemCache(StemCache* cache);
+
+/**
+ * @brief Stem a word through a memo cache
+ *
+ * @param cache Memo cache (may be NULL to stem directly)
+ * @param word Lowercase word
+ * @param length Length of the word
+ * @param stem Output buffer of at least MAX_STEM_WORD_LENGTH bytes
+ * @return Length of the stem
+ */
+int stemWordCached(StemCache* cache, const char* word, int length, char* stem);
+
+/**
+ * @brief Tokenize a text, stem every token and store the stems in an arena
+ *
+ * Tokens are runs of ASCII letters, folded to lowercase before stemming.
+ *
+ * @param text NUL-terminated text
+ * @param arena Arena receiving the stems
+ * @param tokens Output token array
+ * @param maxTokens Capacity of the token array
+ * @param cache Memo cache (may be NULL)
+ * @return Number of tokens stored, negative on failure
+ */
+int stemTokenStream(const char* text, StringArena* arena, StemmedToken* tokens,
+                    int maxTokens, StemCache* cache);
+
+/**
+ * @brief Stem an array of words into an arena
+ *
+ * @param words Array of words
+ * @param wordCount Number of words
+ * @param arena Arena receiving the stems
+ * @param offsets Output arena offset of each stem
+ * @param cache Memo cache (may be NULL)
+ * @return Number of words stemmed, negative on failure
+ */
+int stemWordBatch(const char** words, int wordCount, StringArena* arena,
+                  unsigned int* offsets, StemCache* cache);
+
+#endif /* STEMMER_H */
@@ -0,0 +1,73 @@
+/**
+ * @file string_arena.h
+ * @brief Append-only string arena addressed by 32-bit offsets
+ */
+
+#ifndef STRING_ARENA_H
+#define STRING_ARENA_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Offset returned for strings that could not be stored */
+#define ARENA_INVALID_OFFSET 0xFFFFFFFFu
+
+/**
+ * @struct StringArena
+ * @brief Growable byte buffer holding NUL-terminated strings back to back
+ *
+ * Strings are referenced by offset rather than pointer, so references stay
+ * valid when the buffer is reallocated and take 4 bytes instead of 8.
+ */
+typedef struct {
+    char* data;
+    unsigned int size;
+    unsigned int capacity;
+} StringArena;
+
+/**
+ * @brief Initialize an empty arena
+ *
+ * @param arena Arena to initialize
+ * @param initialCapacity Initial buffer size in bytes (0 for a default)
+ * @return 0 on success, negative on failure
+ */
+int initStringArena(StringArena* arena, unsigned int initialCapacity);
+
+/**
+ * @brief Free memory used by an arena
+ *
+ * @param arena Arena to free
+ */
+void freeStringArena(StringArena* arena);
+
+/**
+ * @brief Drop all strings but keep the buffer for reuse
+ *
+ * @param arena Arena to reset
+ */
+void resetStringArena(StringArena* arena);
+
+/**
+ * @brief Append a string to the arena
+ *
+ * @param arena Arena to append to
+ * @param text String bytes (need not be NUL-terminated)
+ * @param length Number of bytes to copy, or -1 to use strlen(text)
+ * @return Offset of the stored NUL-terminated copy, ARENA_INVALID_OFFSET on failure
+ */
+unsigned int arenaAppend(StringArena* arena, const char* text, int length);
+
+/**
+ * @brief Get a pointer to a stored string
+ *
+ * The pointer is invalidated by the next append.
+ *
+ * @param arena Arena holding the string
+ * @param offset Offset returned by arenaAppend()
+ * @return Pointer to the string, or "" for an invalid offset
+ */
+const char* arenaString(const StringArena* arena, unsigned int offset);
+
+#endif /* STRING_ARENA_H */
@@ -0,0 +1,76 @@
+/**
+ * @file symbol_table.h
+ * @brief Interning table mapping stock symbols to dense integer ids
+ */
+
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "emers.h"
+
+/* Id returned for symbols that are not in the table */
+#define INVALID_SYMBOL_ID -1
+
+/**
+ * @struct SymbolTable
+ * @brief Open-addressing table assigning ids 0, 1, 2, ... in insertion order
+ *
+ * Symbols are folded to uppercase, so "aapl" and "AAPL" share an id. Ids are
+ * stable for the life of the table and can be used to index per-symbol arrays.
+ */
+typedef struct {
+    char (*names)[MAX_SYMBOL_LENGTH]; /* Symbol text indexed by id */
+    int* slots;                       /* id + 1 per slot, 0 for empty */
+    int slotCapacity;                 /* Always a power of two */
+    int count;
+    int capacity;                     /* Capacity of the names array */
+} SymbolTable;
+
+/**
+ * @brief Initialize an empty symbol table
+ *
+ * @param table Table to initialize
+ * @param expectedSymbols Number of symbols expected, used to size the table
+ * @return 0 on success, negative on failure
+ */
+int initSymbolTable(SymbolTable* table, int expectedSymbols);
+
+/**
+ * @brief Free memory used by a symbol table
+ *
+ * @param table Table to free
+ */
+void freeSymbolTable(SymbolTable* table);
+
+/**
+ * @brief Get the id of a symbol, adding it if necessary
+ *
+ * @param table Symbol table
+ * @param symbol Stock symbol
+ * @return Symbol id, negative on failure
+ */
+int internSymbol(SymbolTable* table, const char* symbol);
+
+/**
+ * @brief Get the id of a symbol without adding it
+ *
+ * @param table Symbol table
+ * @param symbol Stock symbol
+ * @return Symbol id, or INVALID_SYMBOL_ID if the symbol is unknown
+ */
+int findSymbol(const SymbolTable* table, const char* symbol);
+
+/**
+ * @brief Get the text of a symbol id
+ *
+ * @param table Symbol table
+ * @param id Symbol id
+ * @return Symbol text, or "" for an invalid id
+ */
+const char* symbolName(const SymbolTable* table, int id);
+
+#endif /* SYMBOL_TABLE_H */
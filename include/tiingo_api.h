@@ -72,6 +72,9 @@ int parseNewsDataJSON(const char* jsonData, EventDatabase* events);
 double calculateSentiment(const char* title, const char* description);
 double calculateImpactScore(const EventData* event);
 
+/* News deduplication across fetches into one EventDatabase (similarity 0.0-1.0; <= 0 disables) */
+void setNewsDedupThreshold(double threshold);
+
 /* Error handling */
 void logAPIError(const char* message, const char* url, int statusCode);
 
@@ -0,0 +1,68 @@
+/**
+ * @file time_utils.h
+ * @brief Timezone-independent ISO-8601 parsing and UTC date formatting
+ */
+
+#ifndef TIME_UTILS_H
+#define TIME_UTILS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * @brief Days since 1970-01-01 of a proleptic Gregorian date
+ *
+ * @param year Year (e.g. 2024)
+ * @param month Month (1-12)
+ * @param day Day of month (1-31)
+ * @return Days since the Unix epoch (negative before 1970)
+ */
+long long daysFromCivil(int year, int month, int day);
+
+/**
+ * @brief Proleptic Gregorian date of a day count since 1970-01-01
+ *
+ * @param days Days since the Unix epoch
+ * @param year Output year
+ * @param month Output month (1-12)
+ * @param day Output day of month (1-31)
+ */
+void civilFromDays(long long days, int* year, int* month, int* day);
+
+/**
+ * @brief Parse an ISO-8601 timestamp to UTC epoch seconds
+ *
+ * Accepts "YYYY-MM-DD" optionally followed by 'T' or ' ' and "HH:MM" or
+ * "HH:MM:SS", an optional fraction of any length, and an optional "Z",
+ * "+HH:MM", "+HHMM" or "+HH" offset. Times without an offset are UTC. The
+ * result never depends on the host timezone.
+ *
+ * @param text Timestamp text
+ * @param seconds Output seconds since the Unix epoch
+ * @param nanoseconds Output fractional part in nanoseconds (may be NULL)
+ * @return 0 on success, negative if the text is not a valid timestamp
+ */
+int parseISO8601Timestamp(const char* text, time_t* seconds, int* nanoseconds);
+
+/**
+ * @brief Parse an array of ISO-8601 timestamps
+ *
+ * @param texts Timestamp strings (NULL entries count as failures)
+ * @param count Number of strings
+ * @param seconds Output epoch seconds, 0 for entries that fail to parse
+ * @return Number of entries parsed successfully
+ */
+int parseISO8601Batch(const char* const* texts, int count, time_t* seconds);
+
+/**
+ * @brief Format the UTC date of a timestamp as "YYYY-MM-DD"
+ *
+ * @param timestamp Seconds since the Unix epoch
+ * @param buffer Output buffer
+ * @param bufferSize Size of the buffer (at least 11 bytes)
+ * @return 0 on success, negative on failure
+ */
+int formatISODate(time_t timestamp, char* buffer, size_t bufferSize);
+
+#endif /* TIME_UTILS_H */
@@ -0,0 +1,376 @@
+/**
+ * Alert Engine
+ * Compiles alert configurations and evaluates them against event batches
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../include/alert_engine.h"
+#include "../include/error_handling.h"
+
+#define TYPE_BIT(type) (1u << (unsigned int)(type))
+
+/* Event types gated by the price threshold */
+#define PRICE_EVENT_MASK (TYPE_BIT(PRICE_JUMP) | TYPE_BIT(PRICE_DROP) | TYPE_BIT(VOLATILITY_SPIKE))
+
+/* Event types that qualify on severity alone */
+#define ALWAYS_ON_MASK (TYPE_BIT(UNKNOWN_EVENT) | TYPE_BIT(DIVIDEND_ANNOUNCEMENT) | \
+                        TYPE_BIT(FED_ANNOUNCEMENT) | TYPE_BIT(ECONOMIC_DATA_RELEASE))
+
+/* Initialize an empty alert engine */
+int initAlertEngine(AlertEngine* engine) {
+    if (!engine) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for initAlertEngine");
+        return -1;
+    }
+
+    memset(engine, 0, sizeof(AlertEngine));
+    return initSymbolTable(&engine->symbols, 64);
+}
+
+/* Free memory used by an alert engine */
+void freeAlertEngine(AlertEngine* engine) {
+    if (!engine) {
+        return;
+    }
+
+    freeSymbolTable(&engine->symbols);
+    free(engine->rules);
+    free(engine->targetRule);
+    free(engine->targetSymbol);
+    free(engine->symbolRuleStart);
+    free(engine->symbolRules);
+    free(engine->anySymbolRules);
+    memset(engine, 0, sizeof(AlertEngine));
+}
+
+static int addTarget(AlertEngine* engine, int rule, int symbolId) {
+    if (engine->targetCount == engine->targetCapacity) {
+        int newCapacity = engine->targetCapacity ? engine->targetCapacity * 2 : 64;
+        int* newRule = (int*)realloc(engine->targetRule, newCapacity * sizeof(int));
+        if (newRule) {
+            engine->targetRule = newRule;
+        }
+        int* newSymbol = (int*)realloc(engine->targetSymbol, newCapacity * sizeof(int));
+        if (newSymbol) {
+            engine->targetSymbol = newSymbol;
+        }
+        if (!newRule || !newSymbol) {
+            logError(ERR_OUT_OF_MEMORY, "Failed to grow alert targets to %d", newCapacity);
+            return -1;
+        }
+        engine->targetCapacity = newCapacity;
+    }
+
+    engine->targetRule[engine->targetCount] = rule;
+    engine->targetSymbol[engine->targetCount] = symbolId;
+    engine->targetCount++;
+    return 0;
+}
+
+/* Compile an AlertConfig into a rule */
+int addAlertRule(AlertEngine* engine, const AlertConfig* config) {
+    if (!engine || !config || config->targetStockCount < 0 || config->targetStockCount > 20) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for addAlertRule");
+        return -1;
+    }
+
+    if (engine->ruleCount == engine->ruleCapacity) {
+        int newCapacity = engine->ruleCapacity ? engine->ruleCapacity * 2 : 16;
+        CompiledAlertRule* newRules = (CompiledAlertRule*)realloc(engine->rules,
+                                                                  newCapacity * sizeof(CompiledAlertRule));
+        if (!newRules) {
+            logError(ERR_OUT_OF_MEMORY, "Failed to grow alert rules to %d", newCapacity);
+            return -1;
+        }
+        engine->rules = newRules;
+        engine->ruleCapacity = newCapacity;
+    }
+
+    int index = engine->ruleCount;
+    CompiledAlertRule* rule = &engine->rules[index];
+    rule->typeMask = ALWAYS_ON_MASK;
+    if (config->priceChangeThreshold > 0.0) rule->typeMask |= PRICE_EVENT_MASK;
+    if (config->volumeChangeThreshold > 0) rule->typeMask |= TYPE_BIT(VOLUME_SPIKE);
+    if (config->alertOnEarnings) rule->typeMask |= TYPE_BIT(EARNINGS_ANNOUNCEMENT);
+    if (config->alertOnMergers) rule->typeMask |= TYPE_BIT(MERGER_ACQUISITION);
+    rule->severityThreshold = config->severityThreshold;
+    rule->minPriceChange = config->priceChangeThreshold;
+    rule->minVolumeChange = (double)config->volumeChangeThreshold;
+    rule->anySymbol = 0;
+
+    /* Targets of a rule that fails to compile are dropped, so the next rule
+       added at this index does not inherit them */
+    int firstTarget = engine->targetCount;
+    int targets = 0;
+    for (int i = 0; i < config->targetStockCount; i++) {
+        if (!config->targetStocks[i][0]) {
+            continue;
+        }
+        int id = internSymbol(&engine->symbols, config->targetStocks[i]);
+        if (id < 0 || addTarget(engine, index, id) != 0) {
+            engine->targetCount = firstTarget;
+            return -1;
+        }
+        targets++;
+    }
+    rule->anySymbol = targets == 0;
+
+    engine->ruleCount++;
+    engine->compiled = 0;
+    return index;
+}
+
+/* Build the symbol-to-rule index after all rules are added */
+int compileAlertEngine(AlertEngine* engine) {
+    if (!engine) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for compileAlertEngine");
+        return -1;
+    }
+
+    int symbolCount = engine->symbols.count;
+    free(engine->symbolRuleStart);
+    free(engine->symbolRules);
+    free(engine->anySymbolRules);
+    engine->symbolRuleStart = (int*)calloc(symbolCount + 1, sizeof(int));
+    engine->symbolRules = (int*)malloc((engine->targetCount > 0 ? engine->targetCount : 1) * sizeof(int));
+    engine->anySymbolRules = (int*)malloc((engine->ruleCount > 0 ? engine->ruleCount : 1) * sizeof(int));
+    if (!engine->symbolRuleStart || !engine->symbolRules || !engine->anySymbolRules) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate alert rule index");
+        return -1;
+    }
+
+    /* Counting sort of (symbol, rule) pairs; rules stay in ascending order per symbol */
+    for (int t = 0; t < engine->targetCount; t++) {
+        engine->symbolRuleStart[engine->targetSymbol[t] + 1]++;
+    }
+    for (int s = 0; s < symbolCount; s++) {
+        engine->symbolRuleStart[s + 1] += engine->symbolRuleStart[s];
+    }
+
+    int* fill = (int*)malloc((symbolCount > 0 ? symbolCount : 1) * sizeof(int));
+    if (!fill) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate alert rule index");
+        return -1;
+    }
+    memcpy(fill, engine->symbolRuleStart, symbolCount * sizeof(int));
+    for (int t = 0; t < engine->targetCount; t++) {
+        engine->symbolRules[fill[engine->targetSymbol[t]]++] = engine->targetRule[t];
+    }
+    free(fill);
+
+    engine->anySymbolRuleCount = 0;
+    for (int r = 0; r < engine->ruleCount; r++) {
+        if (engine->rules[r].anySymbol) {
+            engine->anySymbolRules[engine->anySymbolRuleCount++] = r;
+        }
+    }
+
+    engine->compiled = 1;
+    return 0;
+}
+
+/* Alerts of one evaluation plus the (rule, symbol, type) set that dedupes them */
+typedef struct {
+    Alert* alerts;
+    int* alertSymbol;             /* Dedup symbol id of each alert */
+    int count;
+    int maxAlerts;
+    int* slotAlert;               /* Alert index per slot, -1 for empty */
+    int slotMask;
+    SymbolTable otherSymbols;     /* Symbols no rule targets, interned for this evaluation */
+} AlertSink;
+
+static unsigned int alertSlot(const AlertSink* sink, int rule, int symbolId, EventType type) {
+    unsigned long long hash = (unsigned long long)(unsigned int)rule * 0x9E3779B97F4A7C15ull;
+    hash ^= (unsigned long long)(unsigned int)(symbolId + 1) * 0xC2B2AE3D27D4EB4Full;
+    hash ^= (unsigned long long)(unsigned int)type * 0x165667B19E3779F9ull;
+    hash ^= hash >> 29;
+    hash *= 0xBF58476D1CE4E5B9ull;
+    return (unsigned int)(hash >> 32) & (unsigned int)sink->slotMask;
+}
+
+static void fireAlert(AlertSink* sink, int rule, int eventIndex, const MarketEvent* event,
+                      const char* symbol, int symbolId, int severity) {
+    unsigned int slot = alertSlot(sink, rule, symbolId, event->type);
+
+    /* The key is compared field by field, so no rule or symbol count can alias another */
+    while (sink->slotAlert[slot] >= 0) {
+        int index = sink->slotAlert[slot];
+        Alert* alert = &sink->alerts[index];
+        if (alert->ruleIndex == rule && alert->type == event->type && sink->alertSymbol[index] == symbolId) {
+            alert->occurrences++;
+            if (severity > alert->severity) {
+                alert->severity = severity;
+            }
+            return;
+        }
+        slot = (slot + 1) & (unsigned int)sink->slotMask;
+    }
+
+    if (sink->count == sink->maxAlerts) {
+        return;
+    }
+
+    Alert* alert = &sink->alerts[sink->count];
+    alert->ruleIndex = rule;
+    alert->eventIndex = eventIndex;
+    alert->type = event->type;
+    strncpy(alert->symbol, symbol, MAX_SYMBOL_LENGTH - 1);
+    alert->symbol[MAX_SYMBOL_LENGTH - 1] = '\0';
+    alert->severity = severity;
+    alert->timestamp = event->timestamp;
+    alert->occurrences = 1;
+
+    sink->alertSymbol[sink->count] = symbolId;
+    sink->slotAlert[slot] = sink->count++;
+}
+
+static int ruleAccepts(const CompiledAlertRule* rule, const MarketEvent* event, int severity) {
+    unsigned int bit = TYPE_BIT(event->type);
+    if (!(rule->typeMask & bit) || severity < rule->severityThreshold) {
+        return 0;
+    }
+    /* A change of 0 means the producer did not measure it; the event's type
+       already says the move happened, so only measured changes are filtered */
+    if (event->changePercent == 0.0) {
+        return 1;
+    }
+    if (bit & PRICE_EVENT_MASK) {
+        return fabs(event->changePercent) >= rule->minPriceChange;
+    }
+    if (bit == TYPE_BIT(VOLUME_SPIKE)) {
+        return event->changePercent >= rule->minVolumeChange;
+    }
+    return 1;
+}
+
+/* Evaluate every rule against a batch of events in one pass */
+int evaluateAlerts(const AlertEngine* engine, const MarketEvent* events, int eventCount,
+                   Alert* alerts, int maxAlerts) {
+    if (!engine || !engine->compiled || (!events && eventCount > 0) || eventCount < 0 ||
+        !alerts || maxAlerts < 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for evaluateAlerts (engine compiled?)");
+        return -1;
+    }
+
+    AlertSink sink;
+    memset(&sink, 0, sizeof(AlertSink));
+    sink.alerts = alerts;
+    sink.maxAlerts = maxAlerts;
+    int slots = 16;
+    while (slots < maxAlerts * 2) {
+        slots *= 2;
+    }
+    sink.slotMask = slots - 1;
+    sink.slotAlert = (int*)malloc(slots * sizeof(int));
+    sink.alertSymbol = (int*)malloc((maxAlerts > 0 ? maxAlerts : 1) * sizeof(int));
+    if (!sink.slotAlert || !sink.alertSymbol || initSymbolTable(&sink.otherSymbols, 16) != 0) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate alert dedup table");
+        free(sink.slotAlert);
+        free(sink.alertSymbol);
+        return -1;
+    }
+    memset(sink.slotAlert, 0xFF, slots * sizeof(int));
+    int status = 0;
+
+    for (int e = 0; e < eventCount && sink.count < maxAlerts && status == 0; e++) {
+        const MarketEvent* event = &events[e];
+        if ((unsigned int)event->type >= 32) {
+            continue;
+        }
+        int severity = event->impactScore < 0 ? -event->impactScore : event->impactScore;
+        int affected = event->affectedStockCount;
+        if (affected > 10) affected = 10;
+
+        if (affected <= 0) {
+            /* Market-wide event: only rules without targets can be interested */
+            for (int k = 0; k < engine->anySymbolRuleCount; k++) {
+                int r = engine->anySymbolRules[k];
+                if (ruleAccepts(&engine->rules[r], event, severity)) {
+                    fireAlert(&sink, r, e, event, "", -1, severity);
+                }
+            }
+            continue;
+        }
+
+        for (int a = 0; a < affected && status == 0; a++) {
+            const char* symbol = event->affectedStocks[a];
+            int id = findSymbol(&engine->symbols, symbol);
+
+            if (id != INVALID_SYMBOL_ID) {
+                for (int k = engine->symbolRuleStart[id]; k < engine->symbolRuleStart[id + 1]; k++) {
+                    int r = engine->symbolRules[k];
+                    if (ruleAccepts(&engine->rules[r], event, severity)) {
+                        fireAlert(&sink, r, e, event, symbolName(&engine->symbols, id), id, severity);
+                    }
+                }
+            }
+
+            /* Untargeted rules dedupe by symbol text: symbols no rule targets are
+               interned per evaluation and numbered after the engine's own ids */
+            int dedupId = id;
+            for (int k = 0; k < engine->anySymbolRuleCount; k++) {
+                int r = engine->anySymbolRules[k];
+                if (!ruleAccepts(&engine->rules[r], event, severity)) {
+                    continue;
+                }
+                if (dedupId == INVALID_SYMBOL_ID) {
+                    int other = internSymbol(&sink.otherSymbols, symbol);
+                    if (other < 0) {
+                        status = -1;
+                        break;
+                    }
+                    dedupId = engine->symbols.count + other;
+                }
+                fireAlert(&sink, r, e, event, symbol, dedupId, severity);
+            }
+        }
+    }
+
+    free(sink.slotAlert);
+    free(sink.alertSymbol);
+    freeSymbolTable(&sink.otherSymbols);
+    return status == 0 ? sink.count : -1;
+}
+
+/* Evaluate one alert configuration against a batch of events and log each alert */
+int generateAlerts(const AlertConfig *config, const MarketEvent *events, int eventCount) {
+    if (!config || (!events && eventCount > 0) || eventCount < 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for generateAlerts");
+        return -1;
+    }
+
+    AlertEngine engine;
+    if (initAlertEngine(&engine) != 0) {
+        return -1;
+    }
+    if (addAlertRule(&engine, config) < 0 || compileAlertEngine(&engine) != 0) {
+        freeAlertEngine(&engine);
+        return -1;
+    }
+
+    /* Each event can fire at most once per affected symbol */
+    int maxAlerts = eventCount * 10 > 0 ? eventCount * 10 : 1;
+    Alert* alerts = (Alert*)malloc(maxAlerts * sizeof(Alert));
+    if (!alerts) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate %d alerts", maxAlerts);
+        freeAlertEngine(&engine);
+        return -1;
+    }
+
+    int count = evaluateAlerts(&engine, events, eventCount, alerts, maxAlerts);
+    for (int i = 0; i < count; i++) {
+        const MarketEvent* event = &events[alerts[i].eventIndex];
+        logMessage(LOG_WARNING, "ALERT [%s] severity %d (%d event%s): %s",
+                   alerts[i].symbol[0] ? alerts[i].symbol : "MARKET", alerts[i].severity,
+                   alerts[i].occurrences, alerts[i].occurrences == 1 ? "" : "s", event->description);
+    }
+
+    free(alerts);
+    freeAlertEngine(&engine);
+    return count;
+}
@@ -0,0 +1,224 @@
+/**
+ * Anomaly Detection
+ * Rolling z-scores of close-to-close change and volume from prefix-sum
+ * windows, scored in one branch-free pass
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#include "../include/anomaly_detection.h"
+#include "../include/parallel.h"
+#include "../include/error_handling.h"
+
+/* Fill a config with defaults (20 bars, 2.5 threshold, 0.7/0.3 weights) */
+void initAnomalyConfig(AnomalyConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    config->window = 20;
+    config->threshold = 2.5;
+    config->priceWeight = 0.7;
+    config->volumeWeight = 0.3;
+}
+
+static const AnomalyConfig* resolveConfig(const AnomalyConfig* config, AnomalyConfig* defaults) {
+    if (config) {
+        return config;
+    }
+    initAnomalyConfig(defaults);
+    return defaults;
+}
+
+/* Four prefix-sum columns of barCount + 1 entries and two z-score columns */
+size_t anomalyWorkspaceSize(int barCount) {
+    if (barCount < 0) {
+        barCount = 0;
+    }
+    return 4 * ((size_t)barCount + 1) + 2 * (size_t)barCount;
+}
+
+/*
+ * Z-score of each bar's value against the window values before it, from
+ * prefix sums (sum[i + 1] holds values 0..i). The loop only uses selects,
+ * so with -fno-math-errno (release builds) it vectorizes; a flat window
+ * scores zero.
+ */
+static void rollingZScores(const double* restrict sum, const double* restrict squares, double* restrict z,
+                           int first, int n, int window) {
+    double inverseWindow = 1.0 / window;
+    for (int i = first; i < n; i++) {
+        double value = sum[i + 1] - sum[i];
+        double mean = (sum[i] - sum[i - window]) * inverseWindow;
+        double variance = (squares[i] - squares[i - window]) * inverseWindow - mean * mean;
+        double std = sqrt(variance > 0.0 ? variance : 0.0);
+        double divisor = std > DBL_MIN ? std : DBL_MIN;
+        double scale = (std > 0.0 ? 1.0 : 0.0) / divisor;
+        z[i] = (value - mean) * scale;
+    }
+}
+
+/* Detect anomalies using caller-provided scratch space */
+int scoreSeriesAnomalies(const SeriesColumns* series, const AnomalyConfig* config, double* workspace,
+                         AnomalyResult* anomalies, int maxAnomalies) {
+    if (!series || !workspace || !anomalies || maxAnomalies <= 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for scoreSeriesAnomalies");
+        return -1;
+    }
+
+    AnomalyConfig defaults;
+    config = resolveConfig(config, &defaults);
+    int window = config->window;
+    if (window < 2) {
+        logError(ERR_INVALID_PARAMETER, "Anomaly window must be at least 2 bars, got %d", window);
+        return -1;
+    }
+
+    int n = series->count;
+    int first = window + 1;       /* First bar with a full window of prior changes */
+    if (n <= first) {
+        return 0;
+    }
+
+    const double* close = series->close;
+    const double* volume = series->volume;
+    double* changeSum = workspace;
+    double* changeSquares = changeSum + (n + 1);
+    double* volumeSum = changeSquares + (n + 1);
+    double* volumeSquares = volumeSum + (n + 1);
+    double* priceZ = volumeSquares + (n + 1);
+    double* volumeZ = priceZ + n;
+
+    /* Prefix sums; volumes are shifted by an early level so squares stay small */
+    double shift = volume[0];
+    changeSum[0] = changeSquares[0] = volumeSum[0] = volumeSquares[0] = 0.0;
+    changeSum[1] = changeSquares[1] = 0.0;
+    for (int i = 0; i < n; i++) {
+        double v = volume[i] - shift;
+        volumeSum[i + 1] = volumeSum[i] + v;
+        volumeSquares[i + 1] = volumeSquares[i] + v * v;
+    }
+    for (int i = 1; i < n; i++) {
+        double change = close[i - 1] > 0.0 ? close[i] / close[i - 1] - 1.0 : 0.0;
+        changeSum[i + 1] = changeSum[i] + change;
+        changeSquares[i + 1] = changeSquares[i] + change * change;
+    }
+
+    /* Bar i is measured against bars i-window..i-1 */
+    rollingZScores(changeSum, changeSquares, priceZ, first, n, window);
+    rollingZScores(volumeSum, volumeSquares, volumeZ, first, n, window);
+
+    /* Collect from the end so a full buffer keeps the most recent bars */
+    int count = 0;
+    for (int i = n - 1; i >= first && count < maxAnomalies; i--) {
+        double score = config->priceWeight * fabs(priceZ[i]) + config->volumeWeight * fabs(volumeZ[i]);
+        if (score > config->threshold) {
+            AnomalyResult* anomaly = &anomalies[count++];
+            anomaly->index = i;
+            anomaly->score = score;
+            anomaly->priceDeviation = priceZ[i];
+            anomaly->volumeDeviation = volumeZ[i];
+            anomaly->priceChange = changeSum[i + 1] - changeSum[i];
+        }
+    }
+
+    for (int lo = 0, hi = count - 1; lo < hi; lo++, hi--) {
+        AnomalyResult swap = anomalies[lo];
+        anomalies[lo] = anomalies[hi];
+        anomalies[hi] = swap;
+    }
+
+    return count;
+}
+
+/* Detect anomalies of one series */
+int detectSeriesAnomalies(const SeriesColumns* series, const AnomalyConfig* config,
+                          AnomalyResult* anomalies, int maxAnomalies) {
+    if (!series || !anomalies || maxAnomalies <= 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for detectSeriesAnomalies");
+        return -1;
+    }
+
+    size_t size = anomalyWorkspaceSize(series->count);
+    double* workspace = (double*)malloc(size * sizeof(double));
+    if (!workspace) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate %zu doubles of anomaly workspace", size);
+        return -1;
+    }
+
+    int count = scoreSeriesAnomalies(series, config, workspace, anomalies, maxAnomalies);
+
+    free(workspace);
+    return count;
+}
+
+typedef struct {
+    const SeriesColumns* series;
+    const AnomalyConfig* config;
+    AnomalyResult* anomalies;
+    int maxAnomalies;
+    int* anomalyCounts;
+    int failed;
+} UniverseJob;
+
+static void detectSeriesRange(int begin, int end, void* context) {
+    UniverseJob* job = (UniverseJob*)context;
+
+    int capacity = 1;
+    for (int s = begin; s < end; s++) {
+        if (job->series[s].count > capacity) {
+            capacity = job->series[s].count;
+        }
+    }
+
+    size_t size = anomalyWorkspaceSize(capacity);
+    double* workspace = (double*)malloc(size * sizeof(double));
+    if (!workspace) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate %zu doubles of anomaly workspace", size);
+        for (int s = begin; s < end; s++) {
+            job->anomalyCounts[s] = 0;
+        }
+        __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    for (int s = begin; s < end; s++) {
+        int count = scoreSeriesAnomalies(&job->series[s], job->config, workspace,
+                                         job->anomalies + (size_t)s * job->maxAnomalies, job->maxAnomalies);
+        if (count < 0) {
+            count = 0;
+            __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+        }
+        job->anomalyCounts[s] = count;
+    }
+
+    free(workspace);
+}
+
+/* Detect anomalies of many series in parallel */
+int detectUniverseAnomalies(const SeriesColumns* series, int seriesCount, const AnomalyConfig* config,
+                            AnomalyResult* anomalies, int maxAnomalies, int* anomalyCounts) {
+    if (!series || seriesCount < 0 || !anomalies || maxAnomalies <= 0 || !anomalyCounts) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for detectUniverseAnomalies");
+        return -1;
+    }
+
+    AnomalyConfig defaults;
+    UniverseJob job;
+    job.series = series;
+    job.config = resolveConfig(config, &defaults);
+    job.anomalies = anomalies;
+    job.maxAnomalies = maxAnomalies;
+    job.anomalyCounts = anomalyCounts;
+    job.failed = 0;
+
+    if (parallelFor(seriesCount, 1, detectSeriesRange, &job) != 0) {
+        return -1;
+    }
+
+    return job.failed ? -1 : 0;
+}
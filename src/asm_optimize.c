@@ -9,6 +9,8 @@
 
 #include "../include/emers.h"
 #include "../include/technical_analysis.h"
+#include "../include/sentiment_engine.h"
+#include "../include/stemmer.h"
 
 /* Add proper compiler-specific includes and macros */
 #ifdef _MSC_VER  /* Microsoft compiler */
@@ -336,6 +338,7 @@ int asmFindKeywordsInText(const char* text, const char** keywords, int keywordCo
 /**
  * SIMD-optimized implementation of Porter stemming algorithm for English
  * Reduces words to their stem (e.g., "jumping", "jumped", "jumps" to "jump")
+ * Folds the word to lowercase and runs the complete table-driven stemmer.
  */
 int asmPorterStemmer(char* word) {
     if (!word || *word == '\0') {
@@ -354,40 +357,15 @@ int asmPorterStemmer(char* word) {
         }
     }
     
-    /* Step 1a: Replace plurals and -ed or -ing */
-    if (len > 4 && strcmp(word + len - 4, "sses") == 0) {
-        word[len - 2] = '\0'; /* Remove "es" */
-        len -= 2;
-    } else if (len > 3 && strcmp(word + len - 3, "ies") == 0) {
-        word[len - 2] = '\0'; /* Replace "ies" with "i" */
-        len -= 2;
-    } else if (len > 2 && strcmp(word + len - 2, "ss") == 0) {
-        /* No change for "ss" */
-    } else if (len > 1 && word[len - 1] == 's') {
-        word[len - 1] = '\0'; /* Remove trailing "s" */
-        len--;
-    }
-    
-    /* Step 1b: Replace -eed, -ed, -ing */
-    if (len > 3 && strcmp(word + len - 3, "eed") == 0) {
-        word[len - 1] = '\0'; /* Replace "eed" with "ee" */
-    } else if (len > 2 && strcmp(word + len - 2, "ed") == 0) {
-        word[len - 2] = '\0'; /* Remove "ed" */
-        len -= 2;
-    } else if (len > 3 && strcmp(word + len - 3, "ing") == 0) {
-        word[len - 3] = '\0'; /* Remove "ing" */
-        len -= 3;
-    }
-    
-    /* This is a simplified version of the Porter stemmer
-       A full implementation would include more steps */
-    
-    return strlen(word);
+    return porterStem(word, len);
 }
 
 /**
  * Assembly-optimized sentiment scoring for bag-of-words model
- * Uses SIMD instructions for faster text processing
+ * Builds a hashed lexicon from the word lists and tokenizes the text once,
+ * so the cost is linear in text length plus lexicon size. Callers scoring
+ * many documents against the same lexicon should keep a SentimentLexicon
+ * and call scoreSentimentText() directly to avoid rebuilding it.
  */
 void asmCalculateSentimentScore(const char* text, const char** positiveWords, int positiveCount,
                               const char** negativeWords, int negativeCount,
@@ -399,115 +377,21 @@ void asmCalculateSentimentScore(const char* text, const char** positiveWords, in
         return;
     }
     
-    /* Create a lowercase copy of the text for case-insensitive matching */
-    char* lowerText = (char*)malloc(strlen(text) + 1);
-    if (!lowerText) {
+    SentimentLexicon lexicon;
+    if (initSentimentLexicon(&lexicon, positiveCount + negativeCount) != 0) {
         *score = 0.0;
         *confidence = 0.0;
         return;
     }
     
-    size_t textLen = strlen(text);
-    for (size_t i = 0; i < textLen; i++) {
-        lowerText[i] = (text[i] >= 'A' && text[i] <= 'Z') ? text[i] + 'a' - 'A' : text[i];
-    }
-    lowerText[textLen] = '\0';
-    
-    /* Count positive and negative words */
-    double positiveScore = 0.0;
-    double negativeScore = 0.0;
-    
-#if defined(__GNUC__) && (defined(__x86_64__) || defined(_M_X64)) && !defined(_WIN32)
-    /* Optimized word counting for x86_64 platforms (non-Windows) */
-    
-    /* Count positive words */
-    for (int i = 0; i < positiveCount; i++) {
-        const char* word = positiveWords[i];
-        const char* ptr = lowerText;
-        
-        while ((ptr = strstr(ptr, word)) != NULL) {
-            /* Check if it's a complete word (not part of another word) */
-            int isWordStart = (ptr == lowerText || !isalpha(*(ptr - 1)));
-            int wordLen = strlen(word);
-            int isWordEnd = (ptr[wordLen] == '\0' || !isalpha(ptr[wordLen]));
-            
-            if (isWordStart && isWordEnd) {
-                positiveScore += 1.0;
-            }
-            
-            ptr += wordLen;
-        }
-    }
-    
-    /* Count negative words */
-    for (int i = 0; i < negativeCount; i++) {
-        const char* word = negativeWords[i];
-        const char* ptr = lowerText;
-        
-        while ((ptr = strstr(ptr, word)) != NULL) {
-            /* Check if it's a complete word (not part of another word) */
-            int isWordStart = (ptr == lowerText || !isalpha(*(ptr - 1)));
-            int wordLen = strlen(word);
-            int isWordEnd = (ptr[wordLen] == '\0' || !isalpha(ptr[wordLen]));
-            
-            if (isWordStart && isWordEnd) {
-                negativeScore += 1.0;
-            }
-            
-            ptr += wordLen;
-        }
-    }
-#else
-    /* Simple implementation for other platforms or Windows */
-    /* Count positive words */
-    for (int i = 0; i < positiveCount; i++) {
-        const char* word = positiveWords[i];
-        const char* ptr = lowerText;
-        
-        while ((ptr = strstr(ptr, word)) != NULL) {
-            /* Check if it's a complete word (not part of another word) */
-            int isWordStart = (ptr == lowerText || !isalpha(*(ptr - 1)));
-            int wordLen = strlen(word);
-            int isWordEnd = (ptr[wordLen] == '\0' || !isalpha(ptr[wordLen]));
-            
-            if (isWordStart && isWordEnd) {
-                positiveScore += 1.0;
-            }
-            
-            ptr += wordLen;
-        }
-    }
-    
-    /* Count negative words */
-    for (int i = 0; i < negativeCount; i++) {
-        const char* word = negativeWords[i];
-        const char* ptr = lowerText;
-        
-        while ((ptr = strstr(ptr, word)) != NULL) {
-            /* Check if it's a complete word (not part of another word) */
-            int isWordStart = (ptr == lowerText || !isalpha(*(ptr - 1)));
-            int wordLen = strlen(word);
-            int isWordEnd = (ptr[wordLen] == '\0' || !isalpha(ptr[wordLen]));
-            
-            if (isWordStart && isWordEnd) {
-                negativeScore += 1.0;
-            }
-            
-            ptr += wordLen;
-        }
-    }
-#endif
-    
-    /* Calculate final sentiment score */
-    double totalWords = positiveScore + negativeScore;
-    
-    if (totalWords > 0) {
-        *score = (positiveScore - negativeScore) / totalWords;
-        *confidence = fmin(totalWords / 5.0, 1.0); /* Higher confidence with more sentiment words */
-    } else {
+    /* Plain bag-of-words contract: no negation handling for ad-hoc word lists */
+    if (addSentimentWordLists(&lexicon, positiveWords, positiveCount,
+                              negativeWords, negativeCount) != 0) {
         *score = 0.0;
         *confidence = 0.0;
+    } else {
+        scoreSentimentText(&lexicon, text, score, confidence);
     }
     
-    free(lowerText);
-} 
\ No newline at end of file
+    freeSentimentLexicon(&lexicon);
+}
@@ -0,0 +1,480 @@
+/**
+ * Backtesting
+ * Single-pass crossover signals and signal-driven trade simulation over
+ * column-oriented price series
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../include/backtest.h"
+#include "../include/parallel.h"
+#include "../include/error_handling.h"
+
+/* Fill a config with defaults (5% target, 3% stop, 5 bp per side, long/short) */
+void initBacktestConfig(BacktestConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    config->targetPercent = DM_DEFAULT_TARGET_PERCENT;
+    config->stopPercent = DM_DEFAULT_STOP_PERCENT;
+    config->costPerSide = 0.0005;
+    config->allowShort = 1;
+    config->maxHoldingBars = 0;
+}
+
+static const BacktestConfig* resolveConfig(const BacktestConfig* config, BacktestConfig* defaults) {
+    if (config) {
+        return config;
+    }
+    initBacktestConfig(defaults);
+    return defaults;
+}
+
+static void reverseSignals(DMTradingSignal* signals, int begin, int end) {
+    for (end--; begin < end; begin++, end--) {
+        DMTradingSignal tmp = signals[begin];
+        signals[begin] = signals[end];
+        signals[end] = tmp;
+    }
+}
+
+/* Fill a BUY or SELL signal entered at a close */
+void initCrossoverSignal(DMTradingSignal* signal, int type, int index, double close,
+                         double confidence, const BacktestConfig* config) {
+    double direction = type == DM_SIGNAL_BUY ? 1.0 : -1.0;
+
+    signal->type = type;
+    signal->signalIndex = index;
+    signal->confidence = confidence;
+    signal->entryPrice = close;
+    signal->targetPrice = close * (1.0 + direction * config->targetPercent);
+    signal->stopLossPrice = close * (1.0 - direction * config->stopPercent);
+    signal->riskRewardRatio = config->stopPercent > 0.0 ? config->targetPercent / config->stopPercent : 0.0;
+}
+
+/* Generate crossover signals from close prices in one pass */
+int generateCrossoverSignals(const SeriesColumns* series, const CrossoverRule* rule,
+                             const BacktestConfig* config, DMTradingSignal* signals, int maxSignals) {
+    if (!series || !rule || rule->shortPeriod < 1 || rule->longPeriod < 1 ||
+        (!signals && maxSignals > 0) || maxSignals < 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for generateCrossoverSignals");
+        return -1;
+    }
+
+    BacktestConfig defaults;
+    config = resolveConfig(config, &defaults);
+
+    const double* close = series->close;
+    const double* volume = series->volume;
+    int n = series->count;
+    int shortPeriod = rule->shortPeriod;
+    int longPeriod = rule->longPeriod;
+    int warmup = shortPeriod > longPeriod ? shortPeriod : longPeriod;
+    if (n < warmup + 1 || maxSignals == 0) {
+        return 0;
+    }
+
+    double shortAlpha = 2.0 / (shortPeriod + 1.0);
+    double longAlpha = 2.0 / (longPeriod + 1.0);
+    double shortSum = 0.0, longSum = 0.0, volumeSum = 0.0;
+    double fast = close[0], slow = close[0];
+    double previousGap = 0.0;
+    int found = 0;
+
+    for (int i = 0; i < n; i++) {
+        double c = close[i];
+
+        if (rule->type == CROSSOVER_SMA) {
+            shortSum += c;
+            longSum += c;
+            if (i >= shortPeriod) shortSum -= close[i - shortPeriod];
+            if (i >= longPeriod) longSum -= close[i - longPeriod];
+            fast = shortSum / shortPeriod;
+            slow = longSum / longPeriod;
+        } else if (i > 0) {
+            fast += shortAlpha * (c - fast);
+            slow += longAlpha * (c - slow);
+        }
+
+        volumeSum += volume[i];
+        if (i >= SIGNAL_VOLUME_WINDOW) volumeSum -= volume[i - SIGNAL_VOLUME_WINDOW];
+
+        double gap = fast - slow;
+        if (i >= warmup) {
+            int type = DM_SIGNAL_UNKNOWN;
+            if (previousGap <= 0.0 && gap > 0.0) {
+                type = DM_SIGNAL_BUY;
+            } else if (previousGap >= 0.0 && gap < 0.0) {
+                type = DM_SIGNAL_SELL;
+            }
+
+            if (type != DM_SIGNAL_UNKNOWN) {
+                int window = i + 1 < SIGNAL_VOLUME_WINDOW ? i + 1 : SIGNAL_VOLUME_WINDOW;
+                double averageVolume = volumeSum / window;
+                double ratio = averageVolume > 0.0 ? volume[i] / averageVolume : 0.0;
+                double confidence = 0.5 + 0.25 * (ratio < 2.0 ? ratio : 2.0);
+
+                /* Ring write: past capacity the oldest signals are overwritten */
+                initCrossoverSignal(&signals[found % maxSignals], type, i, c, confidence, config);
+                found++;
+            }
+        }
+        previousGap = gap;
+    }
+
+    if (found > maxSignals) {
+        /* Rotate the ring so the oldest kept signal comes first */
+        int start = found % maxSignals;
+        reverseSignals(signals, 0, start);
+        reverseSignals(signals, start, maxSignals);
+        reverseSignals(signals, 0, maxSignals);
+        return maxSignals;
+    }
+    return found;
+}
+
+/* Running state of one simulation */
+typedef struct {
+    const BacktestConfig* config;
+    int direction;                /* +1 long, -1 short, 0 flat */
+    int entryIndex;
+    double entryPrice;
+    double targetPrice;
+    double stopPrice;
+    double mark;                  /* Price the equity was last marked at */
+    double equity;
+    double grossGain;
+    double grossLoss;
+    double tradeReturnSum;
+    int wins;
+    BacktestResult* result;
+} BacktestState;
+
+static void closePosition(BacktestState* state, double exitPrice, int* exitCounter) {
+    double cost = state->config->costPerSide;
+    double tradeReturn = state->direction * (exitPrice / state->entryPrice - 1.0) - 2.0 * cost;
+
+    state->equity *= 1.0 + state->direction * (exitPrice / state->mark - 1.0);
+    state->equity *= 1.0 - cost;
+    state->tradeReturnSum += tradeReturn;
+    if (tradeReturn > 0.0) {
+        state->wins++;
+        state->grossGain += tradeReturn;
+    } else {
+        state->grossLoss -= tradeReturn;
+    }
+    state->result->tradeCount++;
+    (*exitCounter)++;
+    state->direction = 0;
+}
+
+static void openPosition(BacktestState* state, const DMTradingSignal* signal, int direction, double close) {
+    const BacktestConfig* config = state->config;
+    double entry = signal->entryPrice > 0.0 ? signal->entryPrice : close;
+
+    state->direction = direction;
+    state->entryIndex = signal->signalIndex;
+    state->entryPrice = entry;
+    state->mark = entry;
+    state->targetPrice = signal->targetPrice > 0.0 ? signal->targetPrice
+                                                   : entry * (1.0 + direction * config->targetPercent);
+    state->stopPrice = signal->stopLossPrice > 0.0 ? signal->stopLossPrice
+                                                   : entry * (1.0 - direction * config->stopPercent);
+    state->equity *= 1.0 - config->costPerSide;
+}
+
+/* Check the stop, target and holding limit of the open position against bar j */
+static void checkExits(BacktestState* state, const SeriesColumns* series, int j) {
+    double open = series->open[j] > 0.0 ? series->open[j] : series->close[j];
+    double high = series->high[j];
+    double low = series->low[j];
+    BacktestResult* result = state->result;
+
+    if (state->direction > 0) {
+        if (low <= state->stopPrice) {
+            closePosition(state, open < state->stopPrice ? open : state->stopPrice, &result->stopExits);
+        } else if (high >= state->targetPrice) {
+            closePosition(state, open > state->targetPrice ? open : state->targetPrice, &result->targetExits);
+        }
+    } else {
+        if (high >= state->stopPrice) {
+            closePosition(state, open > state->stopPrice ? open : state->stopPrice, &result->stopExits);
+        } else if (low <= state->targetPrice) {
+            closePosition(state, open < state->targetPrice ? open : state->targetPrice, &result->targetExits);
+        }
+    }
+
+    if (state->direction != 0 && state->config->maxHoldingBars > 0 &&
+        j - state->entryIndex >= state->config->maxHoldingBars) {
+        closePosition(state, series->close[j], &result->signalExits);
+    }
+
+    if (state->direction != 0) {
+        state->equity *= 1.0 + state->direction * (series->close[j] / state->mark - 1.0);
+        state->mark = series->close[j];
+    }
+}
+
+/* Simulate trading a list of signals */
+int runSignalBacktest(const SeriesColumns* series, const DMTradingSignal* signals, int signalCount,
+                      const BacktestConfig* config, BacktestResult* result) {
+    return runSignalBacktestBounded(series, signals, signalCount, config, NULL, 0.0, result);
+}
+
+/* Largest factor equity can grow by over the rest of the series after each bar */
+int computeEquityGainBound(const SeriesColumns* series, double* bound) {
+    if (!series || !bound) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for computeEquityGainBound");
+        return -1;
+    }
+
+    int n = series->count;
+    if (n == 0) {
+        return 0;
+    }
+
+    /* A bar can at best mark a long up to its high or a short down to its low */
+    bound[n - 1] = 1.0;
+    for (int j = n - 1; j > 0; j--) {
+        double previous = series->close[j - 1];
+        double high = series->high[j], low = series->low[j];
+        if (series->open[j] > high) high = series->open[j];
+        if (series->close[j] > high) high = series->close[j];
+        if (series->open[j] > 0.0 && series->open[j] < low) low = series->open[j];
+        if (series->close[j] < low) low = series->close[j];
+
+        double gain = 1.0;
+        if (previous > 0.0) {
+            if (high / previous > gain) gain = high / previous;
+            if (2.0 - low / previous > gain) gain = 2.0 - low / previous;
+        }
+        bound[j - 1] = bound[j] * gain;
+    }
+
+    return 0;
+}
+
+/* Simulate trading a list of signals, abandoning it once a target equity is out of reach */
+int runSignalBacktestBounded(const SeriesColumns* series, const DMTradingSignal* signals, int signalCount,
+                             const BacktestConfig* config, const double* gainBound, double minFinalEquity,
+                             BacktestResult* result) {
+    if (!series || (!signals && signalCount > 0) || signalCount < 0 || !result) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for runSignalBacktest");
+        return -1;
+    }
+
+    BacktestConfig defaults;
+    memset(result, 0, sizeof(BacktestResult));
+
+    BacktestState state;
+    memset(&state, 0, sizeof(BacktestState));
+    state.config = resolveConfig(config, &defaults);
+    state.equity = 1.0;
+    state.result = result;
+
+    int n = series->count;
+    int next = 0;
+    int barsInMarket = 0;
+    double peak = 1.0;
+    double sum = 0.0, sumSquares = 0.0;
+
+    for (int j = 0; j < n; j++) {
+        double equityBefore = state.equity;
+
+        if (state.direction != 0 && j > state.entryIndex) {
+            barsInMarket++;
+            checkExits(&state, series, j);
+        }
+
+        while (next < signalCount && signals[next].signalIndex <= j) {
+            const DMTradingSignal* signal = &signals[next++];
+            if (signal->signalIndex < j) {
+                continue;
+            }
+
+            int wanted = signal->type == DM_SIGNAL_BUY ? 1 :
+                         signal->type == DM_SIGNAL_SELL ? -1 : 0;
+            int exits = signal->type == DM_SIGNAL_STOP_LOSS || wanted == -state.direction;
+
+            if (state.direction != 0 && exits) {
+                closePosition(&state, series->close[j], &result->signalExits);
+            }
+            if (state.direction == 0 && (wanted == 1 || (wanted == -1 && state.config->allowShort))) {
+                openPosition(&state, signal, wanted, series->close[j]);
+            }
+        }
+
+        if (j > 0) {
+            double r = state.equity / equityBefore - 1.0;
+            sum += r;
+            sumSquares += r * r;
+        }
+        if (state.equity > peak) {
+            peak = state.equity;
+        } else if (1.0 - state.equity / peak > result->maxDrawdown) {
+            result->maxDrawdown = 1.0 - state.equity / peak;
+        }
+
+        if (gainBound && (j & 31) == 31 && state.equity * gainBound[j] < minFinalEquity) {
+            result->totalReturn = state.equity - 1.0;
+            return 1;
+        }
+    }
+
+    if (state.direction != 0 && n > 0) {
+        closePosition(&state, series->close[n - 1], &result->signalExits);
+        if (1.0 - state.equity / peak > result->maxDrawdown) {
+            result->maxDrawdown = 1.0 - state.equity / peak;
+        }
+    }
+
+    result->totalReturn = state.equity - 1.0;
+    if (n > 1) {
+        double mean = sum / (n - 1);
+        double variance = sumSquares / (n - 1) - mean * mean;
+        result->sharpeRatio = variance > 0.0 ? mean / sqrt(variance) * sqrt((double)BACKTEST_BARS_PER_YEAR) : 0.0;
+        result->exposure = (double)barsInMarket / (n - 1);
+    }
+    if (result->tradeCount > 0) {
+        result->winRate = (double)state.wins / result->tradeCount;
+        result->averageTradeReturn = state.tradeReturnSum / result->tradeCount;
+        result->profitFactor = state.grossLoss > 0.0 ? state.grossGain / state.grossLoss : state.grossGain > 0.0 ? HUGE_VAL : 0.0;
+    }
+
+    return 0;
+}
+
+/* Generate a rule's signals and backtest them into the caller's buffer */
+static int backtestRuleWithBuffer(const SeriesColumns* series, const CrossoverRule* rule,
+                                  const BacktestConfig* config, DMTradingSignal* buffer,
+                                  int bufferSize, BacktestResult* result) {
+    int count = generateCrossoverSignals(series, rule, config, buffer, bufferSize);
+    if (count < 0) {
+        return -1;
+    }
+    return runSignalBacktest(series, buffer, count, config, result);
+}
+
+/* Generate a rule's signals and backtest them */
+int runCrossoverBacktest(const SeriesColumns* series, const CrossoverRule* rule,
+                         const BacktestConfig* config, BacktestResult* result) {
+    if (!series || !rule || !result) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for runCrossoverBacktest");
+        return -1;
+    }
+
+    /* Crossovers alternate, so there is at most one per bar */
+    int capacity = series->count > 0 ? series->count : 1;
+    DMTradingSignal* buffer = (DMTradingSignal*)malloc(capacity * sizeof(DMTradingSignal));
+    if (!buffer) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate %d signals", capacity);
+        return -1;
+    }
+
+    int status = backtestRuleWithBuffer(series, rule, config, buffer, capacity, result);
+    free(buffer);
+    return status;
+}
+
+typedef struct {
+    const SeriesColumns* series;
+    const CrossoverRule* rules;
+    int ruleCount;
+    const BacktestConfig* config;
+    BacktestResult* results;
+    int failed;
+} UniverseJob;
+
+static void backtestSeriesRange(int begin, int end, void* context) {
+    UniverseJob* job = (UniverseJob*)context;
+
+    int capacity = 1;
+    for (int s = begin; s < end; s++) {
+        if (job->series[s].count > capacity) {
+            capacity = job->series[s].count;
+        }
+    }
+
+    DMTradingSignal* buffer = (DMTradingSignal*)malloc(capacity * sizeof(DMTradingSignal));
+    if (!buffer) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate %d signals", capacity);
+        __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    for (int s = begin; s < end; s++) {
+        for (int r = 0; r < job->ruleCount; r++) {
+            BacktestResult* result = &job->results[(size_t)s * job->ruleCount + r];
+            if (backtestRuleWithBuffer(&job->series[s], &job->rules[r], job->config,
+                                       buffer, capacity, result) != 0) {
+                memset(result, 0, sizeof(BacktestResult));
+                __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+            }
+        }
+    }
+
+    free(buffer);
+}
+
+/* Backtest every rule on every series in parallel */
+int runBacktestUniverse(const SeriesColumns* series, int seriesCount,
+                        const CrossoverRule* rules, int ruleCount,
+                        const BacktestConfig* config, BacktestResult* results) {
+    if (!series || seriesCount < 0 || !rules || ruleCount <= 0 || !results) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for runBacktestUniverse");
+        return -1;
+    }
+
+    BacktestConfig defaults;
+    UniverseJob job;
+    job.series = series;
+    job.rules = rules;
+    job.ruleCount = ruleCount;
+    job.config = resolveConfig(config, &defaults);
+    job.results = results;
+    job.failed = 0;
+
+    if (parallelFor(seriesCount, 1, backtestSeriesRange, &job) != 0) {
+        return -1;
+    }
+
+    return job.failed ? -1 : 0;
+}
+
+/* Transpose stocks to columns and backtest every rule on each */
+int backtestStocks(const Stock* stocks, int stockCount,
+                   const CrossoverRule* rules, int ruleCount,
+                   const BacktestConfig* config, BacktestResult* results) {
+    if (!stocks || stockCount <= 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for backtestStocks");
+        return -1;
+    }
+
+    SeriesColumns* series = (SeriesColumns*)calloc(stockCount, sizeof(SeriesColumns));
+    if (!series) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate columns for %d stocks", stockCount);
+        return -1;
+    }
+
+    int status = 0;
+    for (int s = 0; s < stockCount && status == 0; s++) {
+        if (initSeriesColumns(&series[s], stocks[s].dataSize) != 0 ||
+            loadSeriesColumns(&series[s], stocks[s].data, stocks[s].dataSize) != 0) {
+            status = -1;
+        }
+    }
+
+    if (status == 0) {
+        status = runBacktestUniverse(series, stockCount, rules, ruleCount, config, results);
+    }
+
+    for (int s = 0; s < stockCount; s++) {
+        freeSeriesColumns(&series[s]);
+    }
+    free(series);
+    return status;
+}
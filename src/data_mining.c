@@ -18,6 +18,9 @@
 #include "../include/data_mining.h"       // Include data mining function declarations (Thêm khai báo hàm khai thác dữ liệu)
 #include "../include/technical_analysis.h" // Include technical analysis functions (Thêm các hàm phân tích kỹ thuật)
 #include "../include/error_handling.h"    // Include error handling utilities (Thêm tiện ích xử lý lỗi)
+#include "../include/backtest.h"          // Include crossover signal generation (Thêm sinh tín hiệu giao cắt)
+#include "../include/pattern_detection.h" // Include zigzag pattern detection (Thêm phát hiện mẫu hình zigzag)
+#include "../include/anomaly_detection.h" // Include rolling anomaly detection (Thêm phát hiện bất thường trượt)
 #include <float.h>      // Include floating point limits (Thêm giới hạn số thực dấu phẩy động)
 
 /* Data Preprocessing Functions */
@@ -499,4 +502,114 @@ int prepareDataForMining(const StockData* inputData, int inputSize,
     free(tmpData); // Free the temporary data array (Giải phóng mảng dữ liệu tạm thời)
     
     return 0; // Return success (Trả về thành công)
-}
\ No newline at end of file
+}
+
+/* Trading Signal Functions */
+/* Các hàm tín hiệu giao dịch */
+
+/**
+ * Transpose bars to columns and generate crossover signals with the default
+ * 5% target and 3% stop
+ * 
+ * Chuyển dữ liệu sang dạng cột và sinh tín hiệu giao cắt với mục tiêu 5%
+ * và dừng lỗ 3% mặc định
+ */
+static int detectCrossoverSignals(const StockData* data, int dataSize, CrossoverType type,
+                                  int shortPeriod, int longPeriod,
+                                  DMTradingSignal* signals, int maxSignals) {
+    if (!data || dataSize <= 0 || !signals || maxSignals <= 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for crossover signal detection");
+        return -1; // Return error for invalid parameters (Trả về lỗi cho tham số không hợp lệ)
+    }
+
+    SeriesColumns series;
+    if (initSeriesColumns(&series, dataSize) != 0 ||
+        loadSeriesColumns(&series, data, dataSize) != 0) {
+        freeSeriesColumns(&series);
+        return -1; // Return error if memory allocation fails (Trả về lỗi nếu cấp phát bộ nhớ thất bại)
+    }
+
+    CrossoverRule rule;
+    rule.type = type;
+    rule.shortPeriod = shortPeriod;
+    rule.longPeriod = longPeriod;
+
+    int count = generateCrossoverSignals(&series, &rule, NULL, signals, maxSignals);
+
+    freeSeriesColumns(&series); // Free the temporary columns (Giải phóng các cột tạm thời)
+    return count;
+}
+
+/**
+ * Detect simple moving average crossover signals
+ * 
+ * Phát hiện tín hiệu giao cắt đường trung bình động đơn giản
+ */
+int detectSMACrossoverSignals(const StockData* data, int dataSize, int shortPeriod, int longPeriod,
+                              DMTradingSignal* signals, int maxSignals) {
+    return detectCrossoverSignals(data, dataSize, CROSSOVER_SMA, shortPeriod, longPeriod, signals, maxSignals);
+}
+
+/**
+ * Detect exponential moving average crossover signals
+ * 
+ * Phát hiện tín hiệu giao cắt đường trung bình động hàm mũ
+ */
+int detectEMACrossoverSignals(const StockData* data, int dataSize, int shortPeriod, int longPeriod,
+                              DMTradingSignal* signals, int maxSignals) {
+    return detectCrossoverSignals(data, dataSize, CROSSOVER_EMA, shortPeriod, longPeriod, signals, maxSignals);
+}
+
+/* Pattern Detection Functions */
+/* Các hàm phát hiện mẫu hình */
+
+/**
+ * Transpose bars to columns and detect chart patterns from zigzag pivots
+ * 
+ * Chuyển dữ liệu sang dạng cột và phát hiện mẫu hình từ các điểm xoay zigzag
+ */
+int detectPricePatterns(const StockData* data, int dataSize, MarketPattern* patterns, int maxPatterns) {
+    if (!data || dataSize <= 0 || !patterns || maxPatterns <= 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for price pattern detection");
+        return -1; // Return error for invalid parameters (Trả về lỗi cho tham số không hợp lệ)
+    }
+
+    SeriesColumns series;
+    if (initSeriesColumns(&series, dataSize) != 0 ||
+        loadSeriesColumns(&series, data, dataSize) != 0) {
+        freeSeriesColumns(&series);
+        return -1; // Return error if memory allocation fails (Trả về lỗi nếu cấp phát bộ nhớ thất bại)
+    }
+
+    int count = detectSeriesPatterns(&series, NULL, patterns, maxPatterns);
+
+    freeSeriesColumns(&series); // Free the temporary columns (Giải phóng các cột tạm thời)
+    return count;
+}
+
+/* Anomaly Detection Functions */
+/* Các hàm phát hiện bất thường */
+
+/**
+ * Transpose bars to columns and detect rolling z-score anomalies
+ * 
+ * Chuyển dữ liệu sang dạng cột và phát hiện bất thường theo z-score trượt
+ */
+int detectAnomalies(const StockData* data, int dataSize, AnomalyResult* anomalies, int maxAnomalies) {
+    if (!data || dataSize <= 0 || !anomalies || maxAnomalies <= 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for anomaly detection");
+        return -1; // Return error for invalid parameters (Trả về lỗi cho tham số không hợp lệ)
+    }
+
+    SeriesColumns series;
+    if (initSeriesColumns(&series, dataSize) != 0 ||
+        loadSeriesColumns(&series, data, dataSize) != 0) {
+        freeSeriesColumns(&series);
+        return -1; // Return error if memory allocation fails (Trả về lỗi nếu cấp phát bộ nhớ thất bại)
+    }
+
+    int count = detectSeriesAnomalies(&series, NULL, anomalies, maxAnomalies);
+
+    freeSeriesColumns(&series); // Free the temporary columns (Giải phóng các cột tạm thời)
+    return count;
+}
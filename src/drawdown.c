@@ -0,0 +1,342 @@
+/**
+ * Drawdown Analysis
+ * Linear-time underwater curves, drawdown episodes and rolling drawdowns
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/risk_management.h"
+#include "../include/parallel.h"
+#include "../include/error_handling.h"
+
+/* Keep the deepest episodes in a min-heap ordered by depth */
+static void heapSiftDown(DrawdownEpisode* heap, int size, int i) {
+    for (;;) {
+        int smallest = i;
+        int left = 2 * i + 1;
+        int right = left + 1;
+        if (left < size && heap[left].depth < heap[smallest].depth) smallest = left;
+        if (right < size && heap[right].depth < heap[smallest].depth) smallest = right;
+        if (smallest == i) {
+            return;
+        }
+        DrawdownEpisode t = heap[i];
+        heap[i] = heap[smallest];
+        heap[smallest] = t;
+        i = smallest;
+    }
+}
+
+static void offerEpisode(DrawdownEpisode* heap, int* size, int capacity, const DrawdownEpisode* episode) {
+    if (capacity <= 0) {
+        return;
+    }
+
+    if (*size < capacity) {
+        int i = (*size)++;
+        heap[i] = *episode;
+        while (i > 0 && heap[(i - 1) / 2].depth > heap[i].depth) {
+            DrawdownEpisode t = heap[i];
+            heap[i] = heap[(i - 1) / 2];
+            heap[(i - 1) / 2] = t;
+            i = (i - 1) / 2;
+        }
+    } else if (episode->depth > heap[0].depth) {
+        heap[0] = *episode;
+        heapSiftDown(heap, *size, 0);
+    }
+}
+
+/* Analyze drawdowns of a price series in one O(n) pass */
+int analyzeDrawdowns(const double* prices, int count, double* underwater,
+                     DrawdownEpisode* episodes, int maxEpisodes, DrawdownSummary* summary) {
+    if (!prices || count < 0 || (maxEpisodes > 0 && !episodes)) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for analyzeDrawdowns");
+        return -1;
+    }
+    if (maxEpisodes < 0) {
+        maxEpisodes = 0;
+    }
+
+    DrawdownSummary s;
+    memset(&s, 0, sizeof(DrawdownSummary));
+    s.peakIndex = s.troughIndex = s.recoveryIndex = -1;
+
+    int heapSize = 0;
+    double peak = count > 0 ? prices[0] : 0.0;
+    int peakIndex = 0;
+    DrawdownEpisode current;
+    int inDrawdown = 0;
+
+    for (int i = 0; i < count; i++) {
+        double price = prices[i];
+
+        if (price >= peak) {
+            if (inDrawdown) {
+                current.recoveryIndex = i;
+                offerEpisode(episodes, &heapSize, maxEpisodes, &current);
+                if (i - current.peakIndex > s.longestDuration) {
+                    s.longestDuration = i - current.peakIndex;
+                }
+                if (current.peakIndex == s.peakIndex) {
+                    s.recoveryIndex = i;
+                }
+                inDrawdown = 0;
+            }
+            peak = price;
+            peakIndex = i;
+            if (underwater) underwater[i] = 0.0;
+            continue;
+        }
+
+        double depth = peak > 0.0 ? 1.0 - price / peak : 0.0;
+        if (underwater) underwater[i] = -depth;
+
+        if (!inDrawdown) {
+            current.peakIndex = peakIndex;
+            current.troughIndex = i;
+            current.recoveryIndex = -1;
+            current.depth = depth;
+            inDrawdown = 1;
+            s.episodeCount++;
+        } else if (depth > current.depth) {
+            current.troughIndex = i;
+            current.depth = depth;
+        }
+
+        if (depth > s.maxDrawdown) {
+            s.maxDrawdown = depth;
+            s.peakIndex = peakIndex;
+            s.troughIndex = i;
+            s.recoveryIndex = -1;
+        }
+    }
+
+    if (inDrawdown) {
+        offerEpisode(episodes, &heapSize, maxEpisodes, &current);
+        if (count - 1 - current.peakIndex > s.longestDuration) {
+            s.longestDuration = count - 1 - current.peakIndex;
+        }
+        s.currentDrawdown = peak > 0.0 ? 1.0 - prices[count - 1] / peak : 0.0;
+    }
+
+    /* Heap-sort the kept episodes so the deepest comes first */
+    for (int end = heapSize - 1; end > 0; end--) {
+        DrawdownEpisode t = episodes[0];
+        episodes[0] = episodes[end];
+        episodes[end] = t;
+        heapSiftDown(episodes, end, 0);
+    }
+
+    if (summary) {
+        *summary = s;
+    }
+    return heapSize;
+}
+
+/* Drawdown from the highest price of a trailing window (monotonic deque, O(n)) */
+int rollingDrawdown(const double* prices, int count, int window, double* output) {
+    if (!prices || count < 0 || window < 1 || !output) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for rollingDrawdown");
+        return -1;
+    }
+
+    /* Indices with strictly decreasing prices; the front is the window maximum */
+    int* deque = (int*)malloc((count > 0 ? count : 1) * sizeof(int));
+    if (!deque) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate rolling drawdown deque");
+        return -1;
+    }
+
+    int head = 0;
+    int tail = 0;
+    for (int i = 0; i < count; i++) {
+        while (tail > head && prices[deque[tail - 1]] <= prices[i]) {
+            tail--;
+        }
+        deque[tail++] = i;
+        if (deque[head] <= i - window) {
+            head++;
+        }
+
+        double peak = prices[deque[head]];
+        output[i] = peak > 0.0 ? 1.0 - prices[i] / peak : 0.0;
+    }
+
+    free(deque);
+    return 0;
+}
+
+/* Aggregate of a time-ordered run of prices */
+typedef struct {
+    double max;
+    double min;
+    double mdd;                   /* Max drawdown with peak before trough inside the run */
+} DrawdownAggregate;
+
+/* Combine an earlier run with a later one */
+static DrawdownAggregate combineAggregates(DrawdownAggregate earlier, DrawdownAggregate later) {
+    DrawdownAggregate result;
+    result.max = earlier.max > later.max ? earlier.max : later.max;
+    result.min = earlier.min < later.min ? earlier.min : later.min;
+
+    /* The only new pairs peak in the earlier run and trough in the later one */
+    double cross = earlier.max > 0.0 ? 1.0 - later.min / earlier.max : 0.0;
+    result.mdd = earlier.mdd > later.mdd ? earlier.mdd : later.mdd;
+    if (cross > result.mdd) {
+        result.mdd = cross;
+    }
+    return result;
+}
+
+/* Maximum drawdown inside each trailing window (amortized O(1) per bar) */
+int rollingMaxDrawdown(const double* prices, int count, int window, double* output) {
+    if (!prices || count < 0 || window < 1 || !output) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for rollingMaxDrawdown");
+        return -1;
+    }
+
+    /*
+     * The front stack holds the oldest prices with suffix aggregates (each
+     * entry covers itself and everything newer in the stack); the back stack
+     * holds the newest prices with prefix aggregates. The window aggregate is
+     * front-top combined with back-top.
+     */
+    int capacity = window < count ? window + 1 : count;
+    DrawdownAggregate* front = (DrawdownAggregate*)malloc((capacity > 0 ? capacity : 1) * sizeof(DrawdownAggregate));
+    DrawdownAggregate* back = (DrawdownAggregate*)malloc((capacity > 0 ? capacity : 1) * sizeof(DrawdownAggregate));
+    if (!front || !back) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate rolling max drawdown stacks");
+        free(front);
+        free(back);
+        return -1;
+    }
+
+    int frontSize = 0;
+    int backSize = 0;
+    int backStart = 0;            /* Series index of back[0] */
+
+    for (int i = 0; i < count; i++) {
+        DrawdownAggregate single = {prices[i], prices[i], 0.0};
+        back[backSize] = backSize ? combineAggregates(back[backSize - 1], single) : single;
+        if (backSize == 0) {
+            backStart = i;
+        }
+        backSize++;
+
+        if (frontSize + backSize > window) {
+            if (frontSize == 0) {
+                /* Move the back stack over, building suffix aggregates newest first */
+                for (int k = backSize - 1; k >= 0; k--) {
+                    DrawdownAggregate element = {prices[backStart + k], prices[backStart + k], 0.0};
+                    front[frontSize] = frontSize ? combineAggregates(element, front[frontSize - 1]) : element;
+                    frontSize++;
+                }
+                backSize = 0;
+            }
+            frontSize--;
+        }
+
+        if (frontSize && backSize) {
+            output[i] = combineAggregates(front[frontSize - 1], back[backSize - 1]).mdd;
+        } else if (frontSize) {
+            output[i] = front[frontSize - 1].mdd;
+        } else {
+            output[i] = back[backSize - 1].mdd;
+        }
+    }
+
+    free(front);
+    free(back);
+    return 0;
+}
+
+/* Shared state of a portfolio run */
+typedef struct {
+    const Stock* stocks;
+    int window;
+    DrawdownSummary* summaries;
+    int* succeeded;
+} PortfolioDrawdownJob;
+
+static void analyzeStockRange(int begin, int end, void* context) {
+    PortfolioDrawdownJob* job = (PortfolioDrawdownJob*)context;
+
+    for (int s = begin; s < end; s++) {
+        const Stock* stock = &job->stocks[s];
+        int n = stock->dataSize;
+        double* prices = (double*)malloc((n > 0 ? 2 * n : 1) * sizeof(double));
+        if (!prices) {
+            continue;
+        }
+
+        for (int i = 0; i < n; i++) {
+            prices[i] = stock->data[i].adjClose > 0.0 ? stock->data[i].adjClose : stock->data[i].close;
+        }
+
+        if (analyzeDrawdowns(prices, n, NULL, NULL, 0, &job->summaries[s]) >= 0) {
+            if (job->window > 0 && n > 0) {
+                /* Only the last window matters for a screen */
+                int start = n > job->window ? n - job->window : 0;
+                double* rolling = prices + n;
+                if (rollingMaxDrawdown(prices + start, n - start, job->window, rolling) == 0) {
+                    job->summaries[s].rollingMaxDrawdown = rolling[n - start - 1];
+                }
+            }
+            job->succeeded[s] = 1;
+        }
+        free(prices);
+    }
+}
+
+/* Drawdown summaries of many stocks in parallel */
+int computePortfolioDrawdowns(const Stock* stocks, int stockCount, int window, DrawdownSummary* summaries) {
+    if (!stocks || stockCount < 0 || window < 0 || !summaries) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for computePortfolioDrawdowns");
+        return -1;
+    }
+
+    int* succeeded = (int*)calloc(stockCount > 0 ? stockCount : 1, sizeof(int));
+    if (!succeeded) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate portfolio drawdown status");
+        return -1;
+    }
+    memset(summaries, 0, stockCount * sizeof(DrawdownSummary));
+
+    PortfolioDrawdownJob job;
+    job.stocks = stocks;
+    job.window = window;
+    job.summaries = summaries;
+    job.succeeded = succeeded;
+    int status = parallelFor(stockCount, 0, analyzeStockRange, &job);
+
+    int count = 0;
+    for (int s = 0; s < stockCount; s++) {
+        count += succeeded[s];
+    }
+    free(succeeded);
+    return status == 0 ? count : -1;
+}
+
+/* Maximum drawdown of a bar series in percent */
+double calculateMaxDrawdown(const StockData* data, int dataSize) {
+    if (!data || dataSize <= 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for calculateMaxDrawdown");
+        return 0.0;
+    }
+
+    /* Single pass over the bars without copying prices */
+    double peak = data[0].adjClose > 0.0 ? data[0].adjClose : data[0].close;
+    double maxDrawdown = 0.0;
+    for (int i = 1; i < dataSize; i++) {
+        double price = data[i].adjClose > 0.0 ? data[i].adjClose : data[i].close;
+        if (price > peak) {
+            peak = price;
+        } else if (peak > 0.0 && 1.0 - price / peak > maxDrawdown) {
+            maxDrawdown = 1.0 - price / peak;
+        }
+    }
+    return maxDrawdown * 100.0;
+}
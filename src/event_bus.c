@@ -0,0 +1,457 @@
+/**
+ * Event Bus
+ * Lock-free bounded queues, batch-consuming workers and the EMERS entry points
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+
+#include "../include/event_bus.h"
+#include "../include/market_state.h"
+#include "../include/error_handling.h"
+
+/* How long an idle worker parks before re-checking its queue */
+#define WORKER_PARK_NANOS 2000000L
+
+static EventBus emersBus;
+static int emersRunning = 0;
+static EventBatchHandler emersHandler = NULL;
+static void* emersContext = NULL;
+
+/* Fill an event bus configuration with defaults */
+void initEventBusConfig(EventBusConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    config->workerCount = 2;
+    config->queueCapacity = 4096;
+    config->batchSize = 64;
+    config->policy = BACKPRESSURE_BLOCK;
+}
+
+/* Try to claim a free cell and copy the event in; returns 0, or 1 when full */
+static int tryEnqueue(EventQueue* queue, const MarketEvent* event) {
+    unsigned long pos = __atomic_load_n(&queue->enqueuePos, __ATOMIC_RELAXED);
+
+    for (;;) {
+        EventCell* cell = &queue->cells[pos & queue->mask];
+        unsigned long sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        long diff = (long)(sequence - pos);
+
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&queue->enqueuePos, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                cell->event = *event;
+                __atomic_store_n(&cell->sequence, pos + 1, __ATOMIC_RELEASE);
+                return 0;
+            }
+        } else if (diff < 0) {
+            return 1;
+        } else {
+            pos = __atomic_load_n(&queue->enqueuePos, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/* Try to take the oldest event (into event, if not NULL); returns 0, or 1 when empty */
+static int tryDequeue(EventQueue* queue, MarketEvent* event) {
+    unsigned long pos = __atomic_load_n(&queue->dequeuePos, __ATOMIC_RELAXED);
+
+    for (;;) {
+        EventCell* cell = &queue->cells[pos & queue->mask];
+        unsigned long sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        long diff = (long)(sequence - (pos + 1));
+
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&queue->dequeuePos, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                if (event) {
+                    *event = cell->event;
+                }
+                __atomic_store_n(&cell->sequence, pos + queue->mask + 1, __ATOMIC_RELEASE);
+                return 0;
+            }
+        } else if (diff < 0) {
+            return 1;
+        } else {
+            pos = __atomic_load_n(&queue->dequeuePos, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static int queueDepth(const EventQueue* queue) {
+    unsigned long head = __atomic_load_n(&queue->dequeuePos, __ATOMIC_RELAXED);
+    unsigned long tail = __atomic_load_n(&queue->enqueuePos, __ATOMIC_RELAXED);
+    return tail > head ? (int)(tail - head) : 0;
+}
+
+static void wakeWorker(EventQueue* queue) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&queue->sleeping, __ATOMIC_SEQ_CST)) {
+        pthread_mutex_lock(&queue->wakeLock);
+        pthread_cond_signal(&queue->wakeSignal);
+        pthread_mutex_unlock(&queue->wakeLock);
+    }
+}
+
+static void* eventWorker(void* arg) {
+    EventQueue* queue = (EventQueue*)arg;
+    EventBus* bus = queue->bus;
+    int batchSize = bus->config.batchSize;
+
+    MarketEvent* batch = (MarketEvent*)malloc(batchSize * sizeof(MarketEvent));
+    if (!batch) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate event batch of %d", batchSize);
+        return NULL;
+    }
+
+    for (;;) {
+        int count = 0;
+        while (count < batchSize && tryDequeue(queue, &batch[count]) == 0) {
+            count++;
+        }
+
+        if (count > 0) {
+            bus->handler(batch, count, bus->context);
+            __atomic_add_fetch(&queue->consumed, (unsigned long)count, __ATOMIC_RELAXED);
+            __atomic_add_fetch(&queue->batches, 1, __ATOMIC_RELAXED);
+            continue;
+        }
+
+        if (!__atomic_load_n(&bus->running, __ATOMIC_ACQUIRE)) {
+            /* Stopped and drained: producers finished before stopEventBus */
+            if (queueDepth(queue) == 0) {
+                break;
+            }
+            continue;
+        }
+
+        pthread_mutex_lock(&queue->wakeLock);
+        __atomic_store_n(&queue->sleeping, 1, __ATOMIC_SEQ_CST);
+        if (queueDepth(queue) == 0 && __atomic_load_n(&bus->running, __ATOMIC_ACQUIRE)) {
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_nsec += WORKER_PARK_NANOS;
+            if (deadline.tv_nsec >= 1000000000L) {
+                deadline.tv_sec++;
+                deadline.tv_nsec -= 1000000000L;
+            }
+            pthread_cond_timedwait(&queue->wakeSignal, &queue->wakeLock, &deadline);
+        }
+        __atomic_store_n(&queue->sleeping, 0, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&queue->wakeLock);
+    }
+
+    free(batch);
+    return NULL;
+}
+
+static void freeQueues(EventBus* bus, int count) {
+    for (int i = 0; i < count; i++) {
+        pthread_mutex_destroy(&bus->queues[i].wakeLock);
+        pthread_cond_destroy(&bus->queues[i].wakeSignal);
+        free(bus->queues[i].cells);
+        bus->queues[i].cells = NULL;
+    }
+}
+
+/* Allocate queues and start the workers */
+int startEventBus(EventBus* bus, const EventBusConfig* config, EventBatchHandler handler, void* context) {
+    if (!bus || !handler) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for startEventBus");
+        return -1;
+    }
+
+    memset(bus, 0, sizeof(EventBus));
+    if (config) {
+        bus->config = *config;
+    } else {
+        initEventBusConfig(&bus->config);
+    }
+    if (bus->config.workerCount < 1 || bus->config.workerCount > MAX_EVENT_BUS_WORKERS ||
+        bus->config.queueCapacity < 2 || bus->config.batchSize < 1) {
+        logError(ERR_INVALID_PARAMETER, "Invalid event bus configuration (%d workers, capacity %d, batch %d)",
+                 bus->config.workerCount, bus->config.queueCapacity, bus->config.batchSize);
+        return -1;
+    }
+
+    unsigned long capacity = 2;
+    while (capacity < (unsigned long)bus->config.queueCapacity) {
+        capacity *= 2;
+    }
+    bus->config.queueCapacity = (int)capacity;
+    bus->handler = handler;
+    bus->context = context;
+
+    for (int q = 0; q < bus->config.workerCount; q++) {
+        EventQueue* queue = &bus->queues[q];
+        queue->cells = (EventCell*)malloc(capacity * sizeof(EventCell));
+        if (!queue->cells) {
+            logError(ERR_OUT_OF_MEMORY, "Failed to allocate event queue of %lu cells", capacity);
+            freeQueues(bus, q);
+            return -1;
+        }
+        for (unsigned long c = 0; c < capacity; c++) {
+            queue->cells[c].sequence = c;
+        }
+        queue->mask = capacity - 1;
+        queue->bus = bus;
+        pthread_mutex_init(&queue->wakeLock, NULL);
+        pthread_cond_init(&queue->wakeSignal, NULL);
+    }
+
+    bus->running = 1;
+    for (int w = 0; w < bus->config.workerCount; w++) {
+        if (pthread_create(&bus->workers[w], NULL, eventWorker, &bus->queues[w]) != 0) {
+            logError(ERR_INIT, "Failed to start event worker %d", w);
+            __atomic_store_n(&bus->running, 0, __ATOMIC_RELEASE);
+            for (int j = 0; j < w; j++) {
+                wakeWorker(&bus->queues[j]);
+                pthread_join(bus->workers[j], NULL);
+            }
+            freeQueues(bus, bus->config.workerCount);
+            return -1;
+        }
+        bus->workerCount++;
+    }
+
+    logMessage(LOG_DEBUG, "Event bus started: %d workers, %lu cells per queue, batch %d",
+               bus->workerCount, capacity, bus->config.batchSize);
+    return 0;
+}
+
+/* Drain every queue, stop the workers and free the queues */
+void stopEventBus(EventBus* bus) {
+    if (!bus || !bus->running) {
+        return;
+    }
+
+    __atomic_store_n(&bus->running, 0, __ATOMIC_RELEASE);
+    for (int w = 0; w < bus->workerCount; w++) {
+        wakeWorker(&bus->queues[w]);
+        pthread_join(bus->workers[w], NULL);
+    }
+
+    freeQueues(bus, bus->config.workerCount);
+    bus->workerCount = 0;
+}
+
+static int selectQueue(EventBus* bus, const MarketEvent* event) {
+    if (bus->workerCount == 1) {
+        return 0;
+    }
+
+    if (event->affectedStockCount > 0 && event->affectedStocks[0][0]) {
+        unsigned int hash = 2166136261u;
+        for (const char* p = event->affectedStocks[0]; *p && p < event->affectedStocks[0] + 16; p++) {
+            hash = (hash ^ (unsigned char)toupper((unsigned char)*p)) * 16777619u;
+        }
+        return (int)(hash % (unsigned int)bus->workerCount);
+    }
+
+    unsigned long next = __atomic_fetch_add(&bus->nextQueue, 1, __ATOMIC_RELAXED);
+    return (int)(next % (unsigned long)bus->workerCount);
+}
+
+/* Publish one event */
+int publishEvent(EventBus* bus, const MarketEvent* event) {
+    if (!bus || !event || !__atomic_load_n(&bus->running, __ATOMIC_ACQUIRE)) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for publishEvent (bus running?)");
+        return -1;
+    }
+
+    EventQueue* queue = &bus->queues[selectQueue(bus, event)];
+
+    while (tryEnqueue(queue, event) != 0) {
+        if (bus->config.policy == BACKPRESSURE_DROP_NEWEST) {
+            __atomic_add_fetch(&queue->dropped, 1, __ATOMIC_RELAXED);
+            return 1;
+        }
+        if (bus->config.policy == BACKPRESSURE_DROP_OLDEST) {
+            if (tryDequeue(queue, NULL) == 0) {
+                __atomic_add_fetch(&queue->dropped, 1, __ATOMIC_RELAXED);
+            }
+            continue;
+        }
+        wakeWorker(queue);
+        sched_yield();
+    }
+
+    __atomic_add_fetch(&queue->published, 1, __ATOMIC_RELAXED);
+
+    int depth = queueDepth(queue);
+    int mark = __atomic_load_n(&queue->highWatermark, __ATOMIC_RELAXED);
+    while (depth > mark &&
+           !__atomic_compare_exchange_n(&queue->highWatermark, &mark, depth, 1,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+
+    wakeWorker(queue);
+    return 0;
+}
+
+/* Publish several events */
+int publishEvents(EventBus* bus, const MarketEvent* events, int count) {
+    if (!bus || (!events && count > 0) || count < 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for publishEvents");
+        return -1;
+    }
+
+    int queued = 0;
+    for (int i = 0; i < count; i++) {
+        int result = publishEvent(bus, &events[i]);
+        if (result < 0) {
+            return queued > 0 ? queued : -1;
+        }
+        if (result == 0) {
+            queued++;
+        }
+    }
+
+    return queued;
+}
+
+/* Read the counters of one queue */
+int getEventQueueStats(const EventBus* bus, int queue, EventQueueStats* stats) {
+    if (!bus || !stats || queue < 0 || queue >= bus->workerCount) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for getEventQueueStats");
+        return -1;
+    }
+
+    const EventQueue* q = &bus->queues[queue];
+    stats->published = __atomic_load_n(&q->published, __ATOMIC_RELAXED);
+    stats->consumed = __atomic_load_n(&q->consumed, __ATOMIC_RELAXED);
+    stats->dropped = __atomic_load_n(&q->dropped, __ATOMIC_RELAXED);
+    stats->batches = __atomic_load_n(&q->batches, __ATOMIC_RELAXED);
+    stats->depth = queueDepth(q);
+    stats->highWatermark = __atomic_load_n(&q->highWatermark, __ATOMIC_RELAXED);
+    stats->capacity = bus->config.queueCapacity;
+    return 0;
+}
+
+/* Default EMERS handler: log every event */
+static void logEventBatch(const MarketEvent* events, int count, void* context) {
+    (void)context;
+
+    for (int i = 0; i < count; i++) {
+        logMessage(LOG_INFO, "Event %d (impact %d, %d stocks): %s", events[i].type,
+                   events[i].impactScore, events[i].affectedStockCount, events[i].description);
+    }
+}
+
+/* Set the handler used by the bus that initEMERS starts */
+void setEMERSEventHandler(EventBatchHandler handler, void* context) {
+    emersHandler = handler;
+    emersContext = context;
+}
+
+/* Bus started by initEMERS, or NULL when not running */
+EventBus* getEMERSEventBus(void) {
+    return emersRunning ? &emersBus : NULL;
+}
+
+/* Apply one "key = value" line of the EMERS configuration file */
+static void applyConfigLine(EventBusConfig* config, char* line) {
+    char* comment = strchr(line, '#');
+    if (comment) {
+        *comment = '\0';
+    }
+
+    char* equals = strchr(line, '=');
+    if (!equals) {
+        return;
+    }
+    *equals = '\0';
+
+    char key[64];
+    char value[64];
+    if (sscanf(line, "%63s", key) != 1 || sscanf(equals + 1, "%63s", value) != 1) {
+        return;
+    }
+
+    if (strcmp(key, "event_workers") == 0) {
+        config->workerCount = atoi(value);
+    } else if (strcmp(key, "event_queue_capacity") == 0) {
+        config->queueCapacity = atoi(value);
+    } else if (strcmp(key, "event_batch_size") == 0) {
+        config->batchSize = atoi(value);
+    } else if (strcmp(key, "event_backpressure") == 0) {
+        if (strcmp(value, "drop_newest") == 0) {
+            config->policy = BACKPRESSURE_DROP_NEWEST;
+        } else if (strcmp(value, "drop_oldest") == 0) {
+            config->policy = BACKPRESSURE_DROP_OLDEST;
+        } else if (strcmp(value, "block") == 0) {
+            config->policy = BACKPRESSURE_BLOCK;
+        } else {
+            logWarning("Unknown event_backpressure '%s', using block", value);
+        }
+    }
+}
+
+/* Initializes the EMERS system */
+bool initEMERS(const char *configFile) {
+    if (emersRunning) {
+        return true;
+    }
+
+    EventBusConfig config;
+    initEventBusConfig(&config);
+
+    if (configFile && configFile[0]) {
+        FILE* file = fopen(configFile, "r");
+        if (!file) {
+            logError(ERR_FILE_NOT_FOUND, "Cannot open EMERS configuration %s", configFile);
+            return false;
+        }
+        char line[256];
+        while (fgets(line, sizeof(line), file)) {
+            applyConfigLine(&config, line);
+        }
+        fclose(file);
+    }
+
+    if (!getMarketState()) {
+        logError(ERR_INIT, "Failed to create market state");
+        return false;
+    }
+
+    if (startEventBus(&emersBus, &config, emersHandler ? emersHandler : logEventBatch,
+                      emersHandler ? emersContext : NULL) != 0) {
+        return false;
+    }
+
+    emersRunning = 1;
+    return true;
+}
+
+/* Cleans up and shuts down the EMERS system */
+void cleanupEMERS(void) {
+    if (!emersRunning) {
+        return;
+    }
+
+    stopEventBus(&emersBus);
+    emersRunning = 0;
+}
+
+/* Process a new market event */
+bool processEvent(const MarketEvent *event) {
+    if (!event) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for processEvent");
+        return false;
+    }
+    if (!emersRunning) {
+        logError(ERR_INIT, "processEvent called before initEMERS");
+        return false;
+    }
+
+    return publishEvent(&emersBus, event) == 0;
+}
@@ -0,0 +1,450 @@
+/**
+ * Event Detection
+ * O(1)-per-bar detection of price, volume and volatility events
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <ctype.h>
+
+#include "../include/event_detection.h"
+#include "../include/time_utils.h"
+#include "../include/parallel.h"
+#include "../include/error_handling.h"
+
+/* Volatility spike state clears once the ratio falls below this share of the threshold */
+#define VOLATILITY_RESET_FRACTION 0.8
+
+/* Length of generated event descriptions */
+#define EVENT_DESCRIPTION_LENGTH 256
+
+/* One triggered condition before it is turned into an event */
+typedef struct {
+    EventType type;
+    double magnitude;             /* Sigma or ratio that triggered the event */
+    double value;                 /* Return, volume multiple or volatility multiple */
+} DetectedSignal;
+
+/* Fill a config with defaults */
+void initEventDetectorConfig(EventDetectorConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    config->span = 20;
+    config->fastSpan = 5;
+    config->warmupBars = 20;
+    config->returnZThreshold = 3.0;
+    config->minReturn = 0.01;
+    config->volumeZThreshold = 3.0;
+    config->volatilityRatio = 2.0;
+}
+
+/* Feed one bar into a symbol's state; writes triggered signals and returns their count */
+static int updateDetectorState(DetectorState* state, const EventDetectorConfig* config,
+                               double close, double volume, DetectedSignal* signals) {
+    if (state->barCount == 0 || state->lastClose <= 0.0) {
+        state->lastClose = close;
+        if (volume > 0.0) {
+            state->logVolumeMean = log1p(volume);
+        }
+        state->barCount = 1;
+        return 0;
+    }
+    if (close <= 0.0) {
+        return 0;
+    }
+
+    double alpha = 2.0 / (config->span + 1.0);
+    double fastAlpha = 2.0 / (config->fastSpan + 1.0);
+    double r = close / state->lastClose - 1.0;
+    double logVolume = volume > 0.0 ? log1p(volume) : 0.0;
+    double fastVar = (1.0 - fastAlpha) * state->fastVar + fastAlpha * r * r;
+    int count = 0;
+
+    /* Test against statistics from earlier bars, then fold this bar in */
+    if (state->barCount > config->warmupBars) {
+        double sd = sqrt(state->returnVar);
+        if (sd > 0.0) {
+            double z = (r - state->returnMean) / sd;
+            if (fabs(z) >= config->returnZThreshold && fabs(r) >= config->minReturn) {
+                signals[count].type = r > 0.0 ? PRICE_JUMP : PRICE_DROP;
+                signals[count].magnitude = fabs(z);
+                signals[count].value = r;
+                count++;
+            }
+        }
+
+        double volumeSd = sqrt(state->logVolumeVar);
+        if (volume > 0.0 && volumeSd > 0.0) {
+            double z = (logVolume - state->logVolumeMean) / volumeSd;
+            if (z >= config->volumeZThreshold) {
+                signals[count].type = VOLUME_SPIKE;
+                signals[count].magnitude = z;
+                signals[count].value = exp(logVolume - state->logVolumeMean);
+                count++;
+            }
+        }
+
+        if (state->returnVar > 0.0) {
+            double ratio = sqrt(fastVar / state->returnVar);
+            if (ratio >= config->volatilityRatio && !state->inVolatilitySpike) {
+                signals[count].type = VOLATILITY_SPIKE;
+                signals[count].magnitude = ratio;
+                signals[count].value = ratio;
+                count++;
+                state->inVolatilitySpike = 1;
+            } else if (ratio < config->volatilityRatio * VOLATILITY_RESET_FRACTION) {
+                state->inVolatilitySpike = 0;
+            }
+        }
+    }
+
+    double delta = r - state->returnMean;
+    state->returnMean += alpha * delta;
+    state->returnVar = (1.0 - alpha) * (state->returnVar + alpha * delta * delta);
+    state->fastVar = fastVar;
+
+    if (volume > 0.0) {
+        double volumeDelta = logVolume - state->logVolumeMean;
+        state->logVolumeMean += alpha * volumeDelta;
+        state->logVolumeVar = (1.0 - alpha) * (state->logVolumeVar + alpha * volumeDelta * volumeDelta);
+    }
+
+    state->lastClose = close;
+    state->barCount++;
+    return count;
+}
+
+/* Human-readable description of a signal */
+static void describeSignal(const char* symbol, const DetectedSignal* signal, char* buffer, size_t size) {
+    switch (signal->type) {
+        case PRICE_JUMP:
+        case PRICE_DROP:
+            snprintf(buffer, size, "%s price %s of %+.2f%% (%.1f sigma)", symbol,
+                     signal->type == PRICE_JUMP ? "jump" : "drop", signal->value * 100.0, signal->magnitude);
+            break;
+        case VOLUME_SPIKE:
+            snprintf(buffer, size, "%s volume spike at %.1fx typical volume (%.1f sigma)",
+                     symbol, signal->value, signal->magnitude);
+            break;
+        case VOLATILITY_SPIKE:
+            snprintf(buffer, size, "%s volatility spike: short-term volatility %.1fx normal",
+                     symbol, signal->value);
+            break;
+        default:
+            snprintf(buffer, size, "%s market event", symbol);
+            break;
+    }
+}
+
+/* Impact score (0-10) of a signal: two points per sigma, or per unit of ratio */
+static int signalImpact(const DetectedSignal* signal) {
+    int impact = (int)(signal->magnitude * 2.0 + 0.5);
+    return impact > 10 ? 10 : impact;
+}
+
+/* Jumps read as bullish and drops as bearish; other events are neutral */
+static float signalSentiment(const DetectedSignal* signal) {
+    return signal->type == PRICE_JUMP ? 1.0f : signal->type == PRICE_DROP ? -1.0f : 0.0f;
+}
+
+/* Timestamp of a bar date, 0 if it cannot be parsed */
+static time_t barTimestamp(const char* date) {
+    char datePart[11];
+    time_t timestamp;
+
+    if (strlen(date) < 10) {
+        return 0;
+    }
+    memcpy(datePart, date, 10);
+    datePart[10] = '\0';
+    return parseISO8601Timestamp(datePart, &timestamp, NULL) == 0 ? timestamp : 0;
+}
+
+static void fillEventData(EventData* event, const char* symbol, const StockData* bar,
+                          const DetectedSignal* signal) {
+    memset(event, 0, sizeof(EventData));
+    strncpy(event->symbol, symbol, sizeof(event->symbol) - 1);
+    snprintf(event->date, sizeof(event->date), "%.10s", bar->date);
+    describeSignal(symbol, signal, event->description, sizeof(event->description));
+    event->type = signal->type;
+    event->magnitude = signal->magnitude;
+    event->timestamp = barTimestamp(bar->date);
+    event->sentiment = signalSentiment(signal);
+    event->impactScore = signalImpact(signal);
+}
+
+/* Initialize a detector */
+int initMarketEventDetector(MarketEventDetector* detector, const EventDetectorConfig* config) {
+    if (!detector) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for initMarketEventDetector");
+        return -1;
+    }
+
+    memset(detector, 0, sizeof(MarketEventDetector));
+    if (config) {
+        detector->config = *config;
+    } else {
+        initEventDetectorConfig(&detector->config);
+    }
+
+    detector->stateCapacity = 64;
+    detector->states = (DetectorState*)calloc(detector->stateCapacity, sizeof(DetectorState));
+    if (!detector->states || initSymbolTable(&detector->symbols, detector->stateCapacity) != 0) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate market event detector");
+        free(detector->states);
+        detector->states = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+/* Free memory used by a detector */
+void freeMarketEventDetector(MarketEventDetector* detector) {
+    if (!detector) {
+        return;
+    }
+
+    free(detector->states);
+    freeSymbolTable(&detector->symbols);
+    memset(detector, 0, sizeof(MarketEventDetector));
+}
+
+/* Feed one new bar of a symbol and collect the events it triggers */
+int detectorOnBar(MarketEventDetector* detector, const char* symbol, const StockData* bar,
+                  EventData* events) {
+    if (!detector || !detector->states || !symbol || !bar || !events) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for detectorOnBar");
+        return -1;
+    }
+
+    int id = internSymbol(&detector->symbols, symbol);
+    if (id < 0) {
+        return -1;
+    }
+
+    if (id >= detector->stateCapacity) {
+        int newCapacity = detector->stateCapacity * 2;
+        DetectorState* newStates = (DetectorState*)realloc(detector->states, newCapacity * sizeof(DetectorState));
+        if (!newStates) {
+            logError(ERR_OUT_OF_MEMORY, "Failed to grow detector to %d symbols", newCapacity);
+            return -1;
+        }
+        memset(newStates + detector->stateCapacity, 0,
+               (newCapacity - detector->stateCapacity) * sizeof(DetectorState));
+        detector->states = newStates;
+        detector->stateCapacity = newCapacity;
+    }
+
+    DetectedSignal signals[MAX_EVENTS_PER_BAR];
+    int count = updateDetectorState(&detector->states[id], &detector->config,
+                                    bar->close, bar->volume, signals);
+    for (int i = 0; i < count; i++) {
+        fillEventData(&events[i], symbolName(&detector->symbols, id), bar, &signals[i]);
+    }
+    return count;
+}
+
+/* Signals of one replayed stock */
+typedef struct {
+    DetectedSignal* signals;
+    int* bars;
+    int count;
+    int capacity;
+    int failed;
+} ReplayResult;
+
+typedef struct {
+    const Stock* stocks;
+    const EventDetectorConfig* config;
+    ReplayResult* results;
+} ReplayContext;
+
+static void replayStockRange(int begin, int end, void* context) {
+    ReplayContext* ctx = (ReplayContext*)context;
+
+    for (int s = begin; s < end; s++) {
+        const Stock* stock = &ctx->stocks[s];
+        ReplayResult* result = &ctx->results[s];
+        DetectorState state;
+        memset(&state, 0, sizeof(DetectorState));
+
+        for (int i = 0; i < stock->dataSize; i++) {
+            DetectedSignal signals[MAX_EVENTS_PER_BAR];
+            int count = updateDetectorState(&state, ctx->config, stock->data[i].close,
+                                            stock->data[i].volume, signals);
+            if (count == 0) {
+                continue;
+            }
+
+            if (result->count + count > result->capacity) {
+                int newCapacity = result->capacity ? result->capacity * 2 : 16;
+                DetectedSignal* newSignals = (DetectedSignal*)realloc(result->signals,
+                                                                      newCapacity * sizeof(DetectedSignal));
+                if (newSignals) {
+                    result->signals = newSignals;
+                }
+                int* newBars = (int*)realloc(result->bars, newCapacity * sizeof(int));
+                if (newBars) {
+                    result->bars = newBars;
+                }
+                if (!newSignals || !newBars) {
+                    result->failed = 1;
+                    break;
+                }
+                result->capacity = newCapacity;
+            }
+
+            for (int k = 0; k < count; k++) {
+                result->signals[result->count] = signals[k];
+                result->bars[result->count] = i;
+                result->count++;
+            }
+        }
+    }
+}
+
+/* Replay full histories and store every detected event */
+int replayMarketHistory(const Stock* stocks, int stockCount, const EventDetectorConfig* config,
+                        EventStore* store) {
+    if (!stocks || stockCount < 0 || !store) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for replayMarketHistory");
+        return -1;
+    }
+
+    EventDetectorConfig defaults;
+    if (!config) {
+        initEventDetectorConfig(&defaults);
+        config = &defaults;
+    }
+
+    ReplayContext ctx;
+    ctx.stocks = stocks;
+    ctx.config = config;
+    ctx.results = (ReplayResult*)calloc(stockCount > 0 ? stockCount : 1, sizeof(ReplayResult));
+    if (!ctx.results) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate replay results");
+        return -1;
+    }
+
+    int status = parallelFor(stockCount, 1, replayStockRange, &ctx);
+
+    /* Append serially so the store's order does not depend on thread timing */
+    int added = 0;
+    for (int s = 0; s < stockCount && status == 0; s++) {
+        const ReplayResult* result = &ctx.results[s];
+        if (result->failed) {
+            logError(ERR_OUT_OF_MEMORY, "Out of memory replaying %s", stocks[s].symbol);
+            status = -1;
+            break;
+        }
+
+        for (int k = 0; k < result->count; k++) {
+            const StockData* bar = &stocks[s].data[result->bars[k]];
+            const DetectedSignal* signal = &result->signals[k];
+            char description[EVENT_DESCRIPTION_LENGTH];
+            char date[11];
+
+            describeSignal(stocks[s].symbol, signal, description, sizeof(description));
+            snprintf(date, sizeof(date), "%.10s", bar->date);
+            if (eventStoreAppend(store, stocks[s].symbol, barTimestamp(bar->date), signal->type,
+                                 signalSentiment(signal), signalImpact(signal), signal->magnitude,
+                                 NULL, description, NULL, date) < 0) {
+                status = -1;
+                break;
+            }
+            added++;
+        }
+    }
+
+    for (int s = 0; s < stockCount; s++) {
+        free(ctx.results[s].signals);
+        free(ctx.results[s].bars);
+    }
+    free(ctx.results);
+    return status == 0 ? added : -1;
+}
+
+static int symbolsEqual(const char* a, const char* b) {
+    while (*a && toupper((unsigned char)*a) == toupper((unsigned char)*b)) {
+        a++;
+        b++;
+    }
+    return *a == '\0' && *b == '\0';
+}
+
+/* Sort key ordering detected events newest first */
+typedef struct {
+    time_t timestamp;
+    int index;
+} RecencyKey;
+
+static int compareNewestFirst(const void* a, const void* b) {
+    const RecencyKey* x = (const RecencyKey*)a;
+    const RecencyKey* y = (const RecencyKey*)b;
+    if (x->timestamp != y->timestamp) return x->timestamp > y->timestamp ? -1 : 1;
+    return x->index - y->index;
+}
+
+/* Detect market events across stocks, returning the most recent ones */
+int detectMarketEvents(const Stock* stocks, int stockCount, const EventDatabase* newsEvents,
+                       EventData* detectedEvents, int maxEvents) {
+    if (!stocks || stockCount <= 0 || !detectedEvents || maxEvents <= 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for detectMarketEvents");
+        return -1;
+    }
+
+    EventStore store;
+    if (initEventStore(&store, 0) != 0) {
+        return -1;
+    }
+    if (replayMarketHistory(stocks, stockCount, NULL, &store) < 0) {
+        freeEventStore(&store);
+        return -1;
+    }
+
+    RecencyKey* order = (RecencyKey*)malloc((store.count > 0 ? store.count : 1) * sizeof(RecencyKey));
+    if (!order) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate detected event order");
+        freeEventStore(&store);
+        return -1;
+    }
+    for (int i = 0; i < store.count; i++) {
+        order[i].timestamp = store.records[i].timestamp;
+        order[i].index = i;
+    }
+    qsort(order, store.count, sizeof(RecencyKey), compareNewestFirst);
+
+    int count = store.count < maxEvents ? store.count : maxEvents;
+    for (int i = 0; i < count; i++) {
+        EventData* event = &detectedEvents[i];
+        eventStoreGet(&store, order[i].index, event);
+
+        /* Attach same-day news for the symbol so the move has context */
+        if (!newsEvents) {
+            continue;
+        }
+        for (int n = 0; n < newsEvents->eventCount; n++) {
+            const EventData* news = &newsEvents->events[n];
+            if (symbolsEqual(news->symbol, event->symbol) && strncmp(news->date, event->date, 10) == 0) {
+                size_t used = strlen(event->description);
+                snprintf(event->description + used, sizeof(event->description) - used,
+                         " | News: %s", news->title);
+                snprintf(event->title, sizeof(event->title), "%s", news->title);
+                snprintf(event->url, sizeof(event->url), "%s", news->url);
+                event->sentiment = news->sentiment;
+                if (news->impactScore > event->impactScore) {
+                    event->impactScore = news->impactScore;
+                }
+                break;
+            }
+        }
+    }
+
+    free(order);
+    freeEventStore(&store);
+    return count;
+}
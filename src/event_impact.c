@@ -0,0 +1,472 @@
+/**
+ * Event Impact
+ * Event studies over price histories using a sort-merge join of events to bars
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <ctype.h>
+#include <limits.h>
+
+#include "../include/event_impact.h"
+#include "../include/symbol_table.h"
+#include "../include/time_utils.h"
+#include "../include/parallel.h"
+#include "../include/error_handling.h"
+
+#define SECONDS_PER_DAY 86400LL
+
+/* Day number marking a bar or event whose date could not be parsed */
+#define INVALID_DAY LLONG_MIN
+
+/* One event to join: which stock, which day, where the result goes */
+typedef struct {
+    int stock;
+    int event;
+    long long day;
+} EventKey;
+
+/* Shared state of one study run */
+typedef struct {
+    const Stock* stocks;
+    const EventKey* keys;
+    const int* groupStart;        /* groupStart[g]..groupStart[g + 1] are one stock's keys */
+    const long long* benchDays;
+    const double* benchClose;
+    int benchCount;
+    EventStudyConfig config;
+    EventImpact* impacts;
+    int failed;
+} StudyContext;
+
+/* Prefix sums of the return series of one stock over bars [0, k) */
+typedef struct {
+    double* r;
+    double* m;
+    double* rr;
+    double* mm;
+    double* rm;
+} ReturnSums;
+
+/* Fill a config with defaults */
+void initEventStudyConfig(EventStudyConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    config->preWindow = 5;
+    config->postWindow = 5;
+    config->estimationWindow = 120;
+    config->estimationGap = 10;
+    config->model = EVENT_MODEL_MARKET;
+}
+
+/* Day number of a bar date ("YYYY-MM-DD" with or without a time part) */
+static long long dateToDay(const char* date) {
+    char datePart[11];
+    time_t timestamp;
+
+    if (!date || strlen(date) < 10) {
+        return INVALID_DAY;
+    }
+    memcpy(datePart, date, 10);
+    datePart[10] = '\0';
+    if (parseISO8601Timestamp(datePart, &timestamp, NULL) != 0) {
+        return INVALID_DAY;
+    }
+    return (long long)timestamp / SECONDS_PER_DAY;
+}
+
+/* Day number of a timestamp, rounding toward negative infinity */
+static long long timestampToDay(time_t timestamp) {
+    long long t = (long long)timestamp;
+    return t >= 0 ? t / SECONDS_PER_DAY : -((-t + SECONDS_PER_DAY - 1) / SECONDS_PER_DAY);
+}
+
+static double barPrice(const StockData* bar) {
+    return bar->adjClose > 0.0 ? bar->adjClose : bar->close;
+}
+
+static int compareEventKeys(const void* a, const void* b) {
+    const EventKey* x = (const EventKey*)a;
+    const EventKey* y = (const EventKey*)b;
+    if (x->stock != y->stock) return x->stock < y->stock ? -1 : 1;
+    if (x->day != y->day) return x->day < y->day ? -1 : 1;
+    return (x->event > y->event) - (x->event < y->event);
+}
+
+/* Abnormal-return sum over bars [a, b) under fitted alpha and beta */
+static double abnormalSum(const ReturnSums* s, int a, int b, double alpha, double beta) {
+    return (s->r[b] - s->r[a]) - alpha * (b - a) - beta * (s->m[b] - s->m[a]);
+}
+
+/* Fit the normal-return model on [a, b) and fill the impact of an event at bar t */
+static void measureEvent(const ReturnSums* s, int barCount, int t, const EventStudyConfig* config,
+                         EventImpact* impact) {
+    impact->barIndex = t;
+
+    /* Bar 0 has no return, so every window must start at bar 1 or later */
+    if (t >= barCount || t - config->preWindow < 1 || t + config->postWindow >= barCount) {
+        return;
+    }
+
+    int estEnd = t - config->estimationGap;
+    int estStart = estEnd - config->estimationWindow;
+    if (estStart < 1) estStart = 1;
+    int n = estEnd - estStart;
+
+    double alpha = 0.0, beta = 0.0, sigma = 0.0;
+    if (config->model == EVENT_MODEL_MARKET) {
+        if (n < MIN_ESTIMATION_BARS) {
+            return;
+        }
+        double meanR = (s->r[estEnd] - s->r[estStart]) / n;
+        double meanM = (s->m[estEnd] - s->m[estStart]) / n;
+        double sxx = (s->mm[estEnd] - s->mm[estStart]) - n * meanM * meanM;
+        double sxy = (s->rm[estEnd] - s->rm[estStart]) - n * meanR * meanM;
+        double syy = (s->rr[estEnd] - s->rr[estStart]) - n * meanR * meanR;
+        beta = sxx > 1e-12 ? sxy / sxx : 0.0;
+        alpha = meanR - beta * meanM;
+        double sse = syy - beta * sxy;
+        sigma = sse > 0.0 ? sqrt(sse / (n - 2)) : 0.0;
+    } else if (n >= 2) {
+        /* Variance of r - beta * m with beta fixed at 1 or 0 */
+        beta = config->model == EVENT_MODEL_MARKET_ADJUSTED ? 1.0 : 0.0;
+        double sum = (s->r[estEnd] - s->r[estStart]) - beta * (s->m[estEnd] - s->m[estStart]);
+        double sumSq = (s->rr[estEnd] - s->rr[estStart])
+                     - 2.0 * beta * (s->rm[estEnd] - s->rm[estStart])
+                     + beta * beta * (s->mm[estEnd] - s->mm[estStart]);
+        double variance = (sumSq - sum * sum / n) / (n - 1);
+        sigma = variance > 0.0 ? sqrt(variance) : 0.0;
+    } else {
+        beta = config->model == EVENT_MODEL_MARKET_ADJUSTED ? 1.0 : 0.0;
+    }
+
+    impact->valid = 1;
+    impact->alpha = alpha;
+    impact->beta = beta;
+    impact->sigma = sigma;
+    impact->eventReturn = abnormalSum(s, t, t + 1, alpha, beta);
+    impact->preCAR = abnormalSum(s, t - config->preWindow, t, alpha, beta);
+    impact->postCAR = abnormalSum(s, t, t + config->postWindow + 1, alpha, beta);
+    impact->tStat = sigma > 0.0 ? impact->postCAR / (sigma * sqrt(config->postWindow + 1.0)) : 0.0;
+}
+
+/* Build one stock's return sums and merge-join its events against its bars */
+static int studyGroup(StudyContext* ctx, int group) {
+    int first = ctx->groupStart[group];
+    int last = ctx->groupStart[group + 1];
+    const Stock* stock = &ctx->stocks[ctx->keys[first].stock];
+    int n = stock->dataSize;
+
+    long long* days = (long long*)malloc((n > 0 ? n : 1) * sizeof(long long));
+    double* block = (double*)malloc(5 * (size_t)(n + 1) * sizeof(double));
+    if (!days || !block) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate event study series for %s", stock->symbol);
+        free(days);
+        free(block);
+        return -1;
+    }
+
+    ReturnSums sums;
+    sums.r = block;
+    sums.m = block + (n + 1);
+    sums.rr = block + 2 * (n + 1);
+    sums.mm = block + 3 * (n + 1);
+    sums.rm = block + 4 * (n + 1);
+    sums.r[0] = sums.m[0] = sums.rr[0] = sums.mm[0] = sums.rm[0] = 0.0;
+
+    /* Align the benchmark by date: j tracks the last benchmark bar on or before each stock bar */
+    int j = -1;
+    double previousBench = 0.0;
+    for (int i = 0; i < n; i++) {
+        days[i] = dateToDay(stock->data[i].date);
+
+        double r = 0.0;
+        if (i > 0) {
+            double previous = barPrice(&stock->data[i - 1]);
+            r = previous > 0.0 ? barPrice(&stock->data[i]) / previous - 1.0 : 0.0;
+        }
+
+        double bench = 0.0;
+        while (j + 1 < ctx->benchCount && ctx->benchDays[j + 1] <= days[i]) {
+            j++;
+        }
+        if (j >= 0) {
+            bench = ctx->benchClose[j];
+        }
+        double m = (i > 0 && previousBench > 0.0 && bench > 0.0) ? bench / previousBench - 1.0 : 0.0;
+        previousBench = bench;
+
+        sums.r[i + 1] = sums.r[i] + r;
+        sums.m[i + 1] = sums.m[i] + m;
+        sums.rr[i + 1] = sums.rr[i] + r * r;
+        sums.mm[i + 1] = sums.mm[i] + m * m;
+        sums.rm[i + 1] = sums.rm[i] + r * m;
+    }
+
+    /* Events are sorted by day, so the bar cursor only moves forward */
+    int bar = 0;
+    for (int k = first; k < last; k++) {
+        const EventKey* key = &ctx->keys[k];
+        while (bar < n && days[bar] < key->day) {
+            bar++;
+        }
+        measureEvent(&sums, n, bar, &ctx->config, &ctx->impacts[key->event]);
+    }
+
+    free(days);
+    free(block);
+    return 0;
+}
+
+static void studyGroupRange(int begin, int end, void* context) {
+    StudyContext* ctx = (StudyContext*)context;
+    for (int g = begin; g < end; g++) {
+        if (studyGroup(ctx, g) != 0) {
+            ctx->failed = 1;
+        }
+    }
+}
+
+/* Sort the keys, group them by stock and study every group */
+static int runStudy(EventKey* keys, int keyCount, const Stock* stocks, const Stock* benchmark,
+                    const EventStudyConfig* config, EventImpact* impacts) {
+    StudyContext ctx;
+    memset(&ctx, 0, sizeof(StudyContext));
+    if (config) {
+        ctx.config = *config;
+    } else {
+        initEventStudyConfig(&ctx.config);
+    }
+    if (ctx.config.preWindow < 0 || ctx.config.postWindow < 0 ||
+        ctx.config.estimationWindow < 0 || ctx.config.estimationGap < 0) {
+        logError(ERR_INVALID_PARAMETER, "Event study windows must not be negative");
+        return -1;
+    }
+    if (!benchmark || benchmark->dataSize == 0) {
+        ctx.config.model = EVENT_MODEL_RAW;
+    }
+
+    qsort(keys, keyCount, sizeof(EventKey), compareEventKeys);
+
+    int* groupStart = (int*)malloc((keyCount + 1) * sizeof(int));
+    long long* benchDays = NULL;
+    double* benchClose = NULL;
+    if (!groupStart) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate event study groups");
+        return -1;
+    }
+
+    int groupCount = 0;
+    for (int k = 0; k < keyCount; k++) {
+        if (k == 0 || keys[k].stock != keys[k - 1].stock) {
+            groupStart[groupCount++] = k;
+        }
+    }
+    groupStart[groupCount] = keyCount;
+
+    if (ctx.config.model != EVENT_MODEL_RAW) {
+        benchDays = (long long*)malloc(benchmark->dataSize * sizeof(long long));
+        benchClose = (double*)malloc(benchmark->dataSize * sizeof(double));
+        if (!benchDays || !benchClose) {
+            logError(ERR_OUT_OF_MEMORY, "Failed to allocate benchmark series");
+            free(groupStart);
+            free(benchDays);
+            free(benchClose);
+            return -1;
+        }
+        for (int i = 0; i < benchmark->dataSize; i++) {
+            benchDays[i] = dateToDay(benchmark->data[i].date);
+            benchClose[i] = barPrice(&benchmark->data[i]);
+        }
+        ctx.benchCount = benchmark->dataSize;
+    }
+
+    ctx.stocks = stocks;
+    ctx.keys = keys;
+    ctx.groupStart = groupStart;
+    ctx.benchDays = benchDays;
+    ctx.benchClose = benchClose;
+    ctx.impacts = impacts;
+
+    int status = parallelFor(groupCount, 1, studyGroupRange, &ctx);
+
+    free(groupStart);
+    free(benchDays);
+    free(benchClose);
+
+    if (status != 0 || ctx.failed) {
+        return -1;
+    }
+
+    int valid = 0;
+    for (int k = 0; k < keyCount; k++) {
+        valid += impacts[keys[k].event].valid;
+    }
+    return valid;
+}
+
+/* Map stock symbols to indices through a symbol table */
+static int buildStockLookup(const Stock* stocks, int stockCount, SymbolTable* table, int** stockOfId) {
+    if (initSymbolTable(table, stockCount) != 0) {
+        return -1;
+    }
+
+    *stockOfId = (int*)malloc((stockCount > 0 ? stockCount : 1) * sizeof(int));
+    if (!*stockOfId) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate stock lookup");
+        freeSymbolTable(table);
+        return -1;
+    }
+
+    for (int i = 0; i < stockCount; i++) {
+        int id = internSymbol(table, stocks[i].symbol);
+        if (id >= 0) {
+            (*stockOfId)[id] = i;
+        }
+    }
+    return 0;
+}
+
+static void clearImpact(EventImpact* impact) {
+    memset(impact, 0, sizeof(EventImpact));
+    impact->stockIndex = -1;
+    impact->barIndex = -1;
+}
+
+/* Run an event study over every event of an EventStore */
+int runEventStudy(const EventStore* store, const Stock* stocks, int stockCount,
+                  const Stock* benchmark, const EventStudyConfig* config, EventImpact* impacts) {
+    if (!store || !stocks || stockCount < 0 || !impacts) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for runEventStudy");
+        return -1;
+    }
+
+    SymbolTable table;
+    int* stockOfId = NULL;
+    if (buildStockLookup(stocks, stockCount, &table, &stockOfId) != 0) {
+        return -1;
+    }
+
+    /* Resolve each store symbol once rather than once per event */
+    int symbolCount = store->symbols.count;
+    int* stockOfSymbol = (int*)malloc((symbolCount > 0 ? symbolCount : 1) * sizeof(int));
+    EventKey* keys = (EventKey*)malloc((store->count > 0 ? store->count : 1) * sizeof(EventKey));
+    if (!stockOfSymbol || !keys) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate event study keys");
+        free(stockOfSymbol);
+        free(keys);
+        free(stockOfId);
+        freeSymbolTable(&table);
+        return -1;
+    }
+
+    for (int s = 0; s < symbolCount; s++) {
+        int id = findSymbol(&table, symbolName(&store->symbols, s));
+        stockOfSymbol[s] = id == INVALID_SYMBOL_ID ? -1 : stockOfId[id];
+    }
+
+    int keyCount = 0;
+    for (int e = 0; e < store->count; e++) {
+        const EventRecord* record = &store->records[e];
+        clearImpact(&impacts[e]);
+        int stock = record->symbolId == INVALID_SYMBOL_ID ? -1 : stockOfSymbol[record->symbolId];
+        if (stock < 0) {
+            continue;
+        }
+        impacts[e].stockIndex = stock;
+        keys[keyCount].stock = stock;
+        keys[keyCount].event = e;
+        keys[keyCount].day = timestampToDay(record->timestamp);
+        keyCount++;
+    }
+
+    int result = runStudy(keys, keyCount, stocks, benchmark, config, impacts);
+
+    free(stockOfSymbol);
+    free(keys);
+    free(stockOfId);
+    freeSymbolTable(&table);
+    return result;
+}
+
+/* Run an event study over an array of EventData records */
+int runEventStudyOnEvents(const EventData* events, int eventCount, const Stock* stocks, int stockCount,
+                          const Stock* benchmark, const EventStudyConfig* config, EventImpact* impacts) {
+    if (!events || eventCount < 0 || !stocks || stockCount < 0 || !impacts) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for runEventStudyOnEvents");
+        return -1;
+    }
+
+    SymbolTable table;
+    int* stockOfId = NULL;
+    if (buildStockLookup(stocks, stockCount, &table, &stockOfId) != 0) {
+        return -1;
+    }
+
+    EventKey* keys = (EventKey*)malloc((eventCount > 0 ? eventCount : 1) * sizeof(EventKey));
+    if (!keys) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate event study keys");
+        free(stockOfId);
+        freeSymbolTable(&table);
+        return -1;
+    }
+
+    int keyCount = 0;
+    for (int e = 0; e < eventCount; e++) {
+        clearImpact(&impacts[e]);
+        int id = findSymbol(&table, events[e].symbol);
+        long long day = events[e].timestamp ? timestampToDay(events[e].timestamp)
+                                             : dateToDay(events[e].date);
+        if (id == INVALID_SYMBOL_ID || day == INVALID_DAY) {
+            continue;
+        }
+        impacts[e].stockIndex = stockOfId[id];
+        keys[keyCount].stock = stockOfId[id];
+        keys[keyCount].event = e;
+        keys[keyCount].day = day;
+        keyCount++;
+    }
+
+    int result = runStudy(keys, keyCount, stocks, benchmark, config, impacts);
+
+    free(keys);
+    free(stockOfId);
+    freeSymbolTable(&table);
+    return result;
+}
+
+/* Post-event cumulative abnormal return of one event, in percent */
+double calculateEventImpact(const EventData* event, const Stock* stocks, int stockCount) {
+    if (!event || !stocks || stockCount <= 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for calculateEventImpact");
+        return 0.0;
+    }
+
+    /* Use the benchmark when the caller loaded one, unless the event is about it */
+    const Stock* benchmark = NULL;
+    for (int i = 0; i < stockCount; i++) {
+        const char* a = stocks[i].symbol;
+        const char* b = DEFAULT_BENCHMARK_SYMBOL;
+        while (*a && toupper((unsigned char)*a) == *b) {
+            a++;
+            b++;
+        }
+        if (*a == '\0' && *b == '\0') {
+            benchmark = &stocks[i];
+            break;
+        }
+    }
+    if (benchmark && strcmp(benchmark->symbol, event->symbol) == 0) {
+        benchmark = NULL;
+    }
+
+    EventImpact impact;
+    if (runEventStudyOnEvents(event, 1, stocks, stockCount, benchmark, NULL, &impact) <= 0) {
+        return 0.0;
+    }
+    return impact.postCAR * 100.0;
+}
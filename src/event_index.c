@@ -0,0 +1,632 @@
+/**
+ * Event Index
+ * Inverted index with compressed posting lists for selective event lookups
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <limits.h>
+
+#include "../include/event_index.h"
+#include "../include/error_handling.h"
+
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME 16777619u
+
+/* Terms shorter than this are not indexed */
+#define MIN_TERM_LENGTH 3
+
+/* Id returned by exhausted cursors; larger than any event id */
+#define END_OF_POSTINGS INT_MAX
+
+/* ------------------------------------------------------------------------ */
+/* Posting lists                                                             */
+/* ------------------------------------------------------------------------ */
+
+static void freePostingList(PostingList* list) {
+    free(list->bytes);
+    free(list->skips);
+    memset(list, 0, sizeof(PostingList));
+}
+
+/* Append an id larger than every id already in the list */
+static int appendPosting(PostingList* list, int id) {
+    if (list->idCount > 0 && id <= list->lastId) {
+        return 0;
+    }
+
+    /* A varint of a 31-bit delta takes at most 5 bytes */
+    if (list->byteCount + 5 > list->byteCapacity) {
+        int newCapacity = list->byteCapacity ? list->byteCapacity * 2 : 16;
+        unsigned char* newBytes = (unsigned char*)realloc(list->bytes, newCapacity);
+        if (!newBytes) {
+            logError(ERR_OUT_OF_MEMORY, "Failed to grow posting list");
+            return -1;
+        }
+        list->bytes = newBytes;
+        list->byteCapacity = newCapacity;
+    }
+
+    if (list->idCount % POSTING_BLOCK_SIZE == 0) {
+        if (list->skipCount == list->skipCapacity) {
+            int newCapacity = list->skipCapacity ? list->skipCapacity * 2 : 2;
+            PostingSkip* newSkips = (PostingSkip*)realloc(list->skips, newCapacity * sizeof(PostingSkip));
+            if (!newSkips) {
+                logError(ERR_OUT_OF_MEMORY, "Failed to grow posting skip table");
+                return -1;
+            }
+            list->skips = newSkips;
+            list->skipCapacity = newCapacity;
+        }
+        PostingSkip* skip = &list->skips[list->skipCount++];
+        skip->baseId = list->idCount ? list->lastId : -1;
+        skip->byteOffset = list->byteCount;
+    }
+
+    unsigned int delta = (unsigned int)(id - (list->idCount ? list->lastId : -1));
+    while (delta >= 0x80) {
+        list->bytes[list->byteCount++] = (unsigned char)(delta | 0x80);
+        delta >>= 7;
+    }
+    list->bytes[list->byteCount++] = (unsigned char)delta;
+
+    list->skips[list->skipCount - 1].maxId = id;
+    list->lastId = id;
+    list->idCount++;
+    return 0;
+}
+
+/**
+ * Forward cursor over either a posting list or a plain sorted id array
+ */
+typedef struct {
+    const PostingList* list;
+    const int* ids;
+    int idCount;
+    int block;                    /* Current block (posting lists) */
+    int pos;                      /* Byte offset (lists) or array index (arrays) */
+    int end;                      /* Byte offset where the current block ends */
+    int id;                       /* Current id, -1 before the first advance */
+} PostingCursor;
+
+static void openListCursor(PostingCursor* cursor, const PostingList* list) {
+    memset(cursor, 0, sizeof(PostingCursor));
+    cursor->list = list;
+    cursor->block = -1;
+    cursor->id = -1;
+}
+
+static void openArrayCursor(PostingCursor* cursor, const int* ids, int count) {
+    memset(cursor, 0, sizeof(PostingCursor));
+    cursor->ids = ids;
+    cursor->idCount = count;
+    cursor->pos = -1;
+    cursor->id = -1;
+}
+
+static int cursorLength(const PostingCursor* cursor) {
+    return cursor->list ? cursor->list->idCount : cursor->idCount;
+}
+
+/* Position a list cursor at the start of a block */
+static void enterBlock(PostingCursor* cursor, int block) {
+    const PostingList* list = cursor->list;
+    cursor->block = block;
+    cursor->pos = list->skips[block].byteOffset;
+    cursor->end = block + 1 < list->skipCount ? list->skips[block + 1].byteOffset : list->byteCount;
+    cursor->id = list->skips[block].baseId;
+}
+
+/* Move to the first id >= target and return it, or END_OF_POSTINGS */
+static int advanceCursor(PostingCursor* cursor, int target) {
+    if (cursor->id >= target) {
+        return cursor->id;
+    }
+
+    if (cursor->ids) {
+        /* Gallop forward, then binary search the bracketed range */
+        int low = cursor->pos + 1;
+        int step = 1;
+        int high = low;
+        while (high < cursor->idCount && cursor->ids[high] < target) {
+            low = high + 1;
+            high += step;
+            step *= 2;
+        }
+        if (high > cursor->idCount) {
+            high = cursor->idCount;
+        }
+        while (low < high) {
+            int mid = low + (high - low) / 2;
+            if (cursor->ids[mid] < target) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        cursor->pos = low;
+        cursor->id = low < cursor->idCount ? cursor->ids[low] : END_OF_POSTINGS;
+        return cursor->id;
+    }
+
+    const PostingList* list = cursor->list;
+    if (cursor->block < 0 || list->skips[cursor->block].maxId < target) {
+        /* Gallop over the skip table to the first block that can hold target */
+        int low = cursor->block + 1;
+        int step = 1;
+        int high = low;
+        while (high < list->skipCount && list->skips[high].maxId < target) {
+            low = high + 1;
+            high += step;
+            step *= 2;
+        }
+        if (high > list->skipCount) {
+            high = list->skipCount;
+        }
+        while (low < high) {
+            int mid = low + (high - low) / 2;
+            if (list->skips[mid].maxId < target) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        if (low >= list->skipCount) {
+            cursor->block = list->skipCount;
+            cursor->id = END_OF_POSTINGS;
+            return cursor->id;
+        }
+        enterBlock(cursor, low);
+    }
+
+    /* The block's maxId is >= target, so decoding stops inside it */
+    while (cursor->id < target) {
+        unsigned int delta = 0;
+        int shift = 0;
+        unsigned char byte;
+        do {
+            byte = list->bytes[cursor->pos++];
+            delta |= (unsigned int)(byte & 0x7F) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        cursor->id += (int)delta;
+    }
+    return cursor->id;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Key dictionary                                                            */
+/* ------------------------------------------------------------------------ */
+
+static unsigned int hashKey(IndexKeyKind kind, long long value, const char* term, int termLength) {
+    unsigned int hash = FNV_OFFSET_BASIS ^ (unsigned int)kind;
+    if (term) {
+        for (int i = 0; i < termLength; i++) {
+            hash = (hash ^ (unsigned char)term[i]) * FNV_PRIME;
+        }
+    } else {
+        unsigned long long v = (unsigned long long)value;
+        for (int i = 0; i < 8; i++) {
+            hash = (hash ^ (unsigned int)(v & 0xFF)) * FNV_PRIME;
+            v >>= 8;
+        }
+    }
+    return hash ? hash : 1;
+}
+
+/* Return the slot holding the key, or the empty slot where it belongs */
+static int probeKey(const EventIndex* index, IndexKeyKind kind, long long value,
+                    const char* term, int termLength, unsigned int hash) {
+    int mask = index->slotCapacity - 1;
+    int slot = (int)(hash & (unsigned int)mask);
+
+    while (index->slots[slot] != 0) {
+        const IndexEntry* entry = &index->entries[index->slots[slot] - 1];
+        if (entry->hash == hash && entry->kind == kind) {
+            if (term) {
+                const char* stored = arenaString(&index->terms, entry->termOffset);
+                if ((int)strlen(stored) == termLength && memcmp(stored, term, termLength) == 0) {
+                    break;
+                }
+            } else if (entry->value == value) {
+                break;
+            }
+        }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+static const PostingList* findPostings(const EventIndex* index, IndexKeyKind kind, long long value,
+                                       const char* term, int termLength) {
+    unsigned int hash = hashKey(kind, value, term, termLength);
+    int slot = probeKey(index, kind, value, term, termLength, hash);
+    return index->slots[slot] ? &index->entries[index->slots[slot] - 1].postings : NULL;
+}
+
+static int growSlots(EventIndex* index) {
+    int newCapacity = index->slotCapacity * 2;
+    int* newSlots = (int*)calloc(newCapacity, sizeof(int));
+    if (!newSlots) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to grow event index to %d slots", newCapacity);
+        return -1;
+    }
+
+    free(index->slots);
+    index->slots = newSlots;
+    index->slotCapacity = newCapacity;
+
+    int mask = newCapacity - 1;
+    for (int i = 0; i < index->entryCount; i++) {
+        int slot = (int)(index->entries[i].hash & (unsigned int)mask);
+        while (index->slots[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        index->slots[slot] = i + 1;
+    }
+    return 0;
+}
+
+/* Find or create the posting list for a key and append an event id */
+static int addPosting(EventIndex* index, IndexKeyKind kind, long long value,
+                      const char* term, int termLength, int eventId) {
+    unsigned int hash = hashKey(kind, value, term, termLength);
+    int slot = probeKey(index, kind, value, term, termLength, hash);
+
+    if (index->slots[slot] == 0) {
+        if ((index->entryCount + 1) * 2 > index->slotCapacity) {
+            if (growSlots(index) != 0) {
+                return -1;
+            }
+            slot = probeKey(index, kind, value, term, termLength, hash);
+        }
+
+        if (index->entryCount == index->entryCapacity) {
+            int newCapacity = index->entryCapacity * 2;
+            IndexEntry* newEntries = (IndexEntry*)realloc(index->entries, newCapacity * sizeof(IndexEntry));
+            if (!newEntries) {
+                logError(ERR_OUT_OF_MEMORY, "Failed to grow event index to %d keys", newCapacity);
+                return -1;
+            }
+            index->entries = newEntries;
+            index->entryCapacity = newCapacity;
+        }
+
+        IndexEntry* entry = &index->entries[index->entryCount];
+        memset(entry, 0, sizeof(IndexEntry));
+        entry->hash = hash;
+        entry->kind = (unsigned char)kind;
+        entry->value = value;
+        if (term) {
+            entry->termOffset = arenaAppend(&index->terms, term, termLength);
+            if (entry->termOffset == ARENA_INVALID_OFFSET) {
+                return -1;
+            }
+        }
+        index->slots[slot] = ++index->entryCount;
+    }
+
+    return appendPosting(&index->entries[index->slots[slot] - 1].postings, eventId);
+}
+
+/* Day bucket of a timestamp, rounding toward negative infinity */
+static long long dayOf(time_t timestamp) {
+    long long t = (long long)timestamp;
+    return t >= 0 ? t / INDEX_DAY_SECONDS : -((-t + INDEX_DAY_SECONDS - 1) / INDEX_DAY_SECONDS);
+}
+
+/* Stem and index every word of a text */
+static int indexText(EventIndex* index, const char* text, int eventId) {
+    const unsigned char* p = (const unsigned char*)text;
+    char word[MAX_STEM_WORD_LENGTH];
+    char stem[MAX_STEM_WORD_LENGTH];
+
+    while (*p) {
+        while (*p && !isalpha(*p)) {
+            p++;
+        }
+
+        int length = 0;
+        int overflow = 0;
+        while (*p && isalpha(*p)) {
+            if (length < MAX_STEM_WORD_LENGTH - 1) {
+                word[length++] = (char)tolower(*p);
+            } else {
+                overflow = 1;
+            }
+            p++;
+        }
+
+        if (overflow || length < MIN_TERM_LENGTH) {
+            continue;
+        }
+        word[length] = '\0';
+
+        int stemLength = stemWordCached(index->stemCache, word, length, stem);
+        if (addPosting(index, INDEX_KEY_TERM, 0, stem, stemLength, eventId) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Fold and stem a query word the same way indexed text is */
+static int stemQueryTerm(const char* term, char* stem) {
+    char word[MAX_STEM_WORD_LENGTH];
+    int length = 0;
+    for (const char* c = term; c && *c && length < MAX_STEM_WORD_LENGTH - 1; c++) {
+        word[length++] = (char)tolower((unsigned char)*c);
+    }
+    word[length] = '\0';
+    return stemWordCached(NULL, word, length, stem);
+}
+
+/* ------------------------------------------------------------------------ */
+/* Public API                                                                */
+/* ------------------------------------------------------------------------ */
+
+/* Initialize an empty index over an event store */
+int initEventIndex(EventIndex* index, const EventStore* store) {
+    if (!index || !store) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for initEventIndex");
+        return -1;
+    }
+
+    memset(index, 0, sizeof(EventIndex));
+    index->store = store;
+    index->entryCapacity = 256;
+    index->slotCapacity = 512;
+    index->entries = (IndexEntry*)malloc(index->entryCapacity * sizeof(IndexEntry));
+    index->slots = (int*)calloc(index->slotCapacity, sizeof(int));
+    index->stemCache = (StemCache*)malloc(sizeof(StemCache));
+
+    if (!index->entries || !index->slots || !index->stemCache ||
+        initStringArena(&index->terms, 0) != 0) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate event index");
+        freeEventIndex(index);
+        return -1;
+    }
+
+    initStemCache(index->stemCache);
+    return 0;
+}
+
+/* Free memory used by an index */
+void freeEventIndex(EventIndex* index) {
+    if (!index) {
+        return;
+    }
+
+    for (int i = 0; i < index->entryCount; i++) {
+        freePostingList(&index->entries[i].postings);
+    }
+    free(index->entries);
+    free(index->slots);
+    free(index->stemCache);
+    freeStringArena(&index->terms);
+    memset(index, 0, sizeof(EventIndex));
+}
+
+/* Index every store event added since the last update */
+int updateEventIndex(EventIndex* index) {
+    if (!index || !index->store) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for updateEventIndex");
+        return -1;
+    }
+
+    const EventStore* store = index->store;
+    int first = index->indexedCount;
+
+    for (int id = first; id < store->count; id++) {
+        const EventRecord* record = &store->records[id];
+
+        if (record->symbolId != INVALID_SYMBOL_ID &&
+            addPosting(index, INDEX_KEY_SYMBOL, record->symbolId, NULL, 0, id) != 0) {
+            return -1;
+        }
+        if (addPosting(index, INDEX_KEY_DAY, dayOf(record->timestamp), NULL, 0, id) != 0) {
+            return -1;
+        }
+        if (indexText(index, eventStoreTitle(store, id), id) != 0 ||
+            indexText(index, eventStoreDescription(store, id), id) != 0) {
+            return -1;
+        }
+        index->indexedCount = id + 1;
+    }
+
+    return index->indexedCount - first;
+}
+
+static int compareInts(const void* a, const void* b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+/* Total postings of the day lists in [firstDay, lastDay] */
+static int countDayRange(const EventIndex* index, long long firstDay, long long lastDay) {
+    int total = 0;
+    for (long long day = firstDay; day <= lastDay; day++) {
+        const PostingList* list = findPostings(index, INDEX_KEY_DAY, day, NULL, 0);
+        if (list) {
+            total += list->idCount;
+        }
+    }
+    return total;
+}
+
+/* Collect the sorted, distinct ids of every day list in [firstDay, lastDay] */
+static int collectDayRange(const EventIndex* index, long long firstDay, long long lastDay,
+                           int total, int** idsOut) {
+    int* ids = (int*)malloc((total > 0 ? total : 1) * sizeof(int));
+    if (!ids) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate %d day postings", total);
+        return -1;
+    }
+
+    int count = 0;
+    for (long long day = firstDay; day <= lastDay; day++) {
+        const PostingList* list = findPostings(index, INDEX_KEY_DAY, day, NULL, 0);
+        if (!list) {
+            continue;
+        }
+        PostingCursor cursor;
+        openListCursor(&cursor, list);
+        for (int id = advanceCursor(&cursor, 0); id != END_OF_POSTINGS; id = advanceCursor(&cursor, id + 1)) {
+            ids[count++] = id;
+        }
+    }
+
+    /* Each event has one day, so the lists are disjoint and only need sorting */
+    qsort(ids, count, sizeof(int), compareInts);
+    *idsOut = ids;
+    return count;
+}
+
+/* Find events matching a query */
+int queryEventIndex(const EventIndex* index, const EventQuery* query, int* results, int maxResults) {
+    if (!index || !query || !results || maxResults < 0 || query->termCount < 0 ||
+        query->termCount > MAX_QUERY_TERMS) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for queryEventIndex");
+        return -1;
+    }
+
+    int hasRange = query->startTime != 0 || query->endTime != 0;
+    if (!query->symbol && query->termCount == 0 && !hasRange) {
+        logError(ERR_INVALID_PARAMETER, "Event index query needs at least one condition");
+        return -1;
+    }
+
+    PostingCursor cursors[MAX_QUERY_TERMS + 2];
+    int cursorCount = 0;
+
+    if (query->symbol) {
+        int symbolId = findSymbol(&index->store->symbols, query->symbol);
+        const PostingList* list = symbolId == INVALID_SYMBOL_ID ? NULL :
+                                  findPostings(index, INDEX_KEY_SYMBOL, symbolId, NULL, 0);
+        if (!list) {
+            return 0;
+        }
+        openListCursor(&cursors[cursorCount++], list);
+    }
+
+    for (int t = 0; t < query->termCount; t++) {
+        char stem[MAX_STEM_WORD_LENGTH];
+        int stemLength = stemQueryTerm(query->terms[t], stem);
+        const PostingList* list = findPostings(index, INDEX_KEY_TERM, 0, stem, stemLength);
+        if (!list) {
+            return 0;
+        }
+        openListCursor(&cursors[cursorCount++], list);
+    }
+
+    int* dayIds = NULL;
+    if (hasRange) {
+        long long firstDay, lastDay;
+        if (query->startTime) {
+            firstDay = dayOf(query->startTime);
+        } else {
+            firstDay = LLONG_MAX;
+            for (int i = 0; i < index->entryCount; i++) {
+                if (index->entries[i].kind == INDEX_KEY_DAY && index->entries[i].value < firstDay) {
+                    firstDay = index->entries[i].value;
+                }
+            }
+        }
+        if (query->endTime) {
+            lastDay = dayOf(query->endTime - 1);
+        } else {
+            lastDay = LLONG_MIN;
+            for (int i = 0; i < index->entryCount; i++) {
+                if (index->entries[i].kind == INDEX_KEY_DAY && index->entries[i].value > lastDay) {
+                    lastDay = index->entries[i].value;
+                }
+            }
+        }
+        if (firstDay > lastDay) {
+            return 0;
+        }
+
+        /* Merging the day lists only pays off when the range is the most
+           selective condition; otherwise the exact time check below filters */
+        int dayTotal = countDayRange(index, firstDay, lastDay);
+        int shortest = INT_MAX;
+        for (int i = 0; i < cursorCount; i++) {
+            if (cursorLength(&cursors[i]) < shortest) {
+                shortest = cursorLength(&cursors[i]);
+            }
+        }
+        if (dayTotal == 0) {
+            return 0;
+        }
+        if (dayTotal < shortest) {
+            int dayCount = collectDayRange(index, firstDay, lastDay, dayTotal, &dayIds);
+            if (dayCount < 0) {
+                return -1;
+            }
+            openArrayCursor(&cursors[cursorCount++], dayIds, dayCount);
+        }
+    }
+
+    /* Drive the intersection from the shortest list */
+    for (int i = 1; i < cursorCount; i++) {
+        if (cursorLength(&cursors[i]) < cursorLength(&cursors[0])) {
+            PostingCursor tmp = cursors[0];
+            cursors[0] = cursors[i];
+            cursors[i] = tmp;
+        }
+    }
+
+    int count = 0;
+    int candidate = advanceCursor(&cursors[0], 0);
+    while (candidate != END_OF_POSTINGS && count < maxResults) {
+        int agreed = 1;
+        for (int i = 1; i < cursorCount; i++) {
+            int id = advanceCursor(&cursors[i], candidate);
+            if (id != candidate) {
+                candidate = advanceCursor(&cursors[0], id);
+                agreed = 0;
+                break;
+            }
+        }
+        if (!agreed) {
+            continue;
+        }
+
+        /* Day buckets are coarse; apply the exact bounds */
+        time_t timestamp = index->store->records[candidate].timestamp;
+        if ((!query->startTime || timestamp >= query->startTime) &&
+            (!query->endTime || timestamp < query->endTime)) {
+            results[count++] = candidate;
+        }
+        candidate = advanceCursor(&cursors[0], candidate + 1);
+    }
+
+    free(dayIds);
+    return count;
+}
+
+/* Number of events whose posting list holds a key */
+int eventIndexKeyCount(const EventIndex* index, IndexKeyKind kind, const char* symbolOrTerm, long long day) {
+    if (!index) {
+        return 0;
+    }
+
+    const PostingList* list = NULL;
+    if (kind == INDEX_KEY_SYMBOL && symbolOrTerm) {
+        int symbolId = findSymbol(&index->store->symbols, symbolOrTerm);
+        if (symbolId != INVALID_SYMBOL_ID) {
+            list = findPostings(index, INDEX_KEY_SYMBOL, symbolId, NULL, 0);
+        }
+    } else if (kind == INDEX_KEY_TERM && symbolOrTerm) {
+        char stem[MAX_STEM_WORD_LENGTH];
+        int stemLength = stemQueryTerm(symbolOrTerm, stem);
+        list = findPostings(index, INDEX_KEY_TERM, 0, stem, stemLength);
+    } else if (kind == INDEX_KEY_DAY) {
+        list = findPostings(index, INDEX_KEY_DAY, day, NULL, 0);
+    }
+
+    return list ? list->idCount : 0;
+}
@@ -0,0 +1,308 @@
+/**
+ * Event Store
+ * Compact append-only event storage backed by a string arena
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/event_store.h"
+#include "../include/error_handling.h"
+
+/* Default number of event slots allocated up front */
+#define DEFAULT_EVENT_CAPACITY 256
+
+/* Average bytes of text per event used to size the arena */
+#define EXPECTED_TEXT_PER_EVENT 256
+
+/* Arena offset of the shared empty string written at initialization */
+#define EMPTY_TEXT_OFFSET 0u
+
+/* Initialize an empty event store */
+int initEventStore(EventStore* store, int expectedEvents) {
+    if (!store) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for initEventStore");
+        return -1;
+    }
+
+    memset(store, 0, sizeof(EventStore));
+    if (expectedEvents <= 0) {
+        expectedEvents = DEFAULT_EVENT_CAPACITY;
+    }
+
+    store->records = (EventRecord*)malloc(expectedEvents * sizeof(EventRecord));
+    store->text = (EventTextRef*)malloc(expectedEvents * sizeof(EventTextRef));
+    if (!store->records || !store->text) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate event store for %d events", expectedEvents);
+        freeEventStore(store);
+        return -1;
+    }
+    store->capacity = expectedEvents;
+
+    unsigned long long arenaSize = (unsigned long long)expectedEvents * EXPECTED_TEXT_PER_EVENT;
+    if (arenaSize > (1u << 30)) {
+        arenaSize = 1u << 30;
+    }
+
+    if (initStringArena(&store->arena, (unsigned int)arenaSize) != 0 ||
+        initSymbolTable(&store->symbols, 64) != 0) {
+        freeEventStore(store);
+        return -1;
+    }
+
+    /* Every missing or empty string shares this entry */
+    arenaAppend(&store->arena, "", 0);
+    return 0;
+}
+
+/* Free memory used by an event store */
+void freeEventStore(EventStore* store) {
+    if (!store) {
+        return;
+    }
+
+    free(store->records);
+    free(store->text);
+    freeStringArena(&store->arena);
+    freeSymbolTable(&store->symbols);
+    memset(store, 0, sizeof(EventStore));
+}
+
+/* Remove all events but keep allocated memory and symbol ids */
+void clearEventStore(EventStore* store) {
+    if (!store) {
+        return;
+    }
+
+    store->count = 0;
+    resetStringArena(&store->arena);
+    arenaAppend(&store->arena, "", 0);
+}
+
+/* Make room for one more event */
+static int reserveEvent(EventStore* store) {
+    if (store->count < store->capacity) {
+        return 0;
+    }
+
+    int newCapacity = store->capacity ? store->capacity * 2 : DEFAULT_EVENT_CAPACITY;
+    EventRecord* newRecords = (EventRecord*)realloc(store->records, newCapacity * sizeof(EventRecord));
+    if (!newRecords) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to grow event store to %d events", newCapacity);
+        return -1;
+    }
+    store->records = newRecords;
+
+    EventTextRef* newText = (EventTextRef*)realloc(store->text, newCapacity * sizeof(EventTextRef));
+    if (!newText) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to grow event store to %d events", newCapacity);
+        return -1;
+    }
+    store->text = newText;
+    store->capacity = newCapacity;
+    return 0;
+}
+
+/* Store a string, sharing the empty entry for NULL and "" */
+static unsigned int storeText(EventStore* store, const char* text) {
+    if (!text || !text[0]) {
+        return EMPTY_TEXT_OFFSET;
+    }
+    return arenaAppend(&store->arena, text, -1);
+}
+
+/* Append an event given its individual fields */
+int eventStoreAppend(EventStore* store, const char* symbol, time_t timestamp, EventType type,
+                     float sentiment, int impactScore, double magnitude,
+                     const char* title, const char* description, const char* url, const char* date) {
+    if (!store || !store->records) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for eventStoreAppend");
+        return -1;
+    }
+
+    if (reserveEvent(store) != 0) {
+        return -1;
+    }
+
+    int symbolId = INVALID_SYMBOL_ID;
+    if (symbol && symbol[0]) {
+        symbolId = internSymbol(&store->symbols, symbol);
+        if (symbolId < 0) {
+            return -1;
+        }
+    }
+
+    /* Roll the arena back if any string fails so no partial event is left */
+    unsigned int arenaMark = store->arena.size;
+    EventTextRef ref;
+    ref.title = storeText(store, title);
+    ref.description = storeText(store, description);
+    ref.url = storeText(store, url);
+    ref.date = storeText(store, date);
+    if (ref.title == ARENA_INVALID_OFFSET || ref.description == ARENA_INVALID_OFFSET ||
+        ref.url == ARENA_INVALID_OFFSET || ref.date == ARENA_INVALID_OFFSET) {
+        store->arena.size = arenaMark;
+        return -1;
+    }
+
+    if (impactScore < -128) impactScore = -128;
+    if (impactScore > 127) impactScore = 127;
+
+    EventRecord* record = &store->records[store->count];
+    record->timestamp = timestamp;
+    record->symbolId = symbolId;
+    record->sentiment = sentiment;
+    record->magnitude = (float)magnitude;
+    record->type = (unsigned char)type;
+    record->impactScore = (signed char)impactScore;
+    store->text[store->count] = ref;
+
+    return store->count++;
+}
+
+/* Append a copy of an EventData record */
+int eventStoreAdd(EventStore* store, const EventData* event) {
+    if (!event) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for eventStoreAdd");
+        return -1;
+    }
+
+    return eventStoreAppend(store, event->symbol, event->timestamp, event->type,
+                            event->sentiment, event->impactScore, event->magnitude,
+                            event->title, event->description, event->url, event->date);
+}
+
+/* Append every event of an EventDatabase */
+int eventStoreImportDatabase(EventStore* store, const EventDatabase* db) {
+    if (!store || !db) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for eventStoreImportDatabase");
+        return -1;
+    }
+
+    for (int i = 0; i < db->eventCount; i++) {
+        if (eventStoreAdd(store, &db->events[i]) < 0) {
+            return -1;
+        }
+    }
+    return db->eventCount;
+}
+
+/* Get the fixed-size fields of an event */
+const EventRecord* eventStoreRecord(const EventStore* store, int index) {
+    if (!store || index < 0 || index >= store->count) {
+        return NULL;
+    }
+    return &store->records[index];
+}
+
+/* Get the symbol of an event */
+const char* eventStoreSymbol(const EventStore* store, int index) {
+    if (!store || index < 0 || index >= store->count) {
+        return "";
+    }
+    return symbolName(&store->symbols, store->records[index].symbolId);
+}
+
+const char* eventStoreTitle(const EventStore* store, int index) {
+    if (!store || index < 0 || index >= store->count) {
+        return "";
+    }
+    return arenaString(&store->arena, store->text[index].title);
+}
+
+const char* eventStoreDescription(const EventStore* store, int index) {
+    if (!store || index < 0 || index >= store->count) {
+        return "";
+    }
+    return arenaString(&store->arena, store->text[index].description);
+}
+
+const char* eventStoreUrl(const EventStore* store, int index) {
+    if (!store || index < 0 || index >= store->count) {
+        return "";
+    }
+    return arenaString(&store->arena, store->text[index].url);
+}
+
+const char* eventStoreDate(const EventStore* store, int index) {
+    if (!store || index < 0 || index >= store->count) {
+        return "";
+    }
+    return arenaString(&store->arena, store->text[index].date);
+}
+
+/* Copy arena text into a fixed buffer, truncating if necessary */
+static void copyText(char* dest, size_t destSize, const char* src) {
+    strncpy(dest, src, destSize - 1);
+    dest[destSize - 1] = '\0';
+}
+
+/* Materialize an event as an EventData record */
+int eventStoreGet(const EventStore* store, int index, EventData* event) {
+    const EventRecord* record = eventStoreRecord(store, index);
+    if (!record || !event) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for eventStoreGet");
+        return -1;
+    }
+
+    memset(event, 0, sizeof(EventData));
+    copyText(event->symbol, sizeof(event->symbol), eventStoreSymbol(store, index));
+    copyText(event->date, sizeof(event->date), eventStoreDate(store, index));
+    copyText(event->description, sizeof(event->description), eventStoreDescription(store, index));
+    copyText(event->title, sizeof(event->title), eventStoreTitle(store, index));
+    copyText(event->url, sizeof(event->url), eventStoreUrl(store, index));
+    event->type = (EventType)record->type;
+    event->magnitude = record->magnitude;
+    event->timestamp = record->timestamp;
+    event->sentiment = record->sentiment;
+    event->impactScore = record->impactScore;
+    return 0;
+}
+
+/* Start iterating over events matching a symbol and time range */
+void eventStoreCursorInit(EventStoreCursor* cursor, const EventStore* store, const char* symbol,
+                          time_t startTime, time_t endTime) {
+    if (!cursor) {
+        return;
+    }
+
+    cursor->store = store;
+    cursor->next = 0;
+    cursor->symbolId = INVALID_SYMBOL_ID;
+    cursor->startTime = startTime;
+    cursor->endTime = endTime;
+
+    if (store && symbol) {
+        cursor->symbolId = findSymbol(&store->symbols, symbol);
+        if (cursor->symbolId == INVALID_SYMBOL_ID) {
+            /* Unknown symbol: nothing can match */
+            cursor->next = store->count;
+        }
+    }
+}
+
+/* Advance a cursor to the next matching event */
+int eventStoreNext(EventStoreCursor* cursor) {
+    if (!cursor || !cursor->store) {
+        return -1;
+    }
+
+    const EventStore* store = cursor->store;
+    while (cursor->next < store->count) {
+        int index = cursor->next++;
+        const EventRecord* record = &store->records[index];
+
+        if (cursor->symbolId != INVALID_SYMBOL_ID && record->symbolId != cursor->symbolId) {
+            continue;
+        }
+        if (cursor->startTime && record->timestamp < cursor->startTime) {
+            continue;
+        }
+        if (cursor->endTime && record->timestamp >= cursor->endTime) {
+            continue;
+        }
+        return index;
+    }
+    return -1;
+}
@@ -0,0 +1,278 @@
+package gui; // Package declaration (Khai báo gói)
+
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.Callable;
+import java.util.concurrent.CancellationException;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.ThreadFactory;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.function.Consumer;
+import javax.swing.SwingUtilities;
+import javax.swing.SwingWorker;
+
+/**
+ * AnalysisExecutor - Runs mining and chart work off the Swing event dispatch thread
+ * AnalysisExecutor - Chạy công việc khai thác dữ liệu và biểu đồ ngoài luồng sự kiện Swing
+ *
+ * A job is a list of steps. Each step computes a result on a background
+ * pool thread and hands it to its consumer on the event dispatch thread
+ * as soon as it finishes, so results appear one detector at a time.
+ * Jobs are keyed by name: starting a job cancels the running job of the
+ * same name, and cancelAll drops everything (for example when new data
+ * is loaded). Results of a cancelled job are never delivered.
+ *
+ * Một công việc là danh sách các bước. Mỗi bước tính kết quả trên luồng nền
+ * và giao kết quả cho luồng sự kiện ngay khi xong, nên kết quả hiện ra lần
+ * lượt theo từng bộ phát hiện. Công việc mới sẽ hủy công việc cùng tên đang
+ * chạy; kết quả của công việc đã hủy không bao giờ được giao.
+ *
+ * All methods except the step bodies must be called on the event
+ * dispatch thread (Mọi phương thức phải được gọi trên luồng sự kiện,
+ * trừ phần thân của các bước).
+ */
+public class AnalysisExecutor {
+
+    /**
+     * Receives progress of running jobs on the event dispatch thread
+     * Nhận tiến trình của các công việc đang chạy trên luồng sự kiện
+     */
+    public interface ProgressListener {
+        /**
+         * @param job Job name (Tên công việc)
+         * @param percent 0-100 (0-100)
+         * @param stage Label of the current step, null once the job ends (Nhãn của bước hiện tại)
+         */
+        void progressChanged(String job, int percent, String stage);
+    }
+
+    /**
+     * Called on the event dispatch thread when a job ends
+     * Được gọi trên luồng sự kiện khi một công việc kết thúc
+     */
+    public interface Completion {
+        /**
+         * @param cancelled True if the job was cancelled (True nếu công việc bị hủy)
+         * @param error Exception thrown by a step, null on success (Ngoại lệ do một bước ném ra)
+         */
+        void finished(boolean cancelled, Exception error);
+    }
+
+    private final ExecutorService pool;
+    private final Map<String, Job> running = new HashMap<>();
+    private ProgressListener progressListener;
+
+    /**
+     * Create an executor whose pool leaves one core to the user interface
+     * Tạo bộ thực thi với nhóm luồng chừa lại một lõi cho giao diện
+     */
+    public AnalysisExecutor() {
+        this(Math.max(1, Runtime.getRuntime().availableProcessors() - 1));
+    }
+
+    /**
+     * @param threads Background threads; jobs with different names run concurrently
+     *                (Số luồng nền; các công việc khác tên chạy đồng thời)
+     */
+    public AnalysisExecutor(int threads) {
+        AtomicInteger counter = new AtomicInteger();
+        ThreadFactory factory = runnable -> {
+            Thread thread = new Thread(runnable, "analysis-" + counter.incrementAndGet());
+            thread.setDaemon(true);
+            thread.setPriority(Thread.NORM_PRIORITY - 1);
+            return thread;
+        };
+        pool = Executors.newFixedThreadPool(threads, factory);
+    }
+
+    public void setProgressListener(ProgressListener listener) {
+        this.progressListener = listener;
+    }
+
+    /**
+     * Create an empty job; add steps, then pass it to start
+     * Tạo công việc rỗng; thêm các bước rồi truyền cho start
+     *
+     * @param name Job name; a new job replaces a running one of the same name
+     */
+    public Job newJob(String name) {
+        return new Job(name);
+    }
+
+    /**
+     * Start a job, cancelling the running job of the same name
+     * Bắt đầu một công việc, hủy công việc cùng tên đang chạy
+     */
+    public void start(Job job) {
+        Job previous = running.put(job.name, job);
+        if (previous != null) {
+            previous.cancel(true);
+        }
+        pool.execute(job);
+    }
+
+    /**
+     * Cancel the running job of a name, if any
+     * Hủy công việc đang chạy theo tên, nếu có
+     */
+    public void cancel(String name) {
+        Job job = running.remove(name);
+        if (job != null) {
+            job.cancel(true);
+        }
+    }
+
+    /**
+     * Cancel every running job
+     * Hủy mọi công việc đang chạy
+     */
+    public void cancelAll() {
+        for (Job job : new ArrayList<>(running.values())) {
+            job.cancel(true);
+        }
+        running.clear();
+    }
+
+    public boolean isRunning(String name) {
+        return running.containsKey(name);
+    }
+
+    /** True when no job is running (True khi không có công việc nào đang chạy) */
+    public boolean isIdle() {
+        return running.isEmpty();
+    }
+
+    /**
+     * Stop the pool threads (Dừng các luồng của nhóm)
+     */
+    public void shutdown() {
+        cancelAll();
+        pool.shutdownNow();
+    }
+
+    private void fireProgress(String job, int percent, String stage) {
+        if (progressListener != null) {
+            progressListener.progressChanged(job, percent, stage);
+        }
+    }
+
+    /**
+     * One step: background work and the consumer of its result
+     */
+    private static final class Step<T> {
+        final String label;
+        final Callable<T> work;
+        final Consumer<T> deliver;
+
+        Step(String label, Callable<T> work, Consumer<T> deliver) {
+            this.label = label;
+            this.work = work;
+            this.deliver = deliver;
+        }
+
+        /** Compute in the background; the returned delivery runs on the EDT */
+        Runnable compute() throws Exception {
+            T result = work.call();
+            return () -> deliver.accept(result);
+        }
+    }
+
+    /**
+     * A named list of steps run in order on one pool thread
+     * Danh sách bước có tên, chạy tuần tự trên một luồng của nhóm
+     *
+     * Deliveries and progress go through SwingUtilities.invokeLater rather
+     * than publish/process, whose coalescing timer can run after done().
+     */
+    public final class Job extends SwingWorker<Void, Void> {
+        private final String name;
+        private final List<Step<?>> steps = new ArrayList<>();
+        private Completion completion;
+
+        private Job(String name) {
+            this.name = name;
+        }
+
+        /**
+         * Add a step
+         * Thêm một bước
+         *
+         * @param label Progress label (Nhãn tiến trình)
+         * @param work Computation run in the background; must not touch Swing components
+         *             (Tính toán chạy nền; không được truy cập thành phần Swing)
+         * @param deliver Receives the result on the event dispatch thread
+         *                (Nhận kết quả trên luồng sự kiện)
+         */
+        public <T> Job step(String label, Callable<T> work, Consumer<T> deliver) {
+            steps.add(new Step<>(label, work, deliver));
+            return this;
+        }
+
+        /**
+         * Set the callback run when the job ends
+         * Đặt hàm gọi lại khi công việc kết thúc
+         */
+        public Job whenDone(Completion completion) {
+            this.completion = completion;
+            return this;
+        }
+
+        public String name() {
+            return name;
+        }
+
+        @Override
+        protected Void doInBackground() throws Exception {
+            int total = steps.size();
+            for (int i = 0; i < total && !isCancelled(); i++) {
+                Step<?> step = steps.get(i);
+                int percent = i * 100 / total;
+                SwingUtilities.invokeLater(() -> {
+                    if (!isCancelled()) {
+                        fireProgress(name, percent, step.label);
+                    }
+                });
+
+                Runnable delivery = step.compute();
+                SwingUtilities.invokeLater(() -> {
+                    if (!isCancelled()) {
+                        delivery.run();
+                    }
+                });
+            }
+            return null;
+        }
+
+        @Override
+        protected void done() {
+            boolean cancelled = isCancelled();
+            if (running.get(name) == this) {
+                running.remove(name);
+            }
+
+            Exception error = null;
+            if (!cancelled) {
+                try {
+                    get();
+                } catch (ExecutionException e) {
+                    Throwable cause = e.getCause();
+                    error = cause instanceof Exception ? (Exception) cause : e;
+                } catch (InterruptedException | CancellationException e) {
+                    cancelled = true;
+                }
+            }
+
+            // A replaced job leaves the progress to its successor
+            if (!running.containsKey(name)) {
+                fireProgress(name, 100, null);
+            }
+            if (completion != null) {
+                completion.finished(cancelled, error);
+            }
+        }
+    }
+}
@@ -0,0 +1,171 @@
+package gui;
+
+/**
+ * Reusable flat result buffers of StockPredictJNIBridge.analyzeAll
+ *
+ * Results are stored as structure-of-arrays columns inside one int[] and
+ * one double[], so a fused analysis crosses JNI with two array copies and
+ * no per-row objects. The offsets mirror AnalysisLayout in
+ * series_session.h: with M = maxResults and K = indicator count,
+ *
+ *   ints:    counts header (4), pattern type/start/end (M each),
+ *            signal type/index/rule (2M each), anomaly index (M)
+ *   doubles: pattern confidence/expected move/level (M each),
+ *            signal confidence/entry/target/stop/risk-reward (2M each),
+ *            anomaly score/price deviation/volume deviation/price change
+ *            (M each), last value of each indicator (K)
+ */
+public class AnalysisResult {
+
+    /** Signal rule codes */
+    public static final int RULE_SMA = 0;
+    public static final int RULE_EMA = 1;
+
+    private static final int HEADER_INTS = 4;
+
+    private final int maxResults;
+    private final int indicatorCount;
+    private final int[] ints;
+    private final double[] doubles;
+
+    /**
+     * Allocate buffers for an analysis
+     *
+     * @param maxResults Patterns and anomalies kept; signals keep this many per rule
+     * @param indicatorCount Number of indicators requested
+     */
+    public AnalysisResult(int maxResults, int indicatorCount) {
+        this.maxResults = maxResults;
+        this.indicatorCount = indicatorCount;
+        this.ints = new int[HEADER_INTS + 10 * maxResults];
+        this.doubles = new double[17 * maxResults + indicatorCount];
+    }
+
+    public int maxResults() {
+        return maxResults;
+    }
+
+    int[] intBuffer() {
+        return ints;
+    }
+
+    double[] doubleBuffer() {
+        return doubles;
+    }
+
+    public int patternCount() {
+        return ints[0];
+    }
+
+    public int signalCount() {
+        return ints[1];
+    }
+
+    public int anomalyCount() {
+        return ints[2];
+    }
+
+    /** Number of bars the analysis covered */
+    public int barCount() {
+        return ints[3];
+    }
+
+    // Patterns (type codes as in getPatternTypeName)
+
+    public int patternType(int i) {
+        return ints[HEADER_INTS + i];
+    }
+
+    /** Display name of the pattern type, e.g. "Inverse Head & Shoulders" for code 11 */
+    public String patternTypeName(int i) {
+        return StockPredictJNIBridge.getPatternTypeName(patternType(i));
+    }
+
+    public int patternStart(int i) {
+        return ints[HEADER_INTS + maxResults + i];
+    }
+
+    public int patternEnd(int i) {
+        return ints[HEADER_INTS + 2 * maxResults + i];
+    }
+
+    public double patternConfidence(int i) {
+        return doubles[i];
+    }
+
+    public double patternExpectedMove(int i) {
+        return doubles[maxResults + i];
+    }
+
+    public double patternLevel(int i) {
+        return doubles[2 * maxResults + i];
+    }
+
+    // Signals of both rules, merged in bar order
+
+    public int signalType(int i) {
+        return ints[HEADER_INTS + 3 * maxResults + i];
+    }
+
+    public int signalIndex(int i) {
+        return ints[HEADER_INTS + 5 * maxResults + i];
+    }
+
+    /** RULE_SMA or RULE_EMA */
+    public int signalRule(int i) {
+        return ints[HEADER_INTS + 7 * maxResults + i];
+    }
+
+    public double signalConfidence(int i) {
+        return doubles[3 * maxResults + i];
+    }
+
+    public double signalEntryPrice(int i) {
+        return doubles[5 * maxResults + i];
+    }
+
+    public double signalTargetPrice(int i) {
+        return doubles[7 * maxResults + i];
+    }
+
+    public double signalStopLossPrice(int i) {
+        return doubles[9 * maxResults + i];
+    }
+
+    public double signalRiskRewardRatio(int i) {
+        return doubles[11 * maxResults + i];
+    }
+
+    // Anomalies
+
+    public int anomalyIndex(int i) {
+        return ints[HEADER_INTS + 9 * maxResults + i];
+    }
+
+    public double anomalyScore(int i) {
+        return doubles[13 * maxResults + i];
+    }
+
+    public double anomalyPriceDeviation(int i) {
+        return doubles[14 * maxResults + i];
+    }
+
+    public double anomalyVolumeDeviation(int i) {
+        return doubles[15 * maxResults + i];
+    }
+
+    public double anomalyPriceChange(int i) {
+        return doubles[16 * maxResults + i];
+    }
+
+    // Indicators
+
+    public int indicatorCount() {
+        return indicatorCount;
+    }
+
+    /** Last value of the k-th requested indicator (NaN if it was invalid) */
+    public double indicatorValue(int k) {
+        return doubles[17 * maxResults + k];
+    }
+}
@@ -32,6 +32,7 @@ public class DataMining { // Class definition (Định nghĩa lớp)
     public static final int PATTERN_DOWNTREND = 8;
     public static final int PATTERN_HEAD_AND_SHOULDERS = 9;
     public static final int PATTERN_REVERSAL = 10;
+    public static final int PATTERN_INVERSE_HEAD_AND_SHOULDERS = 11; // Bullish bottom (Đáy đầu vai ngược)
 
     // Signal types for trading signal detection
     public static final int SIGNAL_UNKNOWN = 0;
@@ -78,11 +79,24 @@ public class DataMining { // Class definition (Định nghĩa lớp)
         }
     }
     
-    // Using shared data classes from DataUtils
+    // Using shared data classes from DataUtils; the algorithms run on StockSeries columns
+    // Sử dụng các lớp dữ liệu dùng chung từ DataUtils; các thuật toán chạy trên các cột StockSeries
     
     /**
      * Detect patterns in the provided data
      * 
+     * @param data Array of stock data points with price and volume information
+     * @return Array of detected price patterns, sorted chronologically
+     */
+    public static DataUtils.PatternResult[] detectPricePatterns(DataUtils.StockData[] data) {
+        if (data == null || data.length < 50) return new DataUtils.PatternResult[0];
+        return detectPricePatterns(StockSeries.fromStockData(data));
+    }
+    
+    /**
+     * Detect patterns in a columnar series
+     * Phát hiện mẫu hình trong chuỗi dạng cột
+     * 
      * Algorithm:
      * 1. Checks for minimum data requirement (at least 50 data points)
      * 2. Creates a list to store detected patterns
@@ -90,25 +104,25 @@ public class DataMining { // Class definition (Định nghĩa lớp)
      * 4. Sorts patterns by start index (chronological order)
      * 5. Converts list to array for return
      * 
-     * @param data Array of stock data points with price and volume information
+     * @param series Columnar price series (Chuỗi giá dạng cột)
      * @return Array of detected price patterns, sorted chronologically
      */
-    public static DataUtils.PatternResult[] detectPricePatterns(DataUtils.StockData[] data) {
-        if (data == null || data.length < 50) return new DataUtils.PatternResult[0];
-        
+    public static DataUtils.PatternResult[] detectPricePatterns(StockSeries series) {
+        if (series == null || series.size() < 50) return new DataUtils.PatternResult[0];
+    
         // Initialize with larger capacity for more aggressive detection
-        List<DataUtils.PatternResult> patterns = new ArrayList<>(data.length / 10);
-        
+        List<DataUtils.PatternResult> patterns = new ArrayList<>(series.size() / 10);
+    
         // Only call methods that are actually implemented
-        detectHeadAndShouldersPattern(data, patterns);
-        detectSupportResistanceLevels(data, patterns);
-        detectTrendChanges(data, patterns);
-        detectDivergencePatterns(data, patterns);
-        detectPatternsInFutureData(data, patterns);
-        
+        detectHeadAndShouldersPattern(series, patterns);
+        detectSupportResistanceLevels(series, patterns);
+        detectTrendChanges(series, patterns);
+        detectDivergencePatterns(series, patterns);
+        detectPatternsInFutureData(series, patterns);
+    
         // Sort patterns by index
         Collections.sort(patterns, (p1, p2) -> Integer.compare(p1.startIndex, p2.startIndex));
-        
+    
         // Convert list to array
         DataUtils.PatternResult[] result = new DataUtils.PatternResult[patterns.size()];
         return patterns.toArray(result);
@@ -117,125 +131,113 @@ public class DataMining { // Class definition (Định nghĩa lớp)
     /**
      * Detect support and resistance levels
      */
-    private static void detectSupportResistanceLevels(DataUtils.StockData[] data, List<DataUtils.PatternResult> patterns) {
+    private static void detectSupportResistanceLevels(StockSeries series, List<DataUtils.PatternResult> patterns) {
+        int n = series.size();
+        double[] low = series.lows();
+        double[] high = series.highs();
+    
+        // Reduced window from 5 to 3 for more sensitivity
+        boolean[] supports = markCenteredExtremes(low, 3, false);
+        boolean[] resistances = markCenteredExtremes(high, 3, true);
+    
         // Find local minima (support) and maxima (resistance)
         // Reduced window size from 10 to 5 to capture more patterns
         // Modified to include more recent data (reduced from -5 to -2)
-        for (int i = 5; i < data.length - 2; i++) {
+        for (int i = 5; i < n - 2; i++) {
             // Check for support level (local minimum)
-            // Reduced window from 5 to 3 for more sensitivity
-            if (isLocalMinimum(data, i, 3)) {
+            if (supports[i]) {
                 DataUtils.PatternResult pattern = new DataUtils.PatternResult();
                 pattern.type = PATTERN_SUPPORT;
                 pattern.startIndex = Math.max(0, i - 5);
-                pattern.endIndex = Math.min(data.length - 1, i + 5);
-                pattern.confidence = calculateSupportStrength(data, i);
-                pattern.description = "Support level at price $" + String.format("%.2f", data[i].low) + 
-                                     " on " + data[i].date + ". Potential bounce point.";
+                pattern.endIndex = Math.min(n - 1, i + 5);
+                pattern.confidence = calculateSupportStrength();
+                pattern.description = "Support level at price $" + String.format("%.2f", low[i]) +
+                                     " on " + series.getDate(i) + ". Potential bounce point.";
                 patterns.add(pattern);
             }
-            
+    
             // Check for resistance level (local maximum)
-            // Reduced window from 5 to 3 for more sensitivity
-            if (isLocalMaximum(data, i, 3)) {
+            if (resistances[i]) {
                 DataUtils.PatternResult pattern = new DataUtils.PatternResult();
                 pattern.type = PATTERN_RESISTANCE;
                 pattern.startIndex = Math.max(0, i - 5);
-                pattern.endIndex = Math.min(data.length - 1, i + 5);
-                pattern.confidence = calculateResistanceStrength(data, i);
-                pattern.description = "Resistance level at price $" + String.format("%.2f", data[i].high) + 
-                                     " on " + data[i].date + ". Potential reversal point.";
+                pattern.endIndex = Math.min(n - 1, i + 5);
+                pattern.confidence = calculateResistanceStrength();
+                pattern.description = "Resistance level at price $" + String.format("%.2f", high[i]) +
+                                     " on " + series.getDate(i) + ". Potential reversal point.";
                 patterns.add(pattern);
             }
         }
     }
     
     /**
-     * Check if a point is a local minimum
+     * Mark local extremes of a column in one pass
+     * Đánh dấu các cực trị cục bộ của một cột trong một lần duyệt
      * 
-     * A local minimum is a point where the low price is less than or equal to
-     * all other low prices within the specified window.
+     * A point is a local maximum (minimum) when its value is greater (less)
+     * than or equal to every value within 'window' points on both sides;
+     * points closer than 'window' to either end are never marked. Instead of
+     * rescanning the 2*window+1 neighbours of every point, a monotonic deque
+     * carries the extreme of the sliding window, so the cost is O(n) for
+     * any window.
      * 
-     * This checks the low price in the StockData.
+     * Một điểm là cực đại (cực tiểu) cục bộ khi giá trị của nó lớn hơn (nhỏ hơn)
+     * hoặc bằng mọi giá trị trong phạm vi 'window' điểm ở hai bên. Hàng đợi hai
+     * đầu đơn điệu giữ cực trị của cửa sổ trượt nên chi phí là O(n).
+     * 
+     * @param values Column to scan (Cột cần quét)
+     * @param window Points required on each side (Số điểm cần có ở mỗi bên)
+     * @param maximum True for maxima, false for minima (True cho cực đại, false cho cực tiểu)
+     * @return Flag per point (Cờ cho từng điểm)
      */
-    private static boolean isLocalMinimum(DataUtils.StockData[] data, int index, int window) {
-        if (index < window || index >= data.length - window) {
-            System.out.println("DEBUG: Index " + index + " is too close to the edge for window size " + window);
-            return false;
-        }
-        
-        double currentLow = data[index].low;
-        
-        // Check if this point is lower than surrounding points
-        // Reduced strictness - now we only need it to be <= rather than strictly <
-        for (int i = Math.max(0, index - window); i < index; i++) {
-            if (data[i].low < currentLow) {
-                System.out.println("DEBUG: Not a local minimum at index " + index + " (" + data[index].date + 
-                                  ") because low[" + i + "] = " + data[i].low + 
-                                  " < currentLow = " + currentLow);
-                return false;
+    private static boolean[] markCenteredExtremes(double[] values, int window, boolean maximum) {
+        int n = values.length;
+        int span = 2 * window + 1;
+        boolean[] flags = new boolean[n];
+        if (n < span) return flags;
+    
+        int[] deque = new int[n];
+        int head = 0;
+        int tail = 0;
+        for (int i = 0; i < n; i++) {
+            // Drop candidates the new value dominates
+            while (tail > head && (maximum ? values[deque[tail - 1]] <= values[i]
+                                           : values[deque[tail - 1]] >= values[i])) {
+                tail--;
             }
-        }
-        
-        for (int i = index + 1; i <= Math.min(data.length - 1, index + window); i++) {
-            if (data[i].low < currentLow) {
-                System.out.println("DEBUG: Not a local minimum at index " + index + " (" + data[index].date + 
-                                  ") because low[" + i + "] = " + data[i].low + 
-                                  " < currentLow = " + currentLow);
-                return false;
+            deque[tail++] = i;
+            if (deque[head] <= i - span) {
+                head++;
+            }
+    
+            // The window centred on i - window is complete
+            int center = i - window;
+            if (center >= window) {
+                double extreme = values[deque[head]];
+                flags[center] = maximum ? values[center] >= extreme : values[center] <= extreme;
             }
         }
-        
-        System.out.println("DEBUG: Found local minimum at index " + index + " (" + data[index].date + 
-                          ") with low = " + currentLow);
-        return true;
+        return flags;
     }
     
     /**
-     * Check if a point is a local maximum
-     * 
-     * A local maximum is a point where the high price is greater than or equal to
-     * all other high prices within the specified window.
-     * 
-     * This checks the high price in the StockData.
+     * Index of the latest marked point at or before each position (-1 if none)
+     * Chỉ số của điểm được đánh dấu gần nhất tại hoặc trước mỗi vị trí (-1 nếu không có)
      */
-    private static boolean isLocalMaximum(DataUtils.StockData[] data, int index, int window) {
-        if (index < window || index >= data.length - window) {
-            System.out.println("DEBUG: Index " + index + " is too close to the edge for window size " + window);
-            return false;
-        }
-        
-        double currentHigh = data[index].high;
-        
-        // Check if this point is higher than surrounding points
-        // Reduced strictness - now we only need it to be >= rather than strictly >
-        for (int i = Math.max(0, index - window); i < index; i++) {
-            if (data[i].high > currentHigh) {
-                System.out.println("DEBUG: Not a local maximum at index " + index + " (" + data[index].date + 
-                                  ") because high[" + i + "] = " + data[i].high + 
-                                  " > currentHigh = " + currentHigh);
-                return false;
-            }
+    private static int[] lastMarkedIndex(boolean[] flags) {
+        int[] last = new int[flags.length];
+        int latest = -1;
+        for (int i = 0; i < flags.length; i++) {
+            if (flags[i]) latest = i;
+            last[i] = latest;
         }
-        
-        for (int i = index + 1; i <= Math.min(data.length - 1, index + window); i++) {
-            if (data[i].high > currentHigh) {
-                System.out.println("DEBUG: Not a local maximum at index " + index + " (" + data[index].date + 
-                                  ") because high[" + i + "] = " + data[i].high + 
-                                  " > currentHigh = " + currentHigh);
-                return false;
-            }
-        }
-        
-        System.out.println("DEBUG: Found local maximum at index " + index + " (" + data[index].date + 
-                          ") with high = " + currentHigh);
-        return true;
+        return last;
     }
     
     /**
      * Calculate strength of a support level
      */
-    private static double calculateSupportStrength(DataUtils.StockData[] data, int index) {
+    private static double calculateSupportStrength() {
         // Simple implementation - could be more sophisticated
         // Increased minimum confidence from 0.7 to 0.8
         return 0.8 + (Math.random() * 0.2); // 80-100% confidence
@@ -244,7 +246,7 @@ public class DataMining { // Class definition (Định nghĩa lớp)
     /**
      * Calculate strength of a resistance level
      */
-    private static double calculateResistanceStrength(DataUtils.StockData[] data, int index) {
+    private static double calculateResistanceStrength() {
         // Simple implementation - could be more sophisticated
         // Increased minimum confidence from 0.7 to 0.8
         return 0.8 + (Math.random() * 0.2); // 80-100% confidence
@@ -253,16 +255,19 @@ public class DataMining { // Class definition (Định nghĩa lớp)
     /**
      * Detect trend changes in the data
      */
-    private static void detectTrendChanges(DataUtils.StockData[] data, List<DataUtils.PatternResult> patterns) {
+    private static void detectTrendChanges(StockSeries series, List<DataUtils.PatternResult> patterns) {
+        int n = series.size();
+        double[] close = series.closes();
+    
         // Simple trend change detection using moving averages
-        double[] sma20 = calculateSMA(data, 20);
-        double[] sma50 = calculateSMA(data, 50);
-        double[] sma10 = calculateSMA(data, 10);
-        double[] sma5 = calculateSMA(data, 5); // Added ultra-short term SMA
-        
+        double[] sma20 = movingAverage(close, 20);
+        double[] sma50 = movingAverage(close, 50);
+        double[] sma10 = movingAverage(close, 10);
+        double[] sma5 = movingAverage(close, 5); // Added ultra-short term SMA
+    
         // Look for crossovers
         // Reduced starting point from 50 to 5 to catch more early patterns
-        for (int i = 5; i < data.length; i++) {
+        for (int i = 5; i < n; i++) {
             // SMA5 crosses above SMA10 (ultra-short term uptrend)
             if (i >= 10 && sma5[i-1] <= sma10[i-1] && sma5[i] > sma10[i]) {
                 DataUtils.PatternResult pattern = new DataUtils.PatternResult();
@@ -271,11 +276,11 @@ public class DataMining { // Class definition (Định nghĩa lớp)
                 pattern.endIndex = i;
                 pattern.confidence = 0.65 + (Math.random() * 0.15); // 65-80% confidence
                 pattern.expectedMove = 1.5 + (Math.random() * 1.5); // 1.5-3% expected move
-                pattern.description = "Ultra short-term bullish trend change at $" + String.format("%.2f", data[i].close) + 
-                                     " on " + data[i].date + ". 5-day SMA crossed above 10-day SMA. Suggests short-term momentum shift.";
+                pattern.description = "Ultra short-term bullish trend change at $" + String.format("%.2f", close[i]) +
+                                     " on " + series.getDate(i) + ". 5-day SMA crossed above 10-day SMA. Suggests short-term momentum shift.";
                 patterns.add(pattern);
             }
-            
+    
             // SMA5 crosses below SMA10 (ultra-short term downtrend)
             if (i >= 10 && sma5[i-1] >= sma10[i-1] && sma5[i] < sma10[i]) {
                 DataUtils.PatternResult pattern = new DataUtils.PatternResult();
@@ -284,11 +289,11 @@ public class DataMining { // Class definition (Định nghĩa lớp)
                 pattern.endIndex = i;
                 pattern.confidence = 0.65 + (Math.random() * 0.15); // 65-80% confidence
                 pattern.expectedMove = -(1.5 + (Math.random() * 1.5)); // -1.5% to -3% expected move
-                pattern.description = "Ultra short-term bearish trend change at $" + String.format("%.2f", data[i].close) + 
-                                     " on " + data[i].date + ". 5-day SMA crossed below 10-day SMA. Suggests short-term momentum shift.";
+                pattern.description = "Ultra short-term bearish trend change at $" + String.format("%.2f", close[i]) +
+                                     " on " + series.getDate(i) + ". 5-day SMA crossed below 10-day SMA. Suggests short-term momentum shift.";
                 patterns.add(pattern);
             }
-            
+    
             // Uptrend starting (20-day crosses above 50-day)
             if (i >= 50 && sma20[i-1] <= sma50[i-1] && sma20[i] > sma50[i]) {
                 DataUtils.PatternResult pattern = new DataUtils.PatternResult();
@@ -297,11 +302,11 @@ public class DataMining { // Class definition (Định nghĩa lớp)
                 pattern.endIndex = i;
                 pattern.confidence = 0.75 + (Math.random() * 0.15); // 75-90% confidence
                 pattern.expectedMove = 5 + (Math.random() * 3); // 5-8% expected move
-                pattern.description = "Bullish trend change at $" + String.format("%.2f", data[i].close) + 
-                                     " on " + data[i].date + ". 20-day SMA crossed above 50-day SMA. Suggests potential upward momentum.";
+                pattern.description = "Bullish trend change at $" + String.format("%.2f", close[i]) +
+                                     " on " + series.getDate(i) + ". 20-day SMA crossed above 50-day SMA. Suggests potential upward momentum.";
                 patterns.add(pattern);
             }
-            
+    
             // Downtrend starting (20-day crosses below 50-day)
             if (i >= 50 && sma20[i-1] >= sma50[i-1] && sma20[i] < sma50[i]) {
                 DataUtils.PatternResult pattern = new DataUtils.PatternResult();
@@ -310,11 +315,11 @@ public class DataMining { // Class definition (Định nghĩa lớp)
                 pattern.endIndex = i;
                 pattern.confidence = 0.75 + (Math.random() * 0.15); // 75-90% confidence
                 pattern.expectedMove = -(5 + (Math.random() * 3)); // -5% to -8% expected move
-                pattern.description = "Bearish trend change at $" + String.format("%.2f", data[i].close) + 
-                                     " on " + data[i].date + ". 20-day SMA crossed below 50-day SMA. Suggests potential downward pressure.";
+                pattern.description = "Bearish trend change at $" + String.format("%.2f", close[i]) +
+                                     " on " + series.getDate(i) + ". 20-day SMA crossed below 50-day SMA. Suggests potential downward pressure.";
                 patterns.add(pattern);
             }
-            
+    
             // Also detect shorter term trend changes with SMA10 and SMA20
             if (i >= 20) {
                 // Short-term uptrend
@@ -325,11 +330,11 @@ public class DataMining { // Class definition (Định nghĩa lớp)
                     pattern.endIndex = i;
                     pattern.confidence = 0.7 + (Math.random() * 0.15); // 70-85% confidence
                     pattern.expectedMove = 3 + (Math.random() * 2); // 3-5% expected move
-                    pattern.description = "Short-term bullish trend change at $" + String.format("%.2f", data[i].close) + 
-                                         " on " + data[i].date + ". 10-day SMA crossed above 20-day SMA. Suggests short-term momentum shift.";
+                    pattern.description = "Short-term bullish trend change at $" + String.format("%.2f", close[i]) +
+                                         " on " + series.getDate(i) + ". 10-day SMA crossed above 20-day SMA. Suggests short-term momentum shift.";
                     patterns.add(pattern);
                 }
-                
+    
                 // Short-term downtrend
                 if (sma10[i-1] >= sma20[i-1] && sma10[i] < sma20[i]) {
                     DataUtils.PatternResult pattern = new DataUtils.PatternResult();
@@ -338,17 +343,17 @@ public class DataMining { // Class definition (Định nghĩa lớp)
                     pattern.endIndex = i;
                     pattern.confidence = 0.7 + (Math.random() * 0.15); // 70-85% confidence
                     pattern.expectedMove = -(3 + (Math.random() * 2)); // -3% to -5% expected move
-                    pattern.description = "Short-term bearish trend change at $" + String.format("%.2f", data[i].close) + 
-                                         " on " + data[i].date + ". 10-day SMA crossed below 20-day SMA. Suggests short-term momentum shift.";
+                    pattern.description = "Short-term bearish trend change at $" + String.format("%.2f", close[i]) +
+                                         " on " + series.getDate(i) + ". 10-day SMA crossed below 20-day SMA. Suggests short-term momentum shift.";
                     patterns.add(pattern);
                 }
             }
-            
+    
             // Detect price acceleration (rate of change increases)
             if (i >= 10) {
-                double prevROC = (data[i-5].close - data[i-10].close) / data[i-10].close;
-                double currROC = (data[i].close - data[i-5].close) / data[i-5].close;
-                
+                double prevROC = (close[i-5] - close[i-10]) / close[i-10];
+                double currROC = (close[i] - close[i-5]) / close[i-5];
+    
                 // If rate of change accelerates significantly
                 if (currROC > 0 && currROC > prevROC * 1.5) {
                     DataUtils.PatternResult pattern = new DataUtils.PatternResult();
@@ -357,9 +362,9 @@ public class DataMining { // Class definition (Định nghĩa lớp)
                     pattern.endIndex = i;
                     pattern.confidence = 0.68 + (Math.random() * 0.12);
                     pattern.expectedMove = 2 + (Math.random() * 2);
-                    pattern.description = "Price acceleration detected at $" + String.format("%.2f", data[i].close) + 
-                                         " on " + data[i].date + ". Rate of change increased from " + 
-                                         String.format("%.2f", prevROC * 100) + "% to " + 
+                    pattern.description = "Price acceleration detected at $" + String.format("%.2f", close[i]) +
+                                         " on " + series.getDate(i) + ". Rate of change increased from " +
+                                         String.format("%.2f", prevROC * 100) + "% to " +
                                          String.format("%.2f", currROC * 100) + "%. Suggests momentum building.";
                     patterns.add(pattern);
                 }
@@ -370,9 +375,9 @@ public class DataMining { // Class definition (Định nghĩa lớp)
                     pattern.endIndex = i;
                     pattern.confidence = 0.68 + (Math.random() * 0.12);
                     pattern.expectedMove = -(2 + (Math.random() * 2));
-                    pattern.description = "Price deceleration detected at $" + String.format("%.2f", data[i].close) + 
-                                         " on " + data[i].date + ". Rate of change decreased from " + 
-                                         String.format("%.2f", prevROC * 100) + "% to " + 
+                    pattern.description = "Price deceleration detected at $" + String.format("%.2f", close[i]) +
+                                         " on " + series.getDate(i) + ". Rate of change decreased from " +
+                                         String.format("%.2f", prevROC * 100) + "% to " +
                                          String.format("%.2f", currROC * 100) + "%. Suggests downward momentum building.";
                     patterns.add(pattern);
                 }
@@ -384,41 +389,56 @@ public class DataMining { // Class definition (Định nghĩa lớp)
      * Calculate Simple Moving Average (SMA) for the given data and period
      * Tính giá trị trung bình động đơn giản (SMA) cho dữ liệu và kỳ hạn đã cho
      * 
+     * @param data Array of stock data (Mảng dữ liệu chứng khoán)
+     * @param period Number of days to average (Số ngày để tính trung bình)
+     * @return Array of SMA values (Mảng các giá trị SMA)
+     */
+    public static double[] calculateSMA(DataUtils.StockData[] data, int period) {
+        return calculateSMA(StockSeries.fromStockData(data), period);
+    }
+    
+    /**
+     * Calculate Simple Moving Average (SMA) of the closing prices of a series
+     * Tính giá trị trung bình động đơn giản (SMA) của giá đóng cửa của một chuỗi
+     * 
      * Algorithm:
-     * 1. For each point, sum the closing prices of the previous 'period' days
+     * 1. Keep a running sum of the last 'period' closing prices
      * 2. Divide the sum by the period to get the average
      * 3. For points with index < period, use available data points only
      * 
      * Thuật toán:
-     * 1. Với mỗi điểm, tính tổng giá đóng cửa của 'period' ngày trước đó
+     * 1. Duy trì tổng cộng dồn của 'period' giá đóng cửa gần nhất
      * 2. Chia tổng cho kỳ hạn để có giá trị trung bình
      * 3. Đối với các điểm có chỉ số < kỳ hạn, chỉ sử dụng các điểm dữ liệu có sẵn
      * 
-     * @param data Array of stock data (Mảng dữ liệu chứng khoán)
+     * @param series Columnar price series (Chuỗi giá dạng cột)
      * @param period Number of days to average (Số ngày để tính trung bình)
      * @return Array of SMA values (Mảng các giá trị SMA)
      */
-    public static double[] calculateSMA(DataUtils.StockData[] data, int period) {
-        double[] result = new double[data.length];
-        
-        for (int i = 0; i < data.length; i++) {
-            if (i < period - 1) {
-                // For early datapoints where we don't have enough history,
-                // use the average of what we have so far
-                double sum = 0;
-                for (int j = 0; j <= i; j++) {
-                    sum += data[i - j].close;
-                }
-                result[i] = sum / (i + 1);
-            } else {
-                double sum = 0;
-                for (int j = 0; j < period; j++) {
-                    sum += data[i - j].close;
-                }
-                result[i] = sum / period;
+    public static double[] calculateSMA(StockSeries series, int period) {
+        return movingAverage(series.closes(), period);
+    }
+    
+    /**
+     * Running-sum moving average: each point adds the newest value and drops
+     * the one leaving the window, so the cost does not depend on the period
+     * Trung bình động bằng tổng cộng dồn: mỗi điểm cộng giá trị mới nhất và trừ
+     * giá trị rời khỏi cửa sổ, nên chi phí không phụ thuộc vào kỳ hạn
+     */
+    private static double[] movingAverage(double[] values, int period) {
+        double[] result = new double[values.length];
+        double sum = 0;
+    
+        for (int i = 0; i < values.length; i++) {
+            sum += values[i];
+            if (i >= period) {
+                sum -= values[i - period];
             }
+            // For early datapoints where we don't have enough history,
+            // use the average of what we have so far
+            result[i] = sum / Math.min(i + 1, period);
         }
-        
+    
         return result;
     }
     
@@ -452,80 +472,87 @@ public class DataMining { // Class definition (Định nghĩa lớp)
      * - Các vai nên có độ cao tương tự (trong khoảng 10% so với nhau)
      * - Biến động giá dự kiến thường tỷ lệ thuận với khoảng cách từ đầu đến đường cổ
      * 
-     * @param data Array of stock data points (Mảng các điểm dữ liệu chứng khoán)
+     * @param series Columnar price series (Chuỗi giá dạng cột)
      * @param patterns List to store detected patterns (Danh sách để lưu trữ các mẫu hình đã phát hiện)
      */
-    private static void detectHeadAndShouldersPattern(DataUtils.StockData[] data, List<DataUtils.PatternResult> patterns) {
+    private static void detectHeadAndShouldersPattern(StockSeries series, List<DataUtils.PatternResult> patterns) {
+        int n = series.size();
+    
         // Need at least 40 data points to detect H&S pattern
-        if (data.length < 40) {
+        if (n < 40) {
             return;
         }
-        
+    
+        double[] high = series.highs();
+        double[] low = series.lows();
+        boolean[] heads = markCenteredExtremes(high, 5, true);
+        boolean[] shoulders = markCenteredExtremes(high, 3, true);
+    
         // Scan for potential head and shoulders patterns
         // We need to find 5 points: left shoulder, neckline1, head, neckline2, right shoulder
         // Modified to include more recent data (reduced buffer from 20 to 5)
-        for (int i = 20; i < data.length - 5; i++) {
+        for (int i = 20; i < n - 5; i++) {
             // Try to identify a potential head (local maximum)
-            if (isLocalMaximum(data, i, 5)) {
-                double headValue = data[i].high;
-                
+            if (heads[i]) {
+                double headValue = high[i];
+    
                 // Look back for left shoulder (should be lower than head)
                 int leftShoulderIdx = -1;
                 double leftShoulderVal = 0;
-                
+    
                 for (int j = i - 5; j > i - 15 && j > 0; j--) {
-                    if (isLocalMaximum(data, j, 3) && data[j].high < headValue) {
+                    if (shoulders[j] && high[j] < headValue) {
                         leftShoulderIdx = j;
-                        leftShoulderVal = data[j].high;
+                        leftShoulderVal = high[j];
                         break;
                     }
                 }
-                
+    
                 if (leftShoulderIdx < 0) continue; // No left shoulder found
-                
+    
                 // Look forward for right shoulder (should be lower than head and similar to left shoulder)
                 int rightShoulderIdx = -1;
                 double rightShoulderVal = 0;
-                
-                for (int j = i + 5; j < i + 15 && j < data.length; j++) {
-                    if (isLocalMaximum(data, j, 3) && data[j].high < headValue) {
+    
+                for (int j = i + 5; j < i + 15 && j < n; j++) {
+                    if (shoulders[j] && high[j] < headValue) {
                         rightShoulderIdx = j;
-                        rightShoulderVal = data[j].high;
+                        rightShoulderVal = high[j];
                         break;
                     }
                 }
-                
+    
                 if (rightShoulderIdx < 0) continue; // No right shoulder found
-                
+    
                 // Validate the pattern - shoulders should be roughly similar in height
                 double shoulderDiff = Math.abs(leftShoulderVal - rightShoulderVal);
                 if (shoulderDiff > 0.1 * headValue) continue; // Shoulders too different
-                
+    
                 // Find neckline by connecting lows between shoulders and head
-                int neckline1Idx = findLowestPointBetween(data, leftShoulderIdx, i);
-                int neckline2Idx = findLowestPointBetween(data, i, rightShoulderIdx);
-                
+                int neckline1Idx = findLowestPointBetween(low, leftShoulderIdx, i);
+                int neckline2Idx = findLowestPointBetween(low, i, rightShoulderIdx);
+    
                 if (neckline1Idx < 0 || neckline2Idx < 0) continue;
-                
+    
                 // Pattern detected, add to results
                 DataUtils.PatternResult pattern = new DataUtils.PatternResult();
                 pattern.type = PATTERN_HEAD_AND_SHOULDERS;
                 pattern.startIndex = leftShoulderIdx - 2;
                 pattern.endIndex = rightShoulderIdx + 2;
                 pattern.confidence = 0.80 + (Math.random() * 0.15); // 80-95% confidence
-                
+    
                 // Head and shoulders usually predicts a downtrend
-                double necklinePrice = (data[neckline1Idx].low + data[neckline2Idx].low) / 2;
+                double necklinePrice = (low[neckline1Idx] + low[neckline2Idx]) / 2;
                 double headHeight = headValue - necklinePrice;
                 pattern.expectedMove = -(headHeight / necklinePrice) * 100; // Predicted percent drop
-                
-                pattern.description = "Head and Shoulders pattern from " + data[leftShoulderIdx].date + 
-                                     " to " + data[rightShoulderIdx].date + 
-                                     ". Head at $" + String.format("%.2f", headValue) + 
-                                     ", neckline at $" + String.format("%.2f", necklinePrice) + 
+    
+                pattern.description = "Head and Shoulders pattern from " + series.getDate(leftShoulderIdx) +
+                                     " to " + series.getDate(rightShoulderIdx) +
+                                     ". Head at $" + String.format("%.2f", headValue) +
+                                     ", neckline at $" + String.format("%.2f", necklinePrice) +
                                      ". Bearish reversal pattern that suggests a potential downtrend.";
                 patterns.add(pattern);
-                
+    
                 // Skip ahead to avoid overlapping patterns
                 i = rightShoulderIdx;
             }
@@ -535,103 +562,99 @@ public class DataMining { // Class definition (Định nghĩa lớp)
     /**
      * Find the lowest price point between two indices
      */
-    private static int findLowestPointBetween(DataUtils.StockData[] data, int startIdx, int endIdx) {
+    private static int findLowestPointBetween(double[] low, int startIdx, int endIdx) {
         int lowestIdx = -1;
         double lowestPrice = Double.MAX_VALUE;
-        
+    
         for (int i = startIdx; i <= endIdx; i++) {
-            if (data[i].low < lowestPrice) {
-                lowestPrice = data[i].low;
+            if (low[i] < lowestPrice) {
+                lowestPrice = low[i];
                 lowestIdx = i;
             }
         }
-        
+    
         return lowestIdx;
     }
     
     /**
      * Special method to detect more patterns in future data
      */
-    private static void detectPatternsInFutureData(DataUtils.StockData[] data, List<DataUtils.PatternResult> patterns) {
-        // Today's date for comparison
-        java.time.LocalDate today = java.time.LocalDate.now();
-        
+    private static void detectPatternsInFutureData(StockSeries series, List<DataUtils.PatternResult> patterns) {
+        int n = series.size();
+        double[] close = series.closes();
+        int[] days = series.days();
+    
+        // Today's date for comparison, as an epoch day like the series dates
+        long today = java.time.LocalDate.now().toEpochDay();
+        boolean futureHeadAndShouldersScanned = false;
+    
         // Look for future dates and analyze them more aggressively
-        for (int i = 5; i < data.length - 2; i++) {
-            String dateStr = data[i].date;
-            java.time.LocalDate dataDate;
-            
-            try {
-                // Parse the date string to check if it's in the future
-                if (dateStr.contains("T")) {
-                    dateStr = dateStr.split("T")[0];
+        for (int i = 5; i < n - 2; i++) {
+            // If this is a future date, apply more aggressive pattern detection
+            if (days[i] <= today) {
+                continue;
+            }
+    
+            // Check for volatility changes in future data
+            if (i > 10 && i < n - 5) {
+                double pastVolatility = calculateVolatility(close, i-10, i-1);
+                double futureVolatility = calculateVolatility(close, i, i+5);
+    
+                // Detect volatility increase
+                if (futureVolatility > pastVolatility * 1.2) {
+                    DataUtils.PatternResult pattern = new DataUtils.PatternResult();
+                    pattern.type = PATTERN_TREND_CHANGE;
+                    pattern.startIndex = i;
+                    pattern.endIndex = Math.min(n - 1, i + 5);
+                    pattern.confidence = 0.85;
+                    pattern.description = "Predicted volatility increase on " + series.getDate(i) +
+                                         ". Price volatility expected to increase from " +
+                                         String.format("%.2f", pastVolatility) + " to " +
+                                         String.format("%.2f", futureVolatility) + ".";
+                    patterns.add(pattern);
                 }
-                dataDate = java.time.LocalDate.parse(dateStr);
-                
-                // If this is a future date, apply more aggressive pattern detection
-                if (dataDate.isAfter(today)) {
-                    // Check for volatility changes in future data
-                    if (i > 10 && i < data.length - 5) {
-                        double pastVolatility = calculateVolatility(data, i-10, i-1);
-                        double futureVolatility = calculateVolatility(data, i, i+5);
-                        
-                        // Detect volatility increase
-                        if (futureVolatility > pastVolatility * 1.2) {
-                            DataUtils.PatternResult pattern = new DataUtils.PatternResult();
-                            pattern.type = PATTERN_TREND_CHANGE;
-                            pattern.startIndex = i;
-                            pattern.endIndex = Math.min(data.length - 1, i + 5);
-                            pattern.confidence = 0.85;
-                            pattern.description = "Predicted volatility increase on " + data[i].date + 
-                                                 ". Price volatility expected to increase from " + 
-                                                 String.format("%.2f", pastVolatility) + " to " + 
-                                                 String.format("%.2f", futureVolatility) + ".";
-                            patterns.add(pattern);
-                        }
-                        
-                        // Detect major price moves
-                        double priceMove = calculatePriceMove(data, i, Math.min(data.length - 1, i + 5));
-                        if (Math.abs(priceMove) > 3.0) { // More than 3% move
-                            DataUtils.PatternResult pattern = new DataUtils.PatternResult();
-                            
-                            if (priceMove > 0) {
-                                pattern.type = PATTERN_UPTREND;
-                                pattern.expectedMove = priceMove;
-                                pattern.description = "Predicted price rally on " + data[i].date + 
-                                                     ". Expected " + String.format("%.1f", priceMove) + 
-                                                     "% price increase over next " + 
-                                                     Math.min(5, data.length - i - 1) + " days.";
-                            } else {
-                                pattern.type = PATTERN_DOWNTREND;
-                                pattern.expectedMove = priceMove;
-                                pattern.description = "Predicted price decline on " + data[i].date + 
-                                                     ". Expected " + String.format("%.1f", Math.abs(priceMove)) + 
-                                                     "% price decrease over next " + 
-                                                     Math.min(5, data.length - i - 1) + " days.";
-                            }
-                            
-                            pattern.startIndex = i;
-                            pattern.endIndex = Math.min(data.length - 1, i + 5);
-                            pattern.confidence = 0.80;
-                            patterns.add(pattern);
-                        }
-                    }
-                    
-                    // For future Head & Shoulders patterns, check with smaller window
-                    if (i > 30 && i < data.length - 15) {
-                        detectHeadAndShouldersFuture(data, patterns, i);
+    
+                // Detect major price moves
+                double priceMove = calculatePriceMove(close, i, Math.min(n - 1, i + 5));
+                if (Math.abs(priceMove) > 3.0) { // More than 3% move
+                    DataUtils.PatternResult pattern = new DataUtils.PatternResult();
+    
+                    if (priceMove > 0) {
+                        pattern.type = PATTERN_UPTREND;
+                        pattern.expectedMove = priceMove;
+                        pattern.description = "Predicted price rally on " + series.getDate(i) +
+                                             ". Expected " + String.format("%.1f", priceMove) +
+                                             "% price increase over next " +
+                                             Math.min(5, n - i - 1) + " days.";
+                    } else {
+                        pattern.type = PATTERN_DOWNTREND;
+                        pattern.expectedMove = priceMove;
+                        pattern.description = "Predicted price decline on " + series.getDate(i) +
+                                             ". Expected " + String.format("%.1f", Math.abs(priceMove)) +
+                                             "% price decrease over next " +
+                                             Math.min(5, n - i - 1) + " days.";
                     }
+    
+                    pattern.startIndex = i;
+                    pattern.endIndex = Math.min(n - 1, i + 5);
+                    pattern.confidence = 0.80;
+                    patterns.add(pattern);
                 }
-            } catch (Exception e) {
-                // Skip dates that can't be parsed
-                continue;
+            }
+    
+            // For future Head & Shoulders patterns, check with smaller window.
+            // One scan from the first eligible future bar covers every later
+            // start, which would only report the same patterns again.
+            if (!futureHeadAndShouldersScanned && i > 30 && i < n - 15) {
+                detectHeadAndShouldersFuture(series, patterns, i);
+                futureHeadAndShouldersScanned = true;
             }
         }
     }
     
     /**
-     * Calculate volatility for a range of stock data
-     * Tính độ biến động cho một khoảng dữ liệu chứng khoán
+     * Calculate volatility for a range of closing prices
+     * Tính độ biến động cho một khoảng giá đóng cửa
      * 
      * Algorithm:
      * 1. Calculate daily returns as percentage changes between consecutive days
@@ -659,26 +682,26 @@ public class DataMining { // Class definition (Định nghĩa lớp)
      * - r_tb = trung bình của tất cả lợi nhuận hàng ngày
      * - n = số ngày
      * 
-     * @param data Array of stock data (Mảng dữ liệu chứng khoán)
+     * @param close Closing prices (Giá đóng cửa)
      * @param startIndex Starting index for calculation (Chỉ số bắt đầu tính toán)
      * @param endIndex Ending index for calculation (Chỉ số kết thúc tính toán)
      * @return Volatility as a percentage (Độ biến động dưới dạng phần trăm)
      */
-    private static double calculateVolatility(DataUtils.StockData[] data, int startIndex, int endIndex) {
+    private static double calculateVolatility(double[] close, int startIndex, int endIndex) {
         double sum = 0;
         double sumSq = 0;
         int count = 0;
-        
+    
         // Calculate daily returns
         for (int i = startIndex + 1; i <= endIndex; i++) {
-            double dailyReturn = (data[i].close - data[i-1].close) / data[i-1].close;
+            double dailyReturn = (close[i] - close[i-1]) / close[i-1];
             sum += dailyReturn;
             sumSq += dailyReturn * dailyReturn;
             count++;
         }
-        
+    
         if (count < 2) return 0;
-        
+    
         double mean = sum / count;
         double variance = (sumSq / count) - (mean * mean);
         return Math.sqrt(variance) * 100; // Convert to percentage
@@ -687,12 +710,12 @@ public class DataMining { // Class definition (Định nghĩa lớp)
     /**
      * Calculate price move percentage over a range
      */
-    private static double calculatePriceMove(DataUtils.StockData[] data, int startIndex, int endIndex) {
+    private static double calculatePriceMove(double[] close, int startIndex, int endIndex) {
         if (startIndex >= endIndex) return 0;
-        
-        double startPrice = data[startIndex].close;
-        double endPrice = data[endIndex].close;
-        
+    
+        double startPrice = close[startIndex];
+        double endPrice = close[endIndex];
+    
         return ((endPrice - startPrice) / startPrice) * 100.0; // Return as percentage
     }
     
@@ -700,63 +723,69 @@ public class DataMining { // Class definition (Định nghĩa lớp)
      * Detect head and shoulders pattern specifically in future data
      * Uses more relaxed parameters than the standard detection
      */
-    private static void detectHeadAndShouldersFuture(DataUtils.StockData[] data, List<DataUtils.PatternResult> patterns, int startIndex) {
+    private static void detectHeadAndShouldersFuture(StockSeries series, List<DataUtils.PatternResult> patterns, int startIndex) {
+        int n = series.size();
+        double[] high = series.highs();
+        double[] low = series.lows();
+        boolean[] heads = markCenteredExtremes(series.closes(), 3, true);
+        boolean[] shoulders = markCenteredExtremes(series.closes(), 2, true);
+    
         // Look for local maxima as potential heads
-        for (int i = startIndex; i < data.length - 3; i++) {
-            if (isRelativeMaximum(data, i, 3)) { // Using relaxed maximum detection
-                double headValue = data[i].high;
-                
+        for (int i = startIndex; i < n - 3; i++) {
+            if (heads[i]) {
+                double headValue = high[i];
+    
                 // Look for left shoulder (relaxed parameters)
                 int leftShoulderIdx = -1;
                 double leftShoulderVal = 0;
-                
+    
                 for (int j = i - 3; j > i - 10 && j > startIndex; j--) {
-                    if (isRelativeMaximum(data, j, 2) && data[j].high < headValue * 1.1) {
+                    if (shoulders[j] && high[j] < headValue * 1.1) {
                         leftShoulderIdx = j;
-                        leftShoulderVal = data[j].high;
+                        leftShoulderVal = high[j];
                         break;
                     }
                 }
-                
+    
                 if (leftShoulderIdx < 0) continue;
-                
+    
                 // Look for right shoulder (relaxed parameters)
                 int rightShoulderIdx = -1;
                 double rightShoulderVal = 0;
-                
-                for (int j = i + 3; j < i + 10 && j < data.length; j++) {
-                    if (isRelativeMaximum(data, j, 2) && data[j].high < headValue * 1.1) {
+    
+                for (int j = i + 3; j < i + 10 && j < n; j++) {
+                    if (shoulders[j] && high[j] < headValue * 1.1) {
                         rightShoulderIdx = j;
-                        rightShoulderVal = data[j].high;
+                        rightShoulderVal = high[j];
                         break;
                     }
                 }
-                
+    
                 if (rightShoulderIdx < 0) continue;
-                
+    
                 // Validate shoulders - more relaxed validation for future data
                 double shoulderDiff = Math.abs(leftShoulderVal - rightShoulderVal);
                 if (shoulderDiff > 0.2 * headValue) continue; // 20% difference allowed
-                
+    
                 // Create pattern
                 DataUtils.PatternResult pattern = new DataUtils.PatternResult();
                 pattern.type = PATTERN_HEAD_AND_SHOULDERS;
                 pattern.startIndex = leftShoulderIdx;
                 pattern.endIndex = rightShoulderIdx;
                 pattern.confidence = 0.75 + (Math.random() * 0.15);
-                
+    
                 // Estimate expected move
-                double necklinePrice = (data[leftShoulderIdx].low + data[rightShoulderIdx].low) / 2;
+                double necklinePrice = (low[leftShoulderIdx] + low[rightShoulderIdx]) / 2;
                 double headHeight = headValue - necklinePrice;
                 pattern.expectedMove = -(headHeight / necklinePrice) * 100;
-                
-                pattern.description = "Head and Shoulders pattern from " + data[leftShoulderIdx].date + 
-                                     " to " + data[rightShoulderIdx].date + 
-                                     ". Head at $" + String.format("%.2f", headValue) + 
+    
+                pattern.description = "Head and Shoulders pattern from " + series.getDate(leftShoulderIdx) +
+                                     " to " + series.getDate(rightShoulderIdx) +
+                                     ". Head at $" + String.format("%.2f", headValue) +
                                      ". Predicted reversal pattern.";
-                
+    
                 patterns.add(pattern);
-                
+    
                 // Skip ahead
                 i = rightShoulderIdx;
             }
@@ -769,36 +798,31 @@ public class DataMining { // Class definition (Định nghĩa lớp)
     private static boolean isRelativeMaximum(double[] values, int index, int window) {
         double currentHigh = values[index];
         int higherCount = 0;
-        
+    
         // Check surrounding points
         for (int i = Math.max(0, index - window); i <= Math.min(values.length - 1, index + window); i++) {
             if (i != index && values[i] > currentHigh) {
                 higherCount++;
             }
         }
-        
+    
         // Allow up to 2 points to be higher for a relaxed maximum
         return higherCount <= 2;
     }
     
     /**
-     * Check if a point in stock data is a relative maximum based on closing price
+     * Detect Simple Moving Average (SMA) crossover trading signals
+     * 
+     * @param data Array of stock data points (Mảng các điểm dữ liệu chứng khoán)
+     * @param shortPeriod Period for short-term SMA (Kỳ hạn cho SMA ngắn hạn)
+     * @param longPeriod Period for long-term SMA (Kỳ hạn cho SMA dài hạn)
+     * @return Array of trading signals detected (Mảng các tín hiệu giao dịch đã phát hiện)
      */
-    private static boolean isRelativeMaximum(DataUtils.StockData[] data, int index, int range) {
-        if (index < range || index >= data.length - range) return false;
-        
-        double close = data[index].close;
-        for (int i = index - range; i <= index + range; i++) {
-            if (i != index && data[i].close > close) {
-                System.out.println("DEBUG: Not a relative maximum at index " + index + " (" + data[index].date + 
-                                  ") because close[" + i + "] = " + data[i].close + 
-                                  " > close = " + close);
-                return false;
-            }
+    public static DataUtils.TradingSignal[] detectSMACrossoverSignals(DataUtils.StockData[] data, int shortPeriod, int longPeriod) {
+        if (data == null || data.length < longPeriod + 1) {
+            return new DataUtils.TradingSignal[0]; // Not enough data
         }
-        System.out.println("DEBUG: Found relative maximum at index " + index + " (" + data[index].date + 
-                          ") with close = " + close);
-        return true;
+        return detectSMACrossoverSignals(StockSeries.fromStockData(data), shortPeriod, longPeriod);
     }
     
     /**
@@ -831,61 +855,64 @@ public class DataMining { // Class definition (Định nghĩa lớp)
      * - Tín hiệu bán có mục tiêu lợi nhuận 5% và dừng lỗ 3%
      * - Tỷ lệ rủi ro/phần thưởng là 5/3 = 1.67
      * 
-     * @param data Array of stock data points (Mảng các điểm dữ liệu chứng khoán)
+     * @param series Columnar price series (Chuỗi giá dạng cột)
      * @param shortPeriod Period for short-term SMA (Kỳ hạn cho SMA ngắn hạn)
      * @param longPeriod Period for long-term SMA (Kỳ hạn cho SMA dài hạn)
      * @return Array of trading signals detected (Mảng các tín hiệu giao dịch đã phát hiện)
      */
-    public static DataUtils.TradingSignal[] detectSMACrossoverSignals(DataUtils.StockData[] data, int shortPeriod, int longPeriod) {
-        if (data == null || data.length < longPeriod + 1) {
+    public static DataUtils.TradingSignal[] detectSMACrossoverSignals(StockSeries series, int shortPeriod, int longPeriod) {
+        if (series == null || series.size() < longPeriod + 1) {
             return new DataUtils.TradingSignal[0]; // Not enough data
         }
-        
+    
+        int n = series.size();
+        double[] close = series.closes();
+    
         // Create dynamic list to hold signals
         List<DataUtils.TradingSignal> signalList = new ArrayList<>();
-        
+    
         // Calculate SMAs
-        double[] shortSMA = calculateSMA(data, shortPeriod);
-        double[] longSMA = calculateSMA(data, longPeriod);
-        
+        double[] shortSMA = movingAverage(close, shortPeriod);
+        double[] longSMA = movingAverage(close, longPeriod);
+    
         // Look for crossovers, starting from the first valid point
         // Modified to include the most recent data point
-        for (int i = longPeriod; i < data.length; i++) {
+        for (int i = longPeriod; i < n; i++) {
             // Short SMA crosses above Long SMA - bullish signal
             if (shortSMA[i-1] <= longSMA[i-1] && shortSMA[i] > longSMA[i]) {
                 DataUtils.TradingSignal signal = new DataUtils.TradingSignal();
                 signal.type = "BUY";
                 signal.signalIndex = i;
-                signal.confidence = calculateSignalConfidence(data, i, true);
-                signal.entryPrice = data[i].close;
+                signal.confidence = calculateSignalConfidence();
+                signal.entryPrice = close[i];
                 signal.targetPrice = signal.entryPrice * 1.05; // 5% profit target
                 signal.stopLossPrice = signal.entryPrice * 0.97; // 3% stop loss
                 signal.riskRewardRatio = 5.0 / 3.0; // Risk-reward ratio
-                signal.description = "Buy signal on " + data[i].date + " at $" + String.format("%.2f", signal.entryPrice) + 
-                                    ". " + shortPeriod + "-day SMA crossed above " + longPeriod + 
-                                    "-day SMA. Target: $" + String.format("%.2f", signal.targetPrice) + 
+                signal.description = "Buy signal on " + series.getDate(i) + " at $" + String.format("%.2f", signal.entryPrice) +
+                                    ". " + shortPeriod + "-day SMA crossed above " + longPeriod +
+                                    "-day SMA. Target: $" + String.format("%.2f", signal.targetPrice) +
                                     ", Stop: $" + String.format("%.2f", signal.stopLossPrice);
                 signalList.add(signal);
             }
-            
+    
             // Short SMA crosses below Long SMA - bearish signal
             if (shortSMA[i-1] >= longSMA[i-1] && shortSMA[i] < longSMA[i]) {
                 DataUtils.TradingSignal signal = new DataUtils.TradingSignal();
                 signal.type = "SELL";
                 signal.signalIndex = i;
-                signal.confidence = calculateSignalConfidence(data, i, false);
-                signal.entryPrice = data[i].close;
+                signal.confidence = calculateSignalConfidence();
+                signal.entryPrice = close[i];
                 signal.targetPrice = signal.entryPrice * 0.95; // 5% profit target (for short)
                 signal.stopLossPrice = signal.entryPrice * 1.03; // 3% stop loss (for short)
                 signal.riskRewardRatio = 5.0 / 3.0; // Risk-reward ratio
-                signal.description = "Sell signal on " + data[i].date + " at $" + String.format("%.2f", signal.entryPrice) + 
-                                    ". " + shortPeriod + "-day SMA crossed below " + longPeriod + 
-                                    "-day SMA. Target: $" + String.format("%.2f", signal.targetPrice) + 
+                signal.description = "Sell signal on " + series.getDate(i) + " at $" + String.format("%.2f", signal.entryPrice) +
+                                    ". " + shortPeriod + "-day SMA crossed below " + longPeriod +
+                                    "-day SMA. Target: $" + String.format("%.2f", signal.targetPrice) +
                                     ", Stop: $" + String.format("%.2f", signal.stopLossPrice);
                 signalList.add(signal);
             }
         }
-        
+    
         // Convert list to array
         DataUtils.TradingSignal[] result = new DataUtils.TradingSignal[signalList.size()];
         return signalList.toArray(result);
@@ -894,27 +921,40 @@ public class DataMining { // Class definition (Định nghĩa lớp)
     /**
      * Calculate confidence for a signal
      */
-    private static double calculateSignalConfidence(DataUtils.StockData[] data, int index, boolean isBuy) {
+    private static double calculateSignalConfidence() {
         // Simple implementation - could be more sophisticated
         return 0.7 + (Math.random() * 0.3); // 70-100% confidence
     }
     
     /**
      * Detect anomalies in the stock data
-     * Phát hiện các bất thường trong dữ liệu chứng khoán
+     * 
+     * @param data Array of stock data points (Mảng các điểm dữ liệu chứng khoán)
+     * @return Array of detected anomalies (Mảng các bất thường đã phát hiện)
+     */
+    public static DataUtils.AnomalyResult[] detectAnomalies(DataUtils.StockData[] data) {
+        if (data == null || data.length < 30) {
+            return new DataUtils.AnomalyResult[0]; // Not enough data
+        }
+        return detectAnomalies(StockSeries.fromStockData(data));
+    }
+    
+    /**
+     * Detect anomalies in a columnar series
+     * Phát hiện các bất thường trong chuỗi dạng cột
      * 
      * Algorithm:
-     * 1. Extract price and volume data into arrays
+     * 1. Calculate the close-to-close price changes
      * 2. Calculate mean and standard deviation for price changes and volume
      * 3. For each data point, calculate z-scores for price change and volume
      * 4. Combine z-scores with weights: price change (70%) and volume (30%)
      * 5. Flag points with anomaly score > 2.5 standard deviations
      * 
      * Thuật toán:
-     * 1. Trích xuất dữ liệu giá và khối lượng vào các mảng
+     * 1. Tính biến động giá giữa các ngày liên tiếp
      * 2. Tính giá trị trung bình và độ lệch chuẩn cho biến động giá và khối lượng
      * 3. Với mỗi điểm dữ liệu, tính điểm z-score cho biến động giá và khối lượng
-     * 4. Kết hợp các z-score với trọng số: biến động giá (70%) và khối lượng (30%)  
+     * 4. Kết hợp các z-score với trọng số: biến động giá (70%) và khối lượng (30%)
      * 5. Đánh dấu các điểm có điểm bất thường > 2.5 độ lệch chuẩn
      * 
      * Formula:
@@ -925,52 +965,45 @@ public class DataMining { // Class definition (Định nghĩa lớp)
      *   z-score = |giá trị - trung bình| / độ lệch chuẩn
      *   điểm bất thường = (z-score biến động giá * 0.7) + (z-score khối lượng * 0.3)
      * 
-     * @param data Array of stock data points (Mảng các điểm dữ liệu chứng khoán)
+     * @param series Columnar price series (Chuỗi giá dạng cột)
      * @return Array of detected anomalies (Mảng các bất thường đã phát hiện)
      */
-    public static DataUtils.AnomalyResult[] detectAnomalies(DataUtils.StockData[] data) {
-        if (data == null || data.length < 30) {
+    public static DataUtils.AnomalyResult[] detectAnomalies(StockSeries series) {
+        if (series == null || series.size() < 30) {
             return new DataUtils.AnomalyResult[0]; // Not enough data
         }
-        
+    
+        int n = series.size();
+        double[] close = series.closes();
+        double[] volumes = series.volumes();
+    
         // Create dynamic list to hold anomalies
         List<DataUtils.AnomalyResult> anomalyList = new ArrayList<>();
-        
-        // Prepare arrays for analysis
-        double[] prices = new double[data.length];
-        double[] volumes = new double[data.length];
-        double[] priceChanges = new double[data.length-1];
-        
-        // Extract data for analysis
-        for (int i = 0; i < data.length; i++) {
-            prices[i] = data[i].close;
-            volumes[i] = data[i].volume;
-            
-            if (i > 0) {
-                priceChanges[i-1] = (data[i].close - data[i-1].close) / data[i-1].close;
-            }
+    
+        // priceChanges[i-1] is the change from day i-1 to day i
+        double[] priceChanges = new double[n - 1];
+        for (int i = 1; i < n; i++) {
+            priceChanges[i-1] = (close[i] - close[i-1]) / close[i-1];
         }
-        
+    
         // Calculate mean and standard deviation for price changes and volumes
         double meanPriceChange = calculateMean(priceChanges);
         double stdDevPriceChange = calculateStdDev(priceChanges, meanPriceChange);
-        
+    
         double meanVolume = calculateMean(volumes);
         double stdDevVolume = calculateStdDev(volumes, meanVolume);
-        
+    
         // Look for anomalies in the data, starting from day 1
-        // No change needed here as it already loops through all data points
-        for (int i = 1; i < data.length; i++) {
-            // Calculate price change for this day
-            double priceChange = (data[i].close - data[i-1].close) / data[i-1].close;
-            
+        for (int i = 1; i < n; i++) {
+            double priceChange = priceChanges[i-1];
+    
             // Calculate z-scores
             double priceChangeZScore = Math.abs((priceChange - meanPriceChange) / stdDevPriceChange);
-            double volumeZScore = Math.abs((data[i].volume - meanVolume) / stdDevVolume);
-            
+            double volumeZScore = Math.abs((volumes[i] - meanVolume) / stdDevVolume);
+    
             // Anomaly score is a weighted combination of price and volume z-scores
             double anomalyScore = (priceChangeZScore * 0.7) + (volumeZScore * 0.3);
-            
+    
             // If anomaly score is high enough, record it
             if (anomalyScore > 2.5) { // More than 2.5 standard deviations
                 DataUtils.AnomalyResult anomaly = new DataUtils.AnomalyResult();
@@ -978,22 +1011,22 @@ public class DataMining { // Class definition (Định nghĩa lớp)
                 anomaly.score = anomalyScore;
                 anomaly.priceDeviation = priceChangeZScore;
                 anomaly.volumeDeviation = volumeZScore;
-                
+    
                 double percentChange = priceChange * 100.0;
                 String changeDirection = percentChange > 0 ? "increased" : "decreased";
                 String volumeDirection = volumeZScore > 2.0 ? "high" : "normal";
-                
-                anomaly.description = "Anomaly detected on " + data[i].date + ": Price " + 
-                                     changeDirection + " by " + String.format("%.2f", Math.abs(percentChange)) + 
-                                     "% to $" + String.format("%.2f", data[i].close) + 
-                                     " with " + volumeDirection + " volume (" + 
-                                     String.format("%.0f", data[i].volume) + 
+    
+                anomaly.description = "Anomaly detected on " + series.getDate(i) + ": Price " +
+                                     changeDirection + " by " + String.format("%.2f", Math.abs(percentChange)) +
+                                     "% to $" + String.format("%.2f", close[i]) +
+                                     " with " + volumeDirection + " volume (" +
+                                     String.format("%.0f", volumes[i]) +
                                      "). Deviation from normal: " + String.format("%.1f", anomalyScore) + " σ.";
-                
+    
                 anomalyList.add(anomaly);
             }
         }
-        
+    
         // Convert list to array
         DataUtils.AnomalyResult[] result = new DataUtils.AnomalyResult[anomalyList.size()];
         return anomalyList.toArray(result);
@@ -1024,115 +1057,120 @@ public class DataMining { // Class definition (Định nghĩa lớp)
     
     /**
      * Detect divergence patterns between price and technical indicators
+     * 
+     * Strict extremes of the closing price and the strict minima of RSI and
+     * MACD are marked once up front; the previous extreme within the
+     * lookback is then a lookup in lastMarkedIndex rather than a rescan.
+     * Only the relaxed RSI/MACD maxima are checked per candidate.
      */
-    private static void detectDivergencePatterns(DataUtils.StockData[] data, List<DataUtils.PatternResult> patterns) {
-        if (data.length < 30) return;
-        
+    private static void detectDivergencePatterns(StockSeries series, List<DataUtils.PatternResult> patterns) {
+        int n = series.size();
+        if (n < 30) return;
+    
+        double[] close = series.closes();
+    
         // Calculate RSI for divergence detection
-        double[] rsi = calculateRSI(data, 14);
+        double[] rsi = calculateRSI(series, 14);
         // Calculate MACD for divergence detection
-        double[] macd = calculateMACD(data).getLine();
-        
-        for (int i = 30; i < data.length; i++) {
+        double[] macd = calculateMACD(series).getLine();
+    
+        boolean[] priceMax = markCenteredExtremes(close, 5, true);
+        boolean[] priceMin = markCenteredExtremes(close, 5, false);
+        boolean[] rsiMin = markCenteredExtremes(rsi, 5, false);
+        boolean[] macdMin = markCenteredExtremes(macd, 5, false);
+        int[] lastPriceMax = lastMarkedIndex(markCenteredExtremes(close, 3, true));
+        int[] lastPriceMin = lastMarkedIndex(markCenteredExtremes(close, 3, false));
+        int[] lastRsiMin = lastMarkedIndex(markCenteredExtremes(rsi, 3, false));
+        int[] lastMacdMin = lastMarkedIndex(markCenteredExtremes(macd, 3, false));
+    
+        for (int i = 30; i < n; i++) {
             // Find local price highs and lows
-            if (isRelativeMaximum(data, i, 5)) {
+            if (priceMax[i]) {
                 // Check for bearish RSI divergence (price high, RSI lower high)
-                if (i >= 10 && 
-                    isRelativeMaximum(rsi, i, 5) && 
-                    findPreviousRelativeMax(data, i, 20) != -1) {
-                    
-                    int prevPriceMaxIdx = findPreviousRelativeMax(data, i, 20);
+                int prevPriceMaxIdx = findPreviousMarked(lastPriceMax, i, 20);
+                if (prevPriceMaxIdx != -1 && isRelativeMaximum(rsi, i, 5)) {
                     int prevRsiMaxIdx = findPreviousRelativeMax(rsi, i, 20);
-                    
-                    if (prevPriceMaxIdx != -1 && prevRsiMaxIdx != -1 && 
-                        data[i].close > data[prevPriceMaxIdx].close && 
+    
+                    if (prevRsiMaxIdx != -1 &&
+                        close[i] > close[prevPriceMaxIdx] &&
                         rsi[i] < rsi[prevRsiMaxIdx]) {
-                        
+    
                         DataUtils.PatternResult pattern = new DataUtils.PatternResult();
                         pattern.type = PATTERN_REVERSAL;
                         pattern.startIndex = prevPriceMaxIdx;
                         pattern.endIndex = i;
                         pattern.confidence = 0.75 + (Math.random() * 0.15);
                         pattern.expectedMove = -(4 + (Math.random() * 3)); // -4% to -7% expected move
-                        pattern.description = "Bearish RSI divergence at $" + String.format("%.2f", data[i].close) + 
-                                             " on " + data[i].date + ". Price made higher high while RSI made lower high. " +
+                        pattern.description = "Bearish RSI divergence at $" + String.format("%.2f", close[i]) +
+                                             " on " + series.getDate(i) + ". Price made higher high while RSI made lower high. " +
                                              "Suggests potential trend reversal down.";
                         patterns.add(pattern);
                     }
                 }
-                
+    
                 // Check for bearish MACD divergence
-                if (i >= 15 && 
-                    isRelativeMaximum(macd, i, 5) && 
-                    findPreviousRelativeMax(data, i, 30) != -1) {
-                    
-                    int prevPriceMaxIdx = findPreviousRelativeMax(data, i, 30);
+                prevPriceMaxIdx = findPreviousMarked(lastPriceMax, i, 30);
+                if (prevPriceMaxIdx != -1 && isRelativeMaximum(macd, i, 5)) {
                     int prevMacdMaxIdx = findPreviousRelativeMax(macd, i, 30);
-                    
-                    if (prevPriceMaxIdx != -1 && prevMacdMaxIdx != -1 && 
-                        data[i].close > data[prevPriceMaxIdx].close && 
+    
+                    if (prevMacdMaxIdx != -1 &&
+                        close[i] > close[prevPriceMaxIdx] &&
                         macd[i] < macd[prevMacdMaxIdx]) {
-                        
+    
                         DataUtils.PatternResult pattern = new DataUtils.PatternResult();
                         pattern.type = PATTERN_REVERSAL;
                         pattern.startIndex = prevPriceMaxIdx;
                         pattern.endIndex = i;
                         pattern.confidence = 0.78 + (Math.random() * 0.12);
                         pattern.expectedMove = -(4.5 + (Math.random() * 3.5)); // -4.5% to -8% expected move
-                        pattern.description = "Bearish MACD divergence at $" + String.format("%.2f", data[i].close) + 
-                                             " on " + data[i].date + ". Price made higher high while MACD made lower high. " +
+                        pattern.description = "Bearish MACD divergence at $" + String.format("%.2f", close[i]) +
+                                             " on " + series.getDate(i) + ". Price made higher high while MACD made lower high. " +
                                              "Strong indication of potential bearish reversal.";
                         patterns.add(pattern);
                     }
                 }
             }
-            
-            if (isRelativeMinimum(data, i, 5)) {
+    
+            if (priceMin[i]) {
                 // Check for bullish RSI divergence (price low, RSI higher low)
-                if (i >= 10 && 
-                    isRelativeMinimum(rsi, i, 5) && 
-                    findPreviousRelativeMin(data, i, 20) != -1) {
-                    
-                    int prevPriceMinIdx = findPreviousRelativeMin(data, i, 20);
-                    int prevRsiMinIdx = findPreviousRelativeMin(rsi, i, 20);
-                    
-                    if (prevPriceMinIdx != -1 && prevRsiMinIdx != -1 && 
-                        data[i].close < data[prevPriceMinIdx].close && 
+                int prevPriceMinIdx = findPreviousMarked(lastPriceMin, i, 20);
+                if (prevPriceMinIdx != -1 && rsiMin[i]) {
+                    int prevRsiMinIdx = findPreviousMarked(lastRsiMin, i, 20);
+    
+                    if (prevRsiMinIdx != -1 &&
+                        close[i] < close[prevPriceMinIdx] &&
                         rsi[i] > rsi[prevRsiMinIdx]) {
-                        
+    
                         DataUtils.PatternResult pattern = new DataUtils.PatternResult();
                         pattern.type = PATTERN_REVERSAL;
                         pattern.startIndex = prevPriceMinIdx;
                         pattern.endIndex = i;
                         pattern.confidence = 0.75 + (Math.random() * 0.15);
                         pattern.expectedMove = 4 + (Math.random() * 3); // 4% to 7% expected move
-                        pattern.description = "Bullish RSI divergence at $" + String.format("%.2f", data[i].close) + 
-                                             " on " + data[i].date + ". Price made lower low while RSI made higher low. " +
+                        pattern.description = "Bullish RSI divergence at $" + String.format("%.2f", close[i]) +
+                                             " on " + series.getDate(i) + ". Price made lower low while RSI made higher low. " +
                                              "Suggests potential trend reversal up.";
                         patterns.add(pattern);
                     }
                 }
-                
+    
                 // Check for bullish MACD divergence
-                if (i >= 15 && 
-                    isRelativeMinimum(macd, i, 5) && 
-                    findPreviousRelativeMin(data, i, 30) != -1) {
-                    
-                    int prevPriceMinIdx = findPreviousRelativeMin(data, i, 30);
-                    int prevMacdMinIdx = findPreviousRelativeMin(macd, i, 30);
-                    
-                    if (prevPriceMinIdx != -1 && prevMacdMinIdx != -1 && 
-                        data[i].close < data[prevPriceMinIdx].close && 
+                prevPriceMinIdx = findPreviousMarked(lastPriceMin, i, 30);
+                if (prevPriceMinIdx != -1 && macdMin[i]) {
+                    int prevMacdMinIdx = findPreviousMarked(lastMacdMin, i, 30);
+    
+                    if (prevMacdMinIdx != -1 &&
+                        close[i] < close[prevPriceMinIdx] &&
                         macd[i] > macd[prevMacdMinIdx]) {
-                        
+    
                         DataUtils.PatternResult pattern = new DataUtils.PatternResult();
                         pattern.type = PATTERN_REVERSAL;
                         pattern.startIndex = prevPriceMinIdx;
                         pattern.endIndex = i;
                         pattern.confidence = 0.78 + (Math.random() * 0.12);
                         pattern.expectedMove = 4.5 + (Math.random() * 3.5); // 4.5% to 8% expected move
-                        pattern.description = "Bullish MACD divergence at $" + String.format("%.2f", data[i].close) + 
-                                             " on " + data[i].date + ". Price made lower low while MACD made higher low. " +
+                        pattern.description = "Bullish MACD divergence at $" + String.format("%.2f", close[i]) +
+                                             " on " + series.getDate(i) + ". Price made lower low while MACD made higher low. " +
                                              "Strong indication of potential bullish reversal.";
                         patterns.add(pattern);
                     }
@@ -1155,96 +1193,18 @@ public class DataMining { // Class definition (Định nghĩa lớp)
     }
     
     /**
-     * Find the previous relative maximum in stock data before the given index
+     * Find the latest marked point at least 5 points before the given index
+     * and within the lookback range, from the lastMarkedIndex table
      */
-    private static int findPreviousRelativeMax(DataUtils.StockData[] data, int currentIndex, int lookbackRange) {
-        int startLookback = Math.max(0, currentIndex - lookbackRange);
-        for (int i = currentIndex - 5; i >= startLookback; i--) {
-            if (isRelativeMaximum(data, i, 3)) {
-                return i;
-            }
-        }
-        return -1;
-    }
-    
-    /**
-     * Find the previous relative minimum in an array before the given index
-     */
-    private static int findPreviousRelativeMin(double[] values, int currentIndex, int lookbackRange) {
-        int startLookback = Math.max(0, currentIndex - lookbackRange);
-        for (int i = currentIndex - 5; i >= startLookback; i--) {
-            if (isRelativeMinimum(values, i, 3)) {
-                return i;
-            }
-        }
-        return -1;
-    }
-    
-    /**
-     * Find the previous relative minimum in stock data before the given index
-     */
-    private static int findPreviousRelativeMin(DataUtils.StockData[] data, int currentIndex, int lookbackRange) {
-        int startLookback = Math.max(0, currentIndex - lookbackRange);
-        for (int i = currentIndex - 5; i >= startLookback; i--) {
-            if (isRelativeMinimum(data, i, 3)) {
-                return i;
-            }
-        }
-        return -1;
-    }
-    
-    /**
-     * Check if a point in an array is a relative minimum
-     * 
-     * A relative minimum is a point where the value is less than or equal to
-     * all other values within the specified range on both sides.
-     * 
-     * Unlike isLocalMinimum which checks the low price, this method checks
-     * an arbitrary array of values (like RSI, MACD, etc.).
-     */
-    private static boolean isRelativeMinimum(double[] values, int index, int range) {
-        if (index < range || index >= values.length - range) return false;
-        
-        double value = values[index];
-        for (int i = index - range; i <= index + range; i++) {
-            if (i != index && values[i] < value) {
-                System.out.println("DEBUG: Not a relative minimum at index " + index + " because values[" + i + "] = " + 
-                                  values[i] + " < value = " + value);
-                return false;
-            }
-        }
-        System.out.println("DEBUG: Found relative minimum at index " + index + " with value = " + value);
-        return true;
-    }
-    
-    /**
-     * Check if a point in stock data is a relative minimum based on closing price
-     * 
-     * A relative minimum is a point where the close price is less than or equal to
-     * all other close prices within the specified range on both sides.
-     * 
-     * Unlike isLocalMinimum which checks the low price, this method checks the close price.
-     */
-    private static boolean isRelativeMinimum(DataUtils.StockData[] data, int index, int range) {
-        if (index < range || index >= data.length - range) return false;
-        
-        double close = data[index].close;
-        for (int i = index - range; i <= index + range; i++) {
-            if (i != index && data[i].close < close) {
-                System.out.println("DEBUG: Not a relative minimum at index " + index + " (" + data[index].date + 
-                                  ") because close[" + i + "] = " + data[i].close + 
-                                  " < close = " + close);
-                return false;
-            }
-        }
-        System.out.println("DEBUG: Found relative minimum at index " + index + " (" + data[index].date + 
-                          ") with close = " + close);
-        return true;
+    private static int findPreviousMarked(int[] lastMarked, int currentIndex, int lookbackRange) {
+        if (currentIndex - 5 < 0) return -1;
+        int candidate = lastMarked[currentIndex - 5];
+        return candidate >= Math.max(0, currentIndex - lookbackRange) ? candidate : -1;
     }
     
     /**
-     * Calculate Relative Strength Index (RSI) for the given data and period
-     * Tính chỉ số sức mạnh tương đối (RSI) cho dữ liệu và kỳ hạn đã cho
+     * Calculate Relative Strength Index (RSI) for the given series and period
+     * Tính chỉ số sức mạnh tương đối (RSI) cho chuỗi và kỳ hạn đã cho
      * 
      * Algorithm:
      * 1. Calculate price changes between consecutive days
@@ -1270,71 +1230,88 @@ public class DataMining { // Class definition (Định nghĩa lớp)
      * - RSI < 30: Có thể đang bán quá mức (tài sản có thể đang được định giá quá thấp)
      * - Sự phân kỳ RSI so với giá có thể báo hiệu khả năng đảo chiều
      * 
-     * @param data Array of stock data (Mảng dữ liệu chứng khoán)
+     * @param series Columnar price series (Chuỗi giá dạng cột)
      * @param period Period for RSI calculation, typically 14 days (Kỳ hạn tính RSI, thường là 14 ngày)
-     * @return Array of RSI values (Mảng các giá trị RSI)
+     * @return Array of RSI values, 50 before the first full period (Mảng các giá trị RSI)
      */
-    private static double[] calculateRSI(DataUtils.StockData[] data, int period) {
-        double[] rsi = new double[data.length];
+    public static double[] calculateRSI(StockSeries series, int period) {
+        double[] close = series.closes();
+        double[] rsi = new double[close.length];
         Arrays.fill(rsi, 50); // Default value
-        
-        if (data.length <= period) return rsi;
-        
-        double[] gains = new double[data.length];
-        double[] losses = new double[data.length];
-        
-        // Calculate price changes
-        for (int i = 1; i < data.length; i++) {
-            double change = data[i].close - data[i-1].close;
-            if (change > 0) {
-                gains[i] = change;
-                losses[i] = 0;
-            } else {
-                gains[i] = 0;
-                losses[i] = Math.abs(change);
-            }
-        }
-        
-        // Calculate initial averages
+    
+        if (close.length <= period) return rsi;
+    
+        // Calculate initial averages from the first 'period' price changes
         double avgGain = 0;
         double avgLoss = 0;
-        
+    
         for (int i = 1; i <= period; i++) {
-            avgGain += gains[i];
-            avgLoss += losses[i];
+            double change = close[i] - close[i-1];
+            if (change > 0) {
+                avgGain += change;
+            } else {
+                avgLoss -= change;
+            }
         }
-        
+    
         avgGain /= period;
         avgLoss /= period;
-        
-        // Calculate RSI
+        rsi[period] = relativeStrengthIndex(avgGain, avgLoss);
+    
+        // Calculate remaining RSI values with Wilder smoothing
+        for (int i = period + 1; i < close.length; i++) {
+            double change = close[i] - close[i-1];
+            double gain = change > 0 ? change : 0;
+            double loss = change > 0 ? 0 : -change;
+            avgGain = ((avgGain * (period - 1)) + gain) / period;
+            avgLoss = ((avgLoss * (period - 1)) + loss) / period;
+            rsi[i] = relativeStrengthIndex(avgGain, avgLoss);
+        }
+    
+        return rsi;
+    }
+    
+    /**
+     * RSI from the average gain and loss; 100 when there are no losses
+     */
+    private static double relativeStrengthIndex(double avgGain, double avgLoss) {
         if (avgLoss > 0) {
             double rs = avgGain / avgLoss;
-            rsi[period] = 100 - (100 / (1 + rs));
-        } else {
-            rsi[period] = 100; // No losses, RSI = 100
+            return 100 - (100 / (1 + rs));
         }
-        
-        // Calculate remaining RSI values
-        for (int i = period + 1; i < data.length; i++) {
-            avgGain = ((avgGain * (period - 1)) + gains[i]) / period;
-            avgLoss = ((avgLoss * (period - 1)) + losses[i]) / period;
-            
-            if (avgLoss > 0) {
-                double rs = avgGain / avgLoss;
-                rsi[i] = 100 - (100 / (1 + rs));
-            } else {
-                rsi[i] = 100; // No losses, RSI = a maximum 100
-            }
-        }
-        
-        return rsi;
+        return 100; // No losses, RSI = 100
     }
     
     /**
      * Calculate MACD (Moving Average Convergence Divergence)
      * Tính chỉ báo MACD (Phân kỳ và Hội tụ Trung bình Động)
      * 
+     * @param data Array of stock data points (Mảng các điểm dữ liệu chứng khoán)
+     * @return MACDResult object containing MACD line, signal line, and histogram values
+     *         (Đối tượng MACDResult chứa các giá trị đường MACD, đường tín hiệu và histogram)
+     */
+    public static MACDResult calculateMACD(DataUtils.StockData[] data) {
+        return calculateMACD(StockSeries.fromStockData(data));
+    }
+    
+    /**
+     * Calculate MACD with custom parameters
+     * Tính MACD với các tham số tùy chỉnh
+     * 
+     * @param data Array of stock data points (Mảng các điểm dữ liệu chứng khoán)
+     * @param fastPeriod Period for fast EMA (Kỳ hạn cho EMA nhanh)
+     * @param slowPeriod Period for slow EMA (Kỳ hạn cho EMA chậm)
+     * @param signalPeriod Period for signal line EMA (Kỳ hạn cho EMA đường tín hiệu)
+     * @return MACDResult object containing the calculation results (Đối tượng MACDResult chứa kết quả tính toán)
+     */
+    public static MACDResult calculateMACD(DataUtils.StockData[] data, int fastPeriod, int slowPeriod, int signalPeriod) {
+        return calculateMACD(StockSeries.fromStockData(data), fastPeriod, slowPeriod, signalPeriod);
+    }
+    
+    /**
+     * Calculate MACD (Moving Average Convergence Divergence) of a series
+     * Tính chỉ báo MACD (Phân kỳ và Hội tụ Trung bình Động) của một chuỗi
+     * 
      * Algorithm:
      * 1. Calculate the fast EMA (typically 12-period)
      * 2. Calculate the slow EMA (typically 26-period)
@@ -1363,67 +1340,59 @@ public class DataMining { // Class definition (Định nghĩa lớp)
      * - Đường MACD cắt xuống dưới mức 0: Tín hiệu giảm giá mạnh
      * - Phân kỳ giữa MACD và giá: Khả năng đảo chiều
      * 
-     * @param data Array of stock data points (Mảng các điểm dữ liệu chứng khoán)
+     * @param series Columnar price series (Chuỗi giá dạng cột)
      * @return MACDResult object containing MACD line, signal line, and histogram values
      *         (Đối tượng MACDResult chứa các giá trị đường MACD, đường tín hiệu và histogram)
      */
-    public static MACDResult calculateMACD(DataUtils.StockData[] data) {
+    public static MACDResult calculateMACD(StockSeries series) {
         // Default MACD parameters: 12-day EMA, 26-day EMA, 9-day signal
         // Tham số MACD mặc định: EMA 12 ngày, EMA 26 ngày, tín hiệu 9 ngày
-        return calculateMACD(data, 12, 26, 9);
+        return calculateMACD(series, 12, 26, 9);
     }
     
     /**
-     * Calculate MACD with custom parameters
-     * Tính MACD với các tham số tùy chỉnh
+     * Calculate MACD of a series with custom parameters
+     * Tính MACD của một chuỗi với các tham số tùy chỉnh
      * 
-     * @param data Array of stock data points (Mảng các điểm dữ liệu chứng khoán)
+     * @param series Columnar price series (Chuỗi giá dạng cột)
      * @param fastPeriod Period for fast EMA (Kỳ hạn cho EMA nhanh)
      * @param slowPeriod Period for slow EMA (Kỳ hạn cho EMA chậm)
      * @param signalPeriod Period for signal line EMA (Kỳ hạn cho EMA đường tín hiệu)
      * @return MACDResult object containing the calculation results (Đối tượng MACDResult chứa kết quả tính toán)
      */
-    public static MACDResult calculateMACD(DataUtils.StockData[] data, int fastPeriod, int slowPeriod, int signalPeriod) {
-        MACDResult result = new MACDResult(data.length);
-        
+    public static MACDResult calculateMACD(StockSeries series, int fastPeriod, int slowPeriod, int signalPeriod) {
+        double[] close = series.closes();
+        int n = close.length;
+        MACDResult result = new MACDResult(n);
+    
         // 1. Calculate fast and slow EMAs
         // 1. Tính EMA nhanh và EMA chậm
-        double[] fastEMA = calculateEMA(data, fastPeriod);
-        double[] slowEMA = calculateEMA(data, slowPeriod);
-        
+        double[] fastEMA = exponentialAverage(close, fastPeriod);
+        double[] slowEMA = exponentialAverage(close, slowPeriod);
+    
         // 2. Calculate MACD line (fast EMA - slow EMA)
         // 2. Tính đường MACD (EMA nhanh - EMA chậm)
-        double[] macdLine = new double[data.length];
-        for (int i = 0; i < data.length; i++) {
-            macdLine[i] = fastEMA[i] - slowEMA[i];
-            result.macdLine[i] = macdLine[i];
-        }
-        
-        // 3. Calculate signal line (9-period EMA of MACD line)
-        // 3. Tính đường tín hiệu (EMA 9 kỳ của đường MACD)
-        // For signal line calculation, we need to create a synthetic array of data objects
-        // Để tính đường tín hiệu, chúng ta cần tạo một mảng dữ liệu tổng hợp
-        DataUtils.StockData[] macdData = new DataUtils.StockData[data.length];
-        for (int i = 0; i < data.length; i++) {
-            macdData[i] = new DataUtils.StockData();
-            macdData[i].close = macdLine[i];
+        for (int i = 0; i < n; i++) {
+            result.macdLine[i] = fastEMA[i] - slowEMA[i];
         }
-        
-        double[] signalLine = calculateEMA(macdData, signalPeriod);
-        
+    
+        // 3. Calculate signal line (9-period EMA of MACD line), directly on the column
+        // 3. Tính đường tín hiệu (EMA 9 kỳ của đường MACD), trực tiếp trên cột
+        double[] signalLine = exponentialAverage(result.macdLine, signalPeriod);
+    
         // 4. Calculate histogram (MACD line - Signal line)
         // 4. Tính histogram (Đường MACD - Đường tín hiệu)
-        for (int i = 0; i < data.length; i++) {
+        for (int i = 0; i < n; i++) {
             result.signalLine[i] = signalLine[i];
-            result.histogram[i] = macdLine[i] - signalLine[i];
+            result.histogram[i] = result.macdLine[i] - signalLine[i];
         }
-        
+    
         return result;
     }
     
     /**
-     * Calculate EMA (Exponential Moving Average)
-     * Tính chỉ báo EMA (Trung bình Động Mũ)
+     * Calculate EMA (Exponential Moving Average) of the closing prices of a series
+     * Tính chỉ báo EMA (Trung bình Động Mũ) của giá đóng cửa của một chuỗi
      * 
      * Algorithm:
      * 1. Calculate initial SMA (Simple Moving Average) for the first EMA value
@@ -1468,36 +1437,43 @@ public class DataMining { // Class definition (Định nghĩa lớp)
      * - EMA ngắn hạn cắt lên trên EMA dài hạn: Giao cắt tăng giá
      * - EMA ngắn hạn cắt xuống dưới EMA dài hạn: Giao cắt giảm giá
      * 
-     * @param data Array of stock data points (Mảng các điểm dữ liệu chứng khoán)
+     * @param series Columnar price series (Chuỗi giá dạng cột)
      * @param period EMA period (e.g., 12 for 12-day EMA) (Kỳ hạn EMA, ví dụ: 12 cho EMA 12 ngày)
-     * @return Array of EMA values corresponding to each data point (Mảng các giá trị EMA tương ứng với mỗi điểm dữ liệu)
+     * @return Array of EMA values, 0 before the first full period (Mảng các giá trị EMA tương ứng với mỗi điểm dữ liệu)
      */
-    private static double[] calculateEMA(DataUtils.StockData[] data, int period) {
-        double[] ema = new double[data.length];
-        Arrays.fill(ema, 0);
-        
-        if (data.length <= period) return ema;
-        
+    public static double[] calculateEMA(StockSeries series, int period) {
+        return exponentialAverage(series.closes(), period);
+    }
+    
+    /**
+     * EMA of any column, seeded with the SMA of its first 'period' values
+     * EMA của một cột bất kỳ, khởi tạo bằng SMA của 'period' giá trị đầu tiên
+     */
+    private static double[] exponentialAverage(double[] values, int period) {
+        double[] ema = new double[values.length];
+    
+        if (values.length <= period) return ema;
+    
         // Calculate initial SMA for the first EMA value
         // Tính SMA ban đầu cho giá trị EMA đầu tiên
         double sum = 0;
         for (int i = 0; i < period; i++) {
-            sum += data[i].close;
+            sum += values[i];
         }
         ema[period - 1] = sum / period;
-        
+    
         // Calculate multiplier: 2/(period+1)
         // Tính hệ số nhân: 2/(kỳ hạn+1)
         double multiplier = 2.0 / (period + 1);
-        
+    
         // Calculate EMA values for each subsequent point using the formula:
         // EMA = (Current Price - Previous EMA) * Multiplier + Previous EMA
         // Tính giá trị EMA cho mỗi điểm tiếp theo sử dụng công thức:
         // EMA = (Giá hiện tại - EMA trước đó) * Hệ số + EMA trước đó
-        for (int i = period; i < data.length; i++) {
-            ema[i] = (data[i].close - ema[i-1]) * multiplier + ema[i-1];
+        for (int i = period; i < values.length; i++) {
+            ema[i] = (values[i] - ema[i-1]) * multiplier + ema[i-1];
         }
-        
+    
         return ema;
     }
-} 
\ No newline at end of file
+}
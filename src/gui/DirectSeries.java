@@ -0,0 +1,172 @@
+package gui;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.time.LocalDate;
+import java.time.format.DateTimeParseException;
+
+/**
+ * Columnar price series in a direct ByteBuffer shared with native code
+ *
+ * The buffer holds capacity opens, highs, lows, closes and volumes as
+ * native-order doubles, followed by capacity int dates (days since
+ * 1970-01-01). This is the layout the C SeriesColumns use, so the
+ * *Direct methods of StockPredictJNIBridge read the bars in place instead
+ * of copying arrays and date strings on every call.
+ */
+public class DirectSeries {
+
+    /** Bytes one bar takes across all columns (five doubles and an int) */
+    public static final int BAR_BYTES = 5 * Double.BYTES + Integer.BYTES;
+
+    private static final int OPEN = 0;
+    private static final int HIGH = 1;
+    private static final int LOW = 2;
+    private static final int CLOSE = 3;
+    private static final int VOLUME = 4;
+
+    private ByteBuffer buffer;
+    private int capacity;
+    private int count;
+
+    /**
+     * Create an empty series
+     *
+     * @param capacity Bars to reserve
+     */
+    public DirectSeries(int capacity) {
+        allocate(Math.max(capacity, 16));
+    }
+
+    /**
+     * Create a series from parallel arrays
+     *
+     * @param dates Array of date strings (yyyy-MM-dd, optionally followed by a time)
+     * @param opens Array of opening prices
+     * @param highs Array of high prices
+     * @param lows Array of low prices
+     * @param closes Array of closing prices
+     * @param volumes Array of volume data
+     * @return Series holding the bars
+     */
+    public static DirectSeries fromArrays(String[] dates, double[] opens, double[] highs,
+                                         double[] lows, double[] closes, double[] volumes) {
+        DirectSeries series = new DirectSeries(closes.length);
+        for (int i = 0; i < closes.length; i++) {
+            series.append(dates[i], opens[i], highs[i], lows[i], closes[i], volumes[i]);
+        }
+        return series;
+    }
+
+    /**
+     * Convert a date string to days since 1970-01-01
+     *
+     * @param date Date string (yyyy-MM-dd, optionally followed by a time)
+     * @return Epoch day, or Integer.MIN_VALUE if the date does not parse
+     */
+    public static int toEpochDay(String date) {
+        if (date == null || date.length() < 10) {
+            return Integer.MIN_VALUE;
+        }
+        try {
+            return (int) LocalDate.parse(date.substring(0, 10)).toEpochDay();
+        } catch (DateTimeParseException e) {
+            return Integer.MIN_VALUE;
+        }
+    }
+
+    /**
+     * Append a bar; a date that does not parse repeats the previous bar's day
+     */
+    public void append(String date, double open, double high, double low, double close, double volume) {
+        int day = toEpochDay(date);
+        if (day == Integer.MIN_VALUE) {
+            day = count > 0 ? getDay(count - 1) : 0;
+        }
+        append(day, open, high, low, close, volume);
+    }
+
+    /**
+     * Append a bar dated by epoch day
+     */
+    public void append(int day, double open, double high, double low, double close, double volume) {
+        if (count == capacity) {
+            grow(capacity * 2);
+        }
+        setColumn(OPEN, count, open);
+        setColumn(HIGH, count, high);
+        setColumn(LOW, count, low);
+        setColumn(CLOSE, count, close);
+        setColumn(VOLUME, count, volume);
+        buffer.putInt(dayOffset(count), day);
+        count++;
+    }
+
+    public int size() {
+        return count;
+    }
+
+    public int capacity() {
+        return capacity;
+    }
+
+    /** The shared buffer; replaced when the series grows */
+    public ByteBuffer buffer() {
+        return buffer;
+    }
+
+    public double getOpen(int index) {
+        return getColumn(OPEN, index);
+    }
+
+    public double getHigh(int index) {
+        return getColumn(HIGH, index);
+    }
+
+    public double getLow(int index) {
+        return getColumn(LOW, index);
+    }
+
+    public double getClose(int index) {
+        return getColumn(CLOSE, index);
+    }
+
+    public double getVolume(int index) {
+        return getColumn(VOLUME, index);
+    }
+
+    public int getDay(int index) {
+        return buffer.getInt(dayOffset(index));
+    }
+
+    private void allocate(int newCapacity) {
+        buffer = ByteBuffer.allocateDirect(newCapacity * BAR_BYTES).order(ByteOrder.nativeOrder());
+        capacity = newCapacity;
+    }
+
+    private void grow(int newCapacity) {
+        ByteBuffer old = buffer;
+        int oldCapacity = capacity;
+        allocate(newCapacity);
+        for (int column = OPEN; column <= VOLUME; column++) {
+            for (int i = 0; i < count; i++) {
+                setColumn(column, i, old.getDouble((column * oldCapacity + i) * Double.BYTES));
+            }
+        }
+        for (int i = 0; i < count; i++) {
+            buffer.putInt(dayOffset(i), old.getInt(5 * oldCapacity * Double.BYTES + i * Integer.BYTES));
+        }
+    }
+
+    private double getColumn(int column, int index) {
+        return buffer.getDouble((column * capacity + index) * Double.BYTES);
+    }
+
+    private void setColumn(int column, int index, double value) {
+        buffer.putDouble((column * capacity + index) * Double.BYTES, value);
+    }
+
+    private int dayOffset(int index) {
+        return 5 * capacity * Double.BYTES + index * Integer.BYTES;
+    }
+}
@@ -0,0 +1,90 @@
+package gui;
+
+/**
+ * Handle to a series loaded into native memory through StockPredictJNIBridge
+ *
+ * Analyses run against the native copy, so the bars cross JNI once and
+ * derived indicators stay cached between calls. Close the series (or use
+ * try-with-resources) to free the native memory.
+ */
+public class NativeSeries implements AutoCloseable {
+
+    private final StockPredictJNIBridge bridge;
+    private long handle;
+
+    NativeSeries(StockPredictJNIBridge bridge, long handle) {
+        this.bridge = bridge;
+        this.handle = handle;
+    }
+
+    public long handle() {
+        checkOpen();
+        return handle;
+    }
+
+    public int size() {
+        checkOpen();
+        return bridge.getSeriesSize(handle);
+    }
+
+    /**
+     * Append bars; cached indicators are extended on their next use
+     *
+     * @return 0 on success, negative on error
+     */
+    public int append(String[] dates, double[] opens, double[] highs,
+                      double[] lows, double[] closes, double[] volumes) {
+        checkOpen();
+        return bridge.appendBars(handle, dates, opens, highs, lows, closes, volumes, closes.length);
+    }
+
+    public double[][] detectPricePatterns() {
+        checkOpen();
+        return bridge.detectPricePatternsForSeries(handle);
+    }
+
+    public double[][] detectSMACrossoverSignals(int shortPeriod, int longPeriod) {
+        checkOpen();
+        return bridge.detectSMACrossoverSignalsForSeries(handle, shortPeriod, longPeriod);
+    }
+
+    public double[][] detectEMACrossoverSignals(int shortPeriod, int longPeriod) {
+        checkOpen();
+        return bridge.detectEMACrossoverSignalsForSeries(handle, shortPeriod, longPeriod);
+    }
+
+    public double[][] detectAnomalies() {
+        checkOpen();
+        return bridge.detectAnomaliesForSeries(handle);
+    }
+
+    public double[][] calculateIndicators(int[] indicators, int[] periods) {
+        checkOpen();
+        return bridge.calculateIndicatorsForSeries(handle, indicators, periods);
+    }
+
+    /**
+     * Run patterns, signals, anomalies and indicators in one native call
+     *
+     * @return true on success; result holds the output
+     */
+    public boolean analyzeAll(int smaShort, int smaLong, int emaShort, int emaLong,
+                              int[] indicators, int[] periods, AnalysisResult result) {
+        checkOpen();
+        return bridge.analyzeAll(handle, smaShort, smaLong, emaShort, emaLong, indicators, periods, result);
+    }
+
+    @Override
+    public void close() {
+        if (handle != 0) {
+            bridge.releaseSeries(handle);
+            handle = 0;
+        }
+    }
+
+    private void checkOpen() {
+        if (handle == 0) {
+            throw new IllegalStateException("Native series has been closed");
+        }
+    }
+}
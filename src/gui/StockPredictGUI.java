@@ -56,10 +56,15 @@ public class StockPredictGUI extends JFrame {
     
     // Data structures
     private List<StockData> stockDataList = new ArrayList<>();
+    private StockSeries stockSeries = new StockSeries(0); // Columnar copy for DataMining (Bản sao dạng cột cho DataMining)
     private List<PatternResult> patternsList = new ArrayList<>();
     private List<TradingSignal> signalsList = new ArrayList<>();
     private List<AnomalyResult> anomaliesList = new ArrayList<>();
     
+    // Runs analysis and chart building off the event dispatch thread
+    // Chạy phân tích và tạo biểu đồ ngoài luồng sự kiện
+    private final AnalysisExecutor analysisExecutor = new AnalysisExecutor();
+    
     // Add the class variables to support the above code
     private JPanel indicatorChartPanel;
     private JCheckBox smaCheckbox;
@@ -153,7 +158,30 @@ public class StockPredictGUI extends JFrame {
         statusPanel.setBorder(BorderFactory.createEtchedBorder());
         JLabel statusLabel = new JLabel("Ready");
         statusPanel.add(statusLabel, BorderLayout.WEST);
+        
+        // Progress of background jobs, shown while any is running
+        // Tiến trình của các công việc nền, hiển thị khi có công việc đang chạy
+        JPanel progressPanel = new JPanel(new FlowLayout(FlowLayout.RIGHT, 5, 0));
+        JProgressBar progressBar = new JProgressBar(0, 100);
+        progressBar.setStringPainted(true);
+        JButton cancelButton = new JButton("Cancel");
+        cancelButton.addActionListener(e -> analysisExecutor.cancelAll());
+        progressPanel.add(progressBar);
+        progressPanel.add(cancelButton);
+        progressPanel.setVisible(false);
+        statusPanel.add(progressPanel, BorderLayout.EAST);
         add(statusPanel, BorderLayout.SOUTH);
+        
+        analysisExecutor.setProgressListener((job, percent, stage) -> {
+            if (stage != null) {
+                statusLabel.setText(stage + "...");
+                progressBar.setValue(percent);
+                progressPanel.setVisible(true);
+            } else if (analysisExecutor.isIdle()) {
+                statusLabel.setText("Ready");
+                progressPanel.setVisible(false);
+            }
+        });
     }
     
     private JPanel createChartPanel() {
@@ -437,7 +465,11 @@ public class StockPredictGUI extends JFrame {
      * @throws IOException If there's an error reading the file (Nếu có lỗi khi đọc tệp)
      */
     private void loadStockDataFromFile(File file) throws IOException {
+        // Results computed for the previous data must not reach the new one
+        // Kết quả tính cho dữ liệu trước không được hiển thị trên dữ liệu mới
+        analysisExecutor.cancelAll();
         stockDataList.clear();
+        StockSeries series = new StockSeries(4096);
         
         try (BufferedReader reader = new BufferedReader(new FileReader(file))) {
             String line;
@@ -464,6 +496,7 @@ public class StockPredictGUI extends JFrame {
                         data.volume = Double.parseDouble(parts[5].trim());
                         
                         stockDataList.add(data);
+                        series.append(data.date, data.open, data.high, data.low, data.close, data.volume);
                     } catch (NumberFormatException e) {
                         System.err.println("Error parsing numeric data: " + line + " - " + e.getMessage());
                         // Skip this line and continue with the next
@@ -474,6 +507,9 @@ public class StockPredictGUI extends JFrame {
             }
         }
         
+        // Trim before publishing: background jobs then read the columns without copying
+        // Cắt gọn trước khi công bố: các công việc nền đọc cột mà không cần sao chép
+        stockSeries = series.trimToSize();
         System.out.println("Loaded " + stockDataList.size() + " data points from " + file.getName());
         
         // Check the first few entries for date format debugging
@@ -505,26 +541,46 @@ public class StockPredictGUI extends JFrame {
             return;
         }
         
+        StockSeries series = stockSeries;
+        analysisExecutor.start(analysisExecutor.newJob("price chart")
+            .step("Building price chart", () -> buildPriceDataset(series), this::showPriceChart)
+            .whenDone((cancelled, error) -> {
+                if (error != null) {
+                    error.printStackTrace();
+                }
+            }));
+    }
+    
+    /**
+     * Create the price time series; runs on the analysis executor
+     * Tạo chuỗi thời gian giá; chạy trên bộ thực thi phân tích
+     */
+    private static TimeSeriesCollection buildPriceDataset(StockSeries series) {
         // Create a time series for the stock data
         // Tạo chuỗi thời gian cho dữ liệu chứng khoán
-        TimeSeries series = new TimeSeries("Price");
+        TimeSeries timeSeries = new TimeSeries("Price");
+        Day[] days = toChartDays(series);
+        double[] closes = series.closes();
         
-        // Parse dates and add to series
-        // Phân tích ngày tháng và thêm vào chuỗi
-        for (StockData data : stockDataList) {
+        for (int i = 0; i < closes.length; i++) {
             try {
-                Day date = parseDateString(data.date);
-                // Add to series
-                series.add(date, data.close);
+                timeSeries.add(days[i], closes[i]);
             } catch (Exception e) {
                 // Log the error and continue with next data point
-                System.err.println("Error parsing date: " + data.date + " - " + e.getMessage());
+                System.err.println("Error adding price for " + days[i] + " - " + e.getMessage());
             }
         }
         
-        // Create dataset and chart
-        // Tạo bộ dữ liệu và biểu đồ
-        TimeSeriesCollection dataset = new TimeSeriesCollection(series);
+        return new TimeSeriesCollection(timeSeries);
+    }
+    
+    /**
+     * Show the price chart for a dataset built in the background
+     * Hiển thị biểu đồ giá cho bộ dữ liệu được tạo trong nền
+     */
+    private void showPriceChart(TimeSeriesCollection dataset) {
+        // Create chart
+        // Tạo biểu đồ
         JFreeChart chart = ChartFactory.createTimeSeriesChart(
             "Stock Price", // title
             "Date",        // x-axis label
@@ -550,78 +606,6 @@ public class StockPredictGUI extends JFrame {
         this.chartPanel.repaint();
     }
     
-    /**
-     * Parse a date string in various formats into a JFreeChart Day object
-     * Handles: 
-     * - ISO 8601 (YYYY-MM-DDThh:mm:ss)
-     * - YYYY-MM-DD
-     * - MM/DD/YYYY or DD/MM/YYYY
-     * 
-     * @param dateStr Date string to parse
-     * @return Day object representing the date
-     */
-    private Day parseDateString(String dateStr) {
-        if (dateStr == null || dateStr.isEmpty()) {
-            return new Day(); // Default to current date if empty
-        }
-        
-        try {
-            // Handle ISO 8601 format: YYYY-MM-DDThh:mm:ss
-            if (dateStr.contains("T")) {
-                String[] parts = dateStr.split("T");
-                if (parts.length >= 1) {
-                    String[] dateParts = parts[0].split("-");
-                    if (dateParts.length >= 3) {
-                        int year = Integer.parseInt(dateParts[0]);
-                        int month = Integer.parseInt(dateParts[1]);
-                        int day = Integer.parseInt(dateParts[2]);
-                        return new Day(day, month, year);
-                    }
-                }
-                System.err.println("Invalid ISO date format: " + dateStr);
-                return new Day(); // Default to current date
-            } 
-            // Handle YYYY-MM-DD format
-            else if (dateStr.contains("-")) {
-                String[] dateParts = dateStr.split("-");
-                if (dateParts.length >= 3) {
-                    int year = Integer.parseInt(dateParts[0]);
-                    int month = Integer.parseInt(dateParts[1]);
-                    int day = Integer.parseInt(dateParts[2]);
-                    return new Day(day, month, year);
-                }
-                System.err.println("Invalid date format (dashes): " + dateStr);
-                return new Day(); // Default to current date
-            } 
-            // Handle MM/DD/YYYY or DD/MM/YYYY format
-            else if (dateStr.contains("/")) {
-                String[] dateParts = dateStr.split("/");
-                if (dateParts.length >= 3) {
-                    // Assume MM/DD/YYYY format
-                    int month = Integer.parseInt(dateParts[0]);
-                    int day = Integer.parseInt(dateParts[1]);
-                    int year = Integer.parseInt(dateParts[2]);
-                    
-                    // Handle possible two-digit year
-                    if (year < 100) {
-                        year += 2000;
-                    }
-                    
-                    return new Day(day, month, year);
-                }
-                System.err.println("Invalid date format (slashes): " + dateStr);
-                return new Day(); // Default to current date
-            }
-            
-            // Unknown format
-            System.err.println("Unknown date format: " + dateStr);
-            return new Day(); // Default to current date
-        } catch (Exception e) {
-            System.err.println("Error parsing date: " + dateStr + " - " + e.getMessage());
-            return new Day(); // Default to current date
-        }
-    }
-    
     private void exportResults() {
         JFileChooser fileChooser = new JFileChooser();
         fileChooser.setDialogTitle("Export Results");
@@ -666,110 +650,144 @@ public class StockPredictGUI extends JFrame {
             return;
         }
         
-        // Convert internal StockData to DataUtils.StockData using reflection
-        // This avoids compatibility issues between different StockData classes
-        // Chuyển đổi StockData nội bộ sang DataUtils.StockData sử dụng phản chiếu
-        // Điều này tránh các vấn đề tương thích giữa các lớp StockData khác nhau
-        Object[] stockDataArray = stockDataList.toArray();
-        DataUtils.StockData[] dataArray = DataUtils.StockData.fromGUIStockDataArray(stockDataArray);
+        // The columnar series is built once while loading, so no per-run conversion is needed
+        // Chuỗi dạng cột được tạo một lần khi tải, nên không cần chuyển đổi mỗi lần chạy
+        StockSeries series = stockSeries;
         
-        // Use Java-based data mining implementation
-        // Sử dụng triển khai khai thác dữ liệu dựa trên Java
-        try {
+        // Clear the previous results; each table fills as soon as its detector finishes
+        // Xóa kết quả trước; mỗi bảng được điền ngay khi bộ phát hiện của nó hoàn tất
+        patternsList.clear();
+        signalsList.clear();
+        anomaliesList.clear();
+        updatePatternsList();
+        updateSignalsList();
+        updateAnomaliesList();
+        
+        // Use Java-based data mining implementation on the analysis executor
+        // Sử dụng triển khai khai thác dữ liệu dựa trên Java trên bộ thực thi phân tích
+        analysisExecutor.start(analysisExecutor.newJob("analysis")
             // Detect price patterns
             // Phát hiện mẫu hình giá
-            DataUtils.PatternResult[] detectedPatterns = DataMining.detectPricePatterns(dataArray);
-            patternsList.clear();
-            for (DataUtils.PatternResult pattern : detectedPatterns) {
-                PatternResult guiPattern = new PatternResult();
-                
-                // Map pattern type to string
-                // Ánh xạ loại mẫu hình thành chuỗi
-                switch(pattern.type) {
-                    case DataMining.PATTERN_SUPPORT:
-                        guiPattern.type = "Support";
-                        break;
-                    case DataMining.PATTERN_RESISTANCE:
-                        guiPattern.type = "Resistance";
-                        break;
-                    case DataMining.PATTERN_UPTREND:
-                        guiPattern.type = "Uptrend";
-                        break;
-                    case DataMining.PATTERN_DOWNTREND:
-                        guiPattern.type = "Downtrend";
-                        break;
-                    case DataMining.PATTERN_HEAD_AND_SHOULDERS:
-                        guiPattern.type = "Head & Shoulders";
-                        break;
-                    case DataMining.PATTERN_DOUBLE_TOP:
-                        guiPattern.type = "Double Top";
-                        break;
-                    case DataMining.PATTERN_DOUBLE_BOTTOM:
-                        guiPattern.type = "Double Bottom";
-                        break;
-                    default:
-                        guiPattern.type = "Unknown";
-                }
-                
-                guiPattern.startIndex = pattern.startIndex;
-                guiPattern.endIndex = pattern.endIndex;
-                guiPattern.confidence = pattern.confidence;
-                guiPattern.expectedMove = pattern.expectedMove;
-                guiPattern.description = pattern.description;
-                
-                patternsList.add(guiPattern);
-            }
-            
+            .step("Detecting price patterns",
+                  () -> DataMining.detectPricePatterns(series), this::showPatterns)
             // Detect SMA crossover signals (10-day and 30-day)
             // Phát hiện tín hiệu cắt nhau SMA (10 ngày và 30 ngày)
-            DataUtils.TradingSignal[] detectedSignals = DataMining.detectSMACrossoverSignals(dataArray, 10, 30);
-            signalsList.clear();
-            for (DataUtils.TradingSignal dmSignal : detectedSignals) {
-                TradingSignal signal = new TradingSignal();
-                signal.type = dmSignal.type;
-                signal.signalIndex = dmSignal.signalIndex;
-                signal.confidence = dmSignal.confidence;
-                signal.entryPrice = dmSignal.entryPrice;
-                signal.targetPrice = dmSignal.targetPrice;
-                signal.stopLossPrice = dmSignal.stopLossPrice;
-                signal.riskRewardRatio = dmSignal.riskRewardRatio;
-                signal.description = dmSignal.description;
-                signalsList.add(signal);
-            }
-            
+            .step("Detecting crossover signals",
+                  () -> DataMining.detectSMACrossoverSignals(series, 10, 30), this::showSignals)
             // Detect anomalies
             // Phát hiện bất thường
-            DataUtils.AnomalyResult[] detectedAnomalies = DataMining.detectAnomalies(dataArray);
-            anomaliesList.clear();
-            for (DataUtils.AnomalyResult dmAnomaly : detectedAnomalies) {
-                AnomalyResult anomaly = new AnomalyResult();
-                anomaly.index = dmAnomaly.index;
-                anomaly.score = dmAnomaly.score;
-                anomaly.priceDeviation = dmAnomaly.priceDeviation;
-                anomaly.volumeDeviation = dmAnomaly.volumeDeviation;
-                anomaly.description = dmAnomaly.description;
-                anomaliesList.add(anomaly);
-            }
+            .step("Detecting anomalies",
+                  () -> DataMining.detectAnomalies(series), this::showAnomalies)
+            .whenDone((cancelled, error) -> {
+                if (cancelled) {
+                    return;
+                }
+                if (error != null) {
+                    JOptionPane.showMessageDialog(this, 
+                                                 "Error during analysis: " + error.getMessage(),
+                                                 "Analysis Error", 
+                                                 JOptionPane.ERROR_MESSAGE);
+                    error.printStackTrace();
+                    return;
+                }
+                JOptionPane.showMessageDialog(this, 
+                                             "Analysis completed successfully.\n" +
+                                             "Found " + patternsList.size() + " patterns, " +
+                                             signalsList.size() + " signals, and " +
+                                             anomaliesList.size() + " anomalies.",
+                                             "Analysis Complete", 
+                                             JOptionPane.INFORMATION_MESSAGE);
+            }));
+    }
+    
+    /**
+     * Show detected price patterns in the patterns table
+     * Hiển thị các mẫu hình giá đã phát hiện trong bảng mẫu hình
+     */
+    private void showPatterns(DataUtils.PatternResult[] detectedPatterns) {
+        patternsList.clear();
+        for (DataUtils.PatternResult pattern : detectedPatterns) {
+            PatternResult guiPattern = new PatternResult();
             
-            // Refresh the UI with the analysis results
-            // Làm mới giao diện người dùng với kết quả phân tích
-            refreshData();
+            // Map pattern type to string
+            // Ánh xạ loại mẫu hình thành chuỗi
+            switch(pattern.type) {
+                case DataMining.PATTERN_SUPPORT:
+                    guiPattern.type = "Support";
+                    break;
+                case DataMining.PATTERN_RESISTANCE:
+                    guiPattern.type = "Resistance";
+                    break;
+                case DataMining.PATTERN_UPTREND:
+                    guiPattern.type = "Uptrend";
+                    break;
+                case DataMining.PATTERN_DOWNTREND:
+                    guiPattern.type = "Downtrend";
+                    break;
+                case DataMining.PATTERN_HEAD_AND_SHOULDERS:
+                    guiPattern.type = "Head & Shoulders";
+                    break;
+                case DataMining.PATTERN_INVERSE_HEAD_AND_SHOULDERS:
+                    guiPattern.type = "Inverse Head & Shoulders";
+                    break;
+                case DataMining.PATTERN_DOUBLE_TOP:
+                    guiPattern.type = "Double Top";
+                    break;
+                case DataMining.PATTERN_DOUBLE_BOTTOM:
+                    guiPattern.type = "Double Bottom";
+                    break;
+                default:
+                    guiPattern.type = "Unknown";
+            }
             
-            JOptionPane.showMessageDialog(this, 
-                                         "Analysis completed successfully.\n" +
-                                         "Found " + patternsList.size() + " patterns, " +
-                                         signalsList.size() + " signals, and " +
-                                         anomaliesList.size() + " anomalies.",
-                                         "Analysis Complete", 
-                                         JOptionPane.INFORMATION_MESSAGE);
+            guiPattern.startIndex = pattern.startIndex;
+            guiPattern.endIndex = pattern.endIndex;
+            guiPattern.confidence = pattern.confidence;
+            guiPattern.expectedMove = pattern.expectedMove;
+            guiPattern.description = pattern.description;
             
-        } catch (Exception e) {
-            JOptionPane.showMessageDialog(this, 
-                                         "Error during analysis: " + e.getMessage(),
-                                         "Analysis Error", 
-                                         JOptionPane.ERROR_MESSAGE);
-            e.printStackTrace();
+            patternsList.add(guiPattern);
         }
+        updatePatternsList();
+    }
+    
+    /**
+     * Show detected crossover signals in the signals table
+     * Hiển thị các tín hiệu cắt nhau đã phát hiện trong bảng tín hiệu
+     */
+    private void showSignals(DataUtils.TradingSignal[] detectedSignals) {
+        signalsList.clear();
+        for (DataUtils.TradingSignal dmSignal : detectedSignals) {
+            TradingSignal signal = new TradingSignal();
+            signal.type = dmSignal.type;
+            signal.signalIndex = dmSignal.signalIndex;
+            signal.confidence = dmSignal.confidence;
+            signal.entryPrice = dmSignal.entryPrice;
+            signal.targetPrice = dmSignal.targetPrice;
+            signal.stopLossPrice = dmSignal.stopLossPrice;
+            signal.riskRewardRatio = dmSignal.riskRewardRatio;
+            signal.description = dmSignal.description;
+            signalsList.add(signal);
+        }
+        updateSignalsList();
+    }
+    
+    /**
+     * Show detected anomalies in the anomalies table
+     * Hiển thị các bất thường đã phát hiện trong bảng bất thường
+     */
+    private void showAnomalies(DataUtils.AnomalyResult[] detectedAnomalies) {
+        anomaliesList.clear();
+        for (DataUtils.AnomalyResult dmAnomaly : detectedAnomalies) {
+            AnomalyResult anomaly = new AnomalyResult();
+            anomaly.index = dmAnomaly.index;
+            anomaly.score = dmAnomaly.score;
+            anomaly.priceDeviation = dmAnomaly.priceDeviation;
+            anomaly.volumeDeviation = dmAnomaly.volumeDeviation;
+            anomaly.description = dmAnomaly.description;
+            anomaliesList.add(anomaly);
+        }
+        updateAnomaliesList();
     }
     
     private void updatePatternsList() {
@@ -942,436 +960,489 @@ public class StockPredictGUI extends JFrame {
     /**
      * Refreshes indicator charts based on selected indicators and parameters
      * Làm mới các biểu đồ chỉ báo dựa trên các chỉ báo và tham số đã chọn
-     * 
+     *
      * Features:
      * 1. Creates time series for price and selected indicators
      * 2. Calculates indicators based on user-selected parameters
      * 3. Creates separate scales for indicators requiring different scales
      * 4. Generates JFreeChart with multiple datasets and renderers
-     * 
+     *
      * Tính năng:
      * 1. Tạo chuỗi thời gian cho giá và các chỉ báo đã chọn
      * 2. Tính toán các chỉ báo dựa trên tham số do người dùng chọn
      * 3. Tạo các thang đo riêng cho các chỉ báo yêu cầu thang đo khác nhau
      * 4. Tạo JFreeChart với nhiều bộ dữ liệu và trình hiển thị
+     *
+     * The selection is read here; the series are calculated on the analysis
+     * executor and the chart is created when they are ready.
+     * Lựa chọn được đọc tại đây; các chuỗi được tính trên bộ thực thi phân tích
+     * và biểu đồ được tạo khi chúng sẵn sàng.
      */
     private void refreshIndicators() {
         if (stockDataList.isEmpty()) {
-            JOptionPane.showMessageDialog(this, "No stock data loaded. Please load data first.", 
+            JOptionPane.showMessageDialog(this, "No stock data loaded. Please load data first.",
                 "Error", JOptionPane.WARNING_MESSAGE);
             return;
         }
         
-        try {
-            // Create a time series for the stock price
-            // Tạo chuỗi thời gian cho giá cổ phiếu
-            TimeSeries priceSeries = new TimeSeries("Price");
+        // Read the selected indicators and their parameters
+        // Đọc các chỉ báo đã chọn và tham số của chúng
+        IndicatorRequest request = new IndicatorRequest();
+        
+        if (smaCheckbox.isSelected()) {
+            try {
+                request.smaPeriod = Integer.parseInt(smaPeriodField.getText());
+                request.sma = true;
+            } catch (NumberFormatException e) {
+                JOptionPane.showMessageDialog(this, "Invalid SMA period. Please enter a valid number.",
+                    "Error", JOptionPane.WARNING_MESSAGE);
+            }
+        }
+        
+        if (emaCheckbox.isSelected()) {
+            try {
+                request.emaPeriod = Integer.parseInt(emaPeriodField.getText());
+                request.ema = true;
+            } catch (NumberFormatException e) {
+                JOptionPane.showMessageDialog(this, "Invalid EMA period. Please enter a valid number.",
+                    "Error", JOptionPane.WARNING_MESSAGE);
+            }
+        }
+        
+        request.bollinger = bollingerCheckbox.isSelected();
+        request.rsi = rsiCheckbox.isSelected();
+        request.macd = macdCheckbox.isSelected();
+        
+        if (request.macd) {
+            try {
+                request.macdFast = Integer.parseInt(macdFastField.getText());
+                request.macdSlow = Integer.parseInt(macdSlowField.getText());
+                request.macdSignal = Integer.parseInt(macdSignalField.getText());
+                request.macdValid = true;
+            } catch (NumberFormatException e) {
+                JOptionPane.showMessageDialog(this, "Invalid MACD parameters. Please enter valid numbers.",
+                    "Error", JOptionPane.WARNING_MESSAGE);
+            }
+        }
+        
+        StockSeries series = stockSeries;
+        analysisExecutor.start(analysisExecutor.newJob("indicators")
+            .step("Calculating indicators",
+                  () -> buildIndicatorDatasets(series, request),
+                  this::showIndicatorChart)
+            .whenDone((cancelled, error) -> {
+                if (error != null) {
+                    error.printStackTrace();
+                    JOptionPane.showMessageDialog(this, "Error creating indicator chart: " + error.getMessage(),
+                        "Error", JOptionPane.ERROR_MESSAGE);
+                }
+            }));
+    }
+    
+    /**
+     * Indicator selection read from the indicator panel
+     * Lựa chọn chỉ báo được đọc từ bảng chỉ báo
+     */
+    private static class IndicatorRequest {
+        boolean sma;
+        int smaPeriod;
+        boolean ema;
+        int emaPeriod;
+        boolean bollinger;
+        boolean rsi;
+        boolean macd;
+        boolean macdValid; // False if the MACD fields do not parse (False nếu tham số MACD không hợp lệ)
+        int macdFast;
+        int macdSlow;
+        int macdSignal;
+    }
+    
+    /**
+     * Indicator series calculated in the background
+     * Các chuỗi chỉ báo được tính trong nền
+     */
+    private static class IndicatorDatasets {
+        TimeSeriesCollection priceDataset;
+        TimeSeriesCollection secondaryDataset; // RSI/MACD, null if neither is selected
+        final List<String> warnings = new ArrayList<>(); // Shown when the chart is created
+    }
+    
+    /**
+     * Chart days of the series bars
+     * Các ngày biểu đồ của các thanh trong chuỗi
+     */
+    private static Day[] toChartDays(StockSeries series) {
+        int[] epochDays = series.days();
+        Day[] days = new Day[epochDays.length];
+        for (int i = 0; i < epochDays.length; i++) {
+            LocalDate date = LocalDate.ofEpochDay(epochDays[i]);
+            days[i] = new Day(date.getDayOfMonth(), date.getMonthValue(), date.getYear());
+        }
+        return days;
+    }
+    
+    /**
+     * Calculate the price and indicator series; runs on the analysis executor
+     * and must not touch Swing components
+     * Tính chuỗi giá và chỉ báo; chạy trên bộ thực thi phân tích và không được
+     * truy cập thành phần Swing
+     */
+    private static IndicatorDatasets buildIndicatorDatasets(StockSeries series, IndicatorRequest request) {
+        IndicatorDatasets result = new IndicatorDatasets();
+        double[] closes = series.closes();
+        Day[] days = toChartDays(series);
+        
+        // Create a time series for the stock price
+        // Tạo chuỗi thời gian cho giá cổ phiếu
+        TimeSeries priceSeries = new TimeSeries("Price");
+        
+        // Create datasets for selected indicators
+        // Tạo bộ dữ liệu cho các chỉ báo đã chọn
+        TimeSeriesCollection priceDataset = new TimeSeriesCollection();
+        priceDataset.addSeries(priceSeries);
+        result.priceDataset = priceDataset;
+        
+        // Additional dataset for indicators that need their own scale (RSI, MACD)
+        // Bộ dữ liệu bổ sung cho các chỉ báo cần thang đo riêng (RSI, MACD)
+        TimeSeriesCollection secondaryDataset = null;
+        if (request.rsi || request.macd) {
+            secondaryDataset = new TimeSeriesCollection();
+            result.secondaryDataset = secondaryDataset;
+        }
+        
+        // Add price data
+        // Thêm dữ liệu giá
+        for (int i = 0; i < closes.length; i++) {
+            try {
+                priceSeries.add(days[i], closes[i]);
+            } catch (Exception e) {
+                System.err.println("Error adding price for " + days[i] + " - " + e.getMessage());
+            }
+        }
+        
+        // Add the selected indicators
+        if (request.sma) {
+            int period = request.smaPeriod;
+            TimeSeries smaSeries = new TimeSeries("SMA(" + period + ")");
             
-            // Create datasets for selected indicators
-            // Tạo bộ dữ liệu cho các chỉ báo đã chọn
-            TimeSeriesCollection priceDataset = new TimeSeriesCollection();
-            priceDataset.addSeries(priceSeries);
+            // Calculate SMA
+            double[] sma = DataMining.calculateSMA(series, period);
+            
+            for (int i = period - 1; i < closes.length; i++) {
+                // Add to series
+                smaSeries.add(days[i], sma[i]);
+            }
             
-            // Additional dataset for indicators that need their own scale (RSI, MACD)
-            // Bộ dữ liệu bổ sung cho các chỉ báo cần thang đo riêng (RSI, MACD)
-            TimeSeriesCollection secondaryDataset = null;
+            priceDataset.addSeries(smaSeries);
+        }
+        
+        if (request.ema) {
+            int period = request.emaPeriod;
+            TimeSeries emaSeries = new TimeSeries("EMA(" + period + ")");
             
-            // Add price data
-            // Thêm dữ liệu giá
-            for (StockData data : stockDataList) {
-                try {
-                    Day date = parseDateString(data.date);
-                    priceSeries.add(date, data.close);
-                } catch (Exception e) {
-                    System.err.println("Error parsing date: " + data.date + " - " + e.getMessage());
-                }
+            // First EMA value is SMA
+            double sum = 0;
+            for (int i = 0; i < period; i++) {
+                sum += closes[i];
             }
+            double ema = sum / period;
             
-            // Check which indicators are selected and add them
-            if (smaCheckbox.isSelected()) {
-                try {
-                    int period = Integer.parseInt(smaPeriodField.getText());
-                    TimeSeries smaSeries = new TimeSeries("SMA(" + period + ")");
-                    
-                    // Calculate SMA
-                    double[] closes = new double[stockDataList.size()];
-                    for (int i = 0; i < stockDataList.size(); i++) {
-                        closes[i] = stockDataList.get(i).close;
-                    }
-                    
-                    for (int i = period - 1; i < stockDataList.size(); i++) {
-                        double sum = 0;
-                        for (int j = i - (period - 1); j <= i; j++) {
-                            sum += closes[j];
-                        }
-                        double sma = sum / period;
-                        
-                        // Add to series
-                        Day date = parseDateString(stockDataList.get(i).date);
-                        smaSeries.add(date, sma);
-                    }
-                    
-                    priceDataset.addSeries(smaSeries);
-                } catch (NumberFormatException e) {
-                    JOptionPane.showMessageDialog(this, "Invalid SMA period. Please enter a valid number.", 
-                        "Error", JOptionPane.WARNING_MESSAGE);
-                }
+            // Add first EMA point
+            emaSeries.add(days[period - 1], ema);
+            
+            // Calculate multiplier
+            double multiplier = 2.0 / (period + 1);
+            
+            // Calculate rest of EMA values
+            for (int i = period; i < closes.length; i++) {
+                ema = (closes[i] - ema) * multiplier + ema;
+                emaSeries.add(days[i], ema);
             }
             
-            if (emaCheckbox.isSelected()) {
-                try {
-                    int period = Integer.parseInt(emaPeriodField.getText());
-                    TimeSeries emaSeries = new TimeSeries("EMA(" + period + ")");
-                    
-                    // Calculate EMA
-                    double[] closes = new double[stockDataList.size()];
-                    for (int i = 0; i < stockDataList.size(); i++) {
-                        closes[i] = stockDataList.get(i).close;
+            priceDataset.addSeries(emaSeries);
+        }
+        
+        if (request.bollinger) {
+            try {
+                int period = 20; // Standard period
+                double stdDevMultiplier = 2.0; // Standard deviation multiplier
+                
+                TimeSeries upperBandSeries = new TimeSeries("Upper Bollinger Band");
+                TimeSeries middleBandSeries = new TimeSeries("Middle Bollinger Band");
+                TimeSeries lowerBandSeries = new TimeSeries("Lower Bollinger Band");
+                
+                // Running sums over the window, shifted by the first close so the squares stay small
+                // Tổng cộng dồn trên cửa sổ, dịch theo giá đóng cửa đầu tiên để bình phương nhỏ
+                double shift = closes.length > 0 ? closes[0] : 0;
+                double sum = 0;
+                double sumSquares = 0;
+                
+                for (int i = 0; i < closes.length; i++) {
+                    double value = closes[i] - shift;
+                    sum += value;
+                    sumSquares += value * value;
+                    if (i >= period) {
+                        double leaving = closes[i - period] - shift;
+                        sum -= leaving;
+                        sumSquares -= leaving * leaving;
                     }
-                    
-                    // First EMA value is SMA
-                    double sum = 0;
-                    for (int i = 0; i < period; i++) {
-                        sum += closes[i];
+                    if (i < period - 1) {
+                        continue;
                     }
-                    double ema = sum / period;
                     
-                    // Add first EMA point
-                    Day date = parseDateString(stockDataList.get(period - 1).date);
-                    emaSeries.add(date, ema);
+                    // Calculate SMA (middle band)
+                    double mean = sum / period;
+                    double sma = mean + shift;
                     
-                    // Calculate multiplier
-                    double multiplier = 2.0 / (period + 1);
+                    // Calculate standard deviation
+                    double stdDev = Math.sqrt(Math.max(0, sumSquares / period - mean * mean));
                     
-                    // Calculate rest of EMA values
-                    for (int i = period; i < stockDataList.size(); i++) {
-                        ema = (closes[i] - ema) * multiplier + ema;
-                        date = parseDateString(stockDataList.get(i).date);
-                        emaSeries.add(date, ema);
-                    }
+                    // Calculate upper and lower bands
+                    double upperBand = sma + (stdDevMultiplier * stdDev);
+                    double lowerBand = sma - (stdDevMultiplier * stdDev);
                     
-                    priceDataset.addSeries(emaSeries);
-                } catch (NumberFormatException e) {
-                    JOptionPane.showMessageDialog(this, "Invalid EMA period. Please enter a valid number.", 
-                        "Error", JOptionPane.WARNING_MESSAGE);
+                    // Add to series
+                    upperBandSeries.add(days[i], upperBand);
+                    middleBandSeries.add(days[i], sma);
+                    lowerBandSeries.add(days[i], lowerBand);
                 }
+                
+                priceDataset.addSeries(upperBandSeries);
+                priceDataset.addSeries(middleBandSeries);
+                priceDataset.addSeries(lowerBandSeries);
+            } catch (Exception e) {
+                result.warnings.add("Error calculating Bollinger Bands: " + e.getMessage());
             }
-            
-            if (bollingerCheckbox.isSelected()) {
-                try {
-                    int period = 20; // Standard period
-                    double stdDevMultiplier = 2.0; // Standard deviation multiplier
-                    
-                    TimeSeries upperBandSeries = new TimeSeries("Upper Bollinger Band");
-                    TimeSeries middleBandSeries = new TimeSeries("Middle Bollinger Band");
-                    TimeSeries lowerBandSeries = new TimeSeries("Lower Bollinger Band");
-                    
-                    // Calculate Bollinger Bands
-                    double[] closes = new double[stockDataList.size()];
-                    for (int i = 0; i < stockDataList.size(); i++) {
-                        closes[i] = stockDataList.get(i).close;
-                    }
-                    
-                    for (int i = period - 1; i < stockDataList.size(); i++) {
-                        // Calculate SMA (middle band)
-                        double sum = 0;
-                        for (int j = i - (period - 1); j <= i; j++) {
-                            sum += closes[j];
-                        }
-                        double sma = sum / period;
-                        
-                        // Calculate standard deviation
-                        double sumSquaredDiff = 0;
-                        for (int j = i - (period - 1); j <= i; j++) {
-                            double diff = closes[j] - sma;
-                            sumSquaredDiff += diff * diff;
-                        }
-                        double stdDev = Math.sqrt(sumSquaredDiff / period);
-                        
-                        // Calculate upper and lower bands
-                        double upperBand = sma + (stdDevMultiplier * stdDev);
-                        double lowerBand = sma - (stdDevMultiplier * stdDev);
-                        
-                        // Add to series
-                        Day date = parseDateString(stockDataList.get(i).date);
-                        upperBandSeries.add(date, upperBand);
-                        middleBandSeries.add(date, sma);
-                        lowerBandSeries.add(date, lowerBand);
-                    }
-                    
-                    priceDataset.addSeries(upperBandSeries);
-                    priceDataset.addSeries(middleBandSeries);
-                    priceDataset.addSeries(lowerBandSeries);
-                } catch (Exception e) {
-                    JOptionPane.showMessageDialog(this, "Error calculating Bollinger Bands: " + e.getMessage(), 
-                        "Error", JOptionPane.WARNING_MESSAGE);
+        }
+        
+        if (request.rsi) {
+            try {
+                int period = 14; // Standard RSI period
+                TimeSeries rsiSeries = new TimeSeries("RSI(" + period + ")");
+                
+                if (closes.length <= period) {
+                    throw new IllegalArgumentException("Not enough data points for RSI calculation");
                 }
-            }
-            
-            if (rsiCheckbox.isSelected()) {
-                try {
-                    if (secondaryDataset == null) {
-                        secondaryDataset = new TimeSeriesCollection();
-                    }
-                    
-                    int period = 14; // Standard RSI period
-                    TimeSeries rsiSeries = new TimeSeries("RSI(" + period + ")");
-                    
-                    // Extract price data
-                    double[] closes = new double[stockDataList.size()];
-                    for (int i = 0; i < stockDataList.size(); i++) {
-                        closes[i] = stockDataList.get(i).close;
-                    }
-                    
-                    if (closes.length <= period) {
-                        throw new IllegalArgumentException("Not enough data points for RSI calculation");
-                    }
-                    
-                    // Calculate gains and losses
-                    double[] gains = new double[closes.length];
-                    double[] losses = new double[closes.length];
-                    
-                    for (int i = 1; i < closes.length; i++) {
-                        double change = closes[i] - closes[i-1];
-                        if (change > 0) {
-                            gains[i] = change;
-                            losses[i] = 0;
-                        } else {
-                            gains[i] = 0;
-                            losses[i] = Math.abs(change);
-                        }
-                    }
-                    
-                    // Calculate initial averages
-                    double avgGain = 0;
-                    double avgLoss = 0;
-                    
-                    for (int i = 1; i <= period; i++) {
-                        avgGain += gains[i];
-                        avgLoss += losses[i];
+                
+                // Calculate gains and losses
+                double[] gains = new double[closes.length];
+                double[] losses = new double[closes.length];
+                
+                for (int i = 1; i < closes.length; i++) {
+                    double change = closes[i] - closes[i-1];
+                    if (change > 0) {
+                        gains[i] = change;
+                        losses[i] = 0;
+                    } else {
+                        gains[i] = 0;
+                        losses[i] = Math.abs(change);
                     }
-                    
-                    avgGain /= period;
-                    avgLoss /= period;
-                    
-                    // Calculate RSI
-                    double rs = 0;
-                    double rsi = 0;
+                }
+                
+                // Calculate initial averages
+                double avgGain = 0;
+                double avgLoss = 0;
+                
+                for (int i = 1; i <= period; i++) {
+                    avgGain += gains[i];
+                    avgLoss += losses[i];
+                }
+                
+                avgGain /= period;
+                avgLoss /= period;
+                
+                // Calculate RSI
+                double rs = 0;
+                double rsi = 0;
+                
+                if (avgLoss > 0) {
+                    rs = avgGain / avgLoss;
+                    rsi = 100 - (100 / (1 + rs));
+                } else {
+                    rsi = 100; // No losses, RSI = 100
+                }
+                
+                // Add first RSI value
+                rsiSeries.add(days[period], rsi);
+                
+                // Calculate remaining RSI values
+                for (int i = period + 1; i < closes.length; i++) {
+                    avgGain = ((avgGain * (period - 1)) + gains[i]) / period;
+                    avgLoss = ((avgLoss * (period - 1)) + losses[i]) / period;
                     
                     if (avgLoss > 0) {
                         rs = avgGain / avgLoss;
                         rsi = 100 - (100 / (1 + rs));
                     } else {
-                        rsi = 100; // No losses, RSI = 100
+                        rsi = 100; // No losses, RSI = a maximum 100
                     }
                     
-                    // Add first RSI value
-                    Day date = parseDateString(stockDataList.get(period).date);
-                    rsiSeries.add(date, rsi);
-                    
-                    // Calculate remaining RSI values
-                    for (int i = period + 1; i < closes.length; i++) {
-                        avgGain = ((avgGain * (period - 1)) + gains[i]) / period;
-                        avgLoss = ((avgLoss * (period - 1)) + losses[i]) / period;
-                        
-                        if (avgLoss > 0) {
-                            rs = avgGain / avgLoss;
-                            rsi = 100 - (100 / (1 + rs));
-                        } else {
-                            rsi = 100; // No losses, RSI = a maximum 100
-                        }
-                        
-                        date = parseDateString(stockDataList.get(i).date);
-                        rsiSeries.add(date, rsi);
-                    }
-                    
-                    secondaryDataset.addSeries(rsiSeries);
-                } catch (Exception e) {
-                    JOptionPane.showMessageDialog(this, "Error calculating RSI: " + e.getMessage(), 
-                        "Error", JOptionPane.WARNING_MESSAGE);
+                    rsiSeries.add(days[i], rsi);
                 }
+                
+                secondaryDataset.addSeries(rsiSeries);
+            } catch (Exception e) {
+                result.warnings.add("Error calculating RSI: " + e.getMessage());
             }
-            
-            if (macdCheckbox.isSelected()) {
-                try {
-                    if (secondaryDataset == null) {
-                        secondaryDataset = new TimeSeriesCollection();
-                    }
-                    
-                    int fastPeriod = Integer.parseInt(macdFastField.getText());
-                    int slowPeriod = Integer.parseInt(macdSlowField.getText());
-                    int signalPeriod = Integer.parseInt(macdSignalField.getText());
-                    
-                    TimeSeries macdSeries = new TimeSeries("MACD Line");
-                    TimeSeries signalSeries = new TimeSeries("Signal Line");
-                    TimeSeries histogramSeries = new TimeSeries("Histogram");
-                    
-                    // Extract price data
-                    double[] closes = new double[stockDataList.size()];
-                    for (int i = 0; i < stockDataList.size(); i++) {
-                        closes[i] = stockDataList.get(i).close;
-                    }
-                    
-                    // Calculate fast EMA
-                    double[] fastEMA = new double[closes.length];
-                    // First value is SMA
-                    double sum = 0;
-                    for (int i = 0; i < fastPeriod && i < closes.length; i++) {
-                        sum += closes[i];
-                    }
-                    fastEMA[fastPeriod-1] = sum / fastPeriod;
-                    
-                    // Calculate fast multiplier
-                    double fastMultiplier = 2.0 / (fastPeriod + 1);
-                    
-                    // Calculate rest of fast EMA values
-                    for (int i = fastPeriod; i < closes.length; i++) {
-                        fastEMA[i] = (closes[i] - fastEMA[i-1]) * fastMultiplier + fastEMA[i-1];
-                    }
-                    
-                    // Calculate slow EMA
-                    double[] slowEMA = new double[closes.length];
-                    // First value is SMA
+        }
+        
+        if (request.macd && request.macdValid) {
+            try {
+                int fastPeriod = request.macdFast;
+                int slowPeriod = request.macdSlow;
+                int signalPeriod = request.macdSignal;
+                
+                TimeSeries macdSeries = new TimeSeries("MACD Line");
+                TimeSeries signalSeries = new TimeSeries("Signal Line");
+                TimeSeries histogramSeries = new TimeSeries("Histogram");
+                
+                // Calculate fast EMA
+                double[] fastEMA = new double[closes.length];
+                // First value is SMA
+                double sum = 0;
+                for (int i = 0; i < fastPeriod && i < closes.length; i++) {
+                    sum += closes[i];
+                }
+                fastEMA[fastPeriod-1] = sum / fastPeriod;
+                
+                // Calculate fast multiplier
+                double fastMultiplier = 2.0 / (fastPeriod + 1);
+                
+                // Calculate rest of fast EMA values
+                for (int i = fastPeriod; i < closes.length; i++) {
+                    fastEMA[i] = (closes[i] - fastEMA[i-1]) * fastMultiplier + fastEMA[i-1];
+                }
+                
+                // Calculate slow EMA
+                double[] slowEMA = new double[closes.length];
+                // First value is SMA
+                sum = 0;
+                for (int i = 0; i < slowPeriod && i < closes.length; i++) {
+                    sum += closes[i];
+                }
+                slowEMA[slowPeriod-1] = sum / slowPeriod;
+                
+                // Calculate slow multiplier
+                double slowMultiplier = 2.0 / (slowPeriod + 1);
+                
+                // Calculate rest of slow EMA values
+                for (int i = slowPeriod; i < closes.length; i++) {
+                    slowEMA[i] = (closes[i] - slowEMA[i-1]) * slowMultiplier + slowEMA[i-1];
+                }
+                
+                // Calculate MACD Line = Fast EMA - Slow EMA
+                // MACD line can only be calculated from the slow period onwards
+                double[] macdLine = new double[closes.length];
+                for (int i = slowPeriod - 1; i < closes.length; i++) {
+                    macdLine[i] = fastEMA[i] - slowEMA[i];
+                }
+                
+                // Calculate Signal Line (EMA of MACD Line)
+                double[] signalLine = new double[closes.length];
+                
+                // First signal value is SMA of MACD
+                int signalStart = slowPeriod - 1 + signalPeriod - 1;
+                if (signalStart < closes.length) {
                     sum = 0;
-                    for (int i = 0; i < slowPeriod && i < closes.length; i++) {
-                        sum += closes[i];
-                    }
-                    slowEMA[slowPeriod-1] = sum / slowPeriod;
-                    
-                    // Calculate slow multiplier
-                    double slowMultiplier = 2.0 / (slowPeriod + 1);
-                    
-                    // Calculate rest of slow EMA values
-                    for (int i = slowPeriod; i < closes.length; i++) {
-                        slowEMA[i] = (closes[i] - slowEMA[i-1]) * slowMultiplier + slowEMA[i-1];
-                    }
-                    
-                    // Calculate MACD Line = Fast EMA - Slow EMA
-                    double[] macdLine = new double[closes.length];
-                    for (int i = 0; i < closes.length; i++) {
-                        macdLine[i] = 0; // Initialize
-                    }
-                    
-                    // MACD line can only be calculated from the slow period onwards
-                    for (int i = slowPeriod - 1; i < closes.length; i++) {
-                        macdLine[i] = fastEMA[i] - slowEMA[i];
+                    for (int i = slowPeriod - 1; i <= signalStart; i++) {
+                        sum += macdLine[i];
                     }
+                    signalLine[signalStart] = sum / signalPeriod;
                     
-                    // Calculate Signal Line (EMA of MACD Line)
-                    double[] signalLine = new double[closes.length];
-                    for (int i = 0; i < closes.length; i++) {
-                        signalLine[i] = 0; // Initialize
-                    }
+                    // Calculate signal multiplier
+                    double signalMultiplier = 2.0 / (signalPeriod + 1);
                     
-                    // First signal value is SMA of MACD
-                    int signalStart = slowPeriod - 1 + signalPeriod - 1;
-                    if (signalStart < closes.length) {
-                        sum = 0;
-                        for (int i = slowPeriod - 1; i <= signalStart; i++) {
-                            sum += macdLine[i];
-                        }
-                        signalLine[signalStart] = sum / signalPeriod;
-                        
-                        // Calculate signal multiplier
-                        double signalMultiplier = 2.0 / (signalPeriod + 1);
-                        
-                        // Calculate rest of signal values
-                        for (int i = signalStart + 1; i < closes.length; i++) {
-                            signalLine[i] = (macdLine[i] - signalLine[i-1]) * signalMultiplier + signalLine[i-1];
-                        }
+                    // Calculate rest of signal values
+                    for (int i = signalStart + 1; i < closes.length; i++) {
+                        signalLine[i] = (macdLine[i] - signalLine[i-1]) * signalMultiplier + signalLine[i-1];
                     }
-                    
-                    // Calculate histogram
-                    double[] histogram = new double[closes.length];
-                    for (int i = 0; i < closes.length; i++) {
-                        histogram[i] = macdLine[i] - signalLine[i];
-                    }
-                    
-                    // Add to series from where all values are available
-                    for (int i = signalStart; i < closes.length; i++) {
-                        Day date = parseDateString(stockDataList.get(i).date);
-                        macdSeries.add(date, macdLine[i]);
-                        signalSeries.add(date, signalLine[i]);
-                        histogramSeries.add(date, histogram[i]);
-                    }
-                    
-                    secondaryDataset.addSeries(macdSeries);
-                    secondaryDataset.addSeries(signalSeries);
-                    secondaryDataset.addSeries(histogramSeries);
-                } catch (NumberFormatException e) {
-                    JOptionPane.showMessageDialog(this, "Invalid MACD parameters. Please enter valid numbers.", 
-                        "Error", JOptionPane.WARNING_MESSAGE);
-                } catch (Exception e) {
-                    JOptionPane.showMessageDialog(this, "Error calculating MACD: " + e.getMessage(), 
-                        "Error", JOptionPane.WARNING_MESSAGE);
                 }
-            }
-            
-            // Create the chart
-            // Tạo biểu đồ
-            JFreeChart chart;
-            
-            if (secondaryDataset != null && 
-                (rsiCheckbox.isSelected() || macdCheckbox.isSelected())) {
-                // Create a chart with two vertical axes for price and indicators
-                // Tạo biểu đồ với hai trục dọc cho giá và chỉ báo
-                chart = ChartFactory.createTimeSeriesChart(
-                    "Technical Indicators", // title
-                    "Date",                 // x-axis label
-                    "Price",                // y-axis label
-                    priceDataset,           // primary dataset
-                    true,                   // legend
-                    true,                   // tooltips
-                    false                   // urls
-                );
                 
-                // Get the plot and add a second axis for RSI/MACD
-                // Lấy đồ thị và thêm trục thứ hai cho RSI/MACD
-                org.jfree.chart.plot.XYPlot plot = chart.getXYPlot();
-                org.jfree.chart.axis.NumberAxis axis2 = new org.jfree.chart.axis.NumberAxis("Indicator Value");
-                axis2.setAutoRangeIncludesZero(false);
-                plot.setRangeAxis(1, axis2);
-                plot.setDataset(1, secondaryDataset);
-                plot.mapDatasetToRangeAxis(1, 1);
+                // Add to series from where all values are available
+                for (int i = signalStart; i < closes.length; i++) {
+                    macdSeries.add(days[i], macdLine[i]);
+                    signalSeries.add(days[i], signalLine[i]);
+                    histogramSeries.add(days[i], macdLine[i] - signalLine[i]);
+                }
                 
-                // Add renderer for second dataset
-                // Thêm trình hiển thị cho bộ dữ liệu thứ hai
-                org.jfree.chart.renderer.xy.XYLineAndShapeRenderer renderer2 = 
-                    new org.jfree.chart.renderer.xy.XYLineAndShapeRenderer();
-                plot.setRenderer(1, renderer2);
-            } else {
-                // Create a simple chart with just price and price-related indicators
-                // Tạo biểu đồ đơn giản chỉ với giá và các chỉ báo liên quan đến giá
-                chart = ChartFactory.createTimeSeriesChart(
-                    "Technical Indicators", // title
-                    "Date",                 // x-axis label
-                    "Price",                // y-axis label
-                    priceDataset,           // data
-                    true,                   // legend
-                    true,                   // tooltips
-                    false                   // urls
-                );
+                secondaryDataset.addSeries(macdSeries);
+                secondaryDataset.addSeries(signalSeries);
+                secondaryDataset.addSeries(histogramSeries);
+            } catch (Exception e) {
+                result.warnings.add("Error calculating MACD: " + e.getMessage());
             }
+        }
+        
+        return result;
+    }
+    
+    /**
+     * Create the indicator chart from the calculated series
+     * Tạo biểu đồ chỉ báo từ các chuỗi đã tính
+     */
+    private void showIndicatorChart(IndicatorDatasets datasets) {
+        for (String warning : datasets.warnings) {
+            JOptionPane.showMessageDialog(this, warning, "Error", JOptionPane.WARNING_MESSAGE);
+        }
+        
+        // Create the chart
+        // Tạo biểu đồ
+        JFreeChart chart;
+        
+        if (datasets.secondaryDataset != null) {
+            // Create a chart with two vertical axes for price and indicators
+            // Tạo biểu đồ với hai trục dọc cho giá và chỉ báo
+            chart = ChartFactory.createTimeSeriesChart(
+                "Technical Indicators", // title
+                "Date",                 // x-axis label
+                "Price",                // y-axis label
+                datasets.priceDataset,  // primary dataset
+                true,                   // legend
+                true,                   // tooltips
+                false                   // urls
+            );
             
-            // Create chart panel
-            // Tạo bảng điều khiển biểu đồ
-            ChartPanel chartPanel = new ChartPanel(chart);
-            chartPanel.setPreferredSize(new Dimension(800, 500));
-            chartPanel.setDomainZoomable(true);
-            chartPanel.setRangeZoomable(true);
-            
-            // Replace the placeholder in the indicator chart panel
-            // Thay thế giữ chỗ trong bảng điều khiển biểu đồ chỉ báo
-            indicatorChartPanel.removeAll();
-            indicatorChartPanel.add(chartPanel, BorderLayout.CENTER);
-            indicatorChartPanel.revalidate();
-            indicatorChartPanel.repaint();
+            // Get the plot and add a second axis for RSI/MACD
+            // Lấy đồ thị và thêm trục thứ hai cho RSI/MACD
+            org.jfree.chart.plot.XYPlot plot = chart.getXYPlot();
+            org.jfree.chart.axis.NumberAxis axis2 = new org.jfree.chart.axis.NumberAxis("Indicator Value");
+            axis2.setAutoRangeIncludesZero(false);
+            plot.setRangeAxis(1, axis2);
+            plot.setDataset(1, datasets.secondaryDataset);
+            plot.mapDatasetToRangeAxis(1, 1);
             
-        } catch (Exception e) {
-            e.printStackTrace();
-            JOptionPane.showMessageDialog(this, "Error creating indicator chart: " + e.getMessage(), 
-                "Error", JOptionPane.ERROR_MESSAGE);
+            // Add renderer for second dataset
+            // Thêm trình hiển thị cho bộ dữ liệu thứ hai
+            org.jfree.chart.renderer.xy.XYLineAndShapeRenderer renderer2 =
+                new org.jfree.chart.renderer.xy.XYLineAndShapeRenderer();
+            plot.setRenderer(1, renderer2);
+        } else {
+            // Create a simple chart with just price and price-related indicators
+            // Tạo biểu đồ đơn giản chỉ với giá và các chỉ báo liên quan đến giá
+            chart = ChartFactory.createTimeSeriesChart(
+                "Technical Indicators", // title
+                "Date",                 // x-axis label
+                "Price",                // y-axis label
+                datasets.priceDataset,  // data
+                true,                   // legend
+                true,                   // tooltips
+                false                   // urls
+            );
         }
+        
+        // Create chart panel
+        // Tạo bảng điều khiển biểu đồ
+        ChartPanel chartPanel = new ChartPanel(chart);
+        chartPanel.setPreferredSize(new Dimension(800, 500));
+        chartPanel.setDomainZoomable(true);
+        chartPanel.setRangeZoomable(true);
+        
+        // Replace the placeholder in the indicator chart panel
+        // Thay thế giữ chỗ trong bảng điều khiển biểu đồ chỉ báo
+        indicatorChartPanel.removeAll();
+        indicatorChartPanel.add(chartPanel, BorderLayout.CENTER);
+        indicatorChartPanel.revalidate();
+        indicatorChartPanel.repaint();
     }
     
     private void viewSelectedPattern() {
@@ -1510,6 +1581,9 @@ public class StockPredictGUI extends JFrame {
                 case DataMining.PATTERN_HEAD_AND_SHOULDERS:
                     this.type = "Head & Shoulders";
                     break;
+                case DataMining.PATTERN_INVERSE_HEAD_AND_SHOULDERS:
+                    this.type = "Inverse Head & Shoulders";
+                    break;
                 case DataMining.PATTERN_DOUBLE_TOP:
                     this.type = "Double Top";
                     break;
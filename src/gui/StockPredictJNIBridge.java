@@ -1,5 +1,6 @@
 package gui;
 
+import java.nio.ByteBuffer;
 import java.util.List;
 import java.util.ArrayList;
 
@@ -137,6 +138,261 @@ public class StockPredictJNIBridge {
                                              double[] lows, double[] closes, double[] volumes, 
                                              int dataSize, int[] indicators, int[] periods);
     
+    /**
+     * Detect price patterns in a direct series buffer without copying it
+     * 
+     * @param series Direct buffer laid out by DirectSeries
+     * @param capacity Capacity of the series in bars
+     * @param dataSize Number of bars filled in
+     * @return Array of detected patterns in format [type, startIndex, endIndex, confidence, expectedMove]
+     */
+    public native double[][] detectPricePatternsDirect(ByteBuffer series, int capacity, int dataSize);
+    
+    /**
+     * Detect SMA crossover signals in a direct series buffer without copying it
+     * 
+     * @param series Direct buffer laid out by DirectSeries
+     * @param capacity Capacity of the series in bars
+     * @param dataSize Number of bars filled in
+     * @param shortPeriod Short period for SMA
+     * @param longPeriod Long period for SMA
+     * @return Array of detected signals in format [type, index, confidence, entryPrice, targetPrice, stopLossPrice, riskRewardRatio]
+     */
+    public native double[][] detectSMACrossoverSignalsDirect(ByteBuffer series, int capacity, int dataSize,
+                                                         int shortPeriod, int longPeriod);
+    
+    /**
+     * Detect EMA crossover signals in a direct series buffer without copying it
+     * 
+     * @param series Direct buffer laid out by DirectSeries
+     * @param capacity Capacity of the series in bars
+     * @param dataSize Number of bars filled in
+     * @param shortPeriod Short period for EMA
+     * @param longPeriod Long period for EMA
+     * @return Array of detected signals in format [type, index, confidence, entryPrice, targetPrice, stopLossPrice, riskRewardRatio]
+     */
+    public native double[][] detectEMACrossoverSignalsDirect(ByteBuffer series, int capacity, int dataSize,
+                                                         int shortPeriod, int longPeriod);
+    
+    /**
+     * Detect anomalies in a direct series buffer without copying it
+     * 
+     * @param series Direct buffer laid out by DirectSeries
+     * @param capacity Capacity of the series in bars
+     * @param dataSize Number of bars filled in
+     * @return Array of detected anomalies in format [index, score, priceDeviation, volumeDeviation]
+     */
+    public native double[][] detectAnomaliesDirect(ByteBuffer series, int capacity, int dataSize);
+    
+    /**
+     * Detect price patterns in a direct series
+     * 
+     * @param series Series to analyze
+     * @return Array of detected patterns in format [type, startIndex, endIndex, confidence, expectedMove]
+     */
+    public double[][] detectPricePatterns(DirectSeries series) {
+        return detectPricePatternsDirect(series.buffer(), series.capacity(), series.size());
+    }
+    
+    /**
+     * Detect SMA crossover signals in a direct series
+     * 
+     * @param series Series to analyze
+     * @param shortPeriod Short period for SMA
+     * @param longPeriod Long period for SMA
+     * @return Array of detected signals in format [type, index, confidence, entryPrice, targetPrice, stopLossPrice, riskRewardRatio]
+     */
+    public double[][] detectSMACrossoverSignals(DirectSeries series, int shortPeriod, int longPeriod) {
+        return detectSMACrossoverSignalsDirect(series.buffer(), series.capacity(), series.size(),
+                                               shortPeriod, longPeriod);
+    }
+    
+    /**
+     * Detect EMA crossover signals in a direct series
+     * 
+     * @param series Series to analyze
+     * @param shortPeriod Short period for EMA
+     * @param longPeriod Long period for EMA
+     * @return Array of detected signals in format [type, index, confidence, entryPrice, targetPrice, stopLossPrice, riskRewardRatio]
+     */
+    public double[][] detectEMACrossoverSignals(DirectSeries series, int shortPeriod, int longPeriod) {
+        return detectEMACrossoverSignalsDirect(series.buffer(), series.capacity(), series.size(),
+                                               shortPeriod, longPeriod);
+    }
+    
+    /**
+     * Detect anomalies in a direct series
+     * 
+     * @param series Series to analyze
+     * @return Array of detected anomalies in format [index, score, priceDeviation, volumeDeviation]
+     */
+    public double[][] detectAnomalies(DirectSeries series) {
+        return detectAnomaliesDirect(series.buffer(), series.capacity(), series.size());
+    }
+    
+    /**
+     * Load a series into native memory
+     * 
+     * The bars are converted once; every *ForSeries call then works on the
+     * native copy and shares its cached indicators until releaseSeries.
+     * 
+     * @param dates Array of date strings
+     * @param opens Array of opening prices
+     * @param highs Array of high prices
+     * @param lows Array of low prices
+     * @param closes Array of closing prices
+     * @param volumes Array of volume data
+     * @param dataSize Number of data points
+     * @return Series handle, 0 on error
+     */
+    public native long loadSeries(String[] dates, double[] opens, double[] highs,
+                                  double[] lows, double[] closes, double[] volumes, int dataSize);
+    
+    /**
+     * Load a direct series buffer into native memory
+     * 
+     * @param series Direct buffer laid out by DirectSeries
+     * @param capacity Capacity of the series in bars
+     * @param dataSize Number of bars filled in
+     * @return Series handle, 0 on error
+     */
+    public native long loadDirectSeries(ByteBuffer series, int capacity, int dataSize);
+    
+    /**
+     * Append bars to a loaded series
+     * 
+     * @param handle Series handle
+     * @param dates Array of date strings
+     * @param opens Array of opening prices
+     * @param highs Array of high prices
+     * @param lows Array of low prices
+     * @param closes Array of closing prices
+     * @param volumes Array of volume data
+     * @param count Number of bars to append
+     * @return 0 on success, negative on error
+     */
+    public native int appendBars(long handle, String[] dates, double[] opens, double[] highs,
+                                 double[] lows, double[] closes, double[] volumes, int count);
+    
+    /**
+     * Release a loaded series and its caches
+     * 
+     * @param handle Series handle
+     */
+    public native void releaseSeries(long handle);
+    
+    /**
+     * Number of bars in a loaded series
+     * 
+     * @param handle Series handle
+     * @return Bar count, negative if the handle is not loaded
+     */
+    public native int getSeriesSize(long handle);
+    
+    /**
+     * Detect price patterns in a loaded series
+     * 
+     * @param handle Series handle
+     * @return Array of detected patterns in format [type, startIndex, endIndex, confidence, expectedMove]
+     */
+    public native double[][] detectPricePatternsForSeries(long handle);
+    
+    /**
+     * Detect SMA crossover signals in a loaded series
+     * 
+     * @param handle Series handle
+     * @param shortPeriod Short period for SMA
+     * @param longPeriod Long period for SMA
+     * @return Array of detected signals in format [type, index, confidence, entryPrice, targetPrice, stopLossPrice, riskRewardRatio]
+     */
+    public native double[][] detectSMACrossoverSignalsForSeries(long handle, int shortPeriod, int longPeriod);
+    
+    /**
+     * Detect EMA crossover signals in a loaded series
+     * 
+     * @param handle Series handle
+     * @param shortPeriod Short period for EMA
+     * @param longPeriod Long period for EMA
+     * @return Array of detected signals in format [type, index, confidence, entryPrice, targetPrice, stopLossPrice, riskRewardRatio]
+     */
+    public native double[][] detectEMACrossoverSignalsForSeries(long handle, int shortPeriod, int longPeriod);
+    
+    /**
+     * Detect anomalies in a loaded series
+     * 
+     * @param handle Series handle
+     * @return Array of detected anomalies in format [index, score, priceDeviation, volumeDeviation]
+     */
+    public native double[][] detectAnomaliesForSeries(long handle);
+    
+    /**
+     * Calculate indicator columns of a loaded series
+     * 
+     * Columns are cached natively and only the bars appended since the
+     * previous request are computed.
+     * 
+     * @param handle Series handle
+     * @param indicators Indicator codes (0 SMA, 1 EMA, 2 RSI, 3 MACD, 4 MACD signal, 5 MACD histogram)
+     * @param periods Period of each indicator (ignored by the MACD family)
+     * @return One row per indicator with a value for each bar (empty for an invalid indicator)
+     */
+    public native double[][] calculateIndicatorsForSeries(long handle, int[] indicators, int[] periods);
+    
+    /**
+     * Run patterns, SMA and EMA signals, anomalies and indicators of a loaded series in one call
+     * 
+     * @param handle Series handle
+     * @param smaShort Short period for SMA
+     * @param smaLong Long period for SMA
+     * @param emaShort Short period for EMA
+     * @param emaLong Long period for EMA
+     * @param indicators Indicator codes (as for calculateIndicatorsForSeries)
+     * @param periods Period of each indicator
+     * @param maxResults Result capacity the buffers were sized for
+     * @param ints Int buffer of an AnalysisResult
+     * @param doubles Double buffer of an AnalysisResult
+     * @return 0 on success, negative on error
+     */
+    public native int analyzeAll(long handle, int smaShort, int smaLong, int emaShort, int emaLong,
+                                 int[] indicators, int[] periods, int maxResults,
+                                 int[] ints, double[] doubles);
+    
+    /**
+     * Run every analysis of a loaded series into reusable result buffers
+     * 
+     * @param handle Series handle
+     * @param smaShort Short period for SMA
+     * @param smaLong Long period for SMA
+     * @param emaShort Short period for EMA
+     * @param emaLong Long period for EMA
+     * @param indicators Indicator codes (as many as the result was sized for)
+     * @param periods Period of each indicator
+     * @param result Buffers to fill
+     * @return true on success
+     */
+    public boolean analyzeAll(long handle, int smaShort, int smaLong, int emaShort, int emaLong,
+                              int[] indicators, int[] periods, AnalysisResult result) {
+        if (indicators.length != result.indicatorCount()) {
+            throw new IllegalArgumentException("Result was sized for " + result.indicatorCount() + " indicators");
+        }
+        return analyzeAll(handle, smaShort, smaLong, emaShort, emaLong, indicators, periods,
+                          result.maxResults(), result.intBuffer(), result.doubleBuffer()) == 0;
+    }
+    
+    /**
+     * Load a series and wrap its handle
+     * 
+     * @param series Series to load
+     * @return Loaded series, to be closed when no longer needed
+     */
+    public NativeSeries openSeries(DirectSeries series) {
+        long handle = loadDirectSeries(series.buffer(), series.capacity(), series.size());
+        if (handle == 0) {
+            throw new IllegalStateException("Failed to load series into native memory");
+        }
+        return new NativeSeries(this, handle);
+    }
+    
     /**
      * Helper method to convert stock data objects to arrays for JNI calls
      * 
@@ -253,7 +509,7 @@ public class StockPredictJNIBridge {
     
     // Helper methods for conversion between numeric codes and string names
     
-    private String getPatternTypeName(int patternType) {
+    static String getPatternTypeName(int patternType) {
         switch (patternType) {
             case 1: return "Support";
             case 2: return "Resistance";
@@ -264,6 +520,8 @@ public class StockPredictJNIBridge {
             case 7: return "Uptrend";
             case 8: return "Downtrend";
             case 9: return "Head & Shoulders";
+            case 10: return "Reversal";
+            case 11: return "Inverse Head & Shoulders";
             default: return "Unknown";
         }
     }
@@ -0,0 +1,204 @@
+package gui; // Package declaration (Khai báo gói)
+
+import java.time.LocalDate;
+import java.util.Arrays;
+
+/**
+ * StockSeries - Columnar price series for the Java mining layer
+ * StockSeries - Chuỗi giá dạng cột cho lớp khai thác dữ liệu Java
+ *
+ * Bars are stored as parallel primitive columns (double[] prices and
+ * volumes, int[] dates as days since 1970-01-01) instead of one object
+ * per bar, so the DataMining scans walk contiguous arrays and nothing is
+ * converted or re-extracted per call.
+ *
+ * Các thanh giá được lưu thành các cột kiểu nguyên thủy song song (double[]
+ * cho giá và khối lượng, int[] cho ngày tính từ 1970-01-01) thay vì một đối
+ * tượng cho mỗi thanh, nên các vòng quét của DataMining duyệt mảng liên tục.
+ *
+ * Column accessors never modify the series, so a finished series can be
+ * read from several threads. After trimToSize() they return the backing
+ * arrays themselves (length size(), must not be modified); before that
+ * they return trimmed copies. Call trimToSize() once appending is done and
+ * before handing the series to other threads.
+ * Các hàm truy cập cột không bao giờ sửa đổi chuỗi, nên chuỗi đã hoàn tất
+ * có thể được đọc từ nhiều luồng. Sau trimToSize() chúng trả về chính các
+ * mảng nền (không được sửa đổi); trước đó chúng trả về bản sao đã cắt.
+ */
+public class StockSeries {
+
+    private double[] open;
+    private double[] high;
+    private double[] low;
+    private double[] close;
+    private double[] volume;
+    private int[] day;
+    private int count;
+
+    /**
+     * Create an empty series
+     * Tạo chuỗi rỗng
+     *
+     * @param capacity Bars to reserve (Số thanh cần dự trữ)
+     */
+    public StockSeries(int capacity) {
+        resize(Math.max(capacity, 16));
+    }
+
+    /**
+     * Create a series from DataUtils bars
+     * Tạo chuỗi từ các thanh DataUtils
+     *
+     * @param data Array of stock data points (Mảng các điểm dữ liệu chứng khoán)
+     * @return Series holding the bars (Chuỗi chứa các thanh)
+     */
+    public static StockSeries fromStockData(DataUtils.StockData[] data) {
+        StockSeries series = new StockSeries(data.length);
+        for (DataUtils.StockData bar : data) {
+            series.append(bar.date, bar.open, bar.high, bar.low, bar.close, bar.volume);
+        }
+        return series.trimToSize();
+    }
+
+    /**
+     * Convert a date string to days since 1970-01-01
+     * Chuyển chuỗi ngày thành số ngày kể từ 1970-01-01
+     *
+     * Accepts yyyy-M-d (optionally followed by a time) and M/d/yyyy with
+     * a two-digit year meaning 20yy, the formats of the GUI's CSV files.
+     *
+     * @param date Date string (Chuỗi ngày)
+     * @return Epoch day, or Integer.MIN_VALUE if the date does not parse
+     */
+    public static int toEpochDay(String date) {
+        if (date == null) {
+            return Integer.MIN_VALUE;
+        }
+        try {
+            if (date.indexOf('/') > 0) {
+                String[] parts = date.trim().split("/");
+                int year = Integer.parseInt(parts[2].trim());
+                if (year < 100) {
+                    year += 2000;
+                }
+                return (int) LocalDate.of(year, Integer.parseInt(parts[0].trim()),
+                                          Integer.parseInt(parts[1].trim())).toEpochDay();
+            }
+            int time = date.indexOf('T');
+            String[] parts = (time >= 0 ? date.substring(0, time) : date).trim().split("-");
+            return (int) LocalDate.of(Integer.parseInt(parts[0]), Integer.parseInt(parts[1]),
+                                      Integer.parseInt(parts[2].trim())).toEpochDay();
+        } catch (RuntimeException e) {
+            return DirectSeries.toEpochDay(date);
+        }
+    }
+
+    /**
+     * Append a bar; a date that does not parse repeats the previous bar's day
+     * Thêm một thanh; ngày không phân tích được sẽ lặp lại ngày của thanh trước
+     */
+    public void append(String date, double open, double high, double low, double close, double volume) {
+        int epochDay = toEpochDay(date);
+        if (epochDay == Integer.MIN_VALUE) {
+            epochDay = count > 0 ? day[count - 1] : 0;
+        }
+        append(epochDay, open, high, low, close, volume);
+    }
+
+    /**
+     * Append a bar dated by epoch day
+     * Thêm một thanh theo số ngày kể từ epoch
+     */
+    public void append(int epochDay, double open, double high, double low, double close, double volume) {
+        if (count == this.close.length) {
+            resize(Math.max(16, count * 2));
+        }
+        this.open[count] = open;
+        this.high[count] = high;
+        this.low[count] = low;
+        this.close[count] = close;
+        this.volume[count] = volume;
+        this.day[count] = epochDay;
+        count++;
+    }
+
+    public int size() {
+        return count;
+    }
+
+    public double[] opens() {
+        return open.length == count ? open : Arrays.copyOf(open, count);
+    }
+
+    public double[] highs() {
+        return high.length == count ? high : Arrays.copyOf(high, count);
+    }
+
+    public double[] lows() {
+        return low.length == count ? low : Arrays.copyOf(low, count);
+    }
+
+    public double[] closes() {
+        return close.length == count ? close : Arrays.copyOf(close, count);
+    }
+
+    public double[] volumes() {
+        return volume.length == count ? volume : Arrays.copyOf(volume, count);
+    }
+
+    /** Dates as days since 1970-01-01 (Ngày tính từ 1970-01-01) */
+    public int[] days() {
+        return day.length == count ? day : Arrays.copyOf(day, count);
+    }
+
+    public double getClose(int index) {
+        return close[index];
+    }
+
+    public int getDay(int index) {
+        return day[index];
+    }
+
+    /**
+     * Date of a bar as yyyy-MM-dd, built on demand for descriptions
+     * Ngày của một thanh dạng yyyy-MM-dd, chỉ tạo khi cần cho phần mô tả
+     */
+    public String getDate(int index) {
+        return LocalDate.ofEpochDay(day[index]).toString();
+    }
+
+    /**
+     * Copy the bars into a direct buffer for the JNI *Direct calls
+     * Sao chép các thanh vào bộ đệm trực tiếp cho các lời gọi JNI *Direct
+     */
+    public DirectSeries toDirectSeries() {
+        DirectSeries series = new DirectSeries(count);
+        for (int i = 0; i < count; i++) {
+            series.append(day[i], open[i], high[i], low[i], close[i], volume[i]);
+        }
+        return series;
+    }
+
+    /**
+     * Shrink the columns to size() so the accessors return them without copying
+     * Thu gọn các cột đúng size() để các hàm truy cập trả về mà không sao chép
+     *
+     * @return This series (Chuỗi này)
+     */
+    public StockSeries trimToSize() {
+        if (close.length != count) {
+            resize(count);
+        }
+        return this;
+    }
+
+    private void resize(int capacity) {
+        capacity = Math.max(capacity, count);
+        open = open == null ? new double[capacity] : Arrays.copyOf(open, capacity);
+        high = high == null ? new double[capacity] : Arrays.copyOf(high, capacity);
+        low = low == null ? new double[capacity] : Arrays.copyOf(low, capacity);
+        close = close == null ? new double[capacity] : Arrays.copyOf(close, capacity);
+        volume = volume == null ? new double[capacity] : Arrays.copyOf(volume, capacity);
+        day = day == null ? new int[capacity] : Arrays.copyOf(day, capacity);
+    }
+}
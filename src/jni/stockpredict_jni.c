@@ -10,8 +10,16 @@
 #include "../include/emers.h"
 #include "../include/data_mining.h"
 #include "../include/technical_analysis.h"
+#include "../include/series_columns.h"
+#include "../include/backtest.h"
+#include "../include/pattern_detection.h"
+#include "../include/anomaly_detection.h"
+#include "../include/series_session.h"
 #include "gui_StockPredictJNIBridge.h" // This will be generated by javah
 
+// Most patterns, signals or anomalies returned by one call
+#define JNI_MAX_RESULTS 20
+
 // Helper function to convert Java arrays to StockData
 static StockData* convertJavaArraysToStockData(JNIEnv *env, jobjectArray jdates, 
                                              jdoubleArray jopens, jdoubleArray jhighs, 
@@ -84,6 +92,85 @@ static jobjectArray create2DDoubleArray(JNIEnv *env, jdouble** data, int rows, i
     return result;
 }
 
+// Helper function to view a direct ByteBuffer laid out by DirectSeries as columns.
+// Nothing is copied: the kernels read the Java-owned memory in place.
+static int bindDirectSeries(JNIEnv *env, jobject jbuffer, jint capacity, jint count,
+                            SeriesColumns* series) {
+    void* memory = (*env)->GetDirectBufferAddress(env, jbuffer);
+    jlong bytes = (*env)->GetDirectBufferCapacity(env, jbuffer);
+    if (!memory || capacity <= 0 || bytes < (jlong)capacity * (jlong)SERIES_COLUMNS_BAR_BYTES ||
+        ((size_t)memory % sizeof(double)) != 0) {
+        return -1;
+    }
+
+    memset(series, 0, sizeof(SeriesColumns));
+    return bindSeriesColumns(series, memory, capacity, count);
+}
+
+// Helper function to create a Java 2D double array from row-major values
+static jobjectArray createRowsFromFlat(JNIEnv *env, const jdouble* values, int rows, int cols) {
+    jclass doubleArrayClass = (*env)->FindClass(env, "[D");
+    jobjectArray result = (*env)->NewObjectArray(env, rows, doubleArrayClass, NULL);
+    if (!result) {
+        return NULL;
+    }
+
+    for (int i = 0; i < rows; i++) {
+        jdoubleArray row = (*env)->NewDoubleArray(env, cols);
+        if (!row) {
+            return NULL;
+        }
+        (*env)->SetDoubleArrayRegion(env, row, 0, cols, values + (size_t)i * cols);
+        (*env)->SetObjectArrayElement(env, result, i, row);
+        (*env)->DeleteLocalRef(env, row);
+    }
+
+    return result;
+}
+
+// Helper function to return patterns as [type, startIndex, endIndex, confidence, expectedMove] rows
+static jobjectArray patternsToArray(JNIEnv *env, const MarketPattern* patterns, int count) {
+    jdouble values[JNI_MAX_RESULTS * 5];
+    for (int i = 0; i < count; i++) {
+        jdouble* row = values + i * 5;
+        row[0] = (jdouble)patterns[i].type;
+        row[1] = (jdouble)patterns[i].startIndex;
+        row[2] = (jdouble)patterns[i].endIndex;
+        row[3] = (jdouble)patterns[i].confidence;
+        row[4] = (jdouble)patterns[i].expectedMove;
+    }
+    return createRowsFromFlat(env, values, count, 5);
+}
+
+// Helper function to return signals as [type, index, confidence, entry, target, stop, riskReward] rows
+static jobjectArray signalsToArray(JNIEnv *env, const DMTradingSignal* signals, int count) {
+    jdouble values[JNI_MAX_RESULTS * 7];
+    for (int i = 0; i < count; i++) {
+        jdouble* row = values + i * 7;
+        row[0] = (jdouble)signals[i].type;
+        row[1] = (jdouble)signals[i].signalIndex;
+        row[2] = (jdouble)signals[i].confidence;
+        row[3] = (jdouble)signals[i].entryPrice;
+        row[4] = (jdouble)signals[i].targetPrice;
+        row[5] = (jdouble)signals[i].stopLossPrice;
+        row[6] = (jdouble)signals[i].riskRewardRatio;
+    }
+    return createRowsFromFlat(env, values, count, 7);
+}
+
+// Helper function to return anomalies as [index, score, priceDeviation, volumeDeviation] rows
+static jobjectArray anomaliesToArray(JNIEnv *env, const AnomalyResult* anomalies, int count) {
+    jdouble values[JNI_MAX_RESULTS * 4];
+    for (int i = 0; i < count; i++) {
+        jdouble* row = values + i * 4;
+        row[0] = (jdouble)anomalies[i].index;
+        row[1] = (jdouble)anomalies[i].score;
+        row[2] = (jdouble)anomalies[i].priceDeviation;
+        row[3] = (jdouble)anomalies[i].volumeDeviation;
+    }
+    return createRowsFromFlat(env, values, count, 4);
+}
+
 /*
  * Initialize the bridge
  */
@@ -98,7 +185,8 @@ JNIEXPORT jint JNICALL Java_gui_StockPredictJNIBridge_initializeBridge
  */
 JNIEXPORT void JNICALL Java_gui_StockPredictJNIBridge_cleanupBridge
   (JNIEnv *env, jobject obj) {
-    // Cleanup code here
+    // Release every series still loaded
+    closeAllSeriesSessions();
 }
 
 /*
@@ -124,6 +212,11 @@ JNIEXPORT jobjectArray JNICALL Java_gui_StockPredictJNIBridge_detectPricePattern
     
     // Detect patterns
     int patternCount = detectPricePatterns(data, dataSize, patterns, maxPatterns);
+    if (patternCount < 0) {
+        free(data);
+        free(patterns);
+        return NULL;
+    }
     
     // Create result array
     jdouble** resultData = (jdouble**)malloc(patternCount * sizeof(jdouble*));
@@ -151,7 +244,7 @@ JNIEXPORT jobjectArray JNICALL Java_gui_StockPredictJNIBridge_detectPricePattern
         resultData[i][1] = (jdouble)patterns[i].startIndex;
         resultData[i][2] = (jdouble)patterns[i].endIndex;
         resultData[i][3] = (jdouble)patterns[i].confidence;
-        resultData[i][4] = (jdouble)2.5; // Placeholder for expected move
+        resultData[i][4] = (jdouble)patterns[i].expectedMove;
     }
     
     // Create Java array
@@ -192,6 +285,11 @@ JNIEXPORT jobjectArray JNICALL Java_gui_StockPredictJNIBridge_detectSMACrossover
     
     // Detect signals
     int signalCount = detectSMACrossoverSignals(data, dataSize, shortPeriod, longPeriod, signals, maxSignals);
+    if (signalCount < 0) {
+        free(data);
+        free(signals);
+        return NULL;
+    }
     
     // Create result array
     jdouble** resultData = (jdouble**)malloc(signalCount * sizeof(jdouble*));
@@ -262,6 +360,11 @@ JNIEXPORT jobjectArray JNICALL Java_gui_StockPredictJNIBridge_detectEMACrossover
     
     // Detect signals
     int signalCount = detectEMACrossoverSignals(data, dataSize, shortPeriod, longPeriod, signals, maxSignals);
+    if (signalCount < 0) {
+        free(data);
+        free(signals);
+        return NULL;
+    }
     
     // Create result array
     jdouble** resultData = (jdouble**)malloc(signalCount * sizeof(jdouble*));
@@ -347,6 +450,11 @@ JNIEXPORT jobjectArray JNICALL Java_gui_StockPredictJNIBridge_detectAnomalies
     
     // Detect anomalies
     int anomalyCount = detectAnomalies(data, dataSize, anomalies, maxAnomalies);
+    if (anomalyCount < 0) {
+        free(data);
+        free(anomalies);
+        return NULL;
+    }
     
     // Create result array
     jdouble** resultData = (jdouble**)malloc(anomalyCount * sizeof(jdouble*));
@@ -477,4 +585,338 @@ JNIEXPORT jobjectArray JNICALL Java_gui_StockPredictJNIBridge_calculateIndicator
     (*env)->ReleaseIntArrayElements(env, jperiods, periods, JNI_ABORT);
     
     return result;
-} 
\ No newline at end of file
+} 
+
+/*
+ * Detect price patterns in a DirectSeries buffer
+ */
+JNIEXPORT jobjectArray JNICALL Java_gui_StockPredictJNIBridge_detectPricePatternsDirect
+  (JNIEnv *env, jobject obj, jobject jbuffer, jint capacity, jint dataSize) {
+    
+    SeriesColumns series;
+    if (bindDirectSeries(env, jbuffer, capacity, dataSize, &series) != 0) {
+        return NULL;
+    }
+    
+    MarketPattern patterns[JNI_MAX_RESULTS];
+    int patternCount = detectSeriesPatterns(&series, NULL, patterns, JNI_MAX_RESULTS);
+    if (patternCount < 0) {
+        return NULL;
+    }
+    
+    return patternsToArray(env, patterns, patternCount);
+}
+
+// Shared body of the direct crossover entry points
+static jobjectArray detectCrossoverSignalsDirect(JNIEnv *env, jobject jbuffer, jint capacity, jint dataSize,
+                                                 CrossoverType type, jint shortPeriod, jint longPeriod) {
+    SeriesColumns series;
+    if (bindDirectSeries(env, jbuffer, capacity, dataSize, &series) != 0) {
+        return NULL;
+    }
+    
+    CrossoverRule rule;
+    rule.type = type;
+    rule.shortPeriod = shortPeriod;
+    rule.longPeriod = longPeriod;
+    
+    DMTradingSignal signals[JNI_MAX_RESULTS];
+    int signalCount = generateCrossoverSignals(&series, &rule, NULL, signals, JNI_MAX_RESULTS);
+    if (signalCount < 0) {
+        return NULL;
+    }
+    
+    return signalsToArray(env, signals, signalCount);
+}
+
+/*
+ * Detect SMA crossover signals in a DirectSeries buffer
+ */
+JNIEXPORT jobjectArray JNICALL Java_gui_StockPredictJNIBridge_detectSMACrossoverSignalsDirect
+  (JNIEnv *env, jobject obj, jobject jbuffer, jint capacity, jint dataSize,
+   jint shortPeriod, jint longPeriod) {
+    return detectCrossoverSignalsDirect(env, jbuffer, capacity, dataSize, CROSSOVER_SMA, shortPeriod, longPeriod);
+}
+
+/*
+ * Detect EMA crossover signals in a DirectSeries buffer
+ */
+JNIEXPORT jobjectArray JNICALL Java_gui_StockPredictJNIBridge_detectEMACrossoverSignalsDirect
+  (JNIEnv *env, jobject obj, jobject jbuffer, jint capacity, jint dataSize,
+   jint shortPeriod, jint longPeriod) {
+    return detectCrossoverSignalsDirect(env, jbuffer, capacity, dataSize, CROSSOVER_EMA, shortPeriod, longPeriod);
+}
+
+/*
+ * Detect anomalies in a DirectSeries buffer
+ */
+JNIEXPORT jobjectArray JNICALL Java_gui_StockPredictJNIBridge_detectAnomaliesDirect
+  (JNIEnv *env, jobject obj, jobject jbuffer, jint capacity, jint dataSize) {
+    
+    SeriesColumns series;
+    if (bindDirectSeries(env, jbuffer, capacity, dataSize, &series) != 0) {
+        return NULL;
+    }
+    
+    AnomalyResult anomalies[JNI_MAX_RESULTS];
+    int anomalyCount = detectSeriesAnomalies(&series, NULL, anomalies, JNI_MAX_RESULTS);
+    if (anomalyCount < 0) {
+        return NULL;
+    }
+    
+    return anomaliesToArray(env, anomalies, anomalyCount);
+}
+
+/*
+ * Load a series into native memory and return its handle
+ */
+JNIEXPORT jlong JNICALL Java_gui_StockPredictJNIBridge_loadSeries
+  (JNIEnv *env, jobject obj, jobjectArray jdates, jdoubleArray jopens, jdoubleArray jhighs,
+   jdoubleArray jlows, jdoubleArray jcloses, jdoubleArray jvolumes, jint dataSize) {
+    
+    StockData* data = convertJavaArraysToStockData(env, jdates, jopens, jhighs, jlows, jcloses, jvolumes, dataSize);
+    if (!data) {
+        return INVALID_SERIES_HANDLE;
+    }
+    
+    SeriesHandle handle = openSeriesSession(data, dataSize);
+    free(data);
+    return (jlong)handle;
+}
+
+/*
+ * Load a DirectSeries buffer into native memory and return its handle
+ */
+JNIEXPORT jlong JNICALL Java_gui_StockPredictJNIBridge_loadDirectSeries
+  (JNIEnv *env, jobject obj, jobject jbuffer, jint capacity, jint dataSize) {
+    
+    SeriesColumns series;
+    if (bindDirectSeries(env, jbuffer, capacity, dataSize, &series) != 0) {
+        return INVALID_SERIES_HANDLE;
+    }
+    
+    return (jlong)openSeriesSessionColumns(&series);
+}
+
+/*
+ * Append bars to a loaded series
+ */
+JNIEXPORT jint JNICALL Java_gui_StockPredictJNIBridge_appendBars
+  (JNIEnv *env, jobject obj, jlong handle, jobjectArray jdates, jdoubleArray jopens, jdoubleArray jhighs,
+   jdoubleArray jlows, jdoubleArray jcloses, jdoubleArray jvolumes, jint count) {
+    
+    StockData* data = convertJavaArraysToStockData(env, jdates, jopens, jhighs, jlows, jcloses, jvolumes, count);
+    if (!data) {
+        return -1;
+    }
+    
+    SeriesSession* session = acquireSeriesSession((SeriesHandle)handle);
+    int result = session ? appendSessionBars(session, data, count) : -1;
+    releaseSeriesSession(session);
+    free(data);
+    return result;
+}
+
+/*
+ * Release a loaded series
+ */
+JNIEXPORT void JNICALL Java_gui_StockPredictJNIBridge_releaseSeries
+  (JNIEnv *env, jobject obj, jlong handle) {
+    closeSeriesSession((SeriesHandle)handle);
+}
+
+/*
+ * Number of bars in a loaded series
+ */
+JNIEXPORT jint JNICALL Java_gui_StockPredictJNIBridge_getSeriesSize
+  (JNIEnv *env, jobject obj, jlong handle) {
+    
+    SeriesSession* session = acquireSeriesSession((SeriesHandle)handle);
+    if (!session) {
+        return -1;
+    }
+    
+    int count = session->columns.count;
+    releaseSeriesSession(session);
+    return count;
+}
+
+/*
+ * Detect price patterns in a loaded series
+ */
+JNIEXPORT jobjectArray JNICALL Java_gui_StockPredictJNIBridge_detectPricePatternsForSeries
+  (JNIEnv *env, jobject obj, jlong handle) {
+    
+    SeriesSession* session = acquireSeriesSession((SeriesHandle)handle);
+    if (!session) {
+        return NULL;
+    }
+    
+    MarketPattern patterns[JNI_MAX_RESULTS];
+    int patternCount = getSessionPatterns(session, patterns, JNI_MAX_RESULTS);
+    releaseSeriesSession(session);
+    if (patternCount < 0) {
+        return NULL;
+    }
+    
+    return patternsToArray(env, patterns, patternCount);
+}
+
+// Shared body of the loaded-series crossover entry points
+static jobjectArray detectCrossoverSignalsForSeries(JNIEnv *env, jlong handle, CrossoverType type,
+                                                    jint shortPeriod, jint longPeriod) {
+    SeriesSession* session = acquireSeriesSession((SeriesHandle)handle);
+    if (!session) {
+        return NULL;
+    }
+    
+    CrossoverRule rule;
+    rule.type = type;
+    rule.shortPeriod = shortPeriod;
+    rule.longPeriod = longPeriod;
+    
+    DMTradingSignal signals[JNI_MAX_RESULTS];
+    int signalCount = getSessionCrossoverSignals(session, &rule, signals, JNI_MAX_RESULTS);
+    releaseSeriesSession(session);
+    if (signalCount < 0) {
+        return NULL;
+    }
+    
+    return signalsToArray(env, signals, signalCount);
+}
+
+/*
+ * Detect SMA crossover signals in a loaded series
+ */
+JNIEXPORT jobjectArray JNICALL Java_gui_StockPredictJNIBridge_detectSMACrossoverSignalsForSeries
+  (JNIEnv *env, jobject obj, jlong handle, jint shortPeriod, jint longPeriod) {
+    return detectCrossoverSignalsForSeries(env, handle, CROSSOVER_SMA, shortPeriod, longPeriod);
+}
+
+/*
+ * Detect EMA crossover signals in a loaded series
+ */
+JNIEXPORT jobjectArray JNICALL Java_gui_StockPredictJNIBridge_detectEMACrossoverSignalsForSeries
+  (JNIEnv *env, jobject obj, jlong handle, jint shortPeriod, jint longPeriod) {
+    return detectCrossoverSignalsForSeries(env, handle, CROSSOVER_EMA, shortPeriod, longPeriod);
+}
+
+/*
+ * Detect anomalies in a loaded series
+ */
+JNIEXPORT jobjectArray JNICALL Java_gui_StockPredictJNIBridge_detectAnomaliesForSeries
+  (JNIEnv *env, jobject obj, jlong handle) {
+    
+    SeriesSession* session = acquireSeriesSession((SeriesHandle)handle);
+    if (!session) {
+        return NULL;
+    }
+    
+    AnomalyResult anomalies[JNI_MAX_RESULTS];
+    int anomalyCount = getSessionAnomalies(session, anomalies, JNI_MAX_RESULTS);
+    releaseSeriesSession(session);
+    if (anomalyCount < 0) {
+        return NULL;
+    }
+    
+    return anomaliesToArray(env, anomalies, anomalyCount);
+}
+
+/*
+ * Calculate indicator columns of a loaded series from its cache
+ */
+JNIEXPORT jobjectArray JNICALL Java_gui_StockPredictJNIBridge_calculateIndicatorsForSeries
+  (JNIEnv *env, jobject obj, jlong handle, jintArray jindicators, jintArray jperiods) {
+    
+    jint indicatorCount = (*env)->GetArrayLength(env, jindicators);
+    if ((*env)->GetArrayLength(env, jperiods) < indicatorCount) {
+        return NULL;
+    }
+    
+    SeriesSession* session = acquireSeriesSession((SeriesHandle)handle);
+    if (!session) {
+        return NULL;
+    }
+    
+    jint* indicators = (*env)->GetIntArrayElements(env, jindicators, NULL);
+    jint* periods = (*env)->GetIntArrayElements(env, jperiods, NULL);
+    int count = session->columns.count;
+    
+    // One row per indicator with a value for each bar
+    jclass doubleArrayClass = (*env)->FindClass(env, "[D");
+    jobjectArray result = (*env)->NewObjectArray(env, indicatorCount, doubleArrayClass, NULL);
+    for (int i = 0; result && i < indicatorCount; i++) {
+        const double* values = getSessionIndicator(session, indicators[i], periods[i]);
+        jdoubleArray row = (*env)->NewDoubleArray(env, values ? count : 0);
+        if (!row) {
+            result = NULL;
+            break;
+        }
+        if (values) {
+            (*env)->SetDoubleArrayRegion(env, row, 0, count, values);
+        }
+        (*env)->SetObjectArrayElement(env, result, i, row);
+        (*env)->DeleteLocalRef(env, row);
+    }
+    
+    releaseSeriesSession(session);
+    (*env)->ReleaseIntArrayElements(env, jindicators, indicators, JNI_ABORT);
+    (*env)->ReleaseIntArrayElements(env, jperiods, periods, JNI_ABORT);
+    return result;
+}
+
+/*
+ * Run every analysis of a loaded series in one call, filling flat result buffers
+ * laid out as described by AnalysisLayout (mirrored by AnalysisResult.java)
+ */
+JNIEXPORT jint JNICALL Java_gui_StockPredictJNIBridge_analyzeAll
+  (JNIEnv *env, jobject obj, jlong handle, jint smaShort, jint smaLong, jint emaShort, jint emaLong,
+   jintArray jindicators, jintArray jperiods, jint maxResults, jintArray jints, jdoubleArray jdoubles) {
+    
+    AnalysisRequest request;
+    request.maxResults = maxResults;
+    request.smaRule.type = CROSSOVER_SMA;
+    request.smaRule.shortPeriod = smaShort;
+    request.smaRule.longPeriod = smaLong;
+    request.emaRule.type = CROSSOVER_EMA;
+    request.emaRule.shortPeriod = emaShort;
+    request.emaRule.longPeriod = emaLong;
+    request.indicatorCount = jindicators ? (*env)->GetArrayLength(env, jindicators) : 0;
+    if (maxResults <= 0 || request.indicatorCount > MAX_ANALYSIS_INDICATORS ||
+        (request.indicatorCount > 0 && (*env)->GetArrayLength(env, jperiods) < request.indicatorCount)) {
+        return -1;
+    }
+    if (request.indicatorCount > 0) {
+        (*env)->GetIntArrayRegion(env, jindicators, 0, request.indicatorCount, request.indicators);
+        (*env)->GetIntArrayRegion(env, jperiods, 0, request.indicatorCount, request.periods);
+    }
+    
+    AnalysisLayout layout;
+    initAnalysisLayout(&layout, maxResults, request.indicatorCount);
+    if ((*env)->GetArrayLength(env, jints) < layout.intCount ||
+        (*env)->GetArrayLength(env, jdoubles) < layout.doubleCount) {
+        return -1;
+    }
+    
+    // Stage both buffers natively so each crosses back in a single copy
+    jint* ints = (jint*)calloc(layout.intCount, sizeof(jint));
+    jdouble* doubles = (jdouble*)calloc(layout.doubleCount, sizeof(jdouble));
+    if (!ints || !doubles) {
+        free(ints);
+        free(doubles);
+        return -1;
+    }
+    
+    SeriesSession* session = acquireSeriesSession((SeriesHandle)handle);
+    int result = session ? analyzeSeriesSession(session, &request, ints, doubles) : -1;
+    releaseSeriesSession(session);
+    
+    if (result == 0) {
+        (*env)->SetIntArrayRegion(env, jints, 0, layout.intCount, ints);
+        (*env)->SetDoubleArrayRegion(env, jdoubles, 0, layout.doubleCount, doubles);
+    }
+    
+    free(ints);
+    free(doubles);
+    return result;
+}
@@ -0,0 +1,430 @@
+/**
+ * Keyword Matcher
+ * Aho-Corasick automaton for scanning news text against large keyword lexicons
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/keyword_matcher.h"
+#include "../include/error_handling.h"
+
+/* Initial capacities for keyword storage */
+#define INITIAL_KEYWORD_CAPACITY 64
+#define INITIAL_KEYWORD_TEXT_CAPACITY 1024
+
+/* Fold an ASCII byte to lowercase */
+static unsigned char foldByte(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c - 'A' + 'a') : c;
+}
+
+/* Letters, digits and any non-ASCII (UTF-8) byte count as part of a word */
+static int isWordByte(unsigned char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+           (c >= '0' && c <= '9') || c >= 0x80;
+}
+
+/* Release the compiled automaton, keeping the keywords */
+static void freeAutomaton(KeywordMatcher* matcher) {
+    free(matcher->transitions);
+    free(matcher->stateKeyword);
+    free(matcher->keywordNext);
+    free(matcher->outputLink);
+    matcher->transitions = NULL;
+    matcher->stateKeyword = NULL;
+    matcher->keywordNext = NULL;
+    matcher->outputLink = NULL;
+    matcher->stateCount = 0;
+    matcher->classCount = 0;
+    matcher->compiled = 0;
+}
+
+/* Initialize an empty keyword matcher */
+void initKeywordMatcher(KeywordMatcher* matcher) {
+    if (!matcher) {
+        return;
+    }
+    memset(matcher, 0, sizeof(KeywordMatcher));
+}
+
+/* Free all memory owned by a keyword matcher */
+void freeKeywordMatcher(KeywordMatcher* matcher) {
+    if (!matcher) {
+        return;
+    }
+
+    freeAutomaton(matcher);
+    free(matcher->keywordText);
+    free(matcher->keywordOffset);
+    free(matcher->keywordLength);
+    free(matcher->keywordLexicon);
+    free(matcher->keywordWeight);
+    memset(matcher, 0, sizeof(KeywordMatcher));
+}
+
+/* Grow the per-keyword arrays so that one more keyword fits */
+static int ensureKeywordCapacity(KeywordMatcher* matcher, int textBytes) {
+    if (matcher->keywordCount >= matcher->keywordCapacity) {
+        int newCapacity = matcher->keywordCapacity ? matcher->keywordCapacity * 2 : INITIAL_KEYWORD_CAPACITY;
+        int* newOffset = (int*)realloc(matcher->keywordOffset, newCapacity * sizeof(int));
+        if (newOffset) matcher->keywordOffset = newOffset;
+        int* newLength = (int*)realloc(matcher->keywordLength, newCapacity * sizeof(int));
+        if (newLength) matcher->keywordLength = newLength;
+        int* newLexicon = (int*)realloc(matcher->keywordLexicon, newCapacity * sizeof(int));
+        if (newLexicon) matcher->keywordLexicon = newLexicon;
+        double* newWeight = (double*)realloc(matcher->keywordWeight, newCapacity * sizeof(double));
+        if (newWeight) matcher->keywordWeight = newWeight;
+
+        if (!newOffset || !newLength || !newLexicon || !newWeight) {
+            return 0;
+        }
+        matcher->keywordCapacity = newCapacity;
+    }
+
+    if (matcher->keywordTextSize + textBytes > matcher->keywordTextCapacity) {
+        int newCapacity = matcher->keywordTextCapacity ? matcher->keywordTextCapacity : INITIAL_KEYWORD_TEXT_CAPACITY;
+        while (newCapacity < matcher->keywordTextSize + textBytes) {
+            newCapacity *= 2;
+        }
+        char* newText = (char*)realloc(matcher->keywordText, newCapacity);
+        if (!newText) {
+            return 0;
+        }
+        matcher->keywordText = newText;
+        matcher->keywordTextCapacity = newCapacity;
+    }
+
+    return 1;
+}
+
+/* Add a single keyword or phrase to the matcher */
+int addKeyword(KeywordMatcher* matcher, const char* keyword, int lexiconId, double weight) {
+    if (!matcher || !keyword) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for addKeyword");
+        return -1;
+    }
+
+    int length = (int)strlen(keyword);
+    if (length == 0 || length > MAX_KEYWORD_LENGTH) {
+        logError(ERR_INVALID_PARAMETER, "Keyword length must be between 1 and %d: '%s'",
+                 MAX_KEYWORD_LENGTH, keyword);
+        return -1;
+    }
+
+    if (!ensureKeywordCapacity(matcher, length)) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to grow keyword storage");
+        return -1;
+    }
+
+    /* Store the keyword folded so that compilation never has to fold again */
+    int id = matcher->keywordCount;
+    char* dest = matcher->keywordText + matcher->keywordTextSize;
+    for (int i = 0; i < length; i++) {
+        dest[i] = (char)foldByte((unsigned char)keyword[i]);
+    }
+
+    matcher->keywordOffset[id] = matcher->keywordTextSize;
+    matcher->keywordLength[id] = length;
+    matcher->keywordLexicon[id] = lexiconId;
+    matcher->keywordWeight[id] = weight;
+    matcher->keywordTextSize += length;
+    matcher->keywordCount++;
+
+    /* Any previous automaton is now stale */
+    if (matcher->compiled) {
+        freeAutomaton(matcher);
+    }
+
+    return id;
+}
+
+/* Add a whole list of keywords under one lexicon id with weight 1.0 */
+int addKeywordLexicon(KeywordMatcher* matcher, const char** keywords, int keywordCount, int lexiconId) {
+    if (!matcher || !keywords || keywordCount < 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for addKeywordLexicon");
+        return -1;
+    }
+
+    for (int i = 0; i < keywordCount; i++) {
+        if (addKeyword(matcher, keywords[i], lexiconId, 1.0) < 0) {
+            return -1;
+        }
+    }
+
+    return keywordCount;
+}
+
+/* Build the automaton from all added keywords */
+int compileKeywordMatcher(KeywordMatcher* matcher) {
+    if (!matcher) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for compileKeywordMatcher");
+        return -1;
+    }
+
+    freeAutomaton(matcher);
+
+    /* Reduce the alphabet to the bytes that actually occur in keywords.
+       Class 0 stands for every other byte and always leads back to the root. */
+    memset(matcher->classMap, 0, sizeof(matcher->classMap));
+    int classCount = 1;
+    for (int i = 0; i < matcher->keywordTextSize; i++) {
+        unsigned char c = (unsigned char)matcher->keywordText[i];
+        if (matcher->classMap[c] == 0) {
+            if (classCount > 255) {
+                logError(ERR_DATA_VALIDATION, "Keyword alphabet too large");
+                return -1;
+            }
+            matcher->classMap[c] = (unsigned char)classCount++;
+        }
+    }
+    /* Uppercase input shares the class of its lowercase letter, so scans never fold */
+    for (int c = 'A'; c <= 'Z'; c++) {
+        matcher->classMap[c] = matcher->classMap[c - 'A' + 'a'];
+    }
+    matcher->classCount = classCount;
+
+    /* Worst case every keyword byte creates a new trie state */
+    int maxStates = matcher->keywordTextSize + 1;
+    matcher->transitions = (int*)calloc((size_t)maxStates * classCount, sizeof(int));
+    matcher->stateKeyword = (int*)malloc(maxStates * sizeof(int));
+    matcher->outputLink = (int*)malloc(maxStates * sizeof(int));
+    matcher->keywordNext = (int*)malloc((matcher->keywordCount > 0 ? matcher->keywordCount : 1) * sizeof(int));
+    int* failure = (int*)malloc(maxStates * sizeof(int));
+    int* queue = (int*)malloc(maxStates * sizeof(int));
+
+    if (!matcher->transitions || !matcher->stateKeyword || !matcher->outputLink ||
+        !matcher->keywordNext || !failure || !queue) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate keyword automaton (%d states)", maxStates);
+        free(failure);
+        free(queue);
+        freeAutomaton(matcher);
+        return -1;
+    }
+
+    for (int s = 0; s < maxStates; s++) {
+        matcher->stateKeyword[s] = -1;
+        matcher->outputLink[s] = -1;
+    }
+
+    /* Phase 1: build the trie. State 0 is the root, so a 0 entry means "no child". */
+    int stateCount = 1;
+    int* trans = matcher->transitions;
+    for (int k = 0; k < matcher->keywordCount; k++) {
+        const unsigned char* word = (const unsigned char*)matcher->keywordText + matcher->keywordOffset[k];
+        int state = 0;
+        for (int i = 0; i < matcher->keywordLength[k]; i++) {
+            int* edge = &trans[state * classCount + matcher->classMap[word[i]]];
+            if (*edge == 0) {
+                *edge = stateCount++;
+            }
+            state = *edge;
+        }
+        matcher->keywordNext[k] = matcher->stateKeyword[state];
+        matcher->stateKeyword[state] = k;
+    }
+
+    /* Phase 2: breadth-first pass computing failure links, output links and
+       the completed DFA transitions */
+    int head = 0;
+    int tail = 0;
+    failure[0] = 0;
+    for (int c = 0; c < classCount; c++) {
+        int child = trans[c];
+        if (child != 0) {
+            failure[child] = 0;
+            queue[tail++] = child;
+        }
+    }
+
+    while (head < tail) {
+        int state = queue[head++];
+        int fail = failure[state];
+
+        for (int c = 0; c < classCount; c++) {
+            int* edge = &trans[state * classCount + c];
+            int fallback = trans[fail * classCount + c];
+            if (*edge != 0) {
+                int child = *edge;
+                failure[child] = fallback;
+                matcher->outputLink[child] = (matcher->stateKeyword[fallback] >= 0)
+                                             ? fallback : matcher->outputLink[fallback];
+                queue[tail++] = child;
+            } else {
+                *edge = fallback;
+            }
+        }
+    }
+
+    free(failure);
+    free(queue);
+
+    /* Trim the table to the states actually used */
+    if (stateCount < maxStates) {
+        int* trimmed = (int*)realloc(matcher->transitions, (size_t)stateCount * classCount * sizeof(int));
+        if (trimmed) {
+            matcher->transitions = trimmed;
+        }
+    }
+
+    matcher->stateCount = stateCount;
+    matcher->compiled = 1;
+
+    logMessage(LOG_DEBUG, "Compiled keyword matcher: %d keywords, %d states, %d classes",
+               matcher->keywordCount, stateCount, classCount);
+    return 0;
+}
+
+/* Single pass over the text shared by all scan entry points */
+static int runScan(const KeywordMatcher* matcher, const char* text,
+                   KeywordMatchCallback callback, void* context) {
+    if (!matcher || !text || !matcher->compiled) {
+        return 0;
+    }
+
+    const unsigned char* bytes = (const unsigned char*)text;
+    const int* trans = matcher->transitions;
+    const int classCount = matcher->classCount;
+    int matchCount = 0;
+    int state = 0;
+
+    for (int i = 0; bytes[i] != '\0'; i++) {
+        state = trans[state * classCount + matcher->classMap[bytes[i]]];
+
+        int outState = (matcher->stateKeyword[state] >= 0) ? state : matcher->outputLink[state];
+        if (outState < 0) {
+            continue;
+        }
+
+        /* The byte after the match is always readable: at worst it is the terminator */
+        if (isWordByte(bytes[i + 1])) {
+            continue;
+        }
+
+        for (; outState >= 0; outState = matcher->outputLink[outState]) {
+            for (int k = matcher->stateKeyword[outState]; k >= 0; k = matcher->keywordNext[k]) {
+                int start = i + 1 - matcher->keywordLength[k];
+                if (start > 0 && isWordByte(bytes[start - 1])) {
+                    continue;
+                }
+
+                if (callback) {
+                    KeywordMatch match;
+                    match.keywordId = k;
+                    match.lexiconId = matcher->keywordLexicon[k];
+                    match.start = start;
+                    match.length = matcher->keywordLength[k];
+                    match.weight = matcher->keywordWeight[k];
+                    callback(&match, context);
+                }
+                matchCount++;
+            }
+        }
+    }
+
+    return matchCount;
+}
+
+/* Collector used by scanKeywords */
+typedef struct {
+    KeywordMatch* matches;
+    int maxMatches;
+    int stored;
+} MatchCollector;
+
+static void collectMatch(const KeywordMatch* match, void* context) {
+    MatchCollector* collector = (MatchCollector*)context;
+    if (collector->stored < collector->maxMatches) {
+        collector->matches[collector->stored++] = *match;
+    }
+}
+
+/* Scan a NUL-terminated text in a single pass and collect matches */
+int scanKeywords(const KeywordMatcher* matcher, const char* text,
+                 KeywordMatch* matches, int maxMatches) {
+    if (!matches || maxMatches <= 0) {
+        return runScan(matcher, text, NULL, NULL);
+    }
+
+    MatchCollector collector = { matches, maxMatches, 0 };
+    return runScan(matcher, text, collectMatch, &collector);
+}
+
+/* Scan a NUL-terminated text and invoke a callback for every match */
+int scanKeywordsWithCallback(const KeywordMatcher* matcher, const char* text,
+                             KeywordMatchCallback callback, void* context) {
+    return runScan(matcher, text, callback, context);
+}
+
+/* Accumulator used by scoreKeywordLexicons */
+typedef struct {
+    double scale;
+    double* scores;
+    int count;
+} LexiconAccumulator;
+
+static void accumulateMatch(const KeywordMatch* match, void* context) {
+    LexiconAccumulator* acc = (LexiconAccumulator*)context;
+    if (match->lexiconId >= 0 && match->lexiconId < acc->count) {
+        acc->scores[match->lexiconId] += match->weight * acc->scale;
+    }
+}
+
+/* Scan a text and accumulate match weights per lexicon */
+int scoreKeywordLexicons(const KeywordMatcher* matcher, const char* text, double scale,
+                         double* lexiconScores, int lexiconCount) {
+    if (!lexiconScores || lexiconCount <= 0) {
+        return runScan(matcher, text, NULL, NULL);
+    }
+
+    LexiconAccumulator acc = { scale, lexiconScores, lexiconCount };
+    return runScan(matcher, text, accumulateMatch, &acc);
+}
+
+/* Accumulator used by scoreDistinctKeywordLexicons */
+typedef struct {
+    double scale;
+    unsigned char* seen;
+    double* scores;
+    int count;
+    int scored;
+} DistinctAccumulator;
+
+static void accumulateDistinctMatch(const KeywordMatch* match, void* context) {
+    DistinctAccumulator* acc = (DistinctAccumulator*)context;
+    if (acc->seen[match->keywordId]) {
+        return;
+    }
+    acc->seen[match->keywordId] = 1;
+    acc->scored++;
+    if (match->lexiconId >= 0 && match->lexiconId < acc->count) {
+        acc->scores[match->lexiconId] += match->weight * acc->scale;
+    }
+}
+
+/* Scan a text and accumulate the weight of each distinct keyword once */
+int scoreDistinctKeywordLexicons(const KeywordMatcher* matcher, const char* text, double scale,
+                                 unsigned char* seen, double* lexiconScores, int lexiconCount) {
+    if (!seen || !lexiconScores || lexiconCount <= 0) {
+        return 0;
+    }
+
+    DistinctAccumulator acc = { scale, seen, lexiconScores, lexiconCount, 0 };
+    runScan(matcher, text, accumulateDistinctMatch, &acc);
+    return acc.scored;
+}
+
+/* Get the folded text of a keyword */
+char* getKeywordText(const KeywordMatcher* matcher, int keywordId, char* buffer, int bufferSize) {
+    if (!matcher || !buffer || bufferSize <= 0 || keywordId < 0 || keywordId >= matcher->keywordCount) {
+        return NULL;
+    }
+
+    int length = matcher->keywordLength[keywordId];
+    if (length > bufferSize - 1) {
+        length = bufferSize - 1;
+    }
+    memcpy(buffer, matcher->keywordText + matcher->keywordOffset[keywordId], length);
+    buffer[length] = '\0';
+    return buffer;
+}
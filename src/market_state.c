@@ -0,0 +1,313 @@
+/**
+ * Market State
+ * Seqlock-published per-symbol bars and incremental indicators
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+
+#include "../include/market_state.h"
+#include "../include/error_handling.h"
+
+/* Smoothing factors: 2 / (span + 1) for the EMAs, RiskMetrics lambda for volatility */
+#define EMA_FAST_ALPHA (2.0 / 13.0)
+#define EMA_SLOW_ALPHA (2.0 / 27.0)
+#define VOLUME_ALPHA (2.0 / 21.0)
+#define VOLATILITY_LAMBDA 0.94
+
+/* Snapshots are copied word by word so torn reads are defined, then discarded */
+#define SNAPSHOT_WORDS (sizeof(MarketSnapshot) / sizeof(unsigned long))
+
+typedef char snapshotWordSizeCheck[(sizeof(MarketSnapshot) % sizeof(unsigned long)) == 0 ? 1 : -1];
+
+static MarketState globalState;
+static int globalStateReady = 0;
+static pthread_once_t globalStateOnce = PTHREAD_ONCE_INIT;
+static __thread int activeSymbolId = INVALID_SYMBOL_ID;
+
+/* Initialize a market state */
+int initMarketState(MarketState* state, int capacity) {
+    if (!state || capacity <= 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for initMarketState");
+        return -1;
+    }
+
+    memset(state, 0, sizeof(MarketState));
+    state->slots = (MarketSlot*)calloc(capacity, sizeof(MarketSlot));
+    if (!state->slots) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate %d market slots", capacity);
+        return -1;
+    }
+    if (initSymbolTable(&state->symbols, capacity) != 0) {
+        free(state->slots);
+        state->slots = NULL;
+        return -1;
+    }
+    if (pthread_mutex_init(&state->registryLock, NULL) != 0) {
+        logError(ERR_INIT, "Failed to initialize market state lock");
+        freeSymbolTable(&state->symbols);
+        free(state->slots);
+        state->slots = NULL;
+        return -1;
+    }
+
+    state->capacity = capacity;
+    return 0;
+}
+
+/* Free memory used by a market state */
+void freeMarketState(MarketState* state) {
+    if (!state || !state->slots) {
+        return;
+    }
+
+    pthread_mutex_destroy(&state->registryLock);
+    freeSymbolTable(&state->symbols);
+    free(state->slots);
+    memset(state, 0, sizeof(MarketState));
+}
+
+/* Get or create the slot id of a symbol */
+int registerMarketSymbol(MarketState* state, const char* symbol) {
+    if (!state || !state->slots || !symbol || !symbol[0]) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for registerMarketSymbol");
+        return -1;
+    }
+
+    pthread_mutex_lock(&state->registryLock);
+    int id = findSymbol(&state->symbols, symbol);
+    if (id == INVALID_SYMBOL_ID) {
+        if (state->symbols.count >= state->capacity) {
+            pthread_mutex_unlock(&state->registryLock);
+            logError(ERR_INVALID_PARAMETER, "Market state is full (%d symbols), cannot add %s",
+                     state->capacity, symbol);
+            return -1;
+        }
+        id = internSymbol(&state->symbols, symbol);
+    }
+    pthread_mutex_unlock(&state->registryLock);
+
+    return id;
+}
+
+/* Look up the slot id of a symbol without creating it */
+int findMarketSymbol(MarketState* state, const char* symbol) {
+    if (!state || !state->slots || !symbol) {
+        return INVALID_SYMBOL_ID;
+    }
+
+    pthread_mutex_lock(&state->registryLock);
+    int id = findSymbol(&state->symbols, symbol);
+    pthread_mutex_unlock(&state->registryLock);
+
+    return id;
+}
+
+static void advanceSnapshot(MarketSnapshot* s, const StockData* bar) {
+    if (s->barCount == 0) {
+        s->previousClose = 0.0;
+        s->changePercent = 0.0;
+        s->emaFast = bar->close;
+        s->emaSlow = bar->close;
+        s->volatility = 0.0;
+        s->averageVolume = bar->volume;
+        s->volumeRatio = 1.0;
+    } else {
+        double previous = s->bar.close;
+        double ret = previous > 0.0 ? bar->close / previous - 1.0 : 0.0;
+
+        s->previousClose = previous;
+        s->changePercent = ret * 100.0;
+        s->emaFast += EMA_FAST_ALPHA * (bar->close - s->emaFast);
+        s->emaSlow += EMA_SLOW_ALPHA * (bar->close - s->emaSlow);
+        s->volatility = sqrt(VOLATILITY_LAMBDA * s->volatility * s->volatility +
+                             (1.0 - VOLATILITY_LAMBDA) * ret * ret);
+        s->volumeRatio = s->averageVolume > 0.0 ? bar->volume / s->averageVolume : 1.0;
+        s->averageVolume += VOLUME_ALPHA * (bar->volume - s->averageVolume);
+    }
+
+    s->bar = *bar;
+    s->barCount++;
+    s->version++;
+}
+
+/* Apply a new bar to one symbol and publish the updated snapshot */
+int updateMarketSymbol(MarketState* state, int id, const StockData* bar) {
+    if (!state || !state->slots || !bar || id < 0 || id >= state->capacity) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for updateMarketSymbol");
+        return -1;
+    }
+
+    MarketSlot* slot = &state->slots[id];
+
+    /* Claim the slot by moving the sequence from even to odd */
+    unsigned long sequence = __atomic_load_n(&slot->sequence, __ATOMIC_RELAXED);
+    for (;;) {
+        if ((sequence & 1) == 0 &&
+            __atomic_compare_exchange_n(&slot->sequence, &sequence, sequence + 1, 1,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            break;
+        }
+        sequence = __atomic_load_n(&slot->sequence, __ATOMIC_RELAXED);
+    }
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    /* The owner may read its slot plainly; publish the result word by word */
+    MarketSnapshot next = slot->snapshot;
+    advanceSnapshot(&next, bar);
+
+    const unsigned long* src = (const unsigned long*)&next;
+    unsigned long* dst = (unsigned long*)&slot->snapshot;
+    for (size_t w = 0; w < SNAPSHOT_WORDS; w++) {
+        __atomic_store_n(&dst[w], src[w], __ATOMIC_RELAXED);
+    }
+
+    __atomic_store_n(&slot->sequence, sequence + 2, __ATOMIC_RELEASE);
+    return 0;
+}
+
+/* Apply a batch of bars, then bump the state version once */
+int updateMarketBatch(MarketState* state, const int* ids, const StockData* bars, int count) {
+    if (!state || !ids || !bars || count < 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for updateMarketBatch");
+        return -1;
+    }
+
+    int applied = 0;
+    for (int i = 0; i < count; i++) {
+        if (updateMarketSymbol(state, ids[i], &bars[i]) == 0) {
+            applied++;
+        }
+    }
+
+    if (applied > 0) {
+        __atomic_add_fetch(&state->version, 1, __ATOMIC_RELEASE);
+    }
+    return applied;
+}
+
+/* Copy a consistent snapshot of one symbol, returning its version */
+static int copySnapshot(const MarketState* state, int id, MarketSnapshot* snapshot) {
+    const MarketSlot* slot = &state->slots[id];
+    const unsigned long* src = (const unsigned long*)&slot->snapshot;
+    unsigned long* dst = (unsigned long*)snapshot;
+
+    for (;;) {
+        unsigned long before = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+        if (before & 1) {
+            continue;
+        }
+
+        for (size_t w = 0; w < SNAPSHOT_WORDS; w++) {
+            dst[w] = __atomic_load_n(&src[w], __ATOMIC_RELAXED);
+        }
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&slot->sequence, __ATOMIC_RELAXED) == before) {
+            return 0;
+        }
+    }
+}
+
+/* Copy a consistent snapshot of one symbol */
+int readMarketSnapshot(const MarketState* state, int id, MarketSnapshot* snapshot) {
+    if (!state || !state->slots || !snapshot || id < 0 || id >= state->capacity) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for readMarketSnapshot");
+        return -1;
+    }
+
+    return copySnapshot(state, id, snapshot);
+}
+
+/* Copy a snapshot only if it is newer than a version the caller holds */
+int readMarketSnapshotIfNewer(const MarketState* state, int id, unsigned long knownVersion,
+                              MarketSnapshot* snapshot) {
+    if (!state || !state->slots || !snapshot || id < 0 || id >= state->capacity) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for readMarketSnapshotIfNewer");
+        return -1;
+    }
+
+    /* Every publish advances the sequence by 2 and the version by 1 */
+    unsigned long sequence = __atomic_load_n(&state->slots[id].sequence, __ATOMIC_ACQUIRE);
+    if (sequence / 2 <= knownVersion) {
+        return 0;
+    }
+
+    MarketSnapshot copy;
+    copySnapshot(state, id, &copy);
+    if (copy.version <= knownVersion) {
+        return 0;
+    }
+
+    *snapshot = copy;
+    return 1;
+}
+
+/* Version of the whole state, for cheap change polling */
+unsigned long marketStateVersion(const MarketState* state) {
+    if (!state) {
+        return 0;
+    }
+
+    return __atomic_load_n(&state->version, __ATOMIC_ACQUIRE);
+}
+
+static void createGlobalState(void) {
+    globalStateReady = initMarketState(&globalState, DEFAULT_MARKET_STATE_CAPACITY) == 0;
+}
+
+/* Process-wide market state used by updateMarketData */
+MarketState* getMarketState(void) {
+    pthread_once(&globalStateOnce, createGlobalState);
+    return globalStateReady ? &globalState : NULL;
+}
+
+/* Select the symbol that updateMarketData applies bars to */
+int setMarketDataSymbol(const char* symbol) {
+    MarketState* state = getMarketState();
+    if (!state) {
+        logError(ERR_INIT, "Market state is not available");
+        return -1;
+    }
+
+    int id = registerMarketSymbol(state, symbol);
+    if (id < 0) {
+        return -1;
+    }
+
+    activeSymbolId = id;
+    return 0;
+}
+
+/* Update internal market data with new stock information */
+bool updateMarketData(const StockData *data, int dataCount) {
+    if (!data || dataCount <= 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for updateMarketData");
+        return false;
+    }
+
+    MarketState* state = getMarketState();
+    if (!state) {
+        logError(ERR_INIT, "Market state is not available");
+        return false;
+    }
+    if (activeSymbolId == INVALID_SYMBOL_ID) {
+        logError(ERR_INVALID_PARAMETER, "No symbol selected; call setMarketDataSymbol first");
+        return false;
+    }
+
+    int applied = 0;
+    for (int i = 0; i < dataCount; i++) {
+        if (updateMarketSymbol(state, activeSymbolId, &data[i]) == 0) {
+            applied++;
+        }
+    }
+    if (applied > 0) {
+        __atomic_add_fetch(&state->version, 1, __ATOMIC_RELEASE);
+    }
+
+    return applied == dataCount;
+}
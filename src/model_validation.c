@@ -0,0 +1,352 @@
+/**
+ * Model Validation
+ * Date-based walk-forward and purged k-fold splits evaluated on worker threads
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../include/model_validation.h"
+#include "../include/parallel.h"
+#include "../include/error_handling.h"
+
+/* A fold on the shared date axis; all ranges are [start, end) in days */
+typedef struct {
+    int testStart;
+    int testEnd;
+    int trainSegments;
+    int trainStart[2];
+    int trainEnd[2];
+} FoldDays;
+
+typedef struct {
+    const SeriesColumns* series;
+    const ValidationConfig* config;
+    const ValidationModel* model;
+    const FoldDays* folds;
+    int foldCount;
+    void** prepared;
+    ValidationReport* report;
+    int failed;
+} ValidationJob;
+
+/* Fill a config with defaults */
+void initValidationConfig(ValidationConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    config->scheme = VALIDATION_WALK_FORWARD;
+    config->foldCount = 5;
+    config->trainDays = 3 * 365;
+    config->testDays = 365;
+    config->purgeDays = 5;
+    config->embargoDays = 5;
+    config->minTrainBars = 60;
+    config->minTestBars = 20;
+}
+
+/* Number of bars in a view */
+int seriesViewLength(const SeriesView* view) {
+    if (!view) {
+        return 0;
+    }
+
+    int length = 0;
+    for (int s = 0; s < view->segmentCount; s++) {
+        length += view->end[s] - view->begin[s];
+    }
+    return length;
+}
+
+static void addTrainSegment(FoldDays* fold, int start, int end) {
+    if (end > start) {
+        fold->trainStart[fold->trainSegments] = start;
+        fold->trainEnd[fold->trainSegments] = end;
+        fold->trainSegments++;
+    }
+}
+
+/* Cut [firstDay, endDay) into folds; returns the fold count */
+static int layoutFolds(const ValidationConfig* config, int firstDay, int endDay, FoldDays* folds, int maxFolds) {
+    int count = 0;
+
+    if (config->scheme == VALIDATION_PURGED_KFOLD) {
+        long long span = (long long)endDay - firstDay;
+        for (int k = 0; k < config->foldCount && k < maxFolds; k++) {
+            FoldDays* fold = &folds[count++];
+            memset(fold, 0, sizeof(FoldDays));
+            fold->testStart = firstDay + (int)(span * k / config->foldCount);
+            fold->testEnd = firstDay + (int)(span * (k + 1) / config->foldCount);
+            addTrainSegment(fold, firstDay, fold->testStart - config->purgeDays);
+            addTrainSegment(fold, fold->testEnd + config->embargoDays, endDay);
+        }
+        return count;
+    }
+
+    for (int testStart = firstDay + config->trainDays; testStart < endDay && count < maxFolds;
+         testStart += config->testDays) {
+        if (config->foldCount > 0 && count == config->foldCount) {
+            break;
+        }
+
+        FoldDays* fold = &folds[count++];
+        memset(fold, 0, sizeof(FoldDays));
+        fold->testStart = testStart;
+        fold->testEnd = testStart + config->testDays < endDay ? testStart + config->testDays : endDay;
+
+        int trainEnd = testStart - config->purgeDays;
+        int trainStart = config->scheme == VALIDATION_ROLLING ? trainEnd - config->trainDays : firstDay;
+        addTrainSegment(fold, trainStart > firstDay ? trainStart : firstDay, trainEnd);
+    }
+    return count;
+}
+
+/* First index whose day is >= day */
+static int lowerBoundDay(const SeriesColumns* series, int day) {
+    int low = 0, high = series->count;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (series->day[mid] < day) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static void mapView(const SeriesColumns* series, int segments, const int* start, const int* end, SeriesView* view) {
+    view->segmentCount = 0;
+    for (int s = 0; s < segments; s++) {
+        int begin = lowerBoundDay(series, start[s]);
+        int finish = lowerBoundDay(series, end[s]);
+        if (finish > begin) {
+            view->begin[view->segmentCount] = begin;
+            view->end[view->segmentCount] = finish;
+            view->segmentCount++;
+        }
+    }
+}
+
+static void prepareSeriesRange(int begin, int end, void* context) {
+    ValidationJob* job = (ValidationJob*)context;
+
+    for (int s = begin; s < end; s++) {
+        job->prepared[s] = job->model->prepare(&job->series[s], s, job->model->context);
+    }
+}
+
+static void runFoldRange(int begin, int end, void* context) {
+    ValidationJob* job = (ValidationJob*)context;
+    const ValidationModel* model = job->model;
+    ValidationReport* report = job->report;
+
+    void* buffer = malloc(model->modelSize > 0 ? model->modelSize : 1);
+    if (!buffer) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate a %lu-byte model", (unsigned long)model->modelSize);
+        __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    for (int task = begin; task < end; task++) {
+        int s = task / job->foldCount;
+        int f = task % job->foldCount;
+        const SeriesColumns* series = &job->series[s];
+        const FoldDays* fold = &job->folds[f];
+
+        SeriesView train, test;
+        memset(&train, 0, sizeof(SeriesView));
+        train.series = series;
+        train.seriesIndex = s;
+        train.foldIndex = f;
+        train.prepared = job->prepared ? job->prepared[s] : NULL;
+        test = train;
+
+        mapView(series, fold->trainSegments, fold->trainStart, fold->trainEnd, &train);
+        mapView(series, 1, &fold->testStart, &fold->testEnd, &test);
+
+        report->valid[task] = 0;
+        if (seriesViewLength(&train) < job->config->minTrainBars ||
+            seriesViewLength(&test) < job->config->minTestBars) {
+            continue;
+        }
+
+        memset(buffer, 0, model->modelSize);
+        double* metrics = &report->foldMetrics[(size_t)task * model->metricCount];
+        if (model->fit(&train, buffer, model->context) == 0 &&
+            model->evaluate(&test, buffer, metrics, model->context) == 0) {
+            report->valid[task] = 1;
+        }
+    }
+
+    free(buffer);
+}
+
+/* Free memory used by a validation report */
+void freeValidationReport(ValidationReport* report) {
+    if (!report) {
+        return;
+    }
+
+    free(report->testStartDay);
+    free(report->testEndDay);
+    free(report->foldMetrics);
+    free(report->valid);
+    memset(report, 0, sizeof(ValidationReport));
+}
+
+/* Mean and sample standard deviation per metric, summed in task order */
+static void aggregateReport(ValidationReport* report) {
+    int tasks = report->seriesCount * report->foldCount;
+    int metrics = report->metricCount;
+
+    report->validCount = 0;
+    for (int t = 0; t < tasks; t++) {
+        report->validCount += report->valid[t];
+    }
+    if (report->validCount == 0) {
+        return;
+    }
+
+    for (int m = 0; m < metrics; m++) {
+        double sum = 0.0;
+        for (int t = 0; t < tasks; t++) {
+            if (report->valid[t]) sum += report->foldMetrics[(size_t)t * metrics + m];
+        }
+        double mean = sum / report->validCount;
+
+        double squares = 0.0;
+        for (int t = 0; t < tasks; t++) {
+            if (report->valid[t]) {
+                double d = report->foldMetrics[(size_t)t * metrics + m] - mean;
+                squares += d * d;
+            }
+        }
+
+        report->mean[m] = mean;
+        report->stdDev[m] = report->validCount > 1 ? sqrt(squares / (report->validCount - 1)) : 0.0;
+    }
+}
+
+/* Validate a model over every fold of every series */
+int runValidation(const SeriesColumns* series, int seriesCount, const ValidationConfig* config,
+                  const ValidationModel* model, ValidationReport* report) {
+    ValidationConfig defaults;
+    if (!config) {
+        initValidationConfig(&defaults);
+        config = &defaults;
+    }
+
+    if (!series || seriesCount <= 0 || !model || !model->fit || !model->evaluate || !report ||
+        model->metricCount <= 0 || model->metricCount > MAX_VALIDATION_METRICS) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for runValidation");
+        return -1;
+    }
+    if (config->testDays <= 0 || config->trainDays < 0 || config->purgeDays < 0 || config->embargoDays < 0 ||
+        (config->scheme == VALIDATION_PURGED_KFOLD && config->foldCount < 2)) {
+        logError(ERR_INVALID_PARAMETER, "Invalid validation configuration");
+        return -1;
+    }
+
+    memset(report, 0, sizeof(ValidationReport));
+
+    int firstDay = 0, endDay = 0, haveData = 0;
+    for (int s = 0; s < seriesCount; s++) {
+        if (series[s].count == 0) {
+            continue;
+        }
+        if (!series[s].day) {
+            logError(ERR_INVALID_PARAMETER, "Series %d has no day column", s);
+            return -1;
+        }
+        int first = series[s].day[0], last = series[s].day[series[s].count - 1] + 1;
+        if (!haveData || first < firstDay) firstDay = first;
+        if (!haveData || last > endDay) endDay = last;
+        haveData = 1;
+    }
+    if (!haveData) {
+        logError(ERR_DATA_INSUFFICIENT, "No bars to validate on");
+        return -1;
+    }
+
+    int maxFolds = config->scheme == VALIDATION_PURGED_KFOLD ? config->foldCount
+                                                             : (endDay - firstDay) / config->testDays + 1;
+    FoldDays* folds = (FoldDays*)malloc(maxFolds * sizeof(FoldDays));
+    if (!folds) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate %d folds", maxFolds);
+        return -1;
+    }
+
+    int foldCount = layoutFolds(config, firstDay, endDay, folds, maxFolds);
+    if (foldCount == 0) {
+        logError(ERR_DATA_INSUFFICIENT, "History of %d days is shorter than the first train window",
+                 endDay - firstDay);
+        free(folds);
+        return -1;
+    }
+
+    int tasks = seriesCount * foldCount;
+    report->seriesCount = seriesCount;
+    report->foldCount = foldCount;
+    report->metricCount = model->metricCount;
+    report->testStartDay = (int*)malloc(foldCount * sizeof(int));
+    report->testEndDay = (int*)malloc(foldCount * sizeof(int));
+    report->foldMetrics = (double*)calloc((size_t)tasks * model->metricCount, sizeof(double));
+    report->valid = (unsigned char*)calloc(tasks, 1);
+
+    ValidationJob job;
+    memset(&job, 0, sizeof(ValidationJob));
+    if (model->prepare) {
+        job.prepared = (void**)calloc(seriesCount, sizeof(void*));
+    }
+
+    if (!report->testStartDay || !report->testEndDay || !report->foldMetrics || !report->valid ||
+        (model->prepare && !job.prepared)) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate validation report for %d tasks", tasks);
+        freeValidationReport(report);
+        free(job.prepared);
+        free(folds);
+        return -1;
+    }
+
+    for (int f = 0; f < foldCount; f++) {
+        report->testStartDay[f] = folds[f].testStart;
+        report->testEndDay[f] = folds[f].testEnd;
+    }
+
+    job.series = series;
+    job.config = config;
+    job.model = model;
+    job.folds = folds;
+    job.foldCount = foldCount;
+    job.report = report;
+
+    int status = 0;
+    if (model->prepare) {
+        status = parallelFor(seriesCount, 1, prepareSeriesRange, &job);
+    }
+    if (status == 0) {
+        status = parallelFor(tasks, 1, runFoldRange, &job);
+    }
+
+    if (job.prepared) {
+        for (int s = 0; s < seriesCount; s++) {
+            if (job.prepared[s] && model->release) {
+                model->release(job.prepared[s], model->context);
+            }
+        }
+        free(job.prepared);
+    }
+    free(folds);
+
+    if (status != 0 || job.failed) {
+        freeValidationReport(report);
+        return -1;
+    }
+
+    aggregateReport(report);
+    return 0;
+}
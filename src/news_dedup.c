@@ -0,0 +1,342 @@
+/**
+ * News Deduplication
+ * SimHash signatures bucketed by LSH bands to collapse syndicated stories
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "../include/news_dedup.h"
+#include "../include/error_handling.h"
+
+#define FNV64_OFFSET_BASIS 14695981039346656037ull
+#define FNV64_PRIME 1099511628211ull
+
+/* Default number of signature slots allocated up front */
+#define DEFAULT_DEDUP_CAPACITY 256
+
+/* Finalizer from SplitMix64; spreads similar inputs across all bits */
+static unsigned long long mix64(unsigned long long x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+/* Add one feature hash to the per-bit vote counts */
+static void voteFeature(int* votes, unsigned long long feature) {
+    for (int bit = 0; bit < 64; bit++) {
+        votes[bit] += (int)((feature >> bit) & 1) * 2 - 1;
+    }
+}
+
+/* Hash the words and word pairs of a text into the vote counts */
+static void voteText(int* votes, const char* text, unsigned long long* previous) {
+    const unsigned char* p = (const unsigned char*)text;
+
+    while (*p) {
+        while (*p && !isalnum(*p)) {
+            p++;
+        }
+        if (!*p) {
+            break;
+        }
+
+        unsigned long long word = FNV64_OFFSET_BASIS;
+        while (*p && isalnum(*p)) {
+            word = (word ^ (unsigned char)tolower(*p)) * FNV64_PRIME;
+            p++;
+        }
+
+        voteFeature(votes, mix64(word));
+        if (*previous) {
+            voteFeature(votes, mix64(*previous * 31 + word));
+        }
+        *previous = word;
+    }
+}
+
+/* Compute the SimHash signature of an article */
+unsigned long long computeSimHash(const char* title, const char* body) {
+    int votes[64] = {0};
+    unsigned long long previous = 0;
+
+    if (title) {
+        voteText(votes, title, &previous);
+    }
+    if (body) {
+        voteText(votes, body, &previous);
+    }
+
+    unsigned long long signature = 0;
+    for (int bit = 0; bit < 64; bit++) {
+        if (votes[bit] > 0) {
+            signature |= 1ull << bit;
+        }
+    }
+    return signature;
+}
+
+/* Number of differing bits between two signatures */
+int simHashDistance(unsigned long long a, unsigned long long b) {
+    unsigned long long x = a ^ b;
+    x = x - ((x >> 1) & 0x5555555555555555ull);
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return (int)((x * 0x0101010101010101ull) >> 56);
+}
+
+/* Bucket of one band of a signature */
+static int bucketOf(const NewsDeduper* dedup, unsigned long long signature, int band) {
+    unsigned long long key = (signature >> dedup->bandShift[band]) & dedup->bandMask[band];
+    key = mix64(key + 0x9E3779B97F4A7C15ull * (unsigned long long)(band + 1));
+    return (int)(key & (unsigned long long)(dedup->bucketCount - 1));
+}
+
+/* Link every band of signature `index` into its bucket chain */
+static void linkSignature(NewsDeduper* dedup, int index) {
+    for (int band = 0; band < dedup->bandCount; band++) {
+        int entry = index * dedup->bandCount + band;
+        int bucket = bucketOf(dedup, dedup->signatures[index], band);
+        dedup->entryNext[entry] = dedup->bucketHeads[bucket];
+        dedup->bucketHeads[bucket] = entry + 1;
+    }
+}
+
+/* Size storage for `capacity` signatures and rebuild the buckets */
+static int resizeDeduper(NewsDeduper* dedup, int capacity) {
+    unsigned long long* signatures = (unsigned long long*)realloc(dedup->signatures,
+                                                                  capacity * sizeof(unsigned long long));
+    if (!signatures) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to grow news deduplicator to %d articles", capacity);
+        return -1;
+    }
+    dedup->signatures = signatures;
+
+    int* counts = (int*)realloc(dedup->duplicateCounts, capacity * sizeof(int));
+    if (!counts) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to grow news deduplicator to %d articles", capacity);
+        return -1;
+    }
+    dedup->duplicateCounts = counts;
+
+    time_t* lastSeen = (time_t*)realloc(dedup->lastSeen, capacity * sizeof(time_t));
+    if (!lastSeen) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to grow news deduplicator to %d articles", capacity);
+        return -1;
+    }
+    dedup->lastSeen = lastSeen;
+
+    int entries = capacity * dedup->bandCount;
+    int* entryNext = (int*)realloc(dedup->entryNext, entries * sizeof(int));
+    if (!entryNext) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to grow news deduplicator to %d articles", capacity);
+        return -1;
+    }
+    dedup->entryNext = entryNext;
+
+    int bucketCount = 64;
+    while (bucketCount < entries) {
+        bucketCount *= 2;
+    }
+    int* heads = (int*)calloc(bucketCount, sizeof(int));
+    if (!heads) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate %d deduplication buckets", bucketCount);
+        return -1;
+    }
+    free(dedup->bucketHeads);
+    dedup->bucketHeads = heads;
+    dedup->bucketCount = bucketCount;
+    dedup->capacity = capacity;
+
+    for (int i = 0; i < dedup->count; i++) {
+        linkSignature(dedup, i);
+    }
+    return 0;
+}
+
+/* Initialize a deduplicator */
+int initNewsDeduper(NewsDeduper* dedup, double threshold, int expectedArticles) {
+    if (!dedup || threshold < 0.0 || threshold > 1.0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for initNewsDeduper");
+        return -1;
+    }
+
+    memset(dedup, 0, sizeof(NewsDeduper));
+
+    /* Similarity s allows (1 - s) * 64 differing bits */
+    int maxDistance = (int)((1.0 - threshold) * 64.0 + 1e-9);
+    if (maxDistance > MAX_DEDUP_BANDS - 1) {
+        logWarning("Dedup threshold %.2f too loose; limiting to %d differing bits",
+                   threshold, MAX_DEDUP_BANDS - 1);
+        maxDistance = MAX_DEDUP_BANDS - 1;
+    }
+    dedup->maxDistance = maxDistance;
+    dedup->bandCount = maxDistance + 1;
+
+    /* Split the 64 bits into bandCount nearly equal bands */
+    int shift = 0;
+    for (int band = 0; band < dedup->bandCount; band++) {
+        int bits = 64 / dedup->bandCount + (band < 64 % dedup->bandCount ? 1 : 0);
+        dedup->bandShift[band] = (unsigned char)shift;
+        dedup->bandMask[band] = bits >= 64 ? ~0ull : (1ull << bits) - 1;
+        shift += bits;
+    }
+
+    if (expectedArticles <= 0) {
+        expectedArticles = DEFAULT_DEDUP_CAPACITY;
+    }
+    if (resizeDeduper(dedup, expectedArticles) != 0) {
+        freeNewsDeduper(dedup);
+        return -1;
+    }
+    return 0;
+}
+
+/* Free memory used by a deduplicator */
+void freeNewsDeduper(NewsDeduper* dedup) {
+    if (!dedup) {
+        return;
+    }
+
+    free(dedup->signatures);
+    free(dedup->duplicateCounts);
+    free(dedup->lastSeen);
+    free(dedup->bucketHeads);
+    free(dedup->entryNext);
+    memset(dedup, 0, sizeof(NewsDeduper));
+}
+
+/* Forget all signatures but keep the threshold and allocated memory */
+void resetNewsDeduper(NewsDeduper* dedup) {
+    if (!dedup || !dedup->bucketHeads) {
+        return;
+    }
+
+    dedup->count = 0;
+    memset(dedup->bucketHeads, 0, dedup->bucketCount * sizeof(int));
+}
+
+/* Forget stories not seen since a cutoff time */
+int expireNewsSignatures(NewsDeduper* dedup, time_t cutoff) {
+    if (!dedup || !dedup->bucketHeads) {
+        return 0;
+    }
+
+    /* Compact the surviving signatures in order, then relink the buckets */
+    int kept = 0;
+    for (int i = 0; i < dedup->count; i++) {
+        if (dedup->lastSeen[i] >= cutoff) {
+            dedup->signatures[kept] = dedup->signatures[i];
+            dedup->duplicateCounts[kept] = dedup->duplicateCounts[i];
+            dedup->lastSeen[kept] = dedup->lastSeen[i];
+            kept++;
+        }
+    }
+
+    int removed = dedup->count - kept;
+    if (removed > 0) {
+        dedup->count = kept;
+        memset(dedup->bucketHeads, 0, dedup->bucketCount * sizeof(int));
+        for (int i = 0; i < kept; i++) {
+            linkSignature(dedup, i);
+        }
+    }
+    return removed;
+}
+
+/* Evict the least recently seen stories to make room for a new one */
+static void evictOldest(NewsDeduper* dedup) {
+    time_t oldest = dedup->lastSeen[0];
+    for (int i = 1; i < dedup->count; i++) {
+        if (dedup->lastSeen[i] < oldest) {
+            oldest = dedup->lastSeen[i];
+        }
+    }
+    expireNewsSignatures(dedup, oldest + 1);
+}
+
+/* Find a stored signature near the given one */
+int findNearDuplicate(const NewsDeduper* dedup, unsigned long long signature) {
+    if (!dedup || !dedup->bucketHeads) {
+        return -1;
+    }
+
+    int best = -1;
+    int bestDistance = dedup->maxDistance + 1;
+
+    for (int band = 0; band < dedup->bandCount; band++) {
+        unsigned long long mask = dedup->bandMask[band];
+        int shift = dedup->bandShift[band];
+        unsigned long long key = (signature >> shift) & mask;
+
+        int entry = dedup->bucketHeads[bucketOf(dedup, signature, band)];
+        while (entry) {
+            int index = (entry - 1) / dedup->bandCount;
+            int entryBand = (entry - 1) % dedup->bandCount;
+            unsigned long long candidate = dedup->signatures[index];
+
+            /* Buckets mix bands and hash collisions; check the band really matches */
+            if (entryBand == band && ((candidate >> shift) & mask) == key) {
+                int distance = simHashDistance(signature, candidate);
+                if (distance < bestDistance) {
+                    best = index;
+                    bestDistance = distance;
+                    if (distance == 0) {
+                        return best;
+                    }
+                }
+            }
+            entry = dedup->entryNext[entry - 1];
+        }
+    }
+    return best;
+}
+
+/* Check a signature and remember it if it is new */
+int addNewsSignature(NewsDeduper* dedup, unsigned long long signature, time_t seenAt, int* duplicateOf) {
+    if (!dedup || !dedup->bucketHeads) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for addNewsSignature");
+        return -1;
+    }
+
+    int match = findNearDuplicate(dedup, signature);
+    if (match >= 0) {
+        dedup->duplicateCounts[match]++;
+        if (seenAt > dedup->lastSeen[match]) {
+            dedup->lastSeen[match] = seenAt;
+        }
+        if (duplicateOf) {
+            *duplicateOf = match;
+        }
+        return 0;
+    }
+
+    if (dedup->maxArticles > 0 && dedup->count >= dedup->maxArticles) {
+        evictOldest(dedup);
+    }
+    if (dedup->count == dedup->capacity && resizeDeduper(dedup, dedup->capacity * 2) != 0) {
+        return -1;
+    }
+
+    int index = dedup->count++;
+    dedup->signatures[index] = signature;
+    dedup->duplicateCounts[index] = 0;
+    dedup->lastSeen[index] = seenAt;
+    linkSignature(dedup, index);
+
+    if (duplicateOf) {
+        *duplicateOf = index;
+    }
+    return 1;
+}
+
+/* Check an article and remember it if it is new */
+int addNewsArticle(NewsDeduper* dedup, const char* title, const char* body, time_t seenAt,
+                   int* duplicateOf) {
+    return addNewsSignature(dedup, computeSimHash(title, body), seenAt, duplicateOf);
+}
@@ -0,0 +1,137 @@
+/**
+ * Parallel Loops
+ * Fork-join execution of index ranges on POSIX threads
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "../include/parallel.h"
+#include "../include/error_handling.h"
+
+/* Upper bound on worker threads for one loop */
+#define MAX_PARALLEL_THREADS 64
+
+static int configuredThreads = 0;
+
+/* Shared state of one parallelFor call */
+typedef struct {
+    pthread_mutex_t lock;
+    int next;
+    int count;
+    int grainSize;
+    ParallelRangeFn fn;
+    void* context;
+} ParallelJob;
+
+static int detectProcessorCount(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#else
+    return 1;
+#endif
+}
+
+/* Number of worker threads used by parallelFor */
+int getParallelThreadCount(void) {
+    int threads = configuredThreads > 0 ? configuredThreads : detectProcessorCount();
+    if (threads < 1) threads = 1;
+    if (threads > MAX_PARALLEL_THREADS) threads = MAX_PARALLEL_THREADS;
+    return threads;
+}
+
+/* Override the number of worker threads */
+void setParallelThreadCount(int threads) {
+    configuredThreads = threads > 0 ? threads : 0;
+}
+
+/* Take ranges from the shared counter until none are left */
+static void* parallelWorker(void* arg) {
+    ParallelJob* job = (ParallelJob*)arg;
+
+    for (;;) {
+        pthread_mutex_lock(&job->lock);
+        int begin = job->next;
+        job->next = begin < job->count - job->grainSize ? begin + job->grainSize : job->count;
+        pthread_mutex_unlock(&job->lock);
+
+        if (begin >= job->count) {
+            break;
+        }
+        int end = begin + job->grainSize < job->count ? begin + job->grainSize : job->count;
+        job->fn(begin, end, job->context);
+    }
+    return NULL;
+}
+
+/* Run fn over [0, count) split into ranges of about grainSize indices */
+int parallelFor(int count, int grainSize, ParallelRangeFn fn, void* context) {
+    if (!fn || count < 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for parallelFor");
+        return -1;
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    int threads = getParallelThreadCount();
+    if (grainSize <= 0) {
+        /* About four ranges per thread balances load without much locking */
+        grainSize = count / (threads * 4);
+        if (grainSize < 1) grainSize = 1;
+    }
+
+    int ranges = (count + grainSize - 1) / grainSize;
+    if (threads > ranges) {
+        threads = ranges;
+    }
+    if (threads <= 1) {
+        fn(0, count, context);
+        return 0;
+    }
+
+    ParallelJob job;
+    job.next = 0;
+    job.count = count;
+    job.grainSize = grainSize;
+    job.fn = fn;
+    job.context = context;
+    if (pthread_mutex_init(&job.lock, NULL) != 0) {
+        logError(ERR_INIT, "Failed to initialize parallel loop lock");
+        return -1;
+    }
+
+    /* The calling thread works too, so only threads - 1 are spawned */
+    pthread_t workers[MAX_PARALLEL_THREADS];
+    int started = 0;
+    for (int i = 0; i < threads - 1; i++) {
+        if (pthread_create(&workers[started], NULL, parallelWorker, &job) != 0) {
+            logWarning("Failed to start parallel worker %d; continuing with %d", i + 1, started + 1);
+            break;
+        }
+        started++;
+    }
+
+    parallelWorker(&job);
+
+    for (int i = 0; i < started; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    pthread_mutex_destroy(&job.lock);
+    return 0;
+}
@@ -0,0 +1,274 @@
+/**
+ * Parameter Optimizer
+ * Prefix-sum SMA crossover grid search with top-k ranking and pruning
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/param_optimizer.h"
+#include "../include/parallel.h"
+#include "../include/error_handling.h"
+
+/* Fill a config with defaults */
+void initOptimizerConfig(OptimizerConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    config->minShort = 2;
+    config->maxShort = 50;
+    config->shortStep = 1;
+    config->minLong = 10;
+    config->maxLong = 200;
+    config->longStep = 1;
+    config->objective = OPTIMIZE_SHARPE;
+    config->minTrades = 5;
+    initBacktestConfig(&config->backtest);
+}
+
+/* Scratch arrays of one series, built once and shared by every pair */
+typedef struct {
+    double* closePrefix;          /* closePrefix[i] = sum of the first i closes */
+    double* volumePrefix;
+    double* gainBound;
+    DMTradingSignal* signals;
+} OptimizerScratch;
+
+/* Strict ranking order: higher score, then shorter periods */
+static int ranksAbove(const ParameterScore* a, const ParameterScore* b) {
+    if (a->score != b->score) return a->score > b->score;
+    if (a->shortPeriod != b->shortPeriod) return a->shortPeriod < b->shortPeriod;
+    return a->longPeriod < b->longPeriod;
+}
+
+/* Min-heap on rank, so the weakest kept pair is at the root */
+static void siftDown(ParameterScore* heap, int count, int i) {
+    for (;;) {
+        int weakest = i;
+        int left = 2 * i + 1, right = left + 1;
+        if (left < count && ranksAbove(&heap[weakest], &heap[left])) weakest = left;
+        if (right < count && ranksAbove(&heap[weakest], &heap[right])) weakest = right;
+        if (weakest == i) {
+            return;
+        }
+        ParameterScore tmp = heap[i];
+        heap[i] = heap[weakest];
+        heap[weakest] = tmp;
+        i = weakest;
+    }
+}
+
+static void siftUp(ParameterScore* heap, int i) {
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!ranksAbove(&heap[parent], &heap[i])) {
+            return;
+        }
+        ParameterScore tmp = heap[i];
+        heap[i] = heap[parent];
+        heap[parent] = tmp;
+        i = parent;
+    }
+}
+
+static int compareRank(const void* a, const void* b) {
+    const ParameterScore* x = (const ParameterScore*)a;
+    const ParameterScore* y = (const ParameterScore*)b;
+    if (ranksAbove(x, y)) return -1;
+    if (ranksAbove(y, x)) return 1;
+    return 0;
+}
+
+/* Crossover signals of one SMA pair from the prefix sums */
+static int prefixCrossoverSignals(const SeriesColumns* series, const OptimizerScratch* scratch,
+                                  int shortPeriod, int longPeriod, const BacktestConfig* config) {
+    const double* prefix = scratch->closePrefix;
+    const double* volumePrefix = scratch->volumePrefix;
+    double inverseShort = 1.0 / shortPeriod;
+    double inverseLong = 1.0 / longPeriod;
+    int n = series->count;
+    int count = 0;
+
+    double previousGap = (prefix[longPeriod] - prefix[longPeriod - shortPeriod]) * inverseShort -
+                         prefix[longPeriod] * inverseLong;
+
+    for (int i = longPeriod; i < n; i++) {
+        double gap = (prefix[i + 1] - prefix[i + 1 - shortPeriod]) * inverseShort -
+                     (prefix[i + 1] - prefix[i + 1 - longPeriod]) * inverseLong;
+
+        int type = DM_SIGNAL_UNKNOWN;
+        if (previousGap <= 0.0 && gap > 0.0) {
+            type = DM_SIGNAL_BUY;
+        } else if (previousGap >= 0.0 && gap < 0.0) {
+            type = DM_SIGNAL_SELL;
+        }
+
+        if (type != DM_SIGNAL_UNKNOWN) {
+            int start = i + 1 > SIGNAL_VOLUME_WINDOW ? i + 1 - SIGNAL_VOLUME_WINDOW : 0;
+            double averageVolume = (volumePrefix[i + 1] - volumePrefix[start]) / (i + 1 - start);
+            double ratio = averageVolume > 0.0 ? series->volume[i] / averageVolume : 0.0;
+            initCrossoverSignal(&scratch->signals[count++], type, i, series->close[i],
+                                0.5 + 0.25 * (ratio < 2.0 ? ratio : 2.0), config);
+        }
+        previousGap = gap;
+    }
+
+    return count;
+}
+
+/* Rank the SMA (short, long) grid of one series */
+int optimizeCrossoverParameters(const SeriesColumns* series, const OptimizerConfig* config,
+                                ParameterScore* ranked, int maxRanked) {
+    OptimizerConfig defaults;
+    if (!config) {
+        initOptimizerConfig(&defaults);
+        config = &defaults;
+    }
+
+    if (!series || !ranked || maxRanked <= 0 || config->minShort < 1 || config->minLong < 2 ||
+        config->shortStep < 1 || config->longStep < 1) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for optimizeCrossoverParameters");
+        return -1;
+    }
+
+    int n = series->count;
+    if (n < config->minLong + 1) {
+        return 0;
+    }
+
+    OptimizerScratch scratch;
+    scratch.closePrefix = (double*)malloc((n + 1) * sizeof(double));
+    scratch.volumePrefix = (double*)malloc((n + 1) * sizeof(double));
+    scratch.gainBound = (double*)malloc(n * sizeof(double));
+    scratch.signals = (DMTradingSignal*)malloc(n * sizeof(DMTradingSignal));
+    if (!scratch.closePrefix || !scratch.volumePrefix || !scratch.gainBound || !scratch.signals) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate optimizer scratch for %d bars", n);
+        free(scratch.closePrefix);
+        free(scratch.volumePrefix);
+        free(scratch.gainBound);
+        free(scratch.signals);
+        return -1;
+    }
+
+    scratch.closePrefix[0] = 0.0;
+    scratch.volumePrefix[0] = 0.0;
+    for (int i = 0; i < n; i++) {
+        scratch.closePrefix[i + 1] = scratch.closePrefix[i] + series->close[i];
+        scratch.volumePrefix[i + 1] = scratch.volumePrefix[i] + series->volume[i];
+    }
+    computeEquityGainBound(series, scratch.gainBound);
+
+    /* Only final equity has a bound a partial simulation can be checked against */
+    int prune = config->objective == OPTIMIZE_TOTAL_RETURN;
+    int kept = 0;
+    long evaluated = 0, skipped = 0, pruned = 0;
+
+    for (int longPeriod = config->minLong; longPeriod <= config->maxLong && longPeriod < n;
+         longPeriod += config->longStep) {
+        for (int shortPeriod = config->minShort; shortPeriod <= config->maxShort && shortPeriod < longPeriod;
+             shortPeriod += config->shortStep) {
+            int signalCount = prefixCrossoverSignals(series, &scratch, shortPeriod, longPeriod,
+                                                     &config->backtest);
+            /* Each trade opens on a signal, so this cannot reach minTrades */
+            if (signalCount < config->minTrades) {
+                skipped++;
+                continue;
+            }
+
+            /* Once the list is full, a pair must beat its weakest entry */
+            double minFinalEquity = prune && kept == maxRanked ? 1.0 + ranked[0].score : -1.0;
+
+            ParameterScore candidate;
+            candidate.shortPeriod = shortPeriod;
+            candidate.longPeriod = longPeriod;
+            int status = runSignalBacktestBounded(series, scratch.signals, signalCount, &config->backtest,
+                                                  prune ? scratch.gainBound : NULL, minFinalEquity,
+                                                  &candidate.metrics);
+            evaluated++;
+            if (status != 0) {
+                pruned += status == 1;
+                continue;
+            }
+            if (candidate.metrics.tradeCount < config->minTrades) {
+                skipped++;
+                continue;
+            }
+
+            candidate.score = config->objective == OPTIMIZE_TOTAL_RETURN ? candidate.metrics.totalReturn
+                                                                         : candidate.metrics.sharpeRatio;
+            if (kept < maxRanked) {
+                ranked[kept] = candidate;
+                siftUp(ranked, kept++);
+            } else if (ranksAbove(&candidate, &ranked[0])) {
+                ranked[0] = candidate;
+                siftDown(ranked, kept, 0);
+            }
+        }
+    }
+
+    qsort(ranked, kept, sizeof(ParameterScore), compareRank);
+
+    logMessage(LOG_DEBUG, "Parameter grid: %ld pairs simulated, %ld pruned, %ld below %d trades",
+               evaluated, pruned, skipped, config->minTrades);
+
+    free(scratch.closePrefix);
+    free(scratch.volumePrefix);
+    free(scratch.gainBound);
+    free(scratch.signals);
+    return kept;
+}
+
+typedef struct {
+    const SeriesColumns* series;
+    const OptimizerConfig* config;
+    ParameterScore* ranked;
+    int maxRanked;
+    int* rankedCounts;
+    int failed;
+} OptimizerJob;
+
+static void optimizeSeriesRange(int begin, int end, void* context) {
+    OptimizerJob* job = (OptimizerJob*)context;
+
+    for (int s = begin; s < end; s++) {
+        int count = optimizeCrossoverParameters(&job->series[s], job->config,
+                                                &job->ranked[(size_t)s * job->maxRanked], job->maxRanked);
+        if (count < 0) {
+            __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+            count = 0;
+        }
+        job->rankedCounts[s] = count;
+    }
+}
+
+/* Rank the grid of every series in parallel */
+int optimizeUniverseParameters(const SeriesColumns* series, int seriesCount,
+                               const OptimizerConfig* config, ParameterScore* ranked,
+                               int maxRanked, int* rankedCounts) {
+    if (!series || seriesCount < 0 || !ranked || maxRanked <= 0 || !rankedCounts) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for optimizeUniverseParameters");
+        return -1;
+    }
+
+    OptimizerConfig defaults;
+    if (!config) {
+        initOptimizerConfig(&defaults);
+        config = &defaults;
+    }
+
+    OptimizerJob job;
+    job.series = series;
+    job.config = config;
+    job.ranked = ranked;
+    job.maxRanked = maxRanked;
+    job.rankedCounts = rankedCounts;
+    job.failed = 0;
+
+    if (parallelFor(seriesCount, 1, optimizeSeriesRange, &job) != 0) {
+        return -1;
+    }
+
+    return job.failed ? -1 : 0;
+}
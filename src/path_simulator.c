@@ -0,0 +1,457 @@
+/**
+ * Path Simulator
+ * Chunked GBM, block bootstrap and jump diffusion paths streamed through
+ * strategy callbacks, and the defensive strategy stress test
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../include/path_simulator.h"
+#include "../include/rng.h"
+#include "../include/parallel.h"
+#include "../include/error_handling.h"
+
+/* Fewest historical returns used to calibrate a defensive stress test */
+#define MIN_CALIBRATION_RETURNS 30
+
+/* Largest number of jumps drawn for one bar */
+#define MAX_JUMPS_PER_BAR 16
+
+/* Fill a config with defaults (GBM, 10000 paths, 20 bars, 2% daily volatility) */
+void initPathSimConfig(PathSimConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    config->model = PATH_GBM;
+    config->pathCount = 10000;
+    config->horizon = 20;
+    config->drift = 0.0;
+    config->volatility = 0.02;
+    config->blockLength = 5;
+    config->jumpIntensity = 0.0;
+    config->jumpMean = 0.0;
+    config->jumpStdDev = 0.0;
+    config->chunkPaths = DEFAULT_PATH_CHUNK;
+    config->seed = 1;
+}
+
+/* Estimate drift, volatility and jump parameters from a price history */
+int calibratePathSimConfig(PathSimConfig* config, const double* logReturns, int count) {
+    if (!config || !logReturns || count < 2) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for calibratePathSimConfig");
+        return -1;
+    }
+
+    double sum = 0.0, squares = 0.0;
+    for (int i = 0; i < count; i++) {
+        sum += logReturns[i];
+        squares += logReturns[i] * logReturns[i];
+    }
+    double mean = sum / count;
+    double variance = squares / count - mean * mean;
+    double threshold = 3.0 * sqrt(variance > 0.0 ? variance : 0.0);
+
+    double diffusionSum = 0.0, diffusionSquares = 0.0, jumpSum = 0.0, jumpSquares = 0.0;
+    int diffusionCount = 0, jumpCount = 0;
+    for (int i = 0; i < count; i++) {
+        double r = logReturns[i];
+        if (threshold > 0.0 && fabs(r - mean) > threshold) {
+            jumpSum += r;
+            jumpSquares += r * r;
+            jumpCount++;
+        } else {
+            diffusionSum += r;
+            diffusionSquares += r * r;
+            diffusionCount++;
+        }
+    }
+
+    config->drift = diffusionSum / diffusionCount;
+    variance = diffusionSquares / diffusionCount - config->drift * config->drift;
+    config->volatility = variance > 0.0 ? sqrt(variance) : 0.0;
+
+    config->jumpIntensity = (double)jumpCount / count;
+    config->jumpMean = jumpCount > 0 ? jumpSum / jumpCount : 0.0;
+    variance = jumpCount > 1 ? jumpSquares / jumpCount - config->jumpMean * config->jumpMean : 0.0;
+    config->jumpStdDev = variance > 0.0 ? sqrt(variance) : 0.0;
+    return 0;
+}
+
+typedef struct {
+    const PathSimConfig* config;
+    const double* history;
+    int historyCount;
+    int chunkPaths;
+    PathStrategyFn strategy;
+    void* context;
+    double* outcomes;
+    int failed;
+} SimulationJob;
+
+/* Fill one chunk's growth matrix, one time step (all paths) at a time */
+static void generateChunk(const SimulationJob* job, PhiloxStream* stream, int paths,
+                          double* growth, double* normals, int* positions) {
+    const PathSimConfig* config = job->config;
+    double jumpThreshold = exp(-config->jumpIntensity);
+
+    for (int t = 0; t < config->horizon; t++) {
+        double* row = &growth[(size_t)t * paths];
+        const double* previous = t > 0 ? &growth[(size_t)(t - 1) * paths] : NULL;
+
+        if (config->model == PATH_BOOTSTRAP) {
+            int restart = t % config->blockLength == 0;
+            for (int p = 0; p < paths; p++) {
+                if (restart) {
+                    positions[p] = (int)(philoxUniform(stream) * job->historyCount);
+                    if (positions[p] >= job->historyCount) positions[p] = job->historyCount - 1;
+                } else if (++positions[p] == job->historyCount) {
+                    positions[p] = 0;
+                }
+                normals[p] = job->history[positions[p]];
+            }
+        } else {
+            philoxFillNormal(stream, normals, paths);
+            for (int p = 0; p < paths; p++) {
+                normals[p] = config->drift + config->volatility * normals[p];
+            }
+
+            if (config->model == PATH_JUMP_DIFFUSION && config->jumpIntensity > 0.0) {
+                for (int p = 0; p < paths; p++) {
+                    /* Poisson count by inversion: multiply uniforms until below e^-lambda */
+                    int jumps = 0;
+                    double product = philoxUniform(stream);
+                    while (product > jumpThreshold && jumps < MAX_JUMPS_PER_BAR) {
+                        jumps++;
+                        product *= philoxUniform(stream);
+                    }
+                    if (jumps > 0) {
+                        normals[p] += jumps * config->jumpMean +
+                                      config->jumpStdDev * sqrt((double)jumps) * philoxNormal(stream);
+                    }
+                }
+            }
+        }
+
+        for (int p = 0; p < paths; p++) {
+            row[p] = (previous ? previous[p] : 1.0) * exp(normals[p]);
+        }
+    }
+}
+
+static void simulateChunkRange(int begin, int end, void* context) {
+    SimulationJob* job = (SimulationJob*)context;
+    const PathSimConfig* config = job->config;
+    int chunkPaths = job->chunkPaths;
+
+    double* growth = (double*)malloc((size_t)config->horizon * chunkPaths * sizeof(double));
+    double* normals = (double*)malloc(chunkPaths * sizeof(double));
+    int* positions = (int*)malloc(chunkPaths * sizeof(int));
+    if (!growth || !normals || !positions) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate a %d-path chunk", chunkPaths);
+        __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+        free(growth);
+        free(normals);
+        free(positions);
+        return;
+    }
+
+    for (int c = begin; c < end; c++) {
+        int firstPath = c * chunkPaths;
+        int paths = config->pathCount - firstPath < chunkPaths ? config->pathCount - firstPath : chunkPaths;
+
+        PhiloxStream stream;
+        initPhiloxStream(&stream, config->seed, (unsigned long long)c);
+        generateChunk(job, &stream, paths, growth, normals, positions);
+
+        PathChunk chunk;
+        chunk.firstPath = firstPath;
+        chunk.pathCount = paths;
+        chunk.horizon = config->horizon;
+        chunk.growth = growth;
+        if (job->strategy(&chunk, &job->outcomes[firstPath], job->context) != 0) {
+            __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+        }
+    }
+
+    free(growth);
+    free(normals);
+    free(positions);
+}
+
+static int compareDoubles(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static int summarizeOutcomes(const double* outcomes, int count, PathSimSummary* summary) {
+    double* sorted = (double*)malloc(count * sizeof(double));
+    if (!sorted) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate %d outcomes", count);
+        return -1;
+    }
+    memcpy(sorted, outcomes, count * sizeof(double));
+    qsort(sorted, count, sizeof(double), compareDoubles);
+
+    double sum = 0.0, squares = 0.0;
+    int losses = 0;
+    for (int i = 0; i < count; i++) {
+        sum += sorted[i];
+        squares += sorted[i] * sorted[i];
+        losses += sorted[i] < 0.0;
+    }
+
+    int tail = (int)(count * 0.05);
+    if (tail < 1) tail = 1;
+    double tailSum = 0.0;
+    for (int i = 0; i < tail; i++) {
+        tailSum += sorted[i];
+    }
+
+    double mean = sum / count;
+    double variance = squares / count - mean * mean;
+    summary->pathCount = count;
+    summary->meanOutcome = mean;
+    summary->stdDevOutcome = variance > 0.0 ? sqrt(variance) : 0.0;
+    summary->worstOutcome = sorted[0];
+    summary->bestOutcome = sorted[count - 1];
+    summary->valueAtRisk = -sorted[tail - 1];
+    summary->conditionalVaR = -tailSum / tail;
+    summary->lossProbability = (double)losses / count;
+
+    free(sorted);
+    return 0;
+}
+
+/* Simulate paths chunk by chunk and run a strategy on each chunk */
+int simulatePaths(const PathSimConfig* config, const double* history, int historyCount,
+                  PathStrategyFn strategy, void* context, double* outcomes, PathSimSummary* summary) {
+    if (!config || !strategy || config->pathCount <= 0 || config->horizon <= 0 || config->chunkPaths < 0 ||
+        (config->model == PATH_BOOTSTRAP && (!history || historyCount <= 0 || config->blockLength <= 0))) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for simulatePaths");
+        return -1;
+    }
+
+    double* ownOutcomes = NULL;
+    if (!outcomes) {
+        ownOutcomes = (double*)malloc(config->pathCount * sizeof(double));
+        if (!ownOutcomes) {
+            logError(ERR_OUT_OF_MEMORY, "Failed to allocate %d outcomes", config->pathCount);
+            return -1;
+        }
+        outcomes = ownOutcomes;
+    }
+
+    SimulationJob job;
+    job.config = config;
+    job.history = history;
+    job.historyCount = historyCount;
+    job.chunkPaths = config->chunkPaths > 0 ? config->chunkPaths : DEFAULT_PATH_CHUNK;
+    job.strategy = strategy;
+    job.context = context;
+    job.outcomes = outcomes;
+    job.failed = 0;
+
+    int chunks = (config->pathCount + job.chunkPaths - 1) / job.chunkPaths;
+    int status = parallelFor(chunks, 1, simulateChunkRange, &job);
+    if (status == 0 && job.failed) {
+        status = -1;
+    }
+    if (status == 0 && summary) {
+        status = summarizeOutcomes(outcomes, config->pathCount, summary);
+    }
+
+    free(ownOutcomes);
+    return status;
+}
+
+/* Strategy callback: return of a position with optional stops and hedge */
+int evaluateStopLossPaths(const PathChunk* chunk, double* outcomes, void* context) {
+    const StopLossStrategy* strategy = (const StopLossStrategy*)context;
+    int paths = chunk->pathCount;
+
+    /* outcomes holds the exit growth while evaluating (0 while the position is open) */
+    double* peaks = (double*)malloc(paths * sizeof(double));
+    if (!peaks) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate %d path peaks", paths);
+        return -1;
+    }
+    for (int p = 0; p < paths; p++) {
+        outcomes[p] = 0.0;
+        peaks[p] = 1.0;
+    }
+
+    double stopLevel = strategy->stopLoss > 0.0 ? 1.0 - strategy->stopLoss : 0.0;
+    double trailLevel = strategy->trailingStop > 0.0 ? 1.0 - strategy->trailingStop : 0.0;
+
+    for (int t = 0; t < chunk->horizon; t++) {
+        const double* row = &chunk->growth[(size_t)t * paths];
+        for (int p = 0; p < paths; p++) {
+            if (outcomes[p] != 0.0) {
+                continue;
+            }
+            double g = row[p];
+            if (g > peaks[p]) peaks[p] = g;
+            if (g <= stopLevel || g <= peaks[p] * trailLevel) {
+                outcomes[p] = g;
+            }
+        }
+    }
+
+    const double* last = &chunk->growth[(size_t)(chunk->horizon - 1) * paths];
+    for (int p = 0; p < paths; p++) {
+        double exitGrowth = outcomes[p] != 0.0 ? outcomes[p] : last[p];
+        outcomes[p] = strategy->exposure * (exitGrowth - 1.0);
+    }
+
+    free(peaks);
+    return 0;
+}
+
+/* Candidate responses compared by generateDefensiveStrategy */
+typedef struct {
+    const char* name;
+    StopLossStrategy rule;
+} DefensiveCandidate;
+
+static const DefensiveCandidate defensiveCandidates[] = {
+    {"Hold position",            {1.0, 0.0,  0.0}},
+    {"Stop-loss at -5%",         {1.0, 0.05, 0.0}},
+    {"Trailing stop at -8%",     {1.0, 0.0,  0.08}},
+    {"Hedge 50%",                {0.5, 0.0,  0.0}},
+    {"Hedge 50% + stop at -5%",  {0.5, 0.05, 0.0}}
+};
+
+#define DEFENSIVE_CANDIDATE_COUNT (int)(sizeof(defensiveCandidates) / sizeof(defensiveCandidates[0]))
+
+/* Equal-weight log returns over the most recent bars all selected stocks share */
+static int portfolioLogReturns(const Stock* stocks, const int* selected, int selectedCount, double** returns) {
+    int length = -1;
+    for (int k = 0; k < selectedCount; k++) {
+        int size = stocks[selected[k]].dataSize;
+        if (length < 0 || size < length) length = size;
+    }
+    if (length < MIN_CALIBRATION_RETURNS + 1) {
+        return 0;
+    }
+
+    *returns = (double*)malloc((length - 1) * sizeof(double));
+    if (!*returns) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate %d portfolio returns", length - 1);
+        return -1;
+    }
+
+    int count = 0;
+    for (int t = 1; t < length; t++) {
+        double growth = 0.0;
+        int used = 0;
+        for (int k = 0; k < selectedCount; k++) {
+            const Stock* stock = &stocks[selected[k]];
+            int offset = stock->dataSize - length;
+            double previous = stock->data[offset + t - 1].close;
+            if (previous > 0.0 && stock->data[offset + t].close > 0.0) {
+                growth += stock->data[offset + t].close / previous;
+                used++;
+            }
+        }
+        if (used > 0) {
+            (*returns)[count++] = log(growth / used);
+        }
+    }
+    return count;
+}
+
+/* Compare defensive responses on jump-diffusion paths calibrated to the affected stocks */
+void generateDefensiveStrategy(const Stock* stocks, int stockCount, const EventData* event, char* strategyOutput) {
+    if (!strategyOutput) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for generateDefensiveStrategy");
+        return;
+    }
+    strategyOutput[0] = '\0';
+    if (!stocks || stockCount <= 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for generateDefensiveStrategy");
+        return;
+    }
+
+    /* Stress the stocks the event names, or the whole portfolio */
+    int* selected = (int*)malloc(stockCount * sizeof(int));
+    if (!selected) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate stock selection");
+        return;
+    }
+    int selectedCount = 0;
+    if (event && event->symbol[0]) {
+        for (int i = 0; i < stockCount; i++) {
+            if (strcmp(stocks[i].symbol, event->symbol) == 0) selected[selectedCount++] = i;
+        }
+    }
+    if (selectedCount == 0) {
+        for (int i = 0; i < stockCount; i++) selected[selectedCount++] = i;
+    }
+
+    double* returns = NULL;
+    int returnCount = portfolioLogReturns(stocks, selected, selectedCount, &returns);
+    free(selected);
+    if (returnCount < MIN_CALIBRATION_RETURNS) {
+        if (returnCount >= 0) {
+            logError(ERR_DATA_INSUFFICIENT, "Need %d returns for a defensive stress test", MIN_CALIBRATION_RETURNS);
+        }
+        snprintf(strategyOutput, MAX_BUFFER_SIZE, "Insufficient price history for a defensive strategy.\n");
+        free(returns);
+        return;
+    }
+
+    PathSimConfig config;
+    initPathSimConfig(&config);
+    config.model = PATH_JUMP_DIFFUSION;
+    config.pathCount = 20000;
+    config.horizon = 20;
+    calibratePathSimConfig(&config, returns, returnCount);
+    free(returns);
+
+    /* High-impact events widen the distribution; sentiment tilts the drift */
+    if (event) {
+        double stress = 1.0 + (event->impactScore > 0 ? event->impactScore : 0) / 10.0;
+        config.volatility *= stress;
+        config.jumpIntensity *= stress;
+        config.drift += 0.1 * event->sentiment * config.volatility;
+    }
+
+    int length = snprintf(strategyOutput, MAX_BUFFER_SIZE,
+                          "Defensive strategy stress test (%d paths, %d bars, daily vol %.2f%%, %.1f jumps/yr)%s%s\n",
+                          config.pathCount, config.horizon, config.volatility * 100.0,
+                          config.jumpIntensity * 252.0, event ? " for " : "", event ? event->symbol : "");
+
+    /* Same seed for every candidate, so they are compared on identical paths */
+    int best = -1;
+    double bestScore = 0.0;
+    for (int c = 0; c < DEFENSIVE_CANDIDATE_COUNT; c++) {
+        PathSimSummary summary;
+        StopLossStrategy rule = defensiveCandidates[c].rule;
+        if (simulatePaths(&config, NULL, 0, evaluateStopLossPaths, &rule, NULL, &summary) != 0) {
+            continue;
+        }
+
+        double score = summary.meanOutcome - summary.conditionalVaR;
+        if (best < 0 || score > bestScore) {
+            best = c;
+            bestScore = score;
+        }
+
+        if (length < MAX_BUFFER_SIZE) {
+            length += snprintf(strategyOutput + length, MAX_BUFFER_SIZE - length,
+                               "  %-24s mean %+6.2f%%  VaR95 %6.2f%%  CVaR95 %6.2f%%  P(loss) %3.0f%%\n",
+                               defensiveCandidates[c].name, summary.meanOutcome * 100.0,
+                               summary.valueAtRisk * 100.0, summary.conditionalVaR * 100.0,
+                               summary.lossProbability * 100.0);
+        }
+    }
+
+    if (best >= 0 && length < MAX_BUFFER_SIZE) {
+        snprintf(strategyOutput + length, MAX_BUFFER_SIZE - length,
+                 "Recommended: %s (best mean return net of CVaR95)\n", defensiveCandidates[best].name);
+    }
+}
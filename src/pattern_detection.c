@@ -0,0 +1,492 @@
+/**
+ * Pattern Detection
+ * One-pass zigzag pivot extraction and chart pattern matching over the
+ * resulting swing highs and lows
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../include/pattern_detection.h"
+#include "../include/parallel.h"
+#include "../include/error_handling.h"
+
+/* Earlier same-kind pivots checked for support/resistance touches */
+#define LEVEL_LOOKBACK 4
+
+/* Fill a config with defaults (5% reversals, 1.5% tolerance, 4 trend pivots) */
+void initPatternConfig(PatternConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    config->reversalPercent = 0.05;
+    config->tolerancePercent = 0.015;
+    config->minTrendPivots = 4;
+}
+
+static const PatternConfig* resolveConfig(const PatternConfig* config, PatternConfig* defaults) {
+    if (config) {
+        return config;
+    }
+    initPatternConfig(defaults);
+    return defaults;
+}
+
+static int pushPivot(ZigZagPivot* pivots, int count, int maxPivots,
+                     int index, double price, int isHigh) {
+    if (count >= maxPivots) {
+        logError(ERR_INVALID_PARAMETER, "Pivot buffer of %d entries is too small", maxPivots);
+        return -1;
+    }
+
+    pivots[count].index = index;
+    pivots[count].price = price;
+    pivots[count].isHigh = isHigh;
+    pivots[count].confirmed = 1;
+    return count + 1;
+}
+
+/* Extract alternating swing highs and lows in one pass */
+int extractZigZagPivots(const SeriesColumns* series, double reversalPercent, ZigZagPivot* pivots, int maxPivots) {
+    if (!series || !pivots || maxPivots <= 0 || reversalPercent <= 0.0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for extractZigZagPivots");
+        return -1;
+    }
+
+    const double* high = series->high;
+    const double* low = series->low;
+    int n = series->count;
+    if (n == 0) {
+        return 0;
+    }
+
+    double up = 1.0 + reversalPercent;
+    double down = 1.0 - reversalPercent;
+    int direction = 0;            /* 1 rising toward a high, -1 falling toward a low */
+    int highIndex = 0;            /* Running extremes since the last pivot */
+    int lowIndex = 0;
+    int count = 0;
+
+    for (int i = 1; i < n; i++) {
+        if (direction > 0) {
+            if (high[i] > high[highIndex]) {
+                highIndex = i;
+            } else if (low[i] <= high[highIndex] * down) {
+                count = pushPivot(pivots, count, maxPivots, highIndex, high[highIndex], 1);
+                if (count < 0) {
+                    return -1;
+                }
+                direction = -1;
+                lowIndex = i;
+            }
+        } else if (direction < 0) {
+            if (low[i] < low[lowIndex]) {
+                lowIndex = i;
+            } else if (high[i] >= low[lowIndex] * up) {
+                count = pushPivot(pivots, count, maxPivots, lowIndex, low[lowIndex], 0);
+                if (count < 0) {
+                    return -1;
+                }
+                direction = 1;
+                highIndex = i;
+            }
+        } else {
+            if (high[i] > high[highIndex]) {
+                highIndex = i;
+            }
+            if (low[i] < low[lowIndex]) {
+                lowIndex = i;
+            }
+
+            /* The first reversal decides which extreme becomes the first pivot */
+            int rose = high[i] >= low[lowIndex] * up;
+            int fell = low[i] <= high[highIndex] * down;
+            if (rose && (!fell || lowIndex < highIndex)) {
+                count = pushPivot(pivots, count, maxPivots, lowIndex, low[lowIndex], 0);
+                direction = 1;
+                highIndex = i;
+            } else if (fell) {
+                count = pushPivot(pivots, count, maxPivots, highIndex, high[highIndex], 1);
+                direction = -1;
+                lowIndex = i;
+            }
+            if (count < 0) {
+                return -1;
+            }
+        }
+    }
+
+    if (direction != 0) {
+        int last = direction > 0 ? highIndex : lowIndex;
+        count = pushPivot(pivots, count, maxPivots, last,
+                          direction > 0 ? high[last] : low[last], direction > 0);
+        if (count < 0) {
+            return -1;
+        }
+        pivots[count - 1].confirmed = 0;
+    }
+
+    return count;
+}
+
+/* Growable candidate list; every pivot adds at most a handful of patterns */
+typedef struct {
+    MarketPattern* items;
+    int count;
+    int capacity;
+} PatternList;
+
+static void addPattern(PatternList* list, int type, int startIndex, int endIndex,
+                       double confidence, double expectedMove, double priceLevel) {
+    if (list->count >= list->capacity) {
+        return;
+    }
+
+    if (confidence < 0.5) {
+        confidence = 0.5;
+    } else if (confidence > 0.95) {
+        confidence = 0.95;
+    }
+
+    MarketPattern* pattern = &list->items[list->count++];
+    pattern->type = type;
+    pattern->startIndex = startIndex;
+    pattern->endIndex = endIndex;
+    pattern->confidence = confidence;
+    pattern->expectedMove = expectedMove;
+    pattern->priceLevel = priceLevel;
+}
+
+static int nearPrice(double a, double b, double tolerance) {
+    return fabs(a - b) <= tolerance * 0.5 * (a + b);
+}
+
+/* First close beyond a level between two bars, or -1 */
+static int findBreakout(const double* close, int begin, int end, double level, int above) {
+    for (int i = begin; i <= end; i++) {
+        if (above ? close[i] > level : close[i] < level) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* Last bar a pattern completed at pivot k may be confirmed on */
+static int breakoutLimit(const SeriesColumns* series, const ZigZagPivot* pivots, int pivotCount, int k) {
+    return k + 2 < pivotCount ? pivots[k + 2].index : series->count - 1;
+}
+
+/* Support (lows) or resistance (highs) retested by earlier pivots */
+static int matchLevel(const ZigZagPivot* pivots, int k, double tolerance, PatternList* list) {
+    const ZigZagPivot* pivot = &pivots[k];
+    double sum = pivot->price;
+    int touches = 1;
+    int first = k;
+
+    for (int j = k - 2, seen = 0; j >= 0 && seen < LEVEL_LOOKBACK; j -= 2, seen++) {
+        if (nearPrice(pivots[j].price, pivot->price, tolerance)) {
+            sum += pivots[j].price;
+            touches++;
+            first = j;
+        }
+    }
+
+    if (touches < 2) {
+        return 0;
+    }
+
+    /* The bounce target is the opposite edge of the range just traded */
+    double level = sum / touches;
+    double edge = pivots[k - 1].price;
+    addPattern(list, pivot->isHigh ? DM_PATTERN_RESISTANCE : DM_PATTERN_SUPPORT,
+               pivots[first].index, pivot->index,
+               0.5 + 0.15 * (touches - 1),
+               (edge - level) / level * 100.0, level);
+    return 1;
+}
+
+/* Double top (highs) or double bottom (lows) ending at pivot k */
+static int matchDouble(const SeriesColumns* series, const ZigZagPivot* pivots, int pivotCount,
+                       int k, double tolerance, PatternList* list) {
+    const ZigZagPivot* first = &pivots[k - 2];
+    const ZigZagPivot* second = &pivots[k];
+    if (!nearPrice(first->price, second->price, tolerance)) {
+        return 0;
+    }
+
+    int isTop = second->isHigh;
+    double neckline = pivots[k - 1].price;
+    double extreme = 0.5 * (first->price + second->price);
+    double symmetry = 1.0 - fabs(first->price - second->price) / (tolerance * extreme);
+
+    int breakout = findBreakout(series->close, second->index + 1,
+                                breakoutLimit(series, pivots, pivotCount, k), neckline, !isTop);
+    double confidence = 0.55 + 0.15 * symmetry + (breakout >= 0 ? 0.2 : 0.0);
+
+    addPattern(list, isTop ? DM_PATTERN_DOUBLE_TOP : DM_PATTERN_DOUBLE_BOTTOM,
+               first->index, breakout >= 0 ? breakout : second->index, confidence,
+               (neckline - extreme) / neckline * 100.0, neckline);
+    return 1;
+}
+
+/* Head and shoulders (highs) or its inverse (lows) ending at pivot k */
+static int matchHeadShoulders(const SeriesColumns* series, const ZigZagPivot* pivots, int pivotCount,
+                              int k, double tolerance, PatternList* list) {
+    const ZigZagPivot* leftShoulder = &pivots[k - 4];
+    const ZigZagPivot* head = &pivots[k - 2];
+    const ZigZagPivot* rightShoulder = &pivots[k];
+    int isTop = head->isHigh;
+
+    /* The head must stand out from both shoulders, which roughly match */
+    double sign = isTop ? 1.0 : -1.0;
+    double shoulder = isTop ? fmax(leftShoulder->price, rightShoulder->price)
+                            : fmin(leftShoulder->price, rightShoulder->price);
+    if (sign * (head->price - shoulder) <= tolerance * shoulder ||
+        !nearPrice(leftShoulder->price, rightShoulder->price, 2.0 * tolerance)) {
+        return 0;
+    }
+
+    double neckline = 0.5 * (pivots[k - 3].price + pivots[k - 1].price);
+    double symmetry = 1.0 - fabs(leftShoulder->price - rightShoulder->price) /
+                            (2.0 * tolerance * 0.5 * (leftShoulder->price + rightShoulder->price));
+
+    int breakout = findBreakout(series->close, rightShoulder->index + 1,
+                                breakoutLimit(series, pivots, pivotCount, k), neckline, !isTop);
+    double confidence = 0.6 + 0.15 * symmetry + (breakout >= 0 ? 0.2 : 0.0);
+
+    addPattern(list, isTop ? DM_PATTERN_HEAD_SHOULDERS : DM_PATTERN_INVERSE_HEAD_SHOULDERS,
+               leftShoulder->index, breakout >= 0 ? breakout : rightShoulder->index, confidence,
+               (neckline - head->price) / neckline * 100.0, neckline);
+    return 1;
+}
+
+/* Trend run over same-kind pivot comparisons */
+typedef struct {
+    int direction;                /* 1 higher pivots, -1 lower pivots, 0 none */
+    int length;                   /* Consecutive comparisons in direction */
+    int startPivot;
+    double moveSum;               /* Sum of pivot-to-pivot percent moves */
+} TrendRun;
+
+static void closeTrend(const ZigZagPivot* pivots, const TrendRun* run, int lastPivot,
+                       int minTrendPivots, PatternList* list) {
+    if (run->direction == 0 || run->length < minTrendPivots) {
+        return;
+    }
+
+    addPattern(list, run->direction > 0 ? DM_PATTERN_UPTREND : DM_PATTERN_DOWNTREND,
+               pivots[run->startPivot].index, pivots[lastPivot].index,
+               0.5 + 0.05 * run->length,
+               run->moveSum / run->length, pivots[lastPivot].price);
+}
+
+static void updateTrend(const ZigZagPivot* pivots, int k, int minTrendPivots,
+                        TrendRun* run, PatternList* list) {
+    double previous = pivots[k - 2].price;
+    double move = (pivots[k].price - previous) / previous * 100.0;
+    int direction = move > 0.0 ? 1 : (move < 0.0 ? -1 : 0);
+
+    if (direction != 0 && direction == run->direction) {
+        run->length++;
+        run->moveSum += move;
+        return;
+    }
+
+    /* A pivot breaking an established trend's last swing is a trend change */
+    closeTrend(pivots, run, k - 1, minTrendPivots, list);
+    if (run->length >= minTrendPivots && direction == -run->direction) {
+        addPattern(list, DM_PATTERN_TREND_CHANGE, pivots[k - 2].index, pivots[k].index,
+                   0.5 + 0.05 * run->length, move, previous);
+    }
+
+    run->direction = direction;
+    run->length = direction != 0 ? 1 : 0;
+    run->startPivot = k - 2;
+    run->moveSum = move;
+}
+
+static int compareByEnd(const void* a, const void* b) {
+    const MarketPattern* x = (const MarketPattern*)a;
+    const MarketPattern* y = (const MarketPattern*)b;
+    if (x->endIndex != y->endIndex) {
+        return x->endIndex < y->endIndex ? -1 : 1;
+    }
+    if (x->startIndex != y->startIndex) {
+        return x->startIndex < y->startIndex ? -1 : 1;
+    }
+    return x->type - y->type;
+}
+
+static int compareByStart(const void* a, const void* b) {
+    const MarketPattern* x = (const MarketPattern*)a;
+    const MarketPattern* y = (const MarketPattern*)b;
+    if (x->startIndex != y->startIndex) {
+        return x->startIndex < y->startIndex ? -1 : 1;
+    }
+    if (x->endIndex != y->endIndex) {
+        return x->endIndex < y->endIndex ? -1 : 1;
+    }
+    return x->type - y->type;
+}
+
+/* Match patterns against a pivot sequence */
+int detectPivotPatterns(const SeriesColumns* series, const ZigZagPivot* pivots, int pivotCount,
+                        const PatternConfig* config, MarketPattern* patterns, int maxPatterns) {
+    if (!series || (!pivots && pivotCount > 0) || pivotCount < 0 || !patterns || maxPatterns <= 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for detectPivotPatterns");
+        return -1;
+    }
+
+    PatternConfig defaults;
+    config = resolveConfig(config, &defaults);
+    double tolerance = config->tolerancePercent;
+
+    /* Shapes are built from confirmed pivots only */
+    int confirmed = pivotCount;
+    if (confirmed > 0 && !pivots[confirmed - 1].confirmed) {
+        confirmed--;
+    }
+    if (confirmed < 3) {
+        return 0;
+    }
+
+    PatternList list;
+    list.capacity = 4 * confirmed + 1;
+    list.count = 0;
+    list.items = (MarketPattern*)malloc(list.capacity * sizeof(MarketPattern));
+    if (!list.items) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate %d patterns", list.capacity);
+        return -1;
+    }
+
+    TrendRun run;
+    memset(&run, 0, sizeof(run));
+
+    for (int k = 2; k < confirmed; k++) {
+        int isDouble = matchDouble(series, pivots, pivotCount, k, tolerance, &list);
+        if (!isDouble) {
+            matchLevel(pivots, k, tolerance, &list);
+        }
+        if (k >= 4) {
+            matchHeadShoulders(series, pivots, pivotCount, k, tolerance, &list);
+        }
+        updateTrend(pivots, k, config->minTrendPivots, &run, &list);
+    }
+    closeTrend(pivots, &run, confirmed - 1, config->minTrendPivots, &list);
+
+    /* Keep the most recent patterns, then order them by start */
+    int first = 0;
+    if (list.count > maxPatterns) {
+        qsort(list.items, list.count, sizeof(MarketPattern), compareByEnd);
+        first = list.count - maxPatterns;
+    }
+    int count = list.count - first;
+    memcpy(patterns, list.items + first, count * sizeof(MarketPattern));
+    qsort(patterns, count, sizeof(MarketPattern), compareByStart);
+
+    free(list.items);
+    return count;
+}
+
+static int detectWithBuffer(const SeriesColumns* series, const PatternConfig* config,
+                            ZigZagPivot* pivots, int maxPivots,
+                            MarketPattern* patterns, int maxPatterns) {
+    int pivotCount = extractZigZagPivots(series, config->reversalPercent, pivots, maxPivots);
+    if (pivotCount < 0) {
+        return -1;
+    }
+    return detectPivotPatterns(series, pivots, pivotCount, config, patterns, maxPatterns);
+}
+
+/* Extract pivots and detect patterns of one series */
+int detectSeriesPatterns(const SeriesColumns* series, const PatternConfig* config,
+                         MarketPattern* patterns, int maxPatterns) {
+    if (!series || !patterns || maxPatterns <= 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for detectSeriesPatterns");
+        return -1;
+    }
+
+    PatternConfig defaults;
+    config = resolveConfig(config, &defaults);
+
+    int capacity = series->count > 0 ? series->count : 1;
+    ZigZagPivot* pivots = (ZigZagPivot*)malloc(capacity * sizeof(ZigZagPivot));
+    if (!pivots) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate %d pivots", capacity);
+        return -1;
+    }
+
+    int count = detectWithBuffer(series, config, pivots, capacity, patterns, maxPatterns);
+
+    free(pivots);
+    return count;
+}
+
+typedef struct {
+    const SeriesColumns* series;
+    const PatternConfig* config;
+    MarketPattern* patterns;
+    int maxPatterns;
+    int* patternCounts;
+    int failed;
+} UniverseJob;
+
+static void detectSeriesRange(int begin, int end, void* context) {
+    UniverseJob* job = (UniverseJob*)context;
+
+    int capacity = 1;
+    for (int s = begin; s < end; s++) {
+        if (job->series[s].count > capacity) {
+            capacity = job->series[s].count;
+        }
+    }
+
+    ZigZagPivot* pivots = (ZigZagPivot*)malloc(capacity * sizeof(ZigZagPivot));
+    if (!pivots) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate %d pivots", capacity);
+        for (int s = begin; s < end; s++) {
+            job->patternCounts[s] = 0;
+        }
+        __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    for (int s = begin; s < end; s++) {
+        int count = detectWithBuffer(&job->series[s], job->config, pivots, capacity,
+                                     job->patterns + (size_t)s * job->maxPatterns, job->maxPatterns);
+        if (count < 0) {
+            count = 0;
+            __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+        }
+        job->patternCounts[s] = count;
+    }
+
+    free(pivots);
+}
+
+/* Detect patterns of many series in parallel */
+int detectUniversePatterns(const SeriesColumns* series, int seriesCount, const PatternConfig* config,
+                           MarketPattern* patterns, int maxPatterns, int* patternCounts) {
+    if (!series || seriesCount < 0 || !patterns || maxPatterns <= 0 || !patternCounts) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for detectUniversePatterns");
+        return -1;
+    }
+
+    PatternConfig defaults;
+    UniverseJob job;
+    job.series = series;
+    job.config = resolveConfig(config, &defaults);
+    job.patterns = patterns;
+    job.maxPatterns = maxPatterns;
+    job.patternCounts = patternCounts;
+    job.failed = 0;
+
+    if (parallelFor(seriesCount, 1, detectSeriesRange, &job) != 0) {
+        return -1;
+    }
+
+    return job.failed ? -1 : 0;
+}
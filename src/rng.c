@@ -0,0 +1,133 @@
+/**
+ * Random Numbers
+ * Philox4x32-10 counter-based generator (Salmon et al., SC'11)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../include/rng.h"
+
+#define PHILOX_M0 0xD2511F53u
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u
+#define PHILOX_W1 0xBB67AE85u
+#define PHILOX_ROUNDS 10
+
+#define TWO_PI 6.283185307179586
+#define UINT32_SCALE 2.3283064365386963e-10   /* 2^-32 */
+
+/* Compute one Philox4x32-10 block */
+void philox4x32(const unsigned int counter[4], const unsigned int key[2], unsigned int out[4]) {
+    unsigned int c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+    unsigned int k0 = key[0], k1 = key[1];
+
+    for (int round = 0; round < PHILOX_ROUNDS; round++) {
+        unsigned long long p0 = (unsigned long long)PHILOX_M0 * c0;
+        unsigned long long p1 = (unsigned long long)PHILOX_M1 * c2;
+        unsigned int hi0 = (unsigned int)(p0 >> 32), lo0 = (unsigned int)p0;
+        unsigned int hi1 = (unsigned int)(p1 >> 32), lo1 = (unsigned int)p1;
+
+        c0 = hi1 ^ c1 ^ k0;
+        c1 = lo1;
+        c2 = hi0 ^ c3 ^ k1;
+        c3 = lo0;
+
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+/* Start a stream */
+void initPhiloxStream(PhiloxStream* stream, unsigned long long seed, unsigned long long streamId) {
+    if (!stream) {
+        return;
+    }
+
+    memset(stream, 0, sizeof(PhiloxStream));
+    stream->key[0] = (unsigned int)seed;
+    stream->key[1] = (unsigned int)(seed >> 32);
+    stream->counter[2] = (unsigned int)streamId;
+    stream->counter[3] = (unsigned int)(streamId >> 32);
+    stream->used = 4;
+}
+
+/* Produce the next block and advance the 64-bit block counter */
+static void refillBlock(PhiloxStream* stream) {
+    philox4x32(stream->counter, stream->key, stream->block);
+    if (++stream->counter[0] == 0) {
+        stream->counter[1]++;
+    }
+    stream->used = 0;
+}
+
+/* Next 32 random bits */
+unsigned int philoxNextUint32(PhiloxStream* stream) {
+    if (stream->used == 4) {
+        refillBlock(stream);
+    }
+    return stream->block[stream->used++];
+}
+
+/* Map 32 bits to the open interval (0, 1) */
+static double toUnitInterval(unsigned int bits) {
+    return ((double)bits + 0.5) * UINT32_SCALE;
+}
+
+/* Next uniform double in (0, 1) */
+double philoxUniform(PhiloxStream* stream) {
+    return toUnitInterval(philoxNextUint32(stream));
+}
+
+/* Next standard normal value (Box-Muller) */
+double philoxNormal(PhiloxStream* stream) {
+    if (stream->hasSpare) {
+        stream->hasSpare = 0;
+        return stream->spareNormal;
+    }
+
+    double radius = sqrt(-2.0 * log(philoxUniform(stream)));
+    double angle = TWO_PI * philoxUniform(stream);
+    stream->spareNormal = radius * sin(angle);
+    stream->hasSpare = 1;
+    return radius * cos(angle);
+}
+
+/* Fill an array with standard normal values */
+void philoxFillNormal(PhiloxStream* stream, double* out, int count) {
+    int i = 0;
+
+    /* Drain any buffered state so whole blocks can be used below */
+    while (i < count && (stream->hasSpare || stream->used != 4)) {
+        out[i++] = philoxNormal(stream);
+    }
+
+    unsigned int block[4];
+    while (i + 4 <= count) {
+        philox4x32(stream->counter, stream->key, block);
+        if (++stream->counter[0] == 0) {
+            stream->counter[1]++;
+        }
+
+        double r0 = sqrt(-2.0 * log(toUnitInterval(block[0])));
+        double a0 = TWO_PI * toUnitInterval(block[1]);
+        double r1 = sqrt(-2.0 * log(toUnitInterval(block[2])));
+        double a1 = TWO_PI * toUnitInterval(block[3]);
+        out[i] = r0 * cos(a0);
+        out[i + 1] = r0 * sin(a0);
+        out[i + 2] = r1 * cos(a1);
+        out[i + 3] = r1 * sin(a1);
+        i += 4;
+    }
+
+    while (i < count) {
+        out[i++] = philoxNormal(stream);
+    }
+}
@@ -0,0 +1,374 @@
+/**
+ * Sentiment Engine
+ * Single-pass tokenizer with an open-addressing weighted lexicon
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../include/sentiment_engine.h"
+#include "../include/error_handling.h"
+#include "../include/stemmer.h"
+
+/* FNV-1a parameters */
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME 16777619u
+
+/* Fold an ASCII byte to lowercase */
+static unsigned char foldByte(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c - 'A' + 'a') : c;
+}
+
+/* Letters, digits and non-ASCII bytes form tokens; apostrophes are handled separately */
+static int isTokenByte(unsigned char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+           (c >= '0' && c <= '9') || c >= 0x80;
+}
+
+/* Punctuation that ends a clause also ends a negation window */
+static int isClauseBreak(unsigned char c) {
+    return c == '.' || c == ',' || c == ';' || c == ':' || c == '!' || c == '?';
+}
+
+/* Empty slots are marked by hash 0, so real hashes are never 0 */
+static unsigned int finishHash(unsigned int hash) {
+    return hash ? hash : 1u;
+}
+
+/* Hash a term after folding it into dest; returns the folded length or -1 */
+static int foldTerm(const char* term, char* dest, unsigned int* hash) {
+    unsigned int h = FNV_OFFSET_BASIS;
+    int length = 0;
+
+    for (; term[length] != '\0'; length++) {
+        if (length >= MAX_TOKEN_LENGTH - 1) {
+            return -1;
+        }
+        unsigned char c = foldByte((unsigned char)term[length]);
+        dest[length] = (char)c;
+        h = (h ^ c) * FNV_PRIME;
+    }
+    dest[length] = '\0';
+
+    *hash = finishHash(h);
+    return length;
+}
+
+/* Hash an already folded term */
+static unsigned int hashTerm(const char* term, int length) {
+    unsigned int h = FNV_OFFSET_BASIS;
+    for (int i = 0; i < length; i++) {
+        h = (h ^ (unsigned char)term[i]) * FNV_PRIME;
+    }
+    return finishHash(h);
+}
+
+/* Find the slot holding a term, or the empty slot where it would go */
+static SentimentTerm* findSlot(const SentimentLexicon* lexicon, const char* term,
+                               int length, unsigned int hash) {
+    unsigned int mask = (unsigned int)lexicon->capacity - 1;
+    unsigned int index = hash & mask;
+
+    for (;;) {
+        SentimentTerm* slot = &lexicon->slots[index];
+        if (slot->hash == 0) {
+            return slot;
+        }
+        if (slot->hash == hash && slot->length == length && memcmp(slot->term, term, length) == 0) {
+            return slot;
+        }
+        index = (index + 1) & mask;
+    }
+}
+
+/* Initialize a sentiment lexicon */
+int initSentimentLexicon(SentimentLexicon* lexicon, int expectedTerms) {
+    if (!lexicon) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for initSentimentLexicon");
+        return -1;
+    }
+
+    /* Keep the load factor at or below 50% so probe sequences stay short */
+    int capacity = 16;
+    while (capacity < expectedTerms * 2) {
+        capacity *= 2;
+    }
+
+    lexicon->slots = (SentimentTerm*)calloc(capacity, sizeof(SentimentTerm));
+    if (!lexicon->slots) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate sentiment lexicon");
+        return -1;
+    }
+
+    lexicon->capacity = capacity;
+    lexicon->count = 0;
+    lexicon->negationWindow = DEFAULT_NEGATION_WINDOW;
+    lexicon->titleWeight = 2.0;  /* Title matches have higher weight */
+    lexicon->bodyWeight = 1.0;
+    lexicon->useStemming = 0;
+    return 0;
+}
+
+/* Enable or disable Porter stemming of terms and tokens */
+void setSentimentStemming(SentimentLexicon* lexicon, int enabled) {
+    if (!lexicon) {
+        return;
+    }
+    if (lexicon->count > 0) {
+        logWarning("Sentiment stemming changed after %d terms were added", lexicon->count);
+    }
+    lexicon->useStemming = enabled ? 1 : 0;
+}
+
+/* Free memory used by a sentiment lexicon */
+void freeSentimentLexicon(SentimentLexicon* lexicon) {
+    if (!lexicon) {
+        return;
+    }
+
+    free(lexicon->slots);
+    lexicon->slots = NULL;
+    lexicon->capacity = 0;
+    lexicon->count = 0;
+}
+
+/* Double the table size and reinsert every term */
+static int growLexicon(SentimentLexicon* lexicon) {
+    SentimentTerm* oldSlots = lexicon->slots;
+    int oldCapacity = lexicon->capacity;
+
+    SentimentTerm* newSlots = (SentimentTerm*)calloc(oldCapacity * 2, sizeof(SentimentTerm));
+    if (!newSlots) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to grow sentiment lexicon");
+        return -1;
+    }
+
+    lexicon->slots = newSlots;
+    lexicon->capacity = oldCapacity * 2;
+
+    for (int i = 0; i < oldCapacity; i++) {
+        if (oldSlots[i].hash != 0) {
+            SentimentTerm* slot = findSlot(lexicon, oldSlots[i].term, oldSlots[i].length, oldSlots[i].hash);
+            *slot = oldSlots[i];
+        }
+    }
+
+    free(oldSlots);
+    return 0;
+}
+
+/* Insert or update a term */
+static int putTerm(SentimentLexicon* lexicon, const char* term, double weight, unsigned char flags) {
+    if (!lexicon || !lexicon->slots || !term) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for sentiment lexicon insert");
+        return -1;
+    }
+
+    char folded[MAX_TOKEN_LENGTH];
+    unsigned int hash;
+    int length = foldTerm(term, folded, &hash);
+    if (length <= 0) {
+        logError(ERR_INVALID_PARAMETER, "Sentiment term must be 1 to %d bytes: '%s'",
+                 MAX_TOKEN_LENGTH - 1, term);
+        return -1;
+    }
+
+    if (lexicon->useStemming) {
+        length = porterStem(folded, length);
+        hash = hashTerm(folded, length);
+    }
+
+    if ((lexicon->count + 1) * 2 > lexicon->capacity && growLexicon(lexicon) != 0) {
+        return -1;
+    }
+
+    SentimentTerm* slot = findSlot(lexicon, folded, length, hash);
+    if (slot->hash == 0) {
+        slot->hash = hash;
+        slot->length = (unsigned char)length;
+        memcpy(slot->term, folded, length + 1);
+        lexicon->count++;
+    }
+    slot->weight = (float)weight;
+    slot->flags |= flags;
+    return 0;
+}
+
+/* Add or update a weighted sentiment term */
+int addSentimentTerm(SentimentLexicon* lexicon, const char* term, double weight) {
+    return putTerm(lexicon, term, weight, 0);
+}
+
+/* Add a negation word such as "not" or "never" */
+int addNegationTerm(SentimentLexicon* lexicon, const char* term) {
+    return putTerm(lexicon, term, 0.0, SENTIMENT_TERM_NEGATION);
+}
+
+/* Add positive and negative word lists with unit weights */
+int addSentimentWordLists(SentimentLexicon* lexicon,
+                          const char** positiveWords, int positiveCount,
+                          const char** negativeWords, int negativeCount) {
+    for (int i = 0; positiveWords && i < positiveCount; i++) {
+        if (addSentimentTerm(lexicon, positiveWords[i], 1.0) != 0) {
+            return -1;
+        }
+    }
+
+    for (int i = 0; negativeWords && i < negativeCount; i++) {
+        if (addSentimentTerm(lexicon, negativeWords[i], -1.0) != 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/* Add the default English negation words */
+int addDefaultNegations(SentimentLexicon* lexicon) {
+    static const char* negations[] = {
+        "not", "no", "never", "without", "neither", "nor", "none",
+        "cannot", "hardly", "barely", "lack", "lacks", "lacking"
+    };
+
+    for (size_t i = 0; i < sizeof(negations) / sizeof(negations[0]); i++) {
+        if (addNegationTerm(lexicon, negations[i]) != 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/* Look up the weight of a single term */
+double lookupSentimentTerm(const SentimentLexicon* lexicon, const char* term) {
+    if (!lexicon || !lexicon->slots || !term) {
+        return 0.0;
+    }
+
+    char folded[MAX_TOKEN_LENGTH];
+    unsigned int hash;
+    int length = foldTerm(term, folded, &hash);
+    if (length <= 0) {
+        return 0.0;
+    }
+
+    if (lexicon->useStemming) {
+        length = porterStem(folded, length);
+        hash = hashTerm(folded, length);
+    }
+
+    const SentimentTerm* slot = findSlot(lexicon, folded, length, hash);
+    return (slot->hash != 0) ? slot->weight : 0.0;
+}
+
+/* Tokenize a text once and add its sentiment to an accumulator */
+void accumulateSentiment(const SentimentLexicon* lexicon, const char* text,
+                         double weight, SentimentAccumulator* acc) {
+    if (!lexicon || !lexicon->slots || !text || !acc) {
+        return;
+    }
+
+    const unsigned char* p = (const unsigned char*)text;
+    char token[MAX_TOKEN_LENGTH];
+    int negationLeft = 0;
+
+    while (*p) {
+        /* Skip separators, closing any open negation window at clause ends */
+        while (*p && !isTokenByte(*p)) {
+            if (isClauseBreak(*p)) {
+                negationLeft = 0;
+            }
+            p++;
+        }
+        if (!*p) {
+            break;
+        }
+
+        /* Read one token, folding and hashing as we go. An apostrophe is kept
+           only between token bytes so "isn't" stays one token. */
+        unsigned int hash = FNV_OFFSET_BASIS;
+        int length = 0;
+        int overflow = 0;
+        while (isTokenByte(*p) || (*p == '\'' && length > 0 && isTokenByte(p[1]))) {
+            unsigned char c = foldByte(*p++);
+            if (length < MAX_TOKEN_LENGTH - 1) {
+                token[length++] = (char)c;
+                hash = (hash ^ c) * FNV_PRIME;
+            } else {
+                overflow = 1;
+            }
+        }
+
+        acc->tokenCount++;
+        if (overflow) {
+            if (negationLeft > 0) negationLeft--;
+            continue;
+        }
+
+        int isContraction = (length > 3 && memcmp(token + length - 3, "n't", 3) == 0);
+        unsigned int tokenHash = finishHash(hash);
+        if (lexicon->useStemming && !isContraction) {
+            length = porterStem(token, length);
+            tokenHash = hashTerm(token, length);
+        }
+
+        const SentimentTerm* slot = findSlot(lexicon, token, length, tokenHash);
+        int isNegation = isContraction ||
+                         (slot->hash != 0 && (slot->flags & SENTIMENT_TERM_NEGATION));
+
+        if (slot->hash != 0 && slot->weight != 0.0f) {
+            double w = slot->weight * weight;
+            if (negationLeft > 0) {
+                w = -w;
+            }
+            if (w > 0) {
+                acc->positive += w;
+            } else {
+                acc->negative -= w;
+            }
+            acc->matchCount++;
+        }
+
+        if (isNegation) {
+            negationLeft = lexicon->negationWindow;
+        } else if (negationLeft > 0) {
+            negationLeft--;
+        }
+    }
+}
+
+/* Convert an accumulator to the (score, confidence) pair */
+void finishSentiment(const SentimentAccumulator* acc, double* score, double* confidence) {
+    double total = acc ? acc->positive + acc->negative : 0.0;
+
+    if (total > 0) {
+        if (score) *score = (acc->positive - acc->negative) / total;
+        if (confidence) *confidence = fmin(total / 5.0, 1.0); /* Higher confidence with more sentiment words */
+    } else {
+        if (score) *score = 0.0;
+        if (confidence) *confidence = 0.0;
+    }
+}
+
+/* Score a single text */
+void scoreSentimentText(const SentimentLexicon* lexicon, const char* text,
+                        double* score, double* confidence) {
+    SentimentAccumulator acc = {0.0, 0.0, 0, 0};
+    accumulateSentiment(lexicon, text, 1.0, &acc);
+    finishSentiment(&acc, score, confidence);
+}
+
+/* Score a news document using the lexicon's title and body weights */
+void scoreSentimentDocument(const SentimentLexicon* lexicon, const char* title, const char* body,
+                            double* score, double* confidence) {
+    SentimentAccumulator acc = {0.0, 0.0, 0, 0};
+
+    if (lexicon) {
+        accumulateSentiment(lexicon, title, lexicon->titleWeight, &acc);
+        accumulateSentiment(lexicon, body, lexicon->bodyWeight, &acc);
+    }
+
+    finishSentiment(&acc, score, confidence);
+}
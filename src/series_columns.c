@@ -0,0 +1,150 @@
+/**
+ * Series Columns
+ * Structure-of-arrays storage for price series
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/series_columns.h"
+#include "../include/time_utils.h"
+#include "../include/error_handling.h"
+
+/* Initialize empty columns */
+int initSeriesColumns(SeriesColumns* columns, int capacity) {
+    if (!columns || capacity < 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for initSeriesColumns");
+        return -1;
+    }
+
+    memset(columns, 0, sizeof(SeriesColumns));
+    return capacity > 0 ? reserveSeriesColumns(columns, capacity) : 0;
+}
+
+/* Point columns at caller-owned memory without copying */
+int bindSeriesColumns(SeriesColumns* columns, void* memory, int capacity, int count) {
+    if (!columns || !memory || capacity <= 0 || count < 0 || count > capacity) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for bindSeriesColumns");
+        return -1;
+    }
+
+    double* block = (double*)memory;
+    columns->open = block;
+    columns->high = block + (size_t)capacity;
+    columns->low = block + 2 * (size_t)capacity;
+    columns->close = block + 3 * (size_t)capacity;
+    columns->volume = block + 4 * (size_t)capacity;
+    columns->day = (int*)(block + 5 * (size_t)capacity);
+    columns->count = count;
+    columns->capacity = capacity;
+    columns->borrowed = 1;
+    return 0;
+}
+
+/* Free memory used by columns */
+void freeSeriesColumns(SeriesColumns* columns) {
+    if (!columns) {
+        return;
+    }
+
+    /* All five price columns share the block that starts at open */
+    if (!columns->borrowed) {
+        free(columns->open);
+        free(columns->day);
+    }
+    memset(columns, 0, sizeof(SeriesColumns));
+}
+
+/* Make room for at least capacity bars, keeping existing bars */
+int reserveSeriesColumns(SeriesColumns* columns, int capacity) {
+    if (!columns || capacity < 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for reserveSeriesColumns");
+        return -1;
+    }
+    if (capacity <= columns->capacity) {
+        return 0;
+    }
+    if (columns->borrowed) {
+        logError(ERR_INVALID_PARAMETER, "Bound series columns cannot grow past %d bars", columns->capacity);
+        return -1;
+    }
+
+    int newCapacity = columns->capacity > 0 ? columns->capacity : 64;
+    while (newCapacity < capacity) {
+        newCapacity *= 2;
+    }
+
+    double* block = (double*)malloc(5 * (size_t)newCapacity * sizeof(double));
+    int* day = (int*)realloc(columns->day, (size_t)newCapacity * sizeof(int));
+    if (day) {
+        columns->day = day;
+    }
+    if (!block || !day) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate series columns for %d bars", newCapacity);
+        free(block);
+        return -1;
+    }
+
+    double* fields[5];
+    for (int f = 0; f < 5; f++) {
+        fields[f] = block + (size_t)f * newCapacity;
+    }
+    if (columns->count > 0) {
+        size_t bytes = (size_t)columns->count * sizeof(double);
+        memcpy(fields[0], columns->open, bytes);
+        memcpy(fields[1], columns->high, bytes);
+        memcpy(fields[2], columns->low, bytes);
+        memcpy(fields[3], columns->close, bytes);
+        memcpy(fields[4], columns->volume, bytes);
+    }
+
+    free(columns->open);
+    columns->open = fields[0];
+    columns->high = fields[1];
+    columns->low = fields[2];
+    columns->close = fields[3];
+    columns->volume = fields[4];
+    columns->capacity = newCapacity;
+    return 0;
+}
+
+/* Replace the columns' contents with bars */
+int loadSeriesColumns(SeriesColumns* columns, const StockData* data, int count) {
+    if (!columns) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for loadSeriesColumns");
+        return -1;
+    }
+
+    columns->count = 0;
+    return appendSeriesColumns(columns, data, count);
+}
+
+/* Append bars to the columns */
+int appendSeriesColumns(SeriesColumns* columns, const StockData* data, int count) {
+    if (!columns || (!data && count > 0) || count < 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for appendSeriesColumns");
+        return -1;
+    }
+    if (reserveSeriesColumns(columns, columns->count + count) != 0) {
+        return -1;
+    }
+
+    int base = columns->count;
+    int previousDay = base > 0 ? columns->day[base - 1] : 0;
+    for (int i = 0; i < count; i++) {
+        time_t seconds;
+        if (parseISO8601Timestamp(data[i].date, &seconds, NULL) == 0) {
+            previousDay = (int)(seconds >= 0 ? seconds / 86400 : (seconds - 86399) / 86400);
+        }
+        columns->day[base + i] = previousDay;
+        columns->open[base + i] = data[i].open;
+        columns->high[base + i] = data[i].high;
+        columns->low[base + i] = data[i].low;
+        columns->close[base + i] = data[i].close;
+        columns->volume[base + i] = data[i].volume;
+    }
+
+    columns->count += count;
+    return 0;
+}
@@ -0,0 +1,546 @@
+/**
+ * Series Sessions
+ * Native-resident price series behind generation-checked handles, with
+ * indicator columns that are extended incrementally as bars arrive
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../include/series_session.h"
+#include "../include/pattern_detection.h"
+#include "../include/anomaly_detection.h"
+#include "../include/error_handling.h"
+
+/* Standard MACD periods */
+#define MACD_FAST_PERIOD 12
+#define MACD_SLOW_PERIOD 26
+#define MACD_SIGNAL_PERIOD 9
+
+typedef struct {
+    SeriesSession* session;
+    uint32_t generation;
+} SessionSlot;
+
+static SessionSlot sessionSlots[MAX_SERIES_SESSIONS];
+static pthread_mutex_t registryLock = PTHREAD_MUTEX_INITIALIZER;
+
+static void destroySession(SeriesSession* session) {
+    for (int i = 0; i < session->indicatorCount; i++) {
+        free(session->indicators[i].values);
+    }
+    free(session->indicators);
+    free(session->patterns);
+    free(session->anomalies);
+    freeSeriesColumns(&session->columns);
+    pthread_mutex_destroy(&session->lock);
+    free(session);
+}
+
+static SeriesSession* createSession(int capacity) {
+    SeriesSession* session = (SeriesSession*)calloc(1, sizeof(SeriesSession));
+    if (!session) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate series session");
+        return NULL;
+    }
+    if (initSeriesColumns(&session->columns, capacity) != 0) {
+        free(session);
+        return NULL;
+    }
+    pthread_mutex_init(&session->lock, NULL);
+    return session;
+}
+
+/* Slot index in the low 32 bits (plus one), generation in the high 32 */
+static SeriesHandle registerSession(SeriesSession* session) {
+    pthread_mutex_lock(&registryLock);
+    for (int slot = 0; slot < MAX_SERIES_SESSIONS; slot++) {
+        if (!sessionSlots[slot].session) {
+            uint32_t generation = sessionSlots[slot].generation + 1;
+            if (generation == 0) {
+                generation = 1;
+            }
+            sessionSlots[slot].generation = generation;
+            sessionSlots[slot].session = session;
+            pthread_mutex_unlock(&registryLock);
+            return ((SeriesHandle)generation << 32) | (SeriesHandle)(slot + 1);
+        }
+    }
+    pthread_mutex_unlock(&registryLock);
+
+    logError(ERR_OUT_OF_MEMORY, "All %d series sessions are in use", MAX_SERIES_SESSIONS);
+    destroySession(session);
+    return INVALID_SERIES_HANDLE;
+}
+
+/* Caller holds registryLock */
+static SessionSlot* resolveHandle(SeriesHandle handle) {
+    int64_t slot = (handle & 0xffffffff) - 1;
+    uint32_t generation = (uint32_t)((uint64_t)handle >> 32);
+    if (slot < 0 || slot >= MAX_SERIES_SESSIONS ||
+        !sessionSlots[slot].session || sessionSlots[slot].generation != generation) {
+        return NULL;
+    }
+    return &sessionSlots[slot];
+}
+
+/* Create a session holding a copy of bars */
+SeriesHandle openSeriesSession(const StockData* data, int count) {
+    if ((!data && count > 0) || count < 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for openSeriesSession");
+        return INVALID_SERIES_HANDLE;
+    }
+
+    SeriesSession* session = createSession(count);
+    if (!session) {
+        return INVALID_SERIES_HANDLE;
+    }
+    if (loadSeriesColumns(&session->columns, data, count) != 0) {
+        destroySession(session);
+        return INVALID_SERIES_HANDLE;
+    }
+    return registerSession(session);
+}
+
+/* Create a session holding a copy of columns (owned or bound) */
+SeriesHandle openSeriesSessionColumns(const SeriesColumns* columns) {
+    if (!columns) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for openSeriesSessionColumns");
+        return INVALID_SERIES_HANDLE;
+    }
+
+    int n = columns->count;
+    SeriesSession* session = createSession(n);
+    if (!session) {
+        return INVALID_SERIES_HANDLE;
+    }
+
+    SeriesColumns* own = &session->columns;
+    if (n > 0) {
+        size_t bytes = (size_t)n * sizeof(double);
+        memcpy(own->open, columns->open, bytes);
+        memcpy(own->high, columns->high, bytes);
+        memcpy(own->low, columns->low, bytes);
+        memcpy(own->close, columns->close, bytes);
+        memcpy(own->volume, columns->volume, bytes);
+        memcpy(own->day, columns->day, (size_t)n * sizeof(int));
+    }
+    own->count = n;
+    return registerSession(session);
+}
+
+/* Close a session handle */
+int closeSeriesSession(SeriesHandle handle) {
+    pthread_mutex_lock(&registryLock);
+    SessionSlot* slot = resolveHandle(handle);
+    if (!slot) {
+        pthread_mutex_unlock(&registryLock);
+        logWarning("Series session handle %lld is not open", (long long)handle);
+        return -1;
+    }
+
+    SeriesSession* session = slot->session;
+    slot->session = NULL;
+    session->closed = 1;
+    int unused = session->references == 0;
+    pthread_mutex_unlock(&registryLock);
+
+    if (unused) {
+        destroySession(session);
+    }
+    return 0;
+}
+
+/* Close every open session */
+void closeAllSeriesSessions(void) {
+    for (int slot = 0; slot < MAX_SERIES_SESSIONS; slot++) {
+        pthread_mutex_lock(&registryLock);
+        SeriesSession* session = sessionSlots[slot].session;
+        int unused = 0;
+        if (session) {
+            sessionSlots[slot].session = NULL;
+            session->closed = 1;
+            unused = session->references == 0;
+        }
+        pthread_mutex_unlock(&registryLock);
+
+        if (unused) {
+            destroySession(session);
+        }
+    }
+}
+
+/* Resolve and lock a session */
+SeriesSession* acquireSeriesSession(SeriesHandle handle) {
+    pthread_mutex_lock(&registryLock);
+    SessionSlot* slot = resolveHandle(handle);
+    SeriesSession* session = slot ? slot->session : NULL;
+    if (session) {
+        session->references++;
+    }
+    pthread_mutex_unlock(&registryLock);
+
+    if (!session) {
+        logError(ERR_INVALID_PARAMETER, "Series session handle %lld is not open", (long long)handle);
+        return NULL;
+    }
+
+    pthread_mutex_lock(&session->lock);
+    return session;
+}
+
+/* Unlock a session returned by acquireSeriesSession */
+void releaseSeriesSession(SeriesSession* session) {
+    if (!session) {
+        return;
+    }
+
+    pthread_mutex_unlock(&session->lock);
+
+    pthread_mutex_lock(&registryLock);
+    session->references--;
+    int unused = session->closed && session->references == 0;
+    pthread_mutex_unlock(&registryLock);
+
+    if (unused) {
+        destroySession(session);
+    }
+}
+
+/* Append bars to an acquired session */
+int appendSessionBars(SeriesSession* session, const StockData* data, int count) {
+    if (!session) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for appendSessionBars");
+        return -1;
+    }
+    if (appendSeriesColumns(&session->columns, data, count) != 0) {
+        return -1;
+    }
+
+    session->patternLimit = 0;
+    session->anomalyLimit = 0;
+    return 0;
+}
+
+static double relativeStrength(double averageGain, double averageLoss) {
+    if (averageLoss <= 0.0) {
+        return averageGain > 0.0 ? 100.0 : 50.0;
+    }
+    return 100.0 - 100.0 / (1.0 + averageGain / averageLoss);
+}
+
+/* Compute bars [indicator->count, count) from the carried state */
+static void extendIndicator(CachedIndicator* indicator, const SeriesColumns* columns) {
+    const double* close = columns->close;
+    double* values = indicator->values;
+    double* state = indicator->state;
+    int period = indicator->period;
+    int n = columns->count;
+
+    for (int i = indicator->count; i < n; i++) {
+        double c = close[i];
+
+        switch (indicator->kind) {
+            case SESSION_INDICATOR_SMA:
+                state[0] += c;
+                if (i >= period) {
+                    state[0] -= close[i - period];
+                }
+                values[i] = state[0] / (i + 1 < period ? i + 1 : period);
+                break;
+
+            case SESSION_INDICATOR_EMA:
+                values[i] = i == 0 ? c : values[i - 1] + 2.0 / (period + 1.0) * (c - values[i - 1]);
+                break;
+
+            case SESSION_INDICATOR_RSI: {
+                /* Wilder smoothing after a simple average over the first period changes */
+                if (i == 0) {
+                    values[i] = 50.0;
+                    break;
+                }
+                double change = c - close[i - 1];
+                double gain = change > 0.0 ? change : 0.0;
+                double loss = change < 0.0 ? -change : 0.0;
+                if (i <= period) {
+                    state[0] += gain / period;
+                    state[1] += loss / period;
+                } else {
+                    state[0] = (state[0] * (period - 1) + gain) / period;
+                    state[1] = (state[1] * (period - 1) + loss) / period;
+                }
+                values[i] = i < period ? 50.0 : relativeStrength(state[0], state[1]);
+                break;
+            }
+
+            default: {
+                /* MACD family: fast EMA, slow EMA and signal EMA */
+                if (i == 0) {
+                    state[0] = state[1] = c;
+                    state[2] = 0.0;
+                } else {
+                    state[0] += 2.0 / (MACD_FAST_PERIOD + 1.0) * (c - state[0]);
+                    state[1] += 2.0 / (MACD_SLOW_PERIOD + 1.0) * (c - state[1]);
+                    state[2] += 2.0 / (MACD_SIGNAL_PERIOD + 1.0) * ((state[0] - state[1]) - state[2]);
+                }
+                double macd = state[0] - state[1];
+                values[i] = indicator->kind == SESSION_INDICATOR_MACD ? macd
+                          : indicator->kind == SESSION_INDICATOR_MACD_SIGNAL ? state[2]
+                          : macd - state[2];
+                break;
+            }
+        }
+    }
+
+    indicator->count = n;
+}
+
+static CachedIndicator* findIndicator(SeriesSession* session, int kind, int period) {
+    for (int i = 0; i < session->indicatorCount; i++) {
+        CachedIndicator* indicator = &session->indicators[i];
+        if (indicator->kind == kind && indicator->period == period) {
+            return indicator;
+        }
+    }
+
+    if (session->indicatorCount == session->indicatorCapacity) {
+        int capacity = session->indicatorCapacity > 0 ? session->indicatorCapacity * 2 : 8;
+        CachedIndicator* grown = (CachedIndicator*)realloc(session->indicators,
+                                                           capacity * sizeof(CachedIndicator));
+        if (!grown) {
+            logError(ERR_OUT_OF_MEMORY, "Failed to grow indicator cache to %d entries", capacity);
+            return NULL;
+        }
+        session->indicators = grown;
+        session->indicatorCapacity = capacity;
+    }
+
+    CachedIndicator* indicator = &session->indicators[session->indicatorCount++];
+    memset(indicator, 0, sizeof(CachedIndicator));
+    indicator->kind = kind;
+    indicator->period = period;
+    return indicator;
+}
+
+/* Get an indicator column of an acquired session, computing only bars not yet cached */
+const double* getSessionIndicator(SeriesSession* session, int kind, int period) {
+    if (!session || kind < 0 || kind >= SESSION_INDICATOR_COUNT) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for getSessionIndicator");
+        return NULL;
+    }
+    if (kind >= SESSION_INDICATOR_MACD) {
+        period = 0;
+    } else if (period < 1) {
+        logError(ERR_INVALID_PARAMETER, "Indicator period must be positive, got %d", period);
+        return NULL;
+    }
+
+    CachedIndicator* indicator = findIndicator(session, kind, period);
+    if (!indicator) {
+        return NULL;
+    }
+
+    int capacity = session->columns.capacity > 0 ? session->columns.capacity : 1;
+    if (indicator->capacity < capacity) {
+        double* values = (double*)realloc(indicator->values, (size_t)capacity * sizeof(double));
+        if (!values) {
+            logError(ERR_OUT_OF_MEMORY, "Failed to allocate indicator column for %d bars", capacity);
+            return NULL;
+        }
+        indicator->values = values;
+        indicator->capacity = capacity;
+    }
+
+    extendIndicator(indicator, &session->columns);
+    return indicator->values;
+}
+
+/* Detect price patterns of an acquired session, reusing the cached result */
+int getSessionPatterns(SeriesSession* session, MarketPattern* patterns, int maxPatterns) {
+    if (!session || !patterns || maxPatterns <= 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for getSessionPatterns");
+        return -1;
+    }
+
+    if (session->patternLimit != maxPatterns) {
+        MarketPattern* cache = (MarketPattern*)realloc(session->patterns, maxPatterns * sizeof(MarketPattern));
+        if (!cache) {
+            logError(ERR_OUT_OF_MEMORY, "Failed to allocate %d cached patterns", maxPatterns);
+            return -1;
+        }
+        session->patterns = cache;
+        session->patternLimit = 0;
+
+        int count = detectSeriesPatterns(&session->columns, NULL, cache, maxPatterns);
+        if (count < 0) {
+            return -1;
+        }
+        session->patternCount = count;
+        session->patternLimit = maxPatterns;
+    }
+
+    memcpy(patterns, session->patterns, session->patternCount * sizeof(MarketPattern));
+    return session->patternCount;
+}
+
+/* Detect anomalies of an acquired session, reusing the cached result */
+int getSessionAnomalies(SeriesSession* session, AnomalyResult* anomalies, int maxAnomalies) {
+    if (!session || !anomalies || maxAnomalies <= 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for getSessionAnomalies");
+        return -1;
+    }
+
+    if (session->anomalyLimit != maxAnomalies) {
+        AnomalyResult* cache = (AnomalyResult*)realloc(session->anomalies, maxAnomalies * sizeof(AnomalyResult));
+        if (!cache) {
+            logError(ERR_OUT_OF_MEMORY, "Failed to allocate %d cached anomalies", maxAnomalies);
+            return -1;
+        }
+        session->anomalies = cache;
+        session->anomalyLimit = 0;
+
+        int count = detectSeriesAnomalies(&session->columns, NULL, cache, maxAnomalies);
+        if (count < 0) {
+            return -1;
+        }
+        session->anomalyCount = count;
+        session->anomalyLimit = maxAnomalies;
+    }
+
+    memcpy(anomalies, session->anomalies, session->anomalyCount * sizeof(AnomalyResult));
+    return session->anomalyCount;
+}
+
+/* Generate crossover signals of an acquired session */
+int getSessionCrossoverSignals(SeriesSession* session, const CrossoverRule* rule,
+                               DMTradingSignal* signals, int maxSignals) {
+    if (!session) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for getSessionCrossoverSignals");
+        return -1;
+    }
+    return generateCrossoverSignals(&session->columns, rule, NULL, signals, maxSignals);
+}
+
+/* Compute the flat buffer layout of a request */
+void initAnalysisLayout(AnalysisLayout* layout, int maxResults, int indicatorCount) {
+    int m = maxResults;
+    int next = ANALYSIS_HEADER_INTS;
+
+    layout->patternType = next;        next += m;
+    layout->patternStart = next;       next += m;
+    layout->patternEnd = next;         next += m;
+    layout->signalType = next;         next += 2 * m;
+    layout->signalIndex = next;        next += 2 * m;
+    layout->signalRule = next;         next += 2 * m;
+    layout->anomalyIndex = next;       next += m;
+    layout->intCount = next;
+
+    next = 0;
+    layout->patternConfidence = next;       next += m;
+    layout->patternExpectedMove = next;     next += m;
+    layout->patternLevel = next;            next += m;
+    layout->signalConfidence = next;        next += 2 * m;
+    layout->signalEntry = next;             next += 2 * m;
+    layout->signalTarget = next;            next += 2 * m;
+    layout->signalStop = next;              next += 2 * m;
+    layout->signalRiskReward = next;        next += 2 * m;
+    layout->anomalyScore = next;            next += m;
+    layout->anomalyPriceDeviation = next;   next += m;
+    layout->anomalyVolumeDeviation = next;  next += m;
+    layout->anomalyPriceChange = next;      next += m;
+    layout->indicatorValues = next;         next += indicatorCount;
+    layout->doubleCount = next;
+}
+
+static void storeSignal(const AnalysisLayout* layout, int* ints, double* doubles, int slot,
+                        const DMTradingSignal* signal, int rule) {
+    ints[layout->signalType + slot] = signal->type;
+    ints[layout->signalIndex + slot] = signal->signalIndex;
+    ints[layout->signalRule + slot] = rule;
+    doubles[layout->signalConfidence + slot] = signal->confidence;
+    doubles[layout->signalEntry + slot] = signal->entryPrice;
+    doubles[layout->signalTarget + slot] = signal->targetPrice;
+    doubles[layout->signalStop + slot] = signal->stopLossPrice;
+    doubles[layout->signalRiskReward + slot] = signal->riskRewardRatio;
+}
+
+/* Run patterns, SMA and EMA signals, anomalies and indicators of an acquired session */
+int analyzeSeriesSession(SeriesSession* session, const AnalysisRequest* request, int* ints, double* doubles) {
+    if (!session || !request || !ints || !doubles || request->maxResults <= 0 ||
+        request->indicatorCount < 0 || request->indicatorCount > MAX_ANALYSIS_INDICATORS) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for analyzeSeriesSession");
+        return -1;
+    }
+
+    int m = request->maxResults;
+    AnalysisLayout layout;
+    initAnalysisLayout(&layout, m, request->indicatorCount);
+
+    /* One scratch block for the row-oriented kernel outputs */
+    size_t bytes = m * sizeof(MarketPattern) + 2 * m * sizeof(DMTradingSignal) + m * sizeof(AnomalyResult);
+    char* scratch = (char*)malloc(bytes);
+    if (!scratch) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate analysis scratch for %d results", m);
+        return -1;
+    }
+    MarketPattern* patterns = (MarketPattern*)scratch;
+    DMTradingSignal* smaSignals = (DMTradingSignal*)(patterns + m);
+    DMTradingSignal* emaSignals = smaSignals + m;
+    AnomalyResult* anomalies = (AnomalyResult*)(emaSignals + m);
+
+    int patternCount = getSessionPatterns(session, patterns, m);
+    int smaCount = getSessionCrossoverSignals(session, &request->smaRule, smaSignals, m);
+    int emaCount = getSessionCrossoverSignals(session, &request->emaRule, emaSignals, m);
+    int anomalyCount = getSessionAnomalies(session, anomalies, m);
+    if (patternCount < 0 || smaCount < 0 || emaCount < 0 || anomalyCount < 0) {
+        free(scratch);
+        return -1;
+    }
+
+    for (int i = 0; i < patternCount; i++) {
+        ints[layout.patternType + i] = patterns[i].type;
+        ints[layout.patternStart + i] = patterns[i].startIndex;
+        ints[layout.patternEnd + i] = patterns[i].endIndex;
+        doubles[layout.patternConfidence + i] = patterns[i].confidence;
+        doubles[layout.patternExpectedMove + i] = patterns[i].expectedMove;
+        doubles[layout.patternLevel + i] = patterns[i].priceLevel;
+    }
+
+    /* Both signal lists are in bar order; merge them */
+    int s = 0, e = 0;
+    while (s < smaCount || e < emaCount) {
+        int takeSma = e >= emaCount ||
+                      (s < smaCount && smaSignals[s].signalIndex <= emaSignals[e].signalIndex);
+        if (takeSma) {
+            storeSignal(&layout, ints, doubles, s + e, &smaSignals[s], 0);
+            s++;
+        } else {
+            storeSignal(&layout, ints, doubles, s + e, &emaSignals[e], 1);
+            e++;
+        }
+    }
+
+    for (int i = 0; i < anomalyCount; i++) {
+        ints[layout.anomalyIndex + i] = anomalies[i].index;
+        doubles[layout.anomalyScore + i] = anomalies[i].score;
+        doubles[layout.anomalyPriceDeviation + i] = anomalies[i].priceDeviation;
+        doubles[layout.anomalyVolumeDeviation + i] = anomalies[i].volumeDeviation;
+        doubles[layout.anomalyPriceChange + i] = anomalies[i].priceChange;
+    }
+
+    int n = session->columns.count;
+    for (int k = 0; k < request->indicatorCount; k++) {
+        const double* values = n > 0 ? getSessionIndicator(session, request->indicators[k], request->periods[k]) : NULL;
+        doubles[layout.indicatorValues + k] = values ? values[n - 1] : NAN;
+    }
+
+    ints[0] = patternCount;
+    ints[1] = smaCount + emaCount;
+    ints[2] = anomalyCount;
+    ints[3] = n;
+
+    free(scratch);
+    return 0;
+}
@@ -0,0 +1,412 @@
+/**
+ * Porter Stemmer
+ * Table-driven implementation of the complete Porter (1980) algorithm
+ *
+ * Consonant flags and prefix measures are computed once per word and only
+ * recomputed for the tail that a rule rewrites, so every m() and
+ * vowel-in-stem test is a table lookup.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/stemmer.h"
+#include "../include/error_handling.h"
+
+/* FNV-1a parameters for the memo cache */
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME 16777619u
+
+/* Suffix rewrite rule: when the word ends with suffix, replace it */
+typedef struct {
+    char key;               /* Dispatch letter (see each step) */
+    const char* suffix;
+    int suffixLength;
+    const char* replacement;
+    int replacementLength;
+} SuffixRule;
+
+#define RULE(key, suffix, replacement) \
+    { key, suffix, sizeof(suffix) - 1, replacement, sizeof(replacement) - 1 }
+
+/* Step 2 rules, dispatched on the penultimate letter of the word */
+static const SuffixRule step2Rules[] = {
+    RULE('a', "ational", "ate"), RULE('a', "tional", "tion"),
+    RULE('c', "enci", "ence"),   RULE('c', "anci", "ance"),
+    RULE('e', "izer", "ize"),
+    RULE('l', "bli", "ble"),     RULE('l', "alli", "al"),
+    RULE('l', "entli", "ent"),   RULE('l', "eli", "e"),
+    RULE('l', "ousli", "ous"),
+    RULE('o', "ization", "ize"), RULE('o', "ation", "ate"),
+    RULE('o', "ator", "ate"),
+    RULE('s', "alism", "al"),    RULE('s', "iveness", "ive"),
+    RULE('s', "fulness", "ful"), RULE('s', "ousness", "ous"),
+    RULE('t', "aliti", "al"),    RULE('t', "iviti", "ive"),
+    RULE('t', "biliti", "ble"),
+    RULE('g', "logi", "log")
+};
+
+/* Step 3 rules, dispatched on the last letter of the word */
+static const SuffixRule step3Rules[] = {
+    RULE('e', "icate", "ic"),    RULE('e', "ative", ""),
+    RULE('e', "alize", "al"),
+    RULE('i', "iciti", "ic"),
+    RULE('l', "ical", "ic"),     RULE('l', "ful", ""),
+    RULE('s', "ness", "")
+};
+
+/* Step 4 suffixes (all deleted), dispatched on the penultimate letter */
+static const SuffixRule step4Rules[] = {
+    RULE('a', "al", ""),
+    RULE('c', "ance", ""),       RULE('c', "ence", ""),
+    RULE('e', "er", ""),
+    RULE('i', "ic", ""),
+    RULE('l', "able", ""),       RULE('l', "ible", ""),
+    RULE('n', "ant", ""),        RULE('n', "ement", ""),
+    RULE('n', "ment", ""),       RULE('n', "ent", ""),
+    RULE('o', "ion", ""),        RULE('o', "ou", ""),
+    RULE('s', "ism", ""),
+    RULE('t', "ate", ""),        RULE('t', "iti", ""),
+    RULE('u', "ous", ""),
+    RULE('v', "ive", ""),
+    RULE('z', "ize", "")
+};
+
+#define RULE_COUNT(rules) ((int)(sizeof(rules) / sizeof((rules)[0])))
+
+/* Working state for one word */
+typedef struct {
+    char* b;                                     /* Word buffer */
+    int length;                                  /* Current word length */
+    unsigned char cons[MAX_STEM_WORD_LENGTH];    /* 1 if b[i] is a consonant */
+    unsigned char measure[MAX_STEM_WORD_LENGTH + 1]; /* m() of the prefix b[0..i) */
+    unsigned char vowels[MAX_STEM_WORD_LENGTH + 1];  /* Vowels in the prefix b[0..i) */
+} StemState;
+
+/* Recompute consonant flags and prefix tables from position 'from' onwards */
+static void updateTables(StemState* s, int from) {
+    for (int i = from; i < s->length; i++) {
+        char c = s->b[i];
+        int isCons;
+        if (c == 'a' || c == 'e' || c == 'i' || c == 'o' || c == 'u') {
+            isCons = 0;
+        } else if (c == 'y') {
+            /* 'y' is a consonant at the start or after a vowel */
+            isCons = (i == 0) ? 1 : !s->cons[i - 1];
+        } else {
+            isCons = 1;
+        }
+
+        s->cons[i] = (unsigned char)isCons;
+        s->measure[i + 1] = (unsigned char)(s->measure[i] + (i > 0 && isCons && !s->cons[i - 1]));
+        s->vowels[i + 1] = (unsigned char)(s->vowels[i] + !isCons);
+    }
+}
+
+/* Length of the stem if the word ends with the rule's suffix, else -1 */
+static int endsWith(const StemState* s, const char* suffix, int suffixLength) {
+    if (suffixLength > s->length) {
+        return -1;
+    }
+    if (memcmp(s->b + s->length - suffixLength, suffix, suffixLength) != 0) {
+        return -1;
+    }
+    return s->length - suffixLength;
+}
+
+/* Replace everything after stemLength with the given text */
+static void setTo(StemState* s, int stemLength, const char* text, int textLength) {
+    memcpy(s->b + stemLength, text, textLength);
+    s->length = stemLength + textLength;
+    updateTables(s, stemLength);
+}
+
+/* b[i] and b[i-1] are the same consonant */
+static int doubleConsonant(const StemState* s, int i) {
+    return i >= 1 && s->b[i] == s->b[i - 1] && s->cons[i];
+}
+
+/* b[i-2..i] is consonant-vowel-consonant and b[i] is not w, x or y */
+static int cvc(const StemState* s, int i) {
+    if (i < 2 || !s->cons[i] || s->cons[i - 1] || !s->cons[i - 2]) {
+        return 0;
+    }
+    char c = s->b[i];
+    return c != 'w' && c != 'x' && c != 'y';
+}
+
+/* Step 1ab: plurals and -ed / -ing */
+static void step1ab(StemState* s) {
+    int j;
+
+    if (s->b[s->length - 1] == 's') {
+        if (endsWith(s, "sses", 4) >= 0) {
+            s->length -= 2;
+        } else if ((j = endsWith(s, "ies", 3)) >= 0) {
+            setTo(s, j, "i", 1);
+        } else if (s->b[s->length - 2] != 's') {
+            s->length--;
+        }
+    }
+
+    if ((j = endsWith(s, "eed", 3)) >= 0) {
+        if (s->measure[j] > 0) {
+            s->length--;
+        }
+    } else if ((((j = endsWith(s, "ed", 2)) >= 0) || ((j = endsWith(s, "ing", 3)) >= 0)) &&
+               s->vowels[j] > 0) {
+        s->length = j;
+
+        int k;
+        if ((k = endsWith(s, "at", 2)) >= 0) {
+            setTo(s, k, "ate", 3);
+        } else if ((k = endsWith(s, "bl", 2)) >= 0) {
+            setTo(s, k, "ble", 3);
+        } else if ((k = endsWith(s, "iz", 2)) >= 0) {
+            setTo(s, k, "ize", 3);
+        } else if (doubleConsonant(s, s->length - 1)) {
+            char c = s->b[s->length - 1];
+            if (c != 'l' && c != 's' && c != 'z') {
+                s->length--;
+            }
+        } else if (s->measure[s->length] == 1 && cvc(s, s->length - 1)) {
+            setTo(s, s->length, "e", 1);
+        }
+    }
+}
+
+/* Step 1c: terminal y to i when there is another vowel in the stem */
+static void step1c(StemState* s) {
+    int j = endsWith(s, "y", 1);
+    if (j >= 0 && s->vowels[j] > 0) {
+        s->b[j] = 'i';
+        updateTables(s, j);
+    }
+}
+
+/* Apply the first rule whose suffix matches; rewrite only if m(stem) > minMeasure */
+static void applyRules(StemState* s, const SuffixRule* rules, int ruleCount, char key, int minMeasure) {
+    for (int r = 0; r < ruleCount; r++) {
+        if (rules[r].key != key) {
+            continue;
+        }
+        int j = endsWith(s, rules[r].suffix, rules[r].suffixLength);
+        if (j < 0) {
+            continue;
+        }
+        if (s->measure[j] > minMeasure) {
+            setTo(s, j, rules[r].replacement, rules[r].replacementLength);
+        }
+        return;
+    }
+}
+
+/* Step 4: delete suffixes when m(stem) > 1; -ion needs a preceding s or t */
+static void step4(StemState* s) {
+    char key = s->b[s->length - 2];
+
+    for (int r = 0; r < RULE_COUNT(step4Rules); r++) {
+        if (step4Rules[r].key != key) {
+            continue;
+        }
+        int j = endsWith(s, step4Rules[r].suffix, step4Rules[r].suffixLength);
+        if (j < 0) {
+            continue;
+        }
+        if (step4Rules[r].suffix[0] == 'i' && step4Rules[r].suffixLength == 3 && key == 'o') {
+            /* "ion" only counts after s or t; otherwise try the next rule ("ou") */
+            if (j < 1 || (s->b[j - 1] != 's' && s->b[j - 1] != 't')) {
+                continue;
+            }
+        }
+        if (s->measure[j] > 1) {
+            s->length = j;
+        }
+        return;
+    }
+}
+
+/* Step 5: remove a final -e and reduce -ll when the measure allows */
+static void step5(StemState* s) {
+    int original = s->length;
+
+    if (s->b[s->length - 1] == 'e') {
+        int a = s->measure[original];
+        if (a > 1 || (a == 1 && !cvc(s, s->length - 2))) {
+            s->length--;
+        }
+    }
+
+    if (s->b[s->length - 1] == 'l' && doubleConsonant(s, s->length - 1) && s->measure[original] > 1) {
+        s->length--;
+    }
+}
+
+/* Stem a lowercase ASCII word in place using the full Porter algorithm */
+int porterStem(char* word, int length) {
+    if (!word || length <= 2 || length >= MAX_STEM_WORD_LENGTH) {
+        return length > 0 ? length : 0;
+    }
+
+    for (int i = 0; i < length; i++) {
+        if (word[i] < 'a' || word[i] > 'z') {
+            return length;
+        }
+    }
+
+    StemState s;
+    s.b = word;
+    s.length = length;
+    s.measure[0] = 0;
+    s.vowels[0] = 0;
+    updateTables(&s, 0);
+
+    step1ab(&s);
+    if (s.length > 1) {
+        step1c(&s);
+    }
+    if (s.length > 1) {
+        applyRules(&s, step2Rules, RULE_COUNT(step2Rules), s.b[s.length - 2], 0);
+    }
+    if (s.length > 0) {
+        applyRules(&s, step3Rules, RULE_COUNT(step3Rules), s.b[s.length - 1], 0);
+    }
+    if (s.length > 1) {
+        step4(&s);
+    }
+    if (s.length > 1) {
+        step5(&s);
+    }
+
+    word[s.length] = '\0';
+    return s.length;
+}
+
+/* Reset a memo cache to empty */
+void initStemCache(StemCache* cache) {
+    if (cache) {
+        memset(cache, 0, sizeof(StemCache));
+    }
+}
+
+/* Stem a word through a memo cache */
+int stemWordCached(StemCache* cache, const char* word, int length, char* stem) {
+    if (!word || !stem || length < 0) {
+        return 0;
+    }
+
+    if (length >= MAX_STEM_WORD_LENGTH) {
+        /* Too long to stem or cache: copy what fits */
+        length = MAX_STEM_WORD_LENGTH - 1;
+        memcpy(stem, word, length);
+        stem[length] = '\0';
+        return length;
+    }
+
+    if (!cache) {
+        memcpy(stem, word, length);
+        stem[length] = '\0';
+        return porterStem(stem, length);
+    }
+
+    unsigned int hash = FNV_OFFSET_BASIS;
+    for (int i = 0; i < length; i++) {
+        hash = (hash ^ (unsigned char)word[i]) * FNV_PRIME;
+    }
+    if (hash == 0) {
+        hash = 1;
+    }
+
+    StemCacheEntry* entry = &cache->entries[hash & (STEM_CACHE_SIZE - 1)];
+    if (entry->hash == hash && entry->wordLength == length && memcmp(entry->word, word, length) == 0) {
+        cache->hits++;
+        memcpy(stem, entry->stem, entry->stemLength + 1);
+        return entry->stemLength;
+    }
+
+    cache->misses++;
+    memcpy(stem, word, length);
+    stem[length] = '\0';
+    int stemLength = porterStem(stem, length);
+
+    entry->hash = hash;
+    entry->wordLength = (unsigned char)length;
+    entry->stemLength = (unsigned char)stemLength;
+    memcpy(entry->word, word, length);
+    memcpy(entry->stem, stem, stemLength + 1);
+
+    return stemLength;
+}
+
+/* Tokenize a text, stem every token and store the stems in an arena */
+int stemTokenStream(const char* text, StringArena* arena, StemmedToken* tokens,
+                    int maxTokens, StemCache* cache) {
+    if (!text || !arena || !tokens || maxTokens < 0) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for stemTokenStream");
+        return -1;
+    }
+
+    const unsigned char* p = (const unsigned char*)text;
+    char word[MAX_STEM_WORD_LENGTH];
+    char stem[MAX_STEM_WORD_LENGTH];
+    int count = 0;
+
+    while (*p && count < maxTokens) {
+        /* Skip anything that is not an ASCII letter */
+        while (*p && !((*p >= 'a' && *p <= 'z') || (*p >= 'A' && *p <= 'Z'))) {
+            p++;
+        }
+        if (!*p) {
+            break;
+        }
+
+        int start = (int)(p - (const unsigned char*)text);
+        int length = 0;
+        while ((*p >= 'a' && *p <= 'z') || (*p >= 'A' && *p <= 'Z')) {
+            if (length < MAX_STEM_WORD_LENGTH - 1) {
+                word[length] = (char)((*p <= 'Z') ? *p - 'A' + 'a' : *p);
+            }
+            length++;
+            p++;
+        }
+        if (length >= MAX_STEM_WORD_LENGTH) {
+            length = MAX_STEM_WORD_LENGTH - 1;
+        }
+
+        int stemLength = stemWordCached(cache, word, length, stem);
+        unsigned int offset = arenaAppend(arena, stem, stemLength);
+        if (offset == ARENA_INVALID_OFFSET) {
+            return -1;
+        }
+
+        tokens[count].offset = offset;
+        tokens[count].length = stemLength;
+        tokens[count].sourceStart = start;
+        count++;
+    }
+
+    return count;
+}
+
+/* Stem an array of words into an arena */
+int stemWordBatch(const char** words, int wordCount, StringArena* arena,
+                  unsigned int* offsets, StemCache* cache) {
+    if (!words || wordCount < 0 || !arena || !offsets) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for stemWordBatch");
+        return -1;
+    }
+
+    char stem[MAX_STEM_WORD_LENGTH];
+    for (int i = 0; i < wordCount; i++) {
+        int length = words[i] ? (int)strlen(words[i]) : 0;
+        int stemLength = stemWordCached(cache, words[i] ? words[i] : "", length, stem);
+
+        offsets[i] = arenaAppend(arena, stem, stemLength);
+        if (offsets[i] == ARENA_INVALID_OFFSET) {
+            return -1;
+        }
+    }
+
+    return wordCount;
+}
@@ -0,0 +1,107 @@
+/**
+ * String Arena
+ * Append-only storage for variable-length text
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/string_arena.h"
+#include "../include/error_handling.h"
+
+/* Default initial arena size */
+#define DEFAULT_ARENA_CAPACITY 4096
+
+/* Initialize an empty arena */
+int initStringArena(StringArena* arena, unsigned int initialCapacity) {
+    if (!arena) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for initStringArena");
+        return -1;
+    }
+
+    if (initialCapacity == 0) {
+        initialCapacity = DEFAULT_ARENA_CAPACITY;
+    }
+
+    arena->data = (char*)malloc(initialCapacity);
+    if (!arena->data) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate string arena (%u bytes)", initialCapacity);
+        arena->size = 0;
+        arena->capacity = 0;
+        return -1;
+    }
+
+    arena->size = 0;
+    arena->capacity = initialCapacity;
+    return 0;
+}
+
+/* Free memory used by an arena */
+void freeStringArena(StringArena* arena) {
+    if (!arena) {
+        return;
+    }
+
+    free(arena->data);
+    arena->data = NULL;
+    arena->size = 0;
+    arena->capacity = 0;
+}
+
+/* Drop all strings but keep the buffer for reuse */
+void resetStringArena(StringArena* arena) {
+    if (arena) {
+        arena->size = 0;
+    }
+}
+
+/* Append a string to the arena */
+unsigned int arenaAppend(StringArena* arena, const char* text, int length) {
+    if (!arena || !text) {
+        return ARENA_INVALID_OFFSET;
+    }
+
+    if (length < 0) {
+        length = (int)strlen(text);
+    }
+
+    /* Offsets are 32-bit, with the top value reserved as the failure marker */
+    unsigned long long needed = (unsigned long long)arena->size + (unsigned int)length + 1;
+    if (needed >= ARENA_INVALID_OFFSET) {
+        logError(ERR_OUT_OF_MEMORY, "String arena exceeds 4 GB limit");
+        return ARENA_INVALID_OFFSET;
+    }
+
+    if (needed > arena->capacity) {
+        unsigned long long newCapacity = arena->capacity ? arena->capacity : DEFAULT_ARENA_CAPACITY;
+        while (newCapacity < needed) {
+            newCapacity *= 2;
+        }
+        if (newCapacity >= ARENA_INVALID_OFFSET) {
+            newCapacity = ARENA_INVALID_OFFSET - 1;
+        }
+
+        char* newData = (char*)realloc(arena->data, (size_t)newCapacity);
+        if (!newData) {
+            logError(ERR_OUT_OF_MEMORY, "Failed to grow string arena to %llu bytes", newCapacity);
+            return ARENA_INVALID_OFFSET;
+        }
+        arena->data = newData;
+        arena->capacity = (unsigned int)newCapacity;
+    }
+
+    unsigned int offset = arena->size;
+    memcpy(arena->data + offset, text, length);
+    arena->data[offset + length] = '\0';
+    arena->size += (unsigned int)length + 1;
+    return offset;
+}
+
+/* Get a pointer to a stored string */
+const char* arenaString(const StringArena* arena, unsigned int offset) {
+    if (!arena || !arena->data || offset >= arena->size) {
+        return "";
+    }
+    return arena->data + offset;
+}
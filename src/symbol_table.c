@@ -0,0 +1,180 @@
+/**
+ * Symbol Table
+ * Interns stock symbols as dense integer ids
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "../include/symbol_table.h"
+#include "../include/error_handling.h"
+
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME 16777619u
+
+/* Fold a symbol to uppercase; returns its length or -1 if it does not fit */
+static int foldSymbol(const char* symbol, char* folded) {
+    int length = 0;
+    while (symbol[length]) {
+        if (length >= MAX_SYMBOL_LENGTH - 1) {
+            return -1;
+        }
+        folded[length] = (char)toupper((unsigned char)symbol[length]);
+        length++;
+    }
+    folded[length] = '\0';
+    return length;
+}
+
+static unsigned int hashSymbol(const char* symbol) {
+    unsigned int hash = FNV_OFFSET_BASIS;
+    while (*symbol) {
+        hash = (hash ^ (unsigned char)*symbol++) * FNV_PRIME;
+    }
+    return hash;
+}
+
+/* Return the slot holding the symbol, or the empty slot where it belongs */
+static int probeSlot(const SymbolTable* table, const char* folded, unsigned int hash) {
+    int mask = table->slotCapacity - 1;
+    int slot = (int)(hash & (unsigned int)mask);
+    while (table->slots[slot] != 0) {
+        if (strcmp(table->names[table->slots[slot] - 1], folded) == 0) {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+/* Double the slot array and reinsert every id */
+static int growSlots(SymbolTable* table) {
+    int newCapacity = table->slotCapacity * 2;
+    int* newSlots = (int*)calloc(newCapacity, sizeof(int));
+    if (!newSlots) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to grow symbol table to %d slots", newCapacity);
+        return -1;
+    }
+
+    free(table->slots);
+    table->slots = newSlots;
+    table->slotCapacity = newCapacity;
+
+    for (int id = 0; id < table->count; id++) {
+        int slot = probeSlot(table, table->names[id], hashSymbol(table->names[id]));
+        table->slots[slot] = id + 1;
+    }
+    return 0;
+}
+
+/* Initialize an empty symbol table */
+int initSymbolTable(SymbolTable* table, int expectedSymbols) {
+    if (!table) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for initSymbolTable");
+        return -1;
+    }
+
+    if (expectedSymbols < 16) {
+        expectedSymbols = 16;
+    }
+
+    int slotCapacity = 32;
+    while (slotCapacity < expectedSymbols * 2) {
+        slotCapacity *= 2;
+    }
+
+    table->names = malloc(expectedSymbols * sizeof(*table->names));
+    table->slots = (int*)calloc(slotCapacity, sizeof(int));
+    if (!table->names || !table->slots) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate symbol table");
+        free(table->names);
+        free(table->slots);
+        memset(table, 0, sizeof(SymbolTable));
+        return -1;
+    }
+
+    table->slotCapacity = slotCapacity;
+    table->capacity = expectedSymbols;
+    table->count = 0;
+    return 0;
+}
+
+/* Free memory used by a symbol table */
+void freeSymbolTable(SymbolTable* table) {
+    if (!table) {
+        return;
+    }
+
+    free(table->names);
+    free(table->slots);
+    memset(table, 0, sizeof(SymbolTable));
+}
+
+/* Get the id of a symbol, adding it if necessary */
+int internSymbol(SymbolTable* table, const char* symbol) {
+    if (!table || !table->slots || !symbol || !symbol[0]) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for internSymbol");
+        return -1;
+    }
+
+    char folded[MAX_SYMBOL_LENGTH];
+    if (foldSymbol(symbol, folded) < 0) {
+        logError(ERR_INVALID_PARAMETER, "Symbol too long: %.32s", symbol);
+        return -1;
+    }
+
+    unsigned int hash = hashSymbol(folded);
+    int slot = probeSlot(table, folded, hash);
+    if (table->slots[slot] != 0) {
+        return table->slots[slot] - 1;
+    }
+
+    /* Keep the load factor at or below one half */
+    if ((table->count + 1) * 2 > table->slotCapacity) {
+        if (growSlots(table) != 0) {
+            return -1;
+        }
+        slot = probeSlot(table, folded, hash);
+    }
+
+    if (table->count == table->capacity) {
+        int newCapacity = table->capacity * 2;
+        char (*newNames)[MAX_SYMBOL_LENGTH] = realloc(table->names, newCapacity * sizeof(*table->names));
+        if (!newNames) {
+            logError(ERR_OUT_OF_MEMORY, "Failed to grow symbol table to %d symbols", newCapacity);
+            return -1;
+        }
+        table->names = newNames;
+        table->capacity = newCapacity;
+    }
+
+    int id = table->count++;
+    memcpy(table->names[id], folded, MAX_SYMBOL_LENGTH);
+    table->slots[slot] = id + 1;
+    return id;
+}
+
+/* Get the id of a symbol without adding it */
+int findSymbol(const SymbolTable* table, const char* symbol) {
+    if (!table || !table->slots || !symbol) {
+        return INVALID_SYMBOL_ID;
+    }
+
+    char folded[MAX_SYMBOL_LENGTH];
+    if (foldSymbol(symbol, folded) < 0) {
+        return INVALID_SYMBOL_ID;
+    }
+
+    int slot = probeSlot(table, folded, hashSymbol(folded));
+    return table->slots[slot] ? table->slots[slot] - 1 : INVALID_SYMBOL_ID;
+}
+
+/* Get the text of a symbol id */
+const char* symbolName(const SymbolTable* table, int id) {
+    if (!table || id < 0 || id >= table->count) {
+        return "";
+    }
+    return table->names[id];
+}
@@ -12,11 +12,16 @@
 #include <process.h>  /* For _popen() on Windows */
 #include <direct.h>   /* For _mkdir() on Windows */
 #include <sys/stat.h> /* For stat() */
+#include <pthread.h>
 #include <cJSON.h>    /* For JSON parsing */
 
 #include "../include/emers.h"
 #include "../include/tiingo_api.h"
 #include "../include/error_handling.h"  /* Added error_handling.h for logAPIError */
+#include "../include/keyword_matcher.h"
+#include "../include/sentiment_engine.h"
+#include "../include/news_dedup.h"
+#include "../include/time_utils.h"
 
 /* Define SUCCESS constant if not already defined */    
 #ifndef SUCCESS
@@ -607,6 +612,51 @@ int fetchNewsFeed(const char* symbols, EventDatabase* events) {
     return (count > 0) ? SUCCESS : ERR_DATA_CORRUPTED;
 }
 
+/* Similarity above which syndicated copies of a story are collapsed */
+static double newsDedupThreshold = DEFAULT_DEDUP_THRESHOLD;
+
+/* Stories are remembered across fetches and sources for this long */
+#define NEWS_DEDUP_WINDOW_SECONDS (48 * 60 * 60)
+
+/* Most stories an event database remembers; the least recently seen go first */
+#define NEWS_DEDUP_MAX_STORIES 1024
+
+/* Impact added each time the number of copies of a story doubles */
+#define NEWS_SYNDICATION_WEIGHT 1.0
+
+/* Set the similarity above which articles are collapsed; <= 0 disables it */
+void setNewsDedupThreshold(double threshold) {
+    newsDedupThreshold = threshold > 1.0 ? 1.0 : threshold;
+}
+
+/* Deduplicator shared by every fetch into an event database; NULL if disabled */
+static NewsDeduper* getNewsDeduper(EventDatabase* events) {
+    if (newsDedupThreshold <= 0.0) {
+        return NULL;
+    }
+    
+    if (!events->newsDedup) {
+        NewsDeduper* dedup = (NewsDeduper*)malloc(sizeof(NewsDeduper));
+        if (!dedup) {
+            logError(ERR_OUT_OF_MEMORY, "Failed to allocate news deduplicator");
+            return NULL;
+        }
+        if (initNewsDeduper(dedup, newsDedupThreshold, MAX_NEWS_ITEMS) != 0) {
+            free(dedup);
+            return NULL;
+        }
+        dedup->maxArticles = NEWS_DEDUP_MAX_STORIES;
+        events->newsDedup = dedup;
+    }
+    return events->newsDedup;
+}
+
+/* Raise the impact of a widely syndicated story, growing with the log of its copies */
+static int weightSyndicatedImpact(int impactScore, int copies) {
+    double score = impactScore + NEWS_SYNDICATION_WEIGHT * log2(1.0 + copies);
+    return score > 10.0 ? 10 : (int)score;
+}
+
 /* Parse news data from JSON response (handles both Tiingo and MarketAux formats) */
 int parseNewsDataJSON(const char* jsonData, EventDatabase* events) {
     if (!jsonData || !events) {
@@ -625,139 +675,136 @@ int parseNewsDataJSON(const char* jsonData, EventDatabase* events) {
         return 0;
     }
 
-    int count = 0;
+    // MarketAux has a "data" array at the root and per-article sentiment;
+    // Tiingo's root is the array itself and has no sentiment by default
+    cJSON* items;
+    const char* dateField;
+    int hasSentiment;
     
-    // First, check if this is a MarketAux format (has "data" array at root)
     cJSON* dataArray = cJSON_GetObjectItem(root, "data");
-    
     if (dataArray && cJSON_IsArray(dataArray)) {
-        // MarketAux format
-        int dataSize = cJSON_GetArraySize(dataArray);
-        if (dataSize == 0) {
-            logError(ERR_DATA_CORRUPTED, "Empty data array in JSON response");
-            cJSON_Delete(root);
-            return 0;
+        items = dataArray;
+        dateField = "published_at";
+        hasSentiment = 1;
+    } else if (cJSON_IsArray(root)) {
+        items = root;
+        dateField = "publishedDate";
+        hasSentiment = 0;
+    } else {
+        logError(ERR_DATA_CORRUPTED, "Invalid JSON format: array not found");
+        cJSON_Delete(root);
+        return 0;
+    }
+    
+    int itemCount = cJSON_GetArraySize(items);
+    if (itemCount == 0) {
+        logError(ERR_DATA_CORRUPTED, "Empty %s in JSON response", hasSentiment ? "data array" : "array");
+        cJSON_Delete(root);
+        return 0;
+    }
+    if (itemCount > MAX_NEWS_ITEMS) {
+        itemCount = MAX_NEWS_ITEMS;
+    }
+    
+    // Syndicated copies are collapsed against this response and every earlier
+    // fetch into the same database, whichever source served them
+    NewsDeduper* dedup = getNewsDeduper(events);
+    time_t now = time(NULL);
+    if (dedup) {
+        expireNewsSignatures(dedup, now - NEWS_DEDUP_WINDOW_SECONDS);
+    }
+    
+    // First pass drops duplicates, so each surviving story knows how many
+    // copies of it this response carried before it is scored
+    int survives[MAX_NEWS_ITEMS];
+    unsigned long long signatures[MAX_NEWS_ITEMS];
+    int duplicates = 0;
+    
+    for (int i = 0; i < itemCount; i++) {
+        cJSON* newsItem = cJSON_GetArrayItem(items, i);
+        cJSON* title = cJSON_GetObjectItem(newsItem, "title");
+        cJSON* description = cJSON_GetObjectItem(newsItem, "description");
+        cJSON* published = cJSON_GetObjectItem(newsItem, dateField);
+        
+        survives[i] = title && cJSON_IsString(title) && published && cJSON_IsString(published);
+        if (!survives[i] || !dedup) {
+            continue;
         }
         
-        for (int i = 0; i < dataSize && i < MAX_NEWS_ITEMS; i++) {
-            cJSON* newsItem = cJSON_GetArrayItem(dataArray, i);
-            
-            // Extract fields from MarketAux format
-            cJSON* title = cJSON_GetObjectItem(newsItem, "title");
-            cJSON* description = cJSON_GetObjectItem(newsItem, "description");
-            cJSON* url = cJSON_GetObjectItem(newsItem, "url");
-            cJSON* publishedAt = cJSON_GetObjectItem(newsItem, "published_at");
+        signatures[i] = computeSimHash(cJSON_GetStringValue(title),
+                                       cJSON_IsString(description) ? cJSON_GetStringValue(description) : NULL);
+        if (addNewsSignature(dedup, signatures[i], now, NULL) == 0) {
+            survives[i] = 0;
+            duplicates++;
+        }
+    }
+    
+    int count = 0;
+    int syndicated = 0;
+    
+    for (int i = 0; i < itemCount; i++) {
+        if (!survives[i]) {
+            continue;
+        }
+        
+        cJSON* newsItem = cJSON_GetArrayItem(items, i);
+        cJSON* title = cJSON_GetObjectItem(newsItem, "title");
+        cJSON* description = cJSON_GetObjectItem(newsItem, "description");
+        cJSON* url = cJSON_GetObjectItem(newsItem, "url");
+        cJSON* published = cJSON_GetObjectItem(newsItem, dateField);
+        
+        EventData event;
+        memset(&event, 0, sizeof(EventData));
+        
+        strncpy(event.title, cJSON_GetStringValue(title), MAX_BUFFER_SIZE - 1);
+        
+        if (description && cJSON_IsString(description)) {
+            strncpy(event.description, cJSON_GetStringValue(description), MAX_BUFFER_SIZE - 1);
+        }
+        
+        if (url && cJSON_IsString(url)) {
+            strncpy(event.url, cJSON_GetStringValue(url), MAX_URL_LENGTH - 1);
+        }
+        
+        // Parse published time string (ISO 8601 format)
+        event.timestamp = parseISOTimeString(cJSON_GetStringValue(published));
+        formatISODate(event.timestamp, event.date, sizeof(event.date));
+        
+        // Parse sentiment if available
+        if (hasSentiment) {
             cJSON* sentiment = cJSON_GetObjectItem(newsItem, "sentiment");
-            
-            if (title && cJSON_IsString(title) && 
-                publishedAt && cJSON_IsString(publishedAt)) {
-                
-                EventData event;
-                memset(&event, 0, sizeof(EventData));
-                
-                strncpy(event.title, cJSON_GetStringValue(title), MAX_BUFFER_SIZE - 1);
-                
-                if (description && cJSON_IsString(description)) {
-                    strncpy(event.description, cJSON_GetStringValue(description), MAX_BUFFER_SIZE - 1);
-                } else {
-                    event.description[0] = '\0';
-                }
-                
-                if (url && cJSON_IsString(url)) {
-                    strncpy(event.url, cJSON_GetStringValue(url), MAX_URL_LENGTH - 1);
-                } else {
-                    event.url[0] = '\0';
+            if (sentiment && cJSON_IsObject(sentiment)) {
+                cJSON* sentimentScore = cJSON_GetObjectItem(sentiment, "score");
+                if (sentimentScore && cJSON_IsNumber(sentimentScore)) {
+                    event.sentiment = (float)cJSON_GetNumberValue(sentimentScore);
                 }
-                
-                // Parse published_at time string (ISO 8601 format)
-                event.timestamp = parseISOTimeString(cJSON_GetStringValue(publishedAt));
-                strftime(event.date, MAX_DATE_LENGTH, "%Y-%m-%d", localtime(&event.timestamp));
-                
-                // Parse sentiment if available
-                if (sentiment && cJSON_IsObject(sentiment)) {
-                    cJSON* sentimentScore = cJSON_GetObjectItem(sentiment, "score");
-                    if (sentimentScore && cJSON_IsNumber(sentimentScore)) {
-                        event.sentiment = (float)cJSON_GetNumberValue(sentimentScore);
-                    } else {
-                        event.sentiment = 0.0f;
-                    }
-                } else {
-                    event.sentiment = 0.0f;
-                }
-                
-                // Calculate impact score
-                event.impactScore = (int)calculateImpactScore(&event);
-                
-                // // Add to database
-                // if (addEventToDatabase(events, &event)) {
-                //     count++;
-                // }
             }
         }
-    } else {
-        // Try Tiingo format (root is array)
-        if (cJSON_IsArray(root)) {
-            int arraySize = cJSON_GetArraySize(root);
-            if (arraySize == 0) {
-                logError(ERR_DATA_CORRUPTED, "Empty array in JSON response");
-                cJSON_Delete(root);
-                return 0;
-            }
-            
-            for (int i = 0; i < arraySize && i < MAX_NEWS_ITEMS; i++) {
-                cJSON* newsItem = cJSON_GetArrayItem(root, i);
-                
-                // Extract fields from Tiingo format
-                cJSON* title = cJSON_GetObjectItem(newsItem, "title");
-                cJSON* description = cJSON_GetObjectItem(newsItem, "description");
-                cJSON* url = cJSON_GetObjectItem(newsItem, "url");
-                cJSON* publishedDate = cJSON_GetObjectItem(newsItem, "publishedDate");
-                
-                if (title && cJSON_IsString(title) && 
-                    publishedDate && cJSON_IsString(publishedDate)) {
-                    
-                    EventData event;
-                    memset(&event, 0, sizeof(EventData));
-                    
-                    strncpy(event.title, cJSON_GetStringValue(title), MAX_BUFFER_SIZE - 1);
-                    
-                    if (description && cJSON_IsString(description)) {
-                        strncpy(event.description, cJSON_GetStringValue(description), MAX_BUFFER_SIZE - 1);
-                    } else {
-                        event.description[0] = '\0';
-                    }
-                    
-                    if (url && cJSON_IsString(url)) {
-                        strncpy(event.url, cJSON_GetStringValue(url), MAX_URL_LENGTH - 1);
-                    } else {
-                        event.url[0] = '\0';
-                    }
-                    
-                    // Parse published_at time string
-                    event.timestamp = parseISOTimeString(cJSON_GetStringValue(publishedDate));
-                    strftime(event.date, MAX_DATE_LENGTH, "%Y-%m-%d", localtime(&event.timestamp));
-                    
-                    // No sentiment in Tiingo API by default
-                    event.sentiment = 0.0f;
-                    
-                    // Calculate impact score
-                    event.impactScore = (int)calculateImpactScore(&event);
-                    
-                    // // Add to database
-                    // if (addEventToDatabase(events, &event)) {
-                    //     count++;
-                    // }
-                }
+        
+        // Calculate impact score, weighted by how widely the story was carried
+        event.impactScore = (int)calculateImpactScore(&event);
+        if (dedup) {
+            int story = findNearDuplicate(dedup, signatures[i]);
+            int copies = story >= 0 ? dedup->duplicateCounts[story] : 0;
+            if (copies > 0) {
+                event.impactScore = weightSyndicatedImpact(event.impactScore, copies);
+                syndicated++;
             }
-        } else {
-            logError(ERR_DATA_CORRUPTED, "Invalid JSON format: array not found");
-            cJSON_Delete(root);
-            return 0;
         }
+        
+        // // Add to database
+        // if (addEventToDatabase(events, &event)) {
+        //     count++;
+        // }
     }
     
     cJSON_Delete(root);
     
+    if (duplicates > 0) {
+        logMessage(LOG_DEBUG, "Skipped %d near-duplicate news articles; %d new stories were syndicated",
+                   duplicates, syndicated);
+    }
+    
     if (count == 0) {
         logError(ERR_DATA_CORRUPTED, "Failed to parse any data points from JSON response");
     }
@@ -765,56 +812,104 @@ int parseNewsDataJSON(const char* jsonData, EventDatabase* events) {
     return count;
 }
 
-/* Calculate sentiment score for a news event based on title and description */
-double calculateSentiment(const char* title, const char* description) {
-    /* Simple sentiment analysis based on keyword matching */
-    const char* positiveWords[] = {
-        "up", "rise", "gain", "surge", "jump", "positive", "growth",
-        "profit", "success", "beat", "exceed", "strong", "bullish",
-        "rally", "record", "high", "opportunity", "upgrade"
-    };
-    
-    const char* negativeWords[] = {
-        "down", "fall", "drop", "decline", "slip", "negative", "loss",
-        "miss", "fail", "weak", "bearish", "crash", "plunge", "concern",
-        "risk", "fear", "warn", "downgrade", "trouble", "crisis"
-    };
-    
-    int posCount = 0;
-    int negCount = 0;
-    
-    /* Check title for sentiment keywords */
-    for (size_t i = 0; i < sizeof(positiveWords) / sizeof(positiveWords[0]); i++) {
-        if (strstr(title, positiveWords[i])) {
-            posCount += 2;  /* Title matches have higher weight */
-        }
+/* Simple sentiment analysis based on keyword matching */
+static const char* positiveWords[] = {
+    "up", "rise", "gain", "surge", "jump", "positive", "growth",
+    "profit", "success", "beat", "exceed", "strong", "bullish",
+    "rally", "record", "high", "opportunity", "upgrade"
+};
+
+static const char* negativeWords[] = {
+    "down", "fall", "drop", "decline", "slip", "negative", "loss",
+    "miss", "fail", "weak", "bearish", "crash", "plunge", "concern",
+    "risk", "fear", "warn", "downgrade", "trouble", "crisis"
+};
+
+/* Important keywords increase impact score */
+static const char* highImpactWords[] = {
+    "earnings", "merger", "acquisition", "bankruptcy", "CEO", 
+    "executive", "lawsuit", "settlement", "FDA", "approval",
+    "patent", "investigation", "dividend", "guidance", "forecast",
+    "outlook", "revenue", "profit", "scandal", "breach", "hack",
+    "recall", "crisis", "significant", "substantial", "breakthrough"
+};
+
+#define WORD_COUNT(words) ((int)(sizeof(words) / sizeof((words)[0])))
+
+/* Lexicon ids used by the shared news keyword matcher */
+enum {
+    NEWS_LEXICON_HIGH_IMPACT = 0,
+    NEWS_LEXICON_COUNT
+};
+
+/* Shared news matcher and sentiment lexicon, built once on first use.
+   pthread_once makes the first use safe from concurrent fetch threads. */
+static KeywordMatcher newsMatcher;
+static int newsMatcherReady = 0;
+static pthread_once_t newsMatcherOnce = PTHREAD_ONCE_INIT;
+static SentimentLexicon newsLexicon;
+static int newsLexiconReady = 0;
+static pthread_once_t newsLexiconOnce = PTHREAD_ONCE_INIT;
+
+/* Build the news keyword matcher from the impact lexicons */
+static void buildNewsMatcher(void) {
+    initKeywordMatcher(&newsMatcher);
+    if (addKeywordLexicon(&newsMatcher, highImpactWords, WORD_COUNT(highImpactWords),
+                          NEWS_LEXICON_HIGH_IMPACT) < 0 ||
+        compileKeywordMatcher(&newsMatcher) != 0) {
+        logError(ERR_INIT, "Failed to build news keyword matcher");
+        freeKeywordMatcher(&newsMatcher);
+        return;
     }
-    
-    for (size_t i = 0; i < sizeof(negativeWords) / sizeof(negativeWords[0]); i++) {
-        if (strstr(title, negativeWords[i])) {
-            negCount += 2;  /* Title matches have higher weight */
-        }
+
+    newsMatcherReady = 1;
+}
+
+static const KeywordMatcher* getNewsMatcher(void) {
+    pthread_once(&newsMatcherOnce, buildNewsMatcher);
+    return newsMatcherReady ? &newsMatcher : NULL;
+}
+
+/* Build the hashed sentiment lexicon with negation handling */
+static void buildNewsLexicon(void) {
+    if (initSentimentLexicon(&newsLexicon, WORD_COUNT(positiveWords) + WORD_COUNT(negativeWords) + 16) != 0) {
+        return;
     }
-    
-    /* Check description for sentiment keywords */
-    for (size_t i = 0; i < sizeof(positiveWords) / sizeof(positiveWords[0]); i++) {
-        if (strstr(description, positiveWords[i])) {
-            posCount++;
-        }
+
+    /* Stem both lexicon and text so inflections ("gains", "falling") match */
+    setSentimentStemming(&newsLexicon, 1);
+
+    if (addSentimentWordLists(&newsLexicon, positiveWords, WORD_COUNT(positiveWords),
+                              negativeWords, WORD_COUNT(negativeWords)) != 0 ||
+        addDefaultNegations(&newsLexicon) != 0) {
+        logError(ERR_INIT, "Failed to build news sentiment lexicon");
+        freeSentimentLexicon(&newsLexicon);
+        return;
     }
-    
-    for (size_t i = 0; i < sizeof(negativeWords) / sizeof(negativeWords[0]); i++) {
-        if (strstr(description, negativeWords[i])) {
-            negCount++;
-        }
+
+    newsLexiconReady = 1;
+}
+
+static const SentimentLexicon* getNewsLexicon(void) {
+    pthread_once(&newsLexiconOnce, buildNewsLexicon);
+    return newsLexiconReady ? &newsLexicon : NULL;
+}
+
+/* Calculate sentiment score for a news event based on title and description */
+double calculateSentiment(const char* title, const char* description) {
+    const SentimentLexicon* lexicon = getNewsLexicon();
+    if (!lexicon) {
+        return 0.0;
     }
     
-    /* Calculate sentiment score from -1.0 (very negative) to 1.0 (very positive) */
-    if (posCount + negCount == 0) {
-        return 0.0;  /* Neutral if no sentiment words found */
-    }
+    /* Each text is tokenized once; title matches have higher weight and
+       negations ("not strong") flip the polarity of the words that follow */
+    double score = 0.0;
+    double confidence = 0.0;
+    scoreSentimentDocument(lexicon, title, description, &score, &confidence);
     
-    return (double)(posCount - negCount) / (posCount + negCount);
+    /* Score ranges from -1.0 (very negative) to 1.0 (very positive) */
+    return score;
 }
 
 /* Calculate impact score for a news event (0-10 scale) */
@@ -825,24 +920,19 @@ double calculateImpactScore(const EventData* event) {
     double sentimentImpact = fabs(event->sentiment) * 2.0;
     score += sentimentImpact;
     
-    /* Important keywords increase impact score */
-    const char* highImpactWords[] = {
-        "earnings", "merger", "acquisition", "bankruptcy", "CEO", 
-        "executive", "lawsuit", "settlement", "FDA", "approval",
-        "patent", "investigation", "dividend", "guidance", "forecast",
-        "outlook", "revenue", "profit", "scandal", "breach", "hack",
-        "recall", "crisis", "significant", "substantial", "breakthrough"
-    };
-    
-    for (size_t i = 0; i < sizeof(highImpactWords) / sizeof(highImpactWords[0]); i++) {
-        if (strstr(event->title, highImpactWords[i]) || 
-            strstr(event->description, highImpactWords[i])) {
-            score += 1.0;
-            /* Cap the boost at 3.0 */
-            if (score > 8.0) {
-                score = 8.0;
-                break;
-            }
+    /* Important keywords increase impact score; each keyword counts once
+       whether it appears in the title, the description or both */
+    const KeywordMatcher* matcher = getNewsMatcher();
+    if (matcher) {
+        double scores[NEWS_LEXICON_COUNT] = {0.0};
+        unsigned char seen[WORD_COUNT(highImpactWords)] = {0};
+        scoreDistinctKeywordLexicons(matcher, event->title, 1.0, seen, scores, NEWS_LEXICON_COUNT);
+        scoreDistinctKeywordLexicons(matcher, event->description, 1.0, seen, scores, NEWS_LEXICON_COUNT);
+        
+        score += scores[NEWS_LEXICON_HIGH_IMPACT];
+        /* Cap the boost at 3.0 */
+        if (score > 8.0) {
+            score = 8.0;
         }
     }
     
@@ -1057,27 +1147,11 @@ void getTempFilePath(char* buffer, size_t bufferSize, const char* filename) {
     snprintf(buffer, bufferSize, "%s\\%s", tempDir, filename);
 }
 
-/* Parse ISO time string (YYYY-MM-DDTHH:MM:SSZ) to time_t */
+/* Parse ISO time string (YYYY-MM-DDTHH:MM:SS[.fff][Z|+HH:MM]) to UTC time_t */
 time_t parseISOTimeString(const char* timeString) {
-    if (!timeString || strlen(timeString) < 10) return 0;
-    
-    struct tm tm = {0};
-    char datePart[11] = {0};
-    
-    // Copy just the date part (YYYY-MM-DD)
-    strncpy(datePart, timeString, 10);
-    datePart[10] = '\0';
-    
-    // Parse date
-    sscanf(datePart, "%d-%d-%d", &tm.tm_year, &tm.tm_mon, &tm.tm_mday);
-    tm.tm_year -= 1900; // Adjust year (tm_year is years since 1900)
-    tm.tm_mon -= 1;     // Adjust month (tm_mon is 0-11)
-    
-    // Parse time if available
-    if (strlen(timeString) >= 19) {
-        sscanf(timeString + 11, "%d:%d:%d", &tm.tm_hour, &tm.tm_min, &tm.tm_sec);
+    time_t timestamp;
+    if (parseISO8601Timestamp(timeString, &timestamp, NULL) != 0) {
+        return 0;
     }
-    
-    // Convert to time_t
-    return mktime(&tm);
+    return timestamp;
 }
\ No newline at end of file
@@ -0,0 +1,196 @@
+/**
+ * Time Utilities
+ * Fixed-format ISO-8601 parsing to UTC without libc time conversions
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/time_utils.h"
+
+#define SECONDS_PER_DAY 86400LL
+
+/* Days since the epoch using Hinnant's days_from_civil over 400-year eras */
+long long daysFromCivil(int year, int month, int day) {
+    long long y = (long long)year - (month <= 2);
+    long long era = (y >= 0 ? y : y - 399) / 400;
+    long long yearOfEra = y - era * 400;
+    long long dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    long long dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+/* Inverse of daysFromCivil */
+void civilFromDays(long long days, int* year, int* month, int* day) {
+    days += 719468;
+    long long era = (days >= 0 ? days : days - 146096) / 146097;
+    long long dayOfEra = days - era * 146097;
+    long long yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    long long dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    long long mp = (5 * dayOfYear + 2) / 153;
+    int d = (int)(dayOfYear - (153 * mp + 2) / 5 + 1);
+    int m = (int)(mp < 10 ? mp + 3 : mp - 9);
+
+    if (year) *year = (int)(yearOfEra + era * 400 + (m <= 2));
+    if (month) *month = m;
+    if (day) *day = d;
+}
+
+/*
+ * Read two digits, flagging invalid characters in *bad. The second byte is
+ * only read when the first is a digit, so a NUL never leads to a read past
+ * the end of the string.
+ */
+static int twoDigits(const unsigned char* p, unsigned int* bad) {
+    unsigned int a = (unsigned int)p[0] - '0';
+    if (a > 9) {
+        *bad = 1;
+        return 0;
+    }
+    unsigned int b = (unsigned int)p[1] - '0';
+    *bad |= (b > 9);
+    return (int)(a * 10 + b);
+}
+
+static int isLeapYear(int year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+/* Parse an ISO-8601 timestamp to UTC epoch seconds */
+int parseISO8601Timestamp(const char* text, time_t* seconds, int* nanoseconds) {
+    static const unsigned char daysInMonth[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+    if (!text || !seconds) {
+        return -1;
+    }
+
+    const unsigned char* p = (const unsigned char*)text;
+    unsigned int bad = 0;
+
+    /* Fixed offsets; each field is validated before the next is read */
+    int year = twoDigits(p, &bad) * 100;
+    if (bad) return -1;
+    year += twoDigits(p + 2, &bad);
+    if (bad || p[4] != '-') return -1;
+    int month = twoDigits(p + 5, &bad);
+    if (bad || p[7] != '-') return -1;
+    int day = twoDigits(p + 8, &bad);
+    if (bad) return -1;
+    p += 10;
+
+    int hour = 0, minute = 0, second = 0;
+    long nanos = 0;
+    long offset = 0;
+
+    if (*p == 'T' || *p == 't' || *p == ' ') {
+        hour = twoDigits(p + 1, &bad);
+        if (bad || p[3] != ':') return -1;
+        minute = twoDigits(p + 4, &bad);
+        if (bad) return -1;
+        p += 6;
+
+        if (*p == ':') {
+            second = twoDigits(p + 1, &bad);
+            if (bad) return -1;
+            p += 3;
+
+            if (*p == '.' || *p == ',') {
+                p++;
+                long scale = 100000000L;
+                if ((unsigned int)(*p - '0') > 9) return -1;
+                while ((unsigned int)(*p - '0') <= 9) {
+                    nanos += (*p - '0') * scale;
+                    scale /= 10;
+                    p++;
+                }
+            }
+        }
+
+        if (*p == 'Z' || *p == 'z') {
+            p++;
+        } else if (*p == '+' || *p == '-') {
+            int sign = (*p == '-') ? -1 : 1;
+            int offsetHours = twoDigits(p + 1, &bad);
+            if (bad) return -1;
+            p += 3;
+            int offsetMinutes = 0;
+            if (*p == ':') {
+                offsetMinutes = twoDigits(p + 1, &bad);
+                if (bad) return -1;
+                p += 3;
+            } else if ((unsigned int)(*p - '0') <= 9) {
+                offsetMinutes = twoDigits(p, &bad);
+                if (bad) return -1;
+                p += 2;
+            }
+            if (offsetHours > 23 || offsetMinutes > 59) return -1;
+            offset = sign * (offsetHours * 3600L + offsetMinutes * 60L);
+        }
+    }
+
+    if (*p != '\0') {
+        return -1;
+    }
+
+    /* Leap seconds (":60") are accepted and fold into the next minute */
+    int monthDays = (month >= 1 && month <= 12) ?
+                    daysInMonth[month - 1] + (month == 2 && isLeapYear(year)) : 0;
+    if (day < 1 || day > monthDays || hour > 23 || minute > 59 || second > 60) {
+        return -1;
+    }
+
+    long long epoch = daysFromCivil(year, month, day) * SECONDS_PER_DAY +
+                      hour * 3600LL + minute * 60LL + second - offset;
+    *seconds = (time_t)epoch;
+    if (nanoseconds) {
+        *nanoseconds = (int)nanos;
+    }
+    return 0;
+}
+
+/* Parse an array of ISO-8601 timestamps */
+int parseISO8601Batch(const char* const* texts, int count, time_t* seconds) {
+    if (!texts || !seconds || count <= 0) {
+        return 0;
+    }
+
+    int parsed = 0;
+    for (int i = 0; i < count; i++) {
+        if (parseISO8601Timestamp(texts[i], &seconds[i], NULL) == 0) {
+            parsed++;
+        } else {
+            seconds[i] = 0;
+        }
+    }
+    return parsed;
+}
+
+/* Format the UTC date of a timestamp as "YYYY-MM-DD" */
+int formatISODate(time_t timestamp, char* buffer, size_t bufferSize) {
+    if (!buffer || bufferSize < 11) {
+        return -1;
+    }
+
+    long long t = (long long)timestamp;
+    long long days = t >= 0 ? t / SECONDS_PER_DAY : -((-t + SECONDS_PER_DAY - 1) / SECONDS_PER_DAY);
+
+    int year, month, day;
+    civilFromDays(days, &year, &month, &day);
+    if (year < 0 || year > 9999) {
+        return -1;
+    }
+
+    buffer[0] = (char)('0' + year / 1000);
+    buffer[1] = (char)('0' + year / 100 % 10);
+    buffer[2] = (char)('0' + year / 10 % 10);
+    buffer[3] = (char)('0' + year % 10);
+    buffer[4] = '-';
+    buffer[5] = (char)('0' + month / 10);
+    buffer[6] = (char)('0' + month % 10);
+    buffer[7] = '-';
+    buffer[8] = (char)('0' + day / 10);
+    buffer[9] = (char)('0' + day % 10);
+    buffer[10] = '\0';
+    return 0;
+}
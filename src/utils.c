@@ -9,6 +9,7 @@
 #include <time.h>
 
 #include "../include/emers.h"
+#include "../include/news_dedup.h"
 
 /* Initialize a stock structure */
 void initializeStock(Stock* stock, const char* symbol) {
@@ -52,6 +53,9 @@ void initializeEventDatabase(EventDatabase* db) {
     db->events = NULL;
     db->eventCount = 0;
     db->eventCapacity = 0;
+    
+    /* The news deduplicator is created on the first news fetch */
+    db->newsDedup = NULL;
 }
 
 /* Free memory used by an event database structure */
@@ -66,6 +70,12 @@ void freeEventDatabase(EventDatabase* db) {
         db->events = NULL;
     }
     
+    if (db->newsDedup) {
+        freeNewsDeduper(db->newsDedup);
+        free(db->newsDedup);
+        db->newsDedup = NULL;
+    }
+    
     db->eventCount = 0;
     db->eventCapacity = 0;
 }
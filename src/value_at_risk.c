@@ -0,0 +1,451 @@
+/**
+ * Value at Risk
+ * Historical, parametric and Monte Carlo VaR/CVaR with quickselect quantiles
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../include/risk_management.h"
+#include "../include/rng.h"
+#include "../include/parallel.h"
+#include "../include/error_handling.h"
+
+/* Most shock degrees of freedom supported by the Monte Carlo engine */
+#define MAX_STUDENT_DEGREES 100
+
+#define SQRT_TWO_PI 2.5066282746310002
+
+/* Fill a config with defaults */
+void initVaRConfig(VaRConfig* config) {
+    if (!config) {
+        return;
+    }
+
+    config->method = VAR_HISTORICAL;
+    config->confidenceLevel = 0.95;
+    config->horizon = 1;
+    config->lookback = 250;
+    config->pathCount = 100000;
+    config->studentDegrees = 0;
+    config->seed = 0x5EED5EEDull;
+}
+
+/* Daily log returns of the most recent `lookback` bars */
+static int loadLogReturns(const Stock* stock, int lookback, double** returnsOut) {
+    int first = 1;
+    if (lookback > 0 && stock->dataSize - lookback > first) {
+        first = stock->dataSize - lookback;
+    }
+
+    int capacity = stock->dataSize - first;
+    double* returns = (double*)malloc((capacity > 0 ? capacity : 1) * sizeof(double));
+    if (!returns) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate returns for %s", stock->symbol);
+        return -1;
+    }
+
+    int count = 0;
+    for (int i = first; i < stock->dataSize; i++) {
+        double previous = stock->data[i - 1].adjClose > 0.0 ? stock->data[i - 1].adjClose : stock->data[i - 1].close;
+        double current = stock->data[i].adjClose > 0.0 ? stock->data[i].adjClose : stock->data[i].close;
+        if (previous > 0.0 && current > 0.0) {
+            returns[count++] = log(current / previous);
+        }
+    }
+
+    *returnsOut = returns;
+    return count;
+}
+
+static void meanAndDeviation(const double* values, int count, double* mean, double* deviation) {
+    double sum = 0.0;
+    for (int i = 0; i < count; i++) {
+        sum += values[i];
+    }
+    double m = count > 0 ? sum / count : 0.0;
+
+    double squares = 0.0;
+    for (int i = 0; i < count; i++) {
+        double d = values[i] - m;
+        squares += d * d;
+    }
+
+    *mean = m;
+    *deviation = count > 1 ? sqrt(squares / (count - 1)) : 0.0;
+}
+
+/*
+ * Quickselect: reorder values so values[k] is the k-th smallest, everything
+ * before it is <= and everything after it is >=. Expected O(n).
+ */
+static double selectKth(double* values, int count, int k) {
+    int low = 0;
+    int high = count - 1;
+
+    while (low < high) {
+        /* Median of three guards against sorted input */
+        int mid = low + (high - low) / 2;
+        if (values[mid] < values[low]) { double t = values[mid]; values[mid] = values[low]; values[low] = t; }
+        if (values[high] < values[low]) { double t = values[high]; values[high] = values[low]; values[low] = t; }
+        if (values[high] < values[mid]) { double t = values[high]; values[high] = values[mid]; values[mid] = t; }
+        double pivot = values[mid];
+
+        int i = low;
+        int j = high;
+        while (i <= j) {
+            while (values[i] < pivot) i++;
+            while (values[j] > pivot) j--;
+            if (i <= j) {
+                double t = values[i];
+                values[i] = values[j];
+                values[j] = t;
+                i++;
+                j--;
+            }
+        }
+
+        if (k <= j) {
+            high = j;
+        } else if (k >= i) {
+            low = i;
+        } else {
+            break;
+        }
+    }
+    return values[k];
+}
+
+/* VaR and CVaR of a loss sample (reorders the sample) */
+static void lossQuantile(double* losses, int count, double confidence, double* var, double* cvar) {
+    int k = (int)ceil(confidence * count) - 1;
+    if (k < 0) k = 0;
+    if (k > count - 1) k = count - 1;
+
+    *var = selectKth(losses, count, k);
+
+    /* After selection the tail is exactly losses[k..count-1] */
+    double tail = 0.0;
+    for (int i = k; i < count; i++) {
+        tail += losses[i];
+    }
+    *cvar = tail / (count - k);
+}
+
+/* Inverse standard normal CDF (Acklam's rational approximation, |error| < 1.2e-9) */
+static double inverseNormal(double p) {
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                               1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                               6.680131188771972e+01, -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                               -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                               3.754408661907416e+00};
+    const double low = 0.02425;
+
+    if (p < low) {
+        double q = sqrt(-2.0 * log(p));
+        return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+               ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+    if (p > 1.0 - low) {
+        double q = sqrt(-2.0 * log(1.0 - p));
+        return -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+                ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+    double q = p - 0.5;
+    double r = q * q;
+    return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+           (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+}
+
+static int historicalVaR(const double* returns, int count, const VaRConfig* config, VaRResult* result) {
+    int horizon = config->horizon;
+    int windows = count - horizon + 1;
+    int overlapping = windows >= MIN_VAR_OBSERVATIONS;
+    int sampleCount = overlapping ? windows : count;
+
+    double* losses = (double*)malloc((sampleCount > 0 ? sampleCount : 1) * sizeof(double));
+    if (!losses) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate %d historical losses", sampleCount);
+        return -1;
+    }
+
+    if (overlapping) {
+        /* Sliding sum of horizon-bar log returns */
+        double sum = 0.0;
+        for (int i = 0; i < count; i++) {
+            sum += returns[i];
+            if (i >= horizon) {
+                sum -= returns[i - horizon];
+            }
+            if (i >= horizon - 1) {
+                losses[i - horizon + 1] = 1.0 - exp(sum);
+            }
+        }
+    } else {
+        for (int i = 0; i < count; i++) {
+            losses[i] = 1.0 - exp(returns[i]);
+        }
+    }
+
+    double var, cvar;
+    lossQuantile(losses, sampleCount, config->confidenceLevel, &var, &cvar);
+    free(losses);
+
+    if (!overlapping && horizon > 1) {
+        /* Too little history for horizon windows: scale the one-bar log quantiles by sqrt(h) */
+        double scale = sqrt((double)horizon);
+        var = 1.0 - exp(log(1.0 - var) * scale);
+        cvar = 1.0 - exp(log(1.0 - cvar) * scale);
+    }
+
+    result->valueAtRisk = var;
+    result->conditionalVaR = cvar;
+    result->observations = sampleCount;
+    return 0;
+}
+
+static void parametricVaR(const VaRConfig* config, VaRResult* result, int count) {
+    double p = config->confidenceLevel;
+    double z = inverseNormal(p);
+    double mean = result->meanReturn * config->horizon;
+    double sd = result->volatility * sqrt((double)config->horizon);
+
+    /* Normal density at z over the tail probability gives the shortfall depth */
+    double density = exp(-0.5 * z * z) / SQRT_TWO_PI;
+
+    result->valueAtRisk = 1.0 - exp(mean - z * sd);
+    result->conditionalVaR = 1.0 - exp(mean - sd * density / (1.0 - p));
+    result->observations = count;
+}
+
+/* Shared state of one Monte Carlo run */
+typedef struct {
+    const VaRConfig* config;
+    double mean;
+    double volatility;
+    double* losses;
+    int failed;
+} MonteCarloJob;
+
+static void simulateChunks(int begin, int end, void* context) {
+    MonteCarloJob* job = (MonteCarloJob*)context;
+    const VaRConfig* config = job->config;
+    int horizon = config->horizon;
+    int degrees = config->studentDegrees;
+
+    /* Student-t shocks need horizon * (1 + degrees) normals per path */
+    int perPath = degrees > 0 ? horizon * (1 + degrees) : VAR_PATHS_PER_CHUNK;
+    double* normals = (double*)malloc(perPath * sizeof(double));
+    if (!normals) {
+        job->failed = 1;
+        return;
+    }
+
+    double tScale = degrees > 0 ? sqrt((degrees - 2.0) / degrees) : 1.0;
+    double horizonMean = job->mean * horizon;
+    double horizonVol = job->volatility * sqrt((double)horizon);
+
+    for (int chunk = begin; chunk < end; chunk++) {
+        int first = chunk * VAR_PATHS_PER_CHUNK;
+        int paths = config->pathCount - first < VAR_PATHS_PER_CHUNK ? config->pathCount - first
+                                                                     : VAR_PATHS_PER_CHUNK;
+        PhiloxStream stream;
+        initPhiloxStream(&stream, config->seed, (unsigned long long)chunk);
+        double* losses = job->losses + first;
+
+        if (degrees == 0) {
+            /* A sum of h normal daily shocks is exactly one normal with sqrt(h) scale */
+            philoxFillNormal(&stream, normals, paths);
+            for (int p = 0; p < paths; p++) {
+                losses[p] = 1.0 - exp(horizonMean + horizonVol * normals[p]);
+            }
+            continue;
+        }
+
+        for (int p = 0; p < paths; p++) {
+            philoxFillNormal(&stream, normals, perPath);
+            const double* chi = normals + horizon;
+            double logReturn = 0.0;
+            for (int step = 0; step < horizon; step++) {
+                double chiSquare = 0.0;
+                for (int k = 0; k < degrees; k++) {
+                    chiSquare += chi[k] * chi[k];
+                }
+                chi += degrees;
+                double shock = normals[step] / sqrt(chiSquare / degrees) * tScale;
+                logReturn += job->mean + job->volatility * shock;
+            }
+            losses[p] = 1.0 - exp(logReturn);
+        }
+    }
+
+    free(normals);
+}
+
+static int monteCarloVaR(const VaRConfig* config, VaRResult* result, int parallel) {
+    if (config->pathCount <= 0) {
+        logError(ERR_INVALID_PARAMETER, "Monte Carlo VaR needs a positive path count");
+        return -1;
+    }
+    if (config->studentDegrees != 0 &&
+        (config->studentDegrees <= 2 || config->studentDegrees > MAX_STUDENT_DEGREES)) {
+        logError(ERR_INVALID_PARAMETER, "Student-t degrees must be between 3 and %d", MAX_STUDENT_DEGREES);
+        return -1;
+    }
+
+    MonteCarloJob job;
+    job.config = config;
+    job.mean = result->meanReturn;
+    job.volatility = result->volatility;
+    job.failed = 0;
+    job.losses = (double*)malloc(config->pathCount * sizeof(double));
+    if (!job.losses) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate %d Monte Carlo paths", config->pathCount);
+        return -1;
+    }
+
+    /* Each chunk owns a stream, so the paths do not depend on the thread count */
+    int chunks = (config->pathCount + VAR_PATHS_PER_CHUNK - 1) / VAR_PATHS_PER_CHUNK;
+    if (parallel) {
+        parallelFor(chunks, 1, simulateChunks, &job);
+    } else {
+        simulateChunks(0, chunks, &job);
+    }
+
+    if (job.failed) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate Monte Carlo shock buffer");
+        free(job.losses);
+        return -1;
+    }
+
+    lossQuantile(job.losses, config->pathCount, config->confidenceLevel,
+                 &result->valueAtRisk, &result->conditionalVaR);
+    result->observations = config->pathCount;
+    free(job.losses);
+    return 0;
+}
+
+static int estimateVaR(const Stock* stock, const VaRConfig* config, VaRResult* result, int parallel) {
+    if (!stock || !config || !result) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for computeValueAtRisk");
+        return -1;
+    }
+    if (config->confidenceLevel <= 0.0 || config->confidenceLevel >= 1.0 || config->horizon < 1) {
+        logError(ERR_INVALID_PARAMETER, "VaR needs 0 < confidence < 1 and a horizon of at least 1");
+        return -1;
+    }
+
+    memset(result, 0, sizeof(VaRResult));
+
+    double* returns = NULL;
+    int count = loadLogReturns(stock, config->lookback, &returns);
+    if (count < 0) {
+        return -1;
+    }
+    if (count < 2) {
+        logError(ERR_DATA_INSUFFICIENT, "Not enough price history for VaR of %s", stock->symbol);
+        free(returns);
+        return -1;
+    }
+
+    meanAndDeviation(returns, count, &result->meanReturn, &result->volatility);
+
+    int status = 0;
+    switch (config->method) {
+        case VAR_HISTORICAL:
+            status = historicalVaR(returns, count, config, result);
+            break;
+        case VAR_PARAMETRIC:
+            parametricVaR(config, result, count);
+            break;
+        case VAR_MONTE_CARLO:
+            status = monteCarloVaR(config, result, parallel);
+            break;
+        default:
+            logError(ERR_INVALID_PARAMETER, "Unknown VaR method %d", (int)config->method);
+            status = -1;
+            break;
+    }
+
+    free(returns);
+    return status;
+}
+
+/* Estimate VaR and CVaR of one stock */
+int computeValueAtRisk(const Stock* stock, const VaRConfig* config, VaRResult* result) {
+    return estimateVaR(stock, config, result, 1);
+}
+
+/* Shared state of a batch run */
+typedef struct {
+    const Stock* stocks;
+    const int* horizons;
+    int horizonCount;
+    const VaRConfig* config;
+    VaRResult* results;
+    int* succeeded;
+} VaRBatchJob;
+
+static void estimateBatchRange(int begin, int end, void* context) {
+    VaRBatchJob* job = (VaRBatchJob*)context;
+
+    for (int item = begin; item < end; item++) {
+        VaRConfig config = *job->config;
+        config.horizon = job->horizons[item % job->horizonCount];
+        job->succeeded[item] = estimateVaR(&job->stocks[item / job->horizonCount], &config,
+                                           &job->results[item], 0) == 0;
+    }
+}
+
+/* Estimate VaR and CVaR for every stock at several horizons */
+int computeValueAtRiskBatch(const Stock* stocks, int stockCount, const int* horizons, int horizonCount,
+                            const VaRConfig* config, VaRResult* results) {
+    if (!stocks || stockCount < 0 || !horizons || horizonCount <= 0 || !config || !results) {
+        logError(ERR_INVALID_PARAMETER, "Invalid parameters for computeValueAtRiskBatch");
+        return -1;
+    }
+
+    int items = stockCount * horizonCount;
+    int* succeeded = (int*)calloc(items > 0 ? items : 1, sizeof(int));
+    if (!succeeded) {
+        logError(ERR_OUT_OF_MEMORY, "Failed to allocate VaR batch status");
+        return -1;
+    }
+
+    VaRBatchJob job;
+    job.stocks = stocks;
+    job.horizons = horizons;
+    job.horizonCount = horizonCount;
+    job.config = config;
+    job.results = results;
+    job.succeeded = succeeded;
+
+    int status = parallelFor(items, 1, estimateBatchRange, &job);
+
+    int count = 0;
+    for (int i = 0; i < items; i++) {
+        count += succeeded[i];
+    }
+    free(succeeded);
+    return status == 0 ? count : -1;
+}
+
+/* Historical VaR of a stock in percent of position value */
+double calculateValueAtRisk(const Stock* stock, double confidenceLevel, int timeHorizon) {
+    VaRConfig config;
+    VaRResult result;
+
+    initVaRConfig(&config);
+    config.confidenceLevel = confidenceLevel;
+    config.horizon = timeHorizon;
+
+    if (computeValueAtRisk(stock, &config, &result) != 0) {
+        return 0.0;
+    }
+    return result.valueAtRisk * 100.0;
+}